@@ -0,0 +1,68 @@
+/* block/gsl_block_alloc.h
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_BLOCK_ALLOC_H__
+#define __GSL_BLOCK_ALLOC_H__
+
+#include <stdlib.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/*
+ * Allocation modes for block data, which may be combined:
+ *
+ * ALIGNED  - data is aligned to GSL_BLOCK_ALIGNMENT bytes
+ * HUGEPAGE - data of at least GSL_BLOCK_HUGEPAGE_SIZE bytes is aligned
+ *            to a huge page boundary and advised for transparent huge
+ *            pages where the system supports it (implies ALIGNED)
+ * PADDED   - matrix rows are padded to a multiple of the alignment,
+ *            avoiding leading dimensions which are a multiple of the
+ *            page size and alias to the same cache sets; only
+ *            accepted by the _alloc_mode functions, not as the
+ *            default mode
+ */
+
+#define GSL_BLOCK_ALLOC_DEFAULT   (0)
+#define GSL_BLOCK_ALLOC_ALIGNED   (1 << 0)
+#define GSL_BLOCK_ALLOC_HUGEPAGE  (1 << 1)
+#define GSL_BLOCK_ALLOC_PADDED    (1 << 2)
+
+#define GSL_BLOCK_ALIGNMENT       (64)
+#define GSL_BLOCK_HUGEPAGE_SIZE   (2097152)
+
+/* true if the pointer p is aligned to GSL_BLOCK_ALIGNMENT bytes */
+#define GSL_BLOCK_IS_ALIGNED(p) \
+  ((((size_t) (p)) & (GSL_BLOCK_ALIGNMENT - 1)) == 0)
+
+size_t gsl_block_set_alloc_mode (const size_t mode);
+size_t gsl_block_get_alloc_mode (void);
+
+__END_DECLS
+
+#endif /* __GSL_BLOCK_ALLOC_H__ */
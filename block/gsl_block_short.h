@@ -22,6 +22,7 @@
 
 #include <stdlib.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_block_alloc.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -44,6 +45,7 @@ struct gsl_block_short_struct
 typedef struct gsl_block_short_struct gsl_block_short;
 
 gsl_block_short *gsl_block_short_alloc (const size_t n);
+gsl_block_short *gsl_block_short_alloc_mode (const size_t n, const size_t mode);
 gsl_block_short *gsl_block_short_calloc (const size_t n);
 void gsl_block_short_free (gsl_block_short * b);
 
@@ -1,8 +1,65 @@
 #include <config.h>
 #include <stdlib.h>
 #include <string.h>
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_block.h>
 
+/* the default mode is kept per thread where the compiler supports
+   thread-local storage, and is limited to the modes which do not
+   change the layout of the result; padding must be requested
+   explicitly through the _alloc_mode functions */
+
+#ifdef GSL_TLS
+static GSL_TLS size_t block_alloc_mode = GSL_BLOCK_ALLOC_DEFAULT;
+#else
+static size_t block_alloc_mode = GSL_BLOCK_ALLOC_DEFAULT;
+#endif
+
+size_t
+gsl_block_set_alloc_mode (const size_t mode)
+{
+  size_t previous_mode = block_alloc_mode;
+  block_alloc_mode = mode & (GSL_BLOCK_ALLOC_ALIGNED | GSL_BLOCK_ALLOC_HUGEPAGE);
+  return previous_mode;
+}
+
+size_t
+gsl_block_get_alloc_mode (void)
+{
+  return block_alloc_mode;
+}
+
+/* allocate nbytes of block data according to mode; the result
+   is released with gsl_free() */
+
+static void *
+block_data_alloc (const size_t nbytes, const size_t mode)
+{
+  if (mode & (GSL_BLOCK_ALLOC_ALIGNED | GSL_BLOCK_ALLOC_HUGEPAGE))
+    {
+      void *p;
+      size_t alignment = GSL_BLOCK_ALIGNMENT;
+
+      if ((mode & GSL_BLOCK_ALLOC_HUGEPAGE) && nbytes >= GSL_BLOCK_HUGEPAGE_SIZE)
+        alignment = GSL_BLOCK_HUGEPAGE_SIZE;
+
+      p = gsl_malloc_aligned (nbytes, alignment);
+
+#if HAVE_MADVISE && defined(MADV_HUGEPAGE)
+      /* advisory only, ignore failure */
+      if (p != 0 && alignment == GSL_BLOCK_HUGEPAGE_SIZE)
+        madvise (p, nbytes - nbytes % GSL_BLOCK_HUGEPAGE_SIZE, MADV_HUGEPAGE);
+#endif
+
+      return p;
+    }
+
+  return gsl_malloc (nbytes);
+}
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "init_source.c"
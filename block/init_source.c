@@ -19,6 +19,12 @@
 
 TYPE (gsl_block) *
 FUNCTION (gsl_block, alloc) (const size_t n)
+{
+  return FUNCTION (gsl_block, alloc_mode) (n, gsl_block_get_alloc_mode ());
+}
+
+TYPE (gsl_block) *
+FUNCTION (gsl_block, alloc_mode) (const size_t n, const size_t mode)
 {
   TYPE (gsl_block) * b;
 
@@ -28,7 +34,7 @@ FUNCTION (gsl_block, alloc) (const size_t n)
                         GSL_EINVAL, 0);
     }
 
-  b = (TYPE (gsl_block) *) malloc (sizeof (TYPE (gsl_block)));
+  b = (TYPE (gsl_block) *) gsl_malloc (sizeof (TYPE (gsl_block)));
 
   if (b == 0)
     {
@@ -36,11 +42,11 @@ FUNCTION (gsl_block, alloc) (const size_t n)
                         GSL_ENOMEM, 0);
     }
 
-  b->data = (ATOMIC *) malloc (MULTIPLICITY * n * sizeof (ATOMIC));
+  b->data = (ATOMIC *) block_data_alloc (MULTIPLICITY * n * sizeof (ATOMIC), mode);
 
   if (b->data == 0)
     {
-      free (b);         /* exception in constructor, avoid memory leak */
+      gsl_free (b);     /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for block data",
                         GSL_ENOMEM, 0);
@@ -76,6 +82,6 @@ void
 FUNCTION (gsl_block, free) (TYPE (gsl_block) * b)
 {
   RETURN_IF_NULL (b);
-  free (b->data);
-  free (b);
+  gsl_free (b->data);
+  gsl_free (b);
 }
@@ -63,6 +63,14 @@ FUNCTION (test, func) (void)
   gsl_test (status, NAME (gsl_block) "_calloc initializes array to zero");
 
   FUNCTION (gsl_block, free) (b);
+
+  b = FUNCTION (gsl_block, alloc_mode) (N, GSL_BLOCK_ALLOC_ALIGNED);
+
+  gsl_test (b->data == 0, NAME (gsl_block) "_alloc_mode returns valid pointer");
+  gsl_test (!GSL_BLOCK_IS_ALIGNED (b->data),
+            NAME (gsl_block) "_alloc_mode returns aligned data");
+
+  FUNCTION (gsl_block, free) (b);
 }
 
 void
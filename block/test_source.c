@@ -64,6 +64,48 @@ FUNCTION (test, func) (void)
   gsl_test (status, NAME (gsl_block) "_calloc initializes array to zero");
 
   FUNCTION (gsl_block, free) (v);       /* free whatever is in v */
+
+  v = FUNCTION (gsl_block, alloc_mode) (N, GSL_BLOCK_ALLOC_ALIGNED);
+
+  gsl_test (v->data == 0, NAME (gsl_block) "_alloc_mode returns valid pointer");
+  gsl_test (v->size != N, NAME (gsl_block) "_alloc_mode returns valid size");
+  gsl_test (!GSL_BLOCK_IS_ALIGNED (v->data),
+            NAME (gsl_block) "_alloc_mode returns aligned data");
+
+  FUNCTION (gsl_block, free) (v);
+
+  size = GSL_BLOCK_HUGEPAGE_SIZE / (MULTIPLICITY * sizeof (ATOMIC)) + N;
+  v = FUNCTION (gsl_block, alloc_mode) (size, GSL_BLOCK_ALLOC_HUGEPAGE);
+
+  gsl_test (v->data == 0, NAME (gsl_block) "_alloc_mode hugepage returns valid pointer");
+  gsl_test (!GSL_BLOCK_IS_ALIGNED (v->data),
+            NAME (gsl_block) "_alloc_mode hugepage returns aligned data");
+
+  /* touch the whole block */
+  for (i = 0; i < MULTIPLICITY * size; i++)
+    v->data[i] = 0;
+
+  FUNCTION (gsl_block, free) (v);
+
+  gsl_block_set_alloc_mode (GSL_BLOCK_ALLOC_ALIGNED);
+  v = FUNCTION (gsl_block, calloc) (N);
+
+  gsl_test (!GSL_BLOCK_IS_ALIGNED (v->data),
+            NAME (gsl_block) "_calloc returns aligned data in aligned mode");
+
+  FUNCTION (gsl_block, free) (v);
+
+  status = (gsl_block_set_alloc_mode (GSL_BLOCK_ALLOC_DEFAULT)
+            != GSL_BLOCK_ALLOC_ALIGNED);
+  status |= (gsl_block_get_alloc_mode () != GSL_BLOCK_ALLOC_DEFAULT);
+
+  gsl_test (status, NAME (gsl_block) "_set_alloc_mode returns previous mode");
+
+  gsl_block_set_alloc_mode (GSL_BLOCK_ALLOC_ALIGNED | GSL_BLOCK_ALLOC_PADDED);
+  status = (gsl_block_set_alloc_mode (GSL_BLOCK_ALLOC_DEFAULT)
+            != GSL_BLOCK_ALLOC_ALIGNED);
+
+  gsl_test (status, NAME (gsl_block) "_set_alloc_mode ignores padded mode");
 }
 
 
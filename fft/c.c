@@ -4,6 +4,7 @@
 #include <string.h>
 #include <math.h>
 
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_complex.h>
 
@@ -21,6 +22,7 @@
 #include "c_pass_6.c"
 #include "c_pass_7.c"
 #include "c_pass_n.c"
+#include "c_pass_bluestein.c"
 #include "c_radix2.c"
 #include "bitreverse.c"
 #include "templates_off.h"
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <math.h>
 
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_complex.h>
 
@@ -17,13 +17,162 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+/* Private state for Bluestein's algorithm, kept behind the opaque
+   bluestein pointer of the wavetable: for each large prime factor f,
+   chirp[i] holds b_l = exp(-i pi l^2 / f) for l < f, followed by the
+   transform of length nb of the convolution kernel conj(b), scaled by
+   1/nb. */
+
+typedef struct
+{
+  size_t nb;
+  TYPE(gsl_complex) *chirp[64];
+  TYPE(gsl_complex) *data;
+  TYPE(gsl_fft_complex_wavetable) *wavetable;
+}
+TYPE(fft_complex_bluestein);
+
+static void
+FUNCTION(fft_complex,bluestein_free) (TYPE(fft_complex_bluestein) * b)
+{
+  RETURN_IF_NULL (b);
+
+  gsl_free (b->data);
+
+  if (b->wavetable)
+    {
+      FUNCTION(gsl_fft_complex_wavetable,free) (b->wavetable);
+    }
+
+  gsl_free (b);
+}
+
+static int
+FUNCTION(fft_complex,bluestein_init) (TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                      const size_t nb)
+{
+  size_t i, l, t, total = 0;
+  TYPE(fft_complex_bluestein) * state;
+  TYPE(gsl_fft_complex_workspace) * work;
+  int status = 0;
+
+  for (i = 0; i < wavetable->nf; i++)
+    {
+      if (wavetable->factor[i] >= FFT_BLUESTEIN_MIN_FACTOR)
+        {
+          total += wavetable->factor[i] + nb;
+        }
+    }
+
+  state = (TYPE(fft_complex_bluestein) *)
+    gsl_calloc (1, sizeof (TYPE(fft_complex_bluestein)));
+
+  if (state == NULL)
+    {
+      GSL_ERROR ("failed to allocate Bluestein state", GSL_ENOMEM);
+    }
+
+  state->nb = nb;
+
+  state->data = (TYPE(gsl_complex) *) 
+    gsl_malloc (total * sizeof (TYPE(gsl_complex)));
+
+  if (state->data == NULL)
+    {
+      FUNCTION(fft_complex,bluestein_free) (state);
+      GSL_ERROR ("failed to allocate chirp table", GSL_ENOMEM);
+    }
+
+  state->wavetable = FUNCTION(gsl_fft_complex_wavetable,alloc) (nb);
+
+  if (state->wavetable == NULL)
+    {
+      /* error in constructor, prevent memory leak */
+
+      FUNCTION(fft_complex,bluestein_free) (state);
+      GSL_ERROR ("failed to allocate convolution wavetable", GSL_ENOMEM);
+    }
+
+  work = FUNCTION(gsl_fft_complex_workspace,alloc) (nb);
+
+  if (work == NULL)
+    {
+      /* error in constructor, prevent memory leak */
+
+      FUNCTION(fft_complex,bluestein_free) (state);
+      GSL_ERROR ("failed to allocate convolution workspace", GSL_ENOMEM);
+    }
+
+  t = 0;
+  for (i = 0; i < wavetable->nf && status == 0; i++)
+    {
+      const size_t factor = wavetable->factor[i];
+      TYPE(gsl_complex) *b, *h;
+      size_t l2 = 0;
+
+      if (factor < FFT_BLUESTEIN_MIN_FACTOR)
+        {
+          continue;
+        }
+
+      b = state->data + t;
+      h = b + factor;
+      state->chirp[i] = b;
+      t += factor + nb;
+
+      for (l = 0; l < nb; l++)
+        {
+          GSL_REAL(h[l]) = 0.0;
+          GSL_IMAG(h[l]) = 0.0;
+        }
+
+      for (l = 0; l < factor; l++)
+        {
+          /* l^2 mod 2f, accumulated to avoid overflow */
+          double theta;
+
+          if (l > 0)
+            {
+              l2 = (l2 + 2 * l - 1) % (2 * factor);
+            }
+
+          theta = -M_PI * (double) l2 / (double) factor;
+          GSL_REAL(b[l]) = cos (theta);
+          GSL_IMAG(b[l]) = sin (theta);
+
+          GSL_REAL(h[l]) = cos (theta) / (double) nb;
+          GSL_IMAG(h[l]) = -sin (theta) / (double) nb;
+
+          if (l > 0)
+            {
+              h[nb - l] = h[l];
+            }
+        }
+
+      status = FUNCTION(gsl_fft_complex,forward) ((BASE *) h, 1, nb,
+                                                  state->wavetable, work);
+    }
+
+  FUNCTION(gsl_fft_complex_workspace,free) (work);
+
+  if (status)
+    {
+      FUNCTION(fft_complex,bluestein_free) (state);
+      return status;
+    }
+
+  wavetable->bluestein = state;
+
+  return 0;
+}
+
 TYPE(gsl_fft_complex_wavetable) * 
 FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
 {
   int status ;
   size_t i;
   size_t n_factors;
-  size_t t, product, product_1, q;
+  size_t t, product, product_1, q, nb;
   double d_theta;
 
   TYPE(gsl_fft_complex_wavetable) * wavetable ;
@@ -34,18 +183,18 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
     }
 
   wavetable = (TYPE(gsl_fft_complex_wavetable) *) 
-    malloc(sizeof(TYPE(gsl_fft_complex_wavetable)));
+    gsl_malloc(sizeof(TYPE(gsl_fft_complex_wavetable)));
 
   if (wavetable == NULL)
     {
       GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
     }
 
-  wavetable->trig = (TYPE(gsl_complex) *) malloc (n * sizeof (TYPE(gsl_complex)));
+  wavetable->trig = (TYPE(gsl_complex) *) gsl_malloc (n * sizeof (TYPE(gsl_complex)));
 
   if (wavetable->trig == NULL)
     {
-      free(wavetable) ; /* error in constructor, prevent memory leak */
+      gsl_free(wavetable) ; /* error in constructor, prevent memory leak */
 
       GSL_ERROR_VAL ("failed to allocate trigonometric lookup table", 
                         GSL_ENOMEM, 0);
@@ -53,14 +202,18 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
 
   wavetable->n = n ;
 
+#if defined(FFT_COMPLEX_SSE2) && defined(BASE_DOUBLE)
+  status = fft_complex_factorize_sse2 (n, &n_factors, wavetable->factor);
+#else
   status = fft_complex_factorize (n, &n_factors, wavetable->factor);
+#endif
 
   if (status)
     {
       /* exception in constructor, avoid memory leak */
 
-      free (wavetable->trig);
-      free (wavetable);         
+      gsl_free (wavetable->trig);
+      gsl_free (wavetable);         
 
       GSL_ERROR_VAL ("factorization failed", GSL_EFACTOR, 0);
     };
@@ -102,17 +255,53 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
     {
       /* exception in constructor, avoid memory leak */
 
-      free (wavetable->trig);
-      free (wavetable);
+      gsl_free (wavetable->trig);
+      gsl_free (wavetable);
 
       GSL_ERROR_VAL ("overflowed trigonometric lookup table", 
                         GSL_ESANITY, 0);
     }
 
+  wavetable->bluestein = NULL;
+
+  nb = fft_bluestein_length (n_factors, wavetable->factor);
+
+  if (nb > 0)
+    {
+      status = FUNCTION(fft_complex,bluestein_init) (wavetable, nb);
+
+      if (status)
+        {
+          /* exception in constructor, avoid memory leak */
+
+          FUNCTION(gsl_fft_complex_wavetable,free) (wavetable);
+
+          GSL_ERROR_VAL ("failed to initialize Bluestein tables", 
+                         status, 0);
+        }
+    }
+
   return wavetable;
 }
 
 
+/* number of elements of scratch space for a transform of length n;
+   factors transformed with Bluestein's algorithm need two extra
+   arrays of the convolution length */
+
+static size_t
+FUNCTION(fft_complex,scratch_size) (size_t n)
+{
+  size_t factors[64], nf, nb = 0;
+
+  if (fft_complex_factorize (n, &nf, factors) == 0)
+    {
+      nb = fft_bluestein_length (nf, factors);
+    }
+
+  return 2 * n + 4 * nb;
+}
+
 TYPE(gsl_fft_complex_workspace) * 
 FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
 {
@@ -124,7 +313,7 @@ FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
     }
 
   workspace = (TYPE(gsl_fft_complex_workspace) *) 
-    malloc(sizeof(TYPE(gsl_fft_complex_workspace)));
+    gsl_malloc(sizeof(TYPE(gsl_fft_complex_workspace)));
 
   if (workspace == NULL)
     {
@@ -133,11 +322,12 @@ FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
 
   workspace->n = n ;
 
-  workspace->scratch = (BASE *) malloc (2 * n * sizeof (BASE));
+  workspace->scratch = (BASE *) 
+    gsl_malloc (FUNCTION(fft_complex,scratch_size) (n) * sizeof (BASE));
 
   if (workspace->scratch == NULL)
     {
-      free(workspace) ; /* error in constructor, prevent memory leak */
+      gsl_free(workspace) ; /* error in constructor, prevent memory leak */
 
       GSL_ERROR_VAL ("failed to allocate scratch space", GSL_ENOMEM, 0);
     }
@@ -152,10 +342,13 @@ FUNCTION(gsl_fft_complex_wavetable,free) (TYPE(gsl_fft_complex_wavetable) * wave
   RETURN_IF_NULL (wavetable);
   /* release trigonometric lookup tables */
 
-  free (wavetable->trig);
+  gsl_free (wavetable->trig);
   wavetable->trig = NULL;
 
-  free (wavetable) ;
+  FUNCTION(fft_complex,bluestein_free) (wavetable->bluestein);
+  wavetable->bluestein = NULL;
+
+  gsl_free (wavetable) ;
 }
 
 void
@@ -164,9 +357,9 @@ FUNCTION(gsl_fft_complex_workspace,free) (TYPE(gsl_fft_complex_workspace) * work
   RETURN_IF_NULL (workspace);
   /* release scratch space */
 
-  free (workspace->scratch);
+  gsl_free (workspace->scratch);
   workspace->scratch = NULL;
-  free (workspace) ;
+  gsl_free (workspace) ;
 }
 
 
@@ -191,5 +384,84 @@ FUNCTION(gsl_fft_complex,memcpy) (TYPE(gsl_fft_complex_wavetable) * dest,
       dest->twiddle[i] = dest->trig + (src->twiddle[i] - src->trig) ;
     }
 
+  if (src->bluestein != NULL)
+    {
+      const TYPE(fft_complex_bluestein) * b = src->bluestein;
+      TYPE(fft_complex_bluestein) * d = dest->bluestein;
+      size_t total = 0;
+
+      for (i = 0 ; i < nf ; i++)
+        {
+          if (b->chirp[i] != NULL)
+            {
+              d->chirp[i] = d->data + (b->chirp[i] - b->data) ;
+              total += src->factor[i] + b->nb ;
+            }
+        }
+
+      memcpy(d->data, b->data, total * sizeof (TYPE(gsl_complex))) ;
+
+      return FUNCTION(gsl_fft_complex,memcpy) (d->wavetable, b->wavetable) ;
+    }
+
   return 0 ;
 }
+
+static void *
+FUNCTION(fft_complex,cache_alloc) (size_t n)
+{
+  return FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+}
+
+static void
+FUNCTION(fft_complex,cache_free) (void * wavetable)
+{
+  FUNCTION(gsl_fft_complex_wavetable,free) ((TYPE(gsl_fft_complex_wavetable) *) wavetable);
+}
+
+static void *
+FUNCTION(fft_complex,cache_workspace_alloc) (size_t n)
+{
+  return FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+}
+
+static void
+FUNCTION(fft_complex,cache_workspace_free) (void * workspace)
+{
+  FUNCTION(gsl_fft_complex_workspace,free) ((TYPE(gsl_fft_complex_workspace) *) workspace);
+}
+
+const TYPE(gsl_fft_complex_wavetable) * 
+FUNCTION(gsl_fft_complex_wavetable,get) (size_t n)
+{
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  return (const TYPE(gsl_fft_complex_wavetable) *)
+    fft_cache_get (FFT_CACHE_KIND(FFT_CACHE_COMPLEX), n,
+                   &FUNCTION(fft_complex,cache_alloc),
+                   &FUNCTION(fft_complex,cache_free));
+}
+
+void
+FUNCTION(gsl_fft_complex_wavetable,release) (const TYPE(gsl_fft_complex_wavetable) * wavetable)
+{
+  RETURN_IF_NULL (wavetable);
+  fft_cache_release (wavetable, &FUNCTION(fft_complex,cache_free));
+}
+
+TYPE(gsl_fft_complex_workspace) * 
+FUNCTION(gsl_fft_complex_workspace,get) (size_t n)
+{
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  return (TYPE(gsl_fft_complex_workspace) *)
+    fft_cache_workspace (FFT_CACHE_KIND(FFT_CACHE_COMPLEX), n,
+                         &FUNCTION(fft_complex,cache_workspace_alloc),
+                         &FUNCTION(fft_complex,cache_workspace_free));
+}
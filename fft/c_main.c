@@ -75,6 +75,139 @@ FUNCTION(gsl_fft_complex,inverse) (TYPE(gsl_complex_packed_array) data,
   return status;
 }
 
+/*
+fft_complex_pass()
+  Apply pass i of the transform described by wavetable
+
+Inputs: in, istride   - input of the pass
+        out, ostride  - output of the pass
+        sign          - direction of the transform
+        wavetable     - factorization and twiddle factors
+        i             - index of the pass
+        product       - product of the factors up to and including
+                        factor i
+        n             - length of the transform
+        work          - scratch space for Bluestein passes, of 4 * nb
+                        elements for the convolution length nb
+
+Return: success, or the error status of a Bluestein pass
+
+Notes:
+1) The passes only depend on n and product through q = n / product,
+the number of twiddle factors per butterfly, and the index arithmetic.
+Scaling both n and product by B therefore computes the transforms of B
+sequences stored interleaved, element j of sequence b at index j*B+b,
+with each twiddle factor loaded once for all of them
+*/
+
+static int
+FUNCTION(fft_complex,pass) (BASE in[], const size_t istride,
+                            BASE out[], const size_t ostride,
+                            const gsl_fft_direction sign,
+                            const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                            const size_t i, const size_t product,
+                            const size_t n, BASE work[])
+{
+  const size_t factor = wavetable->factor[i];
+  const size_t q = n / product;
+  const TYPE(fft_complex_bluestein) * bluestein = wavetable->bluestein;
+
+  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4,
+    *twiddle5, *twiddle6;
+
+#if defined(FFT_COMPLEX_SSE2) && defined(BASE_DOUBLE)
+  if (factor == 2)
+    {
+      fft_complex_pass_2_sse2 (in, istride, out, ostride, sign,
+                               product, n, wavetable->twiddle[i]);
+    }
+  else if (factor == 4)
+    {
+      fft_complex_pass_4_sse2 (in, istride, out, ostride, sign,
+                               product, n, wavetable->twiddle[i]);
+    }
+  else if (factor == 8)
+    {
+      fft_complex_pass_8_sse2 (in, istride, out, ostride, sign,
+                               product, n, wavetable->twiddle[i]);
+    }
+  else
+#endif
+  if (factor == 2)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      FUNCTION(fft_complex,pass_2) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1);
+    }
+  else if (factor == 3)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      twiddle2 = twiddle1 + q;
+      FUNCTION(fft_complex,pass_3) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1, twiddle2);
+    }
+  else if (factor == 4)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      twiddle2 = twiddle1 + q;
+      twiddle3 = twiddle2 + q;
+      FUNCTION(fft_complex,pass_4) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1, twiddle2, 
+                                    twiddle3);
+    }
+  else if (factor == 5)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      twiddle2 = twiddle1 + q;
+      twiddle3 = twiddle2 + q;
+      twiddle4 = twiddle3 + q;
+      FUNCTION(fft_complex,pass_5) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1, twiddle2, 
+                                    twiddle3, twiddle4);
+    }
+  else if (factor == 6)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      twiddle2 = twiddle1 + q;
+      twiddle3 = twiddle2 + q;
+      twiddle4 = twiddle3 + q;
+      twiddle5 = twiddle4 + q;
+      FUNCTION(fft_complex,pass_6) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1, twiddle2, 
+                                    twiddle3, twiddle4, twiddle5);
+    }
+  else if (factor == 7)
+    {
+      twiddle1 = wavetable->twiddle[i];
+      twiddle2 = twiddle1 + q;
+      twiddle3 = twiddle2 + q;
+      twiddle4 = twiddle3 + q;
+      twiddle5 = twiddle4 + q;
+      twiddle6 = twiddle5 + q;
+      FUNCTION(fft_complex,pass_7) (in, istride, out, ostride, sign, 
+                                    product, n, twiddle1, twiddle2, 
+                                    twiddle3, twiddle4, twiddle5, 
+                                    twiddle6);
+    }
+  else if (bluestein != NULL && bluestein->chirp[i] != NULL)
+    {
+      return FUNCTION(fft_complex,pass_bluestein) (in, istride, out, ostride, 
+                                                   sign, factor, product, n, 
+                                                   wavetable->twiddle[i], 
+                                                   bluestein->chirp[i], 
+                                                   bluestein->wavetable, 
+                                                   work);
+    }
+  else
+    {
+      twiddle1 = wavetable->twiddle[i];
+      FUNCTION(fft_complex,pass_n) (in, istride, out, ostride, sign, 
+                                    factor, product, n, twiddle1);
+    }
+
+  return 0;
+}
+
 int
 FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data, 
                                      const size_t stride, 
@@ -87,13 +220,12 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
 
   size_t i;
 
-  size_t q, product = 1;
-
-  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4,
-    *twiddle5, *twiddle6;
+  size_t product = 1;
 
   size_t state = 0;
 
+  int status;
+
   BASE * const scratch = work->scratch;
 
   BASE * in = data;
@@ -124,9 +256,7 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
 
   for (i = 0; i < nf; i++)
     {
-      const size_t factor = wavetable->factor[i];
-      product *= factor;
-      q = n / product;
+      product *= wavetable->factor[i];
 
       if (state == 0)
         {
@@ -145,67 +275,13 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
           state = 0;
         }
 
-      if (factor == 2)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          FUNCTION(fft_complex,pass_2) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1);
-        }
-      else if (factor == 3)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          twiddle2 = twiddle1 + q;
-          FUNCTION(fft_complex,pass_3) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1, twiddle2);
-        }
-      else if (factor == 4)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          twiddle2 = twiddle1 + q;
-          twiddle3 = twiddle2 + q;
-          FUNCTION(fft_complex,pass_4) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1, twiddle2, 
-                                        twiddle3);
-        }
-      else if (factor == 5)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          twiddle2 = twiddle1 + q;
-          twiddle3 = twiddle2 + q;
-          twiddle4 = twiddle3 + q;
-          FUNCTION(fft_complex,pass_5) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1, twiddle2, 
-                                        twiddle3, twiddle4);
-        }
-      else if (factor == 6)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          twiddle2 = twiddle1 + q;
-          twiddle3 = twiddle2 + q;
-          twiddle4 = twiddle3 + q;
-          twiddle5 = twiddle4 + q;
-          FUNCTION(fft_complex,pass_6) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1, twiddle2, 
-                                        twiddle3, twiddle4, twiddle5);
-        }
-      else if (factor == 7)
-        {
-          twiddle1 = wavetable->twiddle[i];
-          twiddle2 = twiddle1 + q;
-          twiddle3 = twiddle2 + q;
-          twiddle4 = twiddle3 + q;
-          twiddle5 = twiddle4 + q;
-          twiddle6 = twiddle5 + q;
-          FUNCTION(fft_complex,pass_7) (in, istride, out, ostride, sign, 
-                                        product, n, twiddle1, twiddle2, 
-                                        twiddle3, twiddle4, twiddle5, 
-                                        twiddle6);
-        }
-      else
+      status = FUNCTION(fft_complex,pass) (in, istride, out, ostride, sign,
+                                           wavetable, i, product, n,
+                                           scratch + 2 * n);
+
+      if (status)
         {
-          twiddle1 = wavetable->twiddle[i];
-          FUNCTION(fft_complex,pass_n) (in, istride, out, ostride, sign, 
-                                        factor, product, n, twiddle1);
+          return status;
         }
     }
 
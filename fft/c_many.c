@@ -0,0 +1,435 @@
+/* fft/c_many.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Batches of complex transforms of the same length.
+
+   The sequences are taken up to nblock at a time and copied into
+   scratch space interleaved, element j of sequence b at index
+   j*nblock+b.  Running the ordinary passes over the interleaved block
+   with n and product scaled by nblock (see fft_complex_pass) transforms
+   all of its sequences together: every butterfly of a single transform
+   becomes nblock adjacent butterflies sharing the same twiddle
+   factors, so each twiddle factor is loaded once per block rather than
+   once per sequence.  The block size is chosen so that the two buffers
+   of a block stay in cache.
+
+   Blocks are independent, so a large batch is divided into nthreads
+   shares, which are handed out to the OpenMP threads.  Each thread
+   uses its own slice of scratch space, and records the status of its
+   shares for the caller. */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef FFT_MANY_BLOCK
+#define FFT_MANY_BLOCK 16       /* maximum number of interleaved sequences */
+#endif
+
+#ifndef FFT_MANY_CACHE
+#define FFT_MANY_CACHE 32768    /* bytes of scratch space per block */
+#endif
+
+#ifndef FFT_MANY_PARALLEL
+#define FFT_MANY_PARALLEL 65536 /* minimum count * n for starting threads */
+#endif
+
+/* number of elements of scratch space needed by one thread */
+
+static size_t
+FUNCTION(fft_complex,many_scratch_size) (const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                         const size_t nblock)
+{
+  const TYPE(fft_complex_bluestein) * bluestein = wavetable->bluestein;
+  const size_t nb = (bluestein != NULL) ? bluestein->nb : 0;
+
+  return 4 * wavetable->n * nblock + 4 * nb;
+}
+
+/*
+fft_complex_interleaved()
+  Transform nblock complex sequences of length n stored interleaved
+
+Inputs: x         - (input/output) the sequences, element j of sequence
+                    b at complex index j*nblock+b
+        y         - scratch space of 2*n*nblock elements
+        n         - length of each sequence
+        nblock    - number of sequences
+        wavetable - wavetable for length n
+        work      - scratch space of 4*nb elements for Bluestein
+                    passes, nb the convolution length
+        sign      - direction of the transforms
+        result    - (output) x or y, whichever holds the transformed
+                    sequences
+
+Return: success, or the error status of a Bluestein pass
+*/
+
+static int
+FUNCTION(fft_complex,interleaved) (BASE x[], BASE y[],
+                                   const size_t n, const size_t nblock,
+                                   const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                   BASE work[], const gsl_fft_direction sign,
+                                   BASE ** result)
+{
+  BASE * in = x;
+  BASE * out = y;
+  size_t product = 1;
+  size_t i;
+
+  for (i = 0; i < wavetable->nf; i++)
+    {
+      BASE * t;
+      int status;
+
+      product *= wavetable->factor[i];
+
+      status = FUNCTION(fft_complex,pass) (in, 1, out, 1, sign, wavetable, i,
+                                           product * nblock, n * nblock, work);
+
+      if (status)
+        {
+          return status;
+        }
+
+      t = in;
+      in = out;
+      out = t;
+    }
+
+  *result = in;
+
+  return 0;
+}
+
+/*
+fft_complex_many_thread()
+  Find the calling thread and the number of threads sharing the work
+
+Inputs: nthreads - number of threads of the workspace
+        t        - (output) index of the calling thread, below nthreads
+        nteam    - (output) number of threads in the team
+
+Notes:
+1) The team may be smaller than nthreads, when the parallel region is
+not started or the OpenMP runtime provides fewer threads, so each
+thread takes every nteam-th of the nthreads shares
+*/
+
+static void
+FUNCTION(fft_complex,many_thread) (const size_t nthreads, size_t * t,
+                                   size_t * nteam)
+{
+#ifdef _OPENMP
+  *t = (size_t) omp_get_thread_num ();
+  *nteam = (size_t) omp_get_num_threads ();
+#else
+  *t = 0;
+  *nteam = 1;
+#endif
+
+  if (*nteam > nthreads)
+    {
+      *nteam = nthreads;
+    }
+}
+
+/*
+fft_complex_many_range()
+  Find the blocks of a share
+
+Inputs: nblocks - total number of blocks
+        nshares - number of shares
+        s       - index of the share
+        start   - (output) first block of the share
+        end     - (output) one past its last block
+*/
+
+static void
+FUNCTION(fft_complex,many_range) (const size_t nblocks, const size_t nshares,
+                                  const size_t s, size_t * start, size_t * end)
+{
+  *start = nblocks * s / nshares;
+  *end = nblocks * (s + 1) / nshares;
+}
+
+/* return the first error recorded for the shares of the last batch */
+
+static int
+FUNCTION(fft_complex,many_status) (const TYPE(gsl_fft_complex_workspace_many) * w)
+{
+  size_t s;
+
+  for (s = 0; s < w->nthreads; s++)
+    {
+      if (w->status[s])
+        {
+          return w->status[s];
+        }
+    }
+
+  return 0;
+}
+
+TYPE(gsl_fft_complex_workspace_many) *
+FUNCTION(gsl_fft_complex_workspace_many,alloc) (size_t n, size_t nthreads)
+{
+  TYPE(gsl_fft_complex_workspace_many) * w;
+  size_t nblock;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_complex_workspace_many) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_complex_workspace_many)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+#ifdef _OPENMP
+  if (nthreads == 0)
+    nthreads = (size_t) omp_get_max_threads ();
+#else
+  nthreads = 1;
+#endif
+
+  nblock = FFT_MANY_CACHE / (4 * n * sizeof (BASE));
+  nblock = GSL_MAX (GSL_MIN (nblock, FFT_MANY_BLOCK), 1);
+
+  w->n = n;
+  w->nblock = nblock;
+  w->nthreads = GSL_MAX (nthreads, 1);
+  w->wavetable = FUNCTION(gsl_fft_complex_wavetable,get) (n);
+
+  if (w->wavetable == NULL)
+    {
+      FUNCTION(gsl_fft_complex_workspace_many,free) (w);
+      GSL_ERROR_NULL ("failed to allocate wavetable", GSL_ENOMEM);
+    }
+
+  w->scratch = (BASE *)
+    gsl_malloc (w->nthreads
+                * FUNCTION(fft_complex,many_scratch_size) (w->wavetable, nblock)
+                * sizeof (BASE));
+
+  if (w->scratch == NULL)
+    {
+      FUNCTION(gsl_fft_complex_workspace_many,free) (w);
+      GSL_ERROR_NULL ("failed to allocate scratch space", GSL_ENOMEM);
+    }
+
+  w->status = (int *) gsl_calloc (w->nthreads, sizeof (int));
+
+  if (w->status == NULL)
+    {
+      FUNCTION(gsl_fft_complex_workspace_many,free) (w);
+      GSL_ERROR_NULL ("failed to allocate status array", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_complex_workspace_many,free) (TYPE(gsl_fft_complex_workspace_many) * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->wavetable)
+    FUNCTION(gsl_fft_complex_wavetable,release) (w->wavetable);
+
+  gsl_free (w->scratch);
+  gsl_free (w->status);
+  gsl_free (w);
+}
+
+/*
+fft_complex_many()
+  Transform count complex sequences of length n, scaling the results
+by norm
+
+Notes:
+1) stride and dist are in units of complex elements, as for the
+single transforms
+*/
+
+static int
+FUNCTION(fft_complex,many) (BASE data[], const size_t stride,
+                            const size_t n, const size_t dist,
+                            const size_t count,
+                            TYPE(gsl_fft_complex_workspace_many) * w,
+                            const gsl_fft_direction sign, const ATOMIC norm)
+{
+  const TYPE(gsl_fft_complex_wavetable) * const wavetable = w->wavetable;
+  const size_t nblock = w->nblock;
+  const size_t nblocks = (count + nblock - 1) / nblock;
+  const size_t size = FUNCTION(fft_complex,many_scratch_size) (wavetable, nblock);
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (n != w->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (n == 1)
+    {                           /* FFT of 1 data point is the identity */
+      return 0;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(w->nthreads) if (w->nthreads > 1 && count * n >= FFT_MANY_PARALLEL)
+#endif
+  {
+    size_t t, nteam, s;
+    BASE * x, * y, * work;
+
+    FUNCTION(fft_complex,many_thread) (w->nthreads, &t, &nteam);
+
+    x = w->scratch + t * size;
+    y = x + 2 * n * nblock;
+    work = y + 2 * n * nblock;
+
+    for (s = t; s < w->nthreads; s += nteam)
+      {
+        size_t start, end, k;
+        int status = 0;
+
+        FUNCTION(fft_complex,many_range) (nblocks, w->nthreads, s,
+                                          &start, &end);
+
+        for (k = start; k < end && status == 0; k++)
+          {
+            const size_t first = k * nblock;
+            const size_t m = GSL_MIN (nblock, count - first);
+            BASE * r;
+            size_t b, j;
+
+            if (m == 1)
+              {
+                /* a single sequence is transformed in place, as there
+                   are no twiddle loads to share */
+
+                BASE * const seq = data + 2 * first * dist;
+                TYPE(gsl_fft_complex_workspace) single;
+
+                single.n = n;
+                single.scratch = x;
+
+                status = FUNCTION(gsl_fft_complex,transform) (seq, stride, n,
+                                                              wavetable,
+                                                              &single, sign);
+
+                if (status == 0 && norm != ONE)
+                  {
+                    for (j = 0; j < n; j++)
+                      {
+                        REAL(seq,stride,j) *= norm;
+                        IMAG(seq,stride,j) *= norm;
+                      }
+                  }
+
+                continue;
+              }
+
+            for (b = 0; b < m; b++)
+              {
+                const BASE * const src = data + 2 * (first + b) * dist;
+
+                for (j = 0; j < n; j++)
+                  {
+                    x[2 * (j * m + b)] = REAL(src,stride,j);
+                    x[2 * (j * m + b) + 1] = IMAG(src,stride,j);
+                  }
+              }
+
+            status = FUNCTION(fft_complex,interleaved) (x, y, n, m, wavetable,
+                                                        work, sign, &r);
+
+            if (status)
+              {
+                break;
+              }
+
+            for (b = 0; b < m; b++)
+              {
+                BASE * const dest = data + 2 * (first + b) * dist;
+
+                for (j = 0; j < n; j++)
+                  {
+                    REAL(dest,stride,j) = norm * r[2 * (j * m + b)];
+                    IMAG(dest,stride,j) = norm * r[2 * (j * m + b) + 1];
+                  }
+              }
+          }
+
+        w->status[s] = status;
+      }
+  }
+
+  return FUNCTION(fft_complex,many_status) (w);
+}
+
+int
+FUNCTION(gsl_fft_complex,transform_many) (TYPE(gsl_complex_packed_array) data,
+                                          const size_t stride, const size_t n,
+                                          const size_t dist, const size_t count,
+                                          TYPE(gsl_fft_complex_workspace_many) * w,
+                                          const gsl_fft_direction sign)
+{
+  return FUNCTION(fft_complex,many) (data, stride, n, dist, count, w, sign, ONE);
+}
+
+int
+FUNCTION(gsl_fft_complex,forward_many) (TYPE(gsl_complex_packed_array) data,
+                                        const size_t stride, const size_t n,
+                                        const size_t dist, const size_t count,
+                                        TYPE(gsl_fft_complex_workspace_many) * w)
+{
+  return FUNCTION(fft_complex,many) (data, stride, n, dist, count, w,
+                                     gsl_fft_forward, ONE);
+}
+
+int
+FUNCTION(gsl_fft_complex,backward_many) (TYPE(gsl_complex_packed_array) data,
+                                         const size_t stride, const size_t n,
+                                         const size_t dist, const size_t count,
+                                         TYPE(gsl_fft_complex_workspace_many) * w)
+{
+  return FUNCTION(fft_complex,many) (data, stride, n, dist, count, w,
+                                     gsl_fft_backward, ONE);
+}
+
+int
+FUNCTION(gsl_fft_complex,inverse_many) (TYPE(gsl_complex_packed_array) data,
+                                        const size_t stride, const size_t n,
+                                        const size_t dist, const size_t count,
+                                        TYPE(gsl_fft_complex_workspace_many) * w)
+{
+  /* normalize inverse fft with 1/n */
+
+  return FUNCTION(fft_complex,many) (data, stride, n, dist, count, w,
+                                     gsl_fft_backward, ONE / (ATOMIC) n);
+}
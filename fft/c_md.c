@@ -0,0 +1,529 @@
+/* fft/c_md.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Two and three dimensional complex transforms of arrays stored in
+   row-major order.
+
+   The transforms along the last dimension run in place over the
+   contiguous rows.  Along the other dimensions the elements of one
+   transform are a whole row apart, so instead of transforming each
+   column with a large stride the columns are taken FFT_MD_BLOCK at a
+   time: a block of neighbouring columns is copied into contiguous
+   scratch space, transformed there and copied back.  Each row of the
+   block is a run of adjacent elements, so every cache line which is
+   loaded is used in full. */
+
+#ifndef FFT_MD_BLOCK
+#define FFT_MD_BLOCK 16
+#endif
+
+/*
+fft_complex_lines()
+  Transform count complex sequences of length n
+
+Inputs: data      - first element of the first sequence
+        n         - length of each sequence
+        stride    - distance between successive elements of a sequence
+        count     - number of sequences
+        dist      - distance between the first elements of successive
+                    sequences
+        imoff     - distance from the real to the imaginary part of
+                    an element
+        wavetable - wavetable for length n
+        work      - workspace for length n
+        block     - scratch space of 2 * FFT_MD_BLOCK * n elements
+        sign      - direction of the transforms
+
+Notes:
+1) All distances are in units of BASE, so the real and imaginary parts
+of an element need not be adjacent, as in the columns of halfcomplex
+rows
+*/
+
+static int
+FUNCTION(fft_complex,lines) (BASE data[], const size_t n, const size_t stride,
+                             const size_t count, const size_t dist,
+                             const size_t imoff,
+                             const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                             TYPE(gsl_fft_complex_workspace) * work,
+                             BASE block[], const gsl_fft_direction sign)
+{
+  size_t t;
+
+  if (n == 1)
+    {
+      return 0;
+    }
+
+  if (stride == 2 && imoff == 1)
+    {
+      for (t = 0; t < count; t++)
+        {
+          int status = FUNCTION(gsl_fft_complex,transform) (data + t * dist, 1, n,
+                                                            wavetable, work, sign);
+          if (status)
+            return status;
+        }
+
+      return 0;
+    }
+
+  for (t = 0; t < count; t += FFT_MD_BLOCK)
+    {
+      const size_t nb = GSL_MIN (FFT_MD_BLOCK, count - t);
+      BASE * const d = data + t * dist;
+      size_t b, j;
+
+      for (j = 0; j < n; j++)
+        {
+          const BASE * const x = d + j * stride;
+
+          for (b = 0; b < nb; b++)
+            {
+              block[2 * (b * n + j)] = x[b * dist];
+              block[2 * (b * n + j) + 1] = x[b * dist + imoff];
+            }
+        }
+
+      for (b = 0; b < nb; b++)
+        {
+          int status = FUNCTION(gsl_fft_complex,transform) (block + 2 * b * n, 1, n,
+                                                            wavetable, work, sign);
+          if (status)
+            return status;
+        }
+
+      for (j = 0; j < n; j++)
+        {
+          BASE * const x = d + j * stride;
+
+          for (b = 0; b < nb; b++)
+            {
+              x[b * dist] = block[2 * (b * n + j)];
+              x[b * dist + imoff] = block[2 * (b * n + j) + 1];
+            }
+        }
+    }
+
+  return 0;
+}
+
+/* transform the sequences of length n which start at i * mdist + c * dist
+   for i < m and c < count, merging the two loops into one call of
+   fft_complex_lines when the starting points form a single progression */
+
+static int
+FUNCTION(fft_complex,lines2) (BASE data[], const size_t n, const size_t stride,
+                              const size_t m, const size_t mdist,
+                              const size_t count, const size_t dist,
+                              const size_t imoff,
+                              const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                              TYPE(gsl_fft_complex_workspace) * work,
+                              BASE block[], const gsl_fft_direction sign)
+{
+  size_t i;
+
+  if (count == 1)
+    {
+      return FUNCTION(fft_complex,lines) (data, n, stride, m, mdist, imoff,
+                                          wavetable, work, block, sign);
+    }
+
+  if (count * dist == mdist)
+    {
+      return FUNCTION(fft_complex,lines) (data, n, stride, m * count, dist, imoff,
+                                          wavetable, work, block, sign);
+    }
+
+  for (i = 0; i < m; i++)
+    {
+      int status = FUNCTION(fft_complex,lines) (data + i * mdist, n, stride,
+                                                count, dist, imoff,
+                                                wavetable, work, block, sign);
+      if (status)
+        return status;
+    }
+
+  return 0;
+}
+
+/*
+fft_complex_planes()
+  Transform count two-dimensional complex arrays of n1 x n2 elements
+
+Inputs: data   - element (0,0) of the first array
+        n1, s1 - number of rows and distance between rows
+        n2, s2 - number of columns and distance between columns
+        count  - number of arrays
+        dist   - distance between successive arrays
+        imoff  - distance from the real to the imaginary part of an element
+        wavetable1, work1 - wavetable and workspace for length n1
+        wavetable2, work2 - wavetable and workspace for length n2
+        block  - scratch space of 2 * FFT_MD_BLOCK * max(n1,n2) elements
+        sign   - direction of the transforms
+*/
+
+static int
+FUNCTION(fft_complex,planes) (BASE data[],
+                              const size_t n1, const size_t s1,
+                              const size_t n2, const size_t s2,
+                              const size_t count, const size_t dist,
+                              const size_t imoff,
+                              const TYPE(gsl_fft_complex_wavetable) * wavetable1,
+                              TYPE(gsl_fft_complex_workspace) * work1,
+                              const TYPE(gsl_fft_complex_wavetable) * wavetable2,
+                              TYPE(gsl_fft_complex_workspace) * work2,
+                              BASE block[], const gsl_fft_direction sign)
+{
+  int status = FUNCTION(fft_complex,lines2) (data, n2, s2, n1, s1, count, dist,
+                                             imoff, wavetable2, work2, block, sign);
+
+  if (status)
+    return status;
+
+  return FUNCTION(fft_complex,lines2) (data, n1, s1, n2, s2, count, dist,
+                                       imoff, wavetable1, work1, block, sign);
+}
+
+TYPE(gsl_fft_complex_workspace_2d) *
+FUNCTION(gsl_fft_complex_workspace_2d,alloc) (size_t n1, size_t n2)
+{
+  TYPE(gsl_fft_complex_workspace_2d) * w;
+
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_complex_workspace_2d) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_complex_workspace_2d)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+
+  w->wavetable[0] = FUNCTION(gsl_fft_complex_wavetable,get) (n1);
+  w->wavetable[1] = FUNCTION(gsl_fft_complex_wavetable,get) (n2);
+  w->work[0] = FUNCTION(gsl_fft_complex_workspace,alloc) (n1);
+  w->work[1] = FUNCTION(gsl_fft_complex_workspace,alloc) (n2);
+  w->block = (BASE *) gsl_malloc (2 * FFT_MD_BLOCK * n1 * sizeof (BASE));
+
+  if (w->wavetable[0] == NULL || w->wavetable[1] == NULL
+      || w->work[0] == NULL || w->work[1] == NULL || w->block == NULL)
+    {
+      FUNCTION(gsl_fft_complex_workspace_2d,free) (w);
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_complex_workspace_2d,free) (TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 2; i++)
+    {
+      if (w->wavetable[i])
+        FUNCTION(gsl_fft_complex_wavetable,release) (w->wavetable[i]);
+
+      if (w->work[i])
+        FUNCTION(gsl_fft_complex_workspace,free) (w->work[i]);
+    }
+
+  gsl_free (w->block);
+  gsl_free (w);
+}
+
+TYPE(gsl_fft_complex_workspace_3d) *
+FUNCTION(gsl_fft_complex_workspace_3d,alloc) (size_t n1, size_t n2, size_t n3)
+{
+  TYPE(gsl_fft_complex_workspace_3d) * w;
+  size_t i;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_complex_workspace_3d) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_complex_workspace_3d)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+  w->n3 = n3;
+
+  for (i = 0; i < 3; i++)
+    {
+      const size_t n = (i == 0) ? n1 : (i == 1) ? n2 : n3;
+
+      w->wavetable[i] = FUNCTION(gsl_fft_complex_wavetable,get) (n);
+      w->work[i] = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+
+      if (w->wavetable[i] == NULL || w->work[i] == NULL)
+        {
+          FUNCTION(gsl_fft_complex_workspace_3d,free) (w);
+          GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+        }
+    }
+
+  w->block = (BASE *) gsl_malloc (2 * FFT_MD_BLOCK * GSL_MAX (n1, n2) * sizeof (BASE));
+
+  if (w->block == NULL)
+    {
+      FUNCTION(gsl_fft_complex_workspace_3d,free) (w);
+      GSL_ERROR_NULL ("failed to allocate block space", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_complex_workspace_3d,free) (TYPE(gsl_fft_complex_workspace_3d) * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 3; i++)
+    {
+      if (w->wavetable[i])
+        FUNCTION(gsl_fft_complex_wavetable,release) (w->wavetable[i]);
+
+      if (w->work[i])
+        FUNCTION(gsl_fft_complex_workspace,free) (w->work[i]);
+    }
+
+  gsl_free (w->block);
+  gsl_free (w);
+}
+
+int
+FUNCTION(gsl_fft_complex,transform_2d) (TYPE(gsl_complex_packed_array) data,
+                                        const size_t tda,
+                                        const size_t n1, const size_t n2,
+                                        TYPE(gsl_fft_complex_workspace_2d) * w,
+                                        const gsl_fft_direction sign)
+{
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  if (n1 != w->n1 || n2 != w->n2)
+    {
+      GSL_ERROR ("workspace does not match dimensions of data", GSL_EINVAL);
+    }
+
+  if (tda < n2)
+    {
+      GSL_ERROR ("row stride tda must be at least n2", GSL_EINVAL);
+    }
+
+  return FUNCTION(fft_complex,planes) (data, n1, 2 * tda, n2, 2, 1, 0, 1,
+                                       w->wavetable[0], w->work[0],
+                                       w->wavetable[1], w->work[1],
+                                       w->block, sign);
+}
+
+int
+FUNCTION(gsl_fft_complex,forward_2d) (TYPE(gsl_complex_packed_array) data,
+                                      const size_t tda,
+                                      const size_t n1, const size_t n2,
+                                      TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_complex,transform_2d) (data, tda, n1, n2, w,
+                                                 gsl_fft_forward);
+}
+
+int
+FUNCTION(gsl_fft_complex,backward_2d) (TYPE(gsl_complex_packed_array) data,
+                                       const size_t tda,
+                                       const size_t n1, const size_t n2,
+                                       TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_complex,transform_2d) (data, tda, n1, n2, w,
+                                                 gsl_fft_backward);
+}
+
+int
+FUNCTION(gsl_fft_complex,inverse_2d) (TYPE(gsl_complex_packed_array) data,
+                                      const size_t tda,
+                                      const size_t n1, const size_t n2,
+                                      TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  int status = FUNCTION(gsl_fft_complex,transform_2d) (data, tda, n1, n2, w,
+                                                       gsl_fft_backward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/(n1 n2) */
+
+  {
+    const ATOMIC norm = ONE / ((ATOMIC) n1 * (ATOMIC) n2);
+    size_t i, j;
+
+    for (i = 0; i < n1; i++)
+      {
+        BASE * const row = data + 2 * i * tda;
+
+        for (j = 0; j < 2 * n2; j++)
+          {
+            row[j] *= norm;
+          }
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_complex,transform_3d) (TYPE(gsl_complex_packed_array) data,
+                                        const size_t n1, const size_t n2,
+                                        const size_t n3,
+                                        TYPE(gsl_fft_complex_workspace_3d) * w,
+                                        const gsl_fft_direction sign)
+{
+  int status;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  if (n1 != w->n1 || n2 != w->n2 || n3 != w->n3)
+    {
+      GSL_ERROR ("workspace does not match dimensions of data", GSL_EINVAL);
+    }
+
+  /* contiguous rows along the last dimension */
+
+  status = FUNCTION(fft_complex,lines) (data, n3, 2, n1 * n2, 2 * n3, 1,
+                                        w->wavetable[2], w->work[2],
+                                        w->block, sign);
+
+  if (status)
+    return status;
+
+  /* n1 x n2 planes, taken n3 at a time */
+
+  return FUNCTION(fft_complex,planes) (data, n1, 2 * n2 * n3, n2, 2 * n3,
+                                       n3, 2, 1,
+                                       w->wavetable[0], w->work[0],
+                                       w->wavetable[1], w->work[1],
+                                       w->block, sign);
+}
+
+int
+FUNCTION(gsl_fft_complex,forward_3d) (TYPE(gsl_complex_packed_array) data,
+                                      const size_t n1, const size_t n2,
+                                      const size_t n3,
+                                      TYPE(gsl_fft_complex_workspace_3d) * w)
+{
+  return FUNCTION(gsl_fft_complex,transform_3d) (data, n1, n2, n3, w,
+                                                 gsl_fft_forward);
+}
+
+int
+FUNCTION(gsl_fft_complex,backward_3d) (TYPE(gsl_complex_packed_array) data,
+                                       const size_t n1, const size_t n2,
+                                       const size_t n3,
+                                       TYPE(gsl_fft_complex_workspace_3d) * w)
+{
+  return FUNCTION(gsl_fft_complex,transform_3d) (data, n1, n2, n3, w,
+                                                 gsl_fft_backward);
+}
+
+int
+FUNCTION(gsl_fft_complex,inverse_3d) (TYPE(gsl_complex_packed_array) data,
+                                      const size_t n1, const size_t n2,
+                                      const size_t n3,
+                                      TYPE(gsl_fft_complex_workspace_3d) * w)
+{
+  int status = FUNCTION(gsl_fft_complex,transform_3d) (data, n1, n2, n3, w,
+                                                       gsl_fft_backward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/(n1 n2 n3) */
+
+  {
+    const size_t n = n1 * n2 * n3;
+    const ATOMIC norm = ONE / (ATOMIC) n;
+    size_t i;
+
+    for (i = 0; i < 2 * n; i++)
+      {
+        data[i] *= norm;
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_complex,matrix_forward) (TYPE(gsl_matrix_complex) * m,
+                                          TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_complex,forward_2d) (m->data, m->tda,
+                                               m->size1, m->size2, w);
+}
+
+int
+FUNCTION(gsl_fft_complex,matrix_backward) (TYPE(gsl_matrix_complex) * m,
+                                           TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_complex,backward_2d) (m->data, m->tda,
+                                                m->size1, m->size2, w);
+}
+
+int
+FUNCTION(gsl_fft_complex,matrix_inverse) (TYPE(gsl_matrix_complex) * m,
+                                          TYPE(gsl_fft_complex_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_complex,inverse_2d) (m->data, m->tda,
+                                               m->size1, m->size2, w);
+}
+
+int
+FUNCTION(gsl_fft_complex,matrix_transform) (TYPE(gsl_matrix_complex) * m,
+                                            TYPE(gsl_fft_complex_workspace_2d) * w,
+                                            const gsl_fft_direction sign)
+{
+  return FUNCTION(gsl_fft_complex,transform_2d) (m->data, m->tda,
+                                                 m->size1, m->size2, w, sign);
+}
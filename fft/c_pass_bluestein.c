@@ -0,0 +1,143 @@
+/* fft/c_pass_bluestein.c
+ * 
+ * Copyright (C) 2016 The GSL Team
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Pass for a large prime factor f using Bluestein's algorithm. With
+   lt = (l^2 + t^2 - (l-t)^2)/2 the length f DFT of each butterfly is
+
+     x_l = b_l sum_t (z_t b_t) conj(b_(l-t)),  b_t = exp(+/- i pi t^2 / f)
+
+   a convolution which is computed by transforms of length nb >= 2f-1,
+   a power of 2. The work for the pass is O(n log f) instead of the
+   O(n f) of fft_complex_pass_n. The backward chirp is conj(b), and the
+   transform of its kernel is conj(H(-k)) when H is the transform of
+   the forward kernel, so only the forward tables are stored.
+
+   The array work must have room for 4*nb elements. */
+
+static int
+FUNCTION(fft_complex,pass_bluestein) (const BASE in[],
+                                      const size_t istride,
+                                      BASE out[],
+                                      const size_t ostride,
+                                      const gsl_fft_direction sign,
+                                      const size_t factor,
+                                      const size_t product,
+                                      const size_t n,
+                                      const TYPE(gsl_complex) twiddle[],
+                                      const TYPE(gsl_complex) chirp[],
+                                      const TYPE(gsl_fft_complex_wavetable) * bluestein,
+                                      BASE work[])
+{
+  size_t i = 0, j = 0;
+  size_t k, k1, l;
+
+  const size_t nb = bluestein->n;
+  const size_t m = n / factor;
+  const size_t q = n / product;
+  const size_t p_1 = product / factor;
+  const size_t jump = (factor - 1) * p_1;
+  const ATOMIC s = (sign == gsl_fft_forward) ? 1.0 : -1.0;
+  const TYPE(gsl_complex) *H = chirp + factor;
+
+  BASE *buf = work;
+  TYPE(gsl_fft_complex_workspace) bwork;
+
+  int status;
+
+  bwork.n = nb;
+  bwork.scratch = work + 2 * nb;
+
+  for (k = 0; k < q; k++)
+    {
+      for (k1 = 0; k1 < p_1; k1++)
+        {
+          /* a_t = z_t b_t, zero padded to length nb */
+
+          for (l = 0; l < factor; l++)
+            {
+              const ATOMIC z_real = REAL(in,istride,i + l * m);
+              const ATOMIC z_imag = IMAG(in,istride,i + l * m);
+              const ATOMIC b_real = GSL_REAL(chirp[l]);
+              const ATOMIC b_imag = s * GSL_IMAG(chirp[l]);
+
+              REAL(buf,1,l) = z_real * b_real - z_imag * b_imag;
+              IMAG(buf,1,l) = z_real * b_imag + z_imag * b_real;
+            }
+
+          for (l = factor; l < nb; l++)
+            {
+              REAL(buf,1,l) = 0.0;
+              IMAG(buf,1,l) = 0.0;
+            }
+
+          status = FUNCTION(gsl_fft_complex,forward) (buf, 1, nb, bluestein,
+                                                      &bwork);
+          if (status)
+            return status;
+
+          /* multiply by the transform of the kernel */
+
+          for (l = 0; l < nb; l++)
+            {
+              const size_t lh = (sign == gsl_fft_forward || l == 0) ? l : nb - l;
+              const ATOMIC h_real = GSL_REAL(H[lh]);
+              const ATOMIC h_imag = s * GSL_IMAG(H[lh]);
+              const ATOMIC a_real = REAL(buf,1,l);
+              const ATOMIC a_imag = IMAG(buf,1,l);
+
+              REAL(buf,1,l) = a_real * h_real - a_imag * h_imag;
+              IMAG(buf,1,l) = a_real * h_imag + a_imag * h_real;
+            }
+
+          status = FUNCTION(gsl_fft_complex,backward) (buf, 1, nb, bluestein,
+                                                       &bwork);
+          if (status)
+            return status;
+
+          /* x_l = b_l c_l, times the twiddle factors */
+
+          for (l = 0; l < factor; l++)
+            {
+              const ATOMIC b_real = GSL_REAL(chirp[l]);
+              const ATOMIC b_imag = s * GSL_IMAG(chirp[l]);
+              const ATOMIC c_real = REAL(buf,1,l);
+              const ATOMIC c_imag = IMAG(buf,1,l);
+              const ATOMIC x_real = c_real * b_real - c_imag * b_imag;
+              const ATOMIC x_imag = c_real * b_imag + c_imag * b_real;
+              ATOMIC w_real = 1.0, w_imag = 0.0;
+
+              if (k > 0 && l > 0)
+                {
+                  /* backward transform: w -> conjugate(w) */
+                  w_real = GSL_REAL(twiddle[(l - 1) * q + k - 1]);
+                  w_imag = s * GSL_IMAG(twiddle[(l - 1) * q + k - 1]);
+                }
+
+              REAL(out,ostride,j + l * p_1) = w_real * x_real - w_imag * x_imag;
+              IMAG(out,ostride,j + l * p_1) = w_real * x_imag + w_imag * x_real;
+            }
+
+          i++;
+          j++;
+        }
+      j += jump;
+    }
+
+  return 0;
+}
@@ -0,0 +1,316 @@
+/* fft/c_pass_sse2.c
+ * 
+ * Copyright (C) 2016 The GSL Team
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Radix-2, 4 and 8 passes for double precision complex data using
+   SSE2, which every x86-64 processor provides. Each complex number is
+   held in one register as (real, imag), so the additions in the
+   butterflies are single instructions, a multiplication by +/- i is a
+   swap and a sign change, and a twiddle multiplication takes two
+   multiplications and an addition.
+
+   The passes have the same arguments and produce the same output as
+   the generic passes in c_pass_2.c and c_pass_4.c, which are used on
+   other processors and for single precision. */
+
+#if defined(__SSE2__) && !defined(GSL_FFT_NO_SIMD)
+
+#include <emmintrin.h>
+
+#define FFT_COMPLEX_SSE2 1
+
+/* factorize n for the SSE2 passes, which prefer radix 8 */
+
+static int
+fft_complex_factorize_sse2 (const size_t n, size_t *nf, size_t factors[])
+{
+  const size_t complex_subtransforms[] =
+  {8, 7, 6, 5, 4, 3, 2, 0};
+
+  int status = fft_factorize (n, complex_subtransforms, nf, factors);
+
+  if (status == 0)
+    {
+      /* a radix-2 pass left over after the radix-8 passes is slower
+         than two radix-4 passes, so replace 8*2 by 4*4 */
+
+      size_t i, i8 = *nf, i2 = *nf;
+
+      for (i = 0; i < *nf; i++)
+        {
+          if (factors[i] == 8)
+            i8 = i;
+          else if (factors[i] == 2)
+            i2 = i;
+        }
+
+      if (i8 < *nf && i2 < *nf)
+        {
+          factors[i8] = 4;
+          factors[i2] = 4;
+        }
+    }
+
+  return status;
+}
+
+/* sign*i*z for z = (re, im), where isign = (-sign, sign) */
+
+static __m128d
+fft_sse2_rot (const __m128d z, const __m128d isign)
+{
+  return _mm_mul_pd (_mm_shuffle_pd (z, z, 1), isign);
+}
+
+/* w*z, where wr = (re(w), re(w)) and wi = (-im(w), im(w)) */
+
+static __m128d
+fft_sse2_mul (const __m128d z, const __m128d wr, const __m128d wi)
+{
+  return _mm_add_pd (_mm_mul_pd (z, wr),
+                     _mm_mul_pd (_mm_shuffle_pd (z, z, 1), wi));
+}
+
+/* load twiddle l of block k in the layout of fft_complex_pass_n,
+   conjugated for the backward transform */
+
+static void
+fft_sse2_twiddle (const gsl_complex twiddle[], const size_t q,
+                  const size_t k, const size_t l, const double sign,
+                  __m128d * wr, __m128d * wi)
+{
+  if (k == 0)
+    {
+      *wr = _mm_set1_pd (1.0);
+      *wi = _mm_setzero_pd ();
+    }
+  else
+    {
+      const double w_real = GSL_REAL (twiddle[(l - 1) * q + k - 1]);
+      const double w_imag = -sign * GSL_IMAG (twiddle[(l - 1) * q + k - 1]);
+
+      *wr = _mm_set1_pd (w_real);
+      *wi = _mm_set_pd (w_imag, -w_imag);
+    }
+}
+
+static int
+fft_complex_pass_2_sse2 (const double in[],
+                         const size_t istride,
+                         double out[],
+                         const size_t ostride,
+                         const gsl_fft_direction sign,
+                         const size_t product,
+                         const size_t n,
+                         const gsl_complex twiddle[])
+{
+  size_t i = 0, j = 0;
+  size_t k, k1;
+
+  const size_t factor = 2;
+  const size_t m = n / factor;
+  const size_t q = n / product;
+  const size_t p_1 = product / factor;
+  const size_t jump = (factor - 1) * p_1;
+  const size_t is = 2 * istride, os = 2 * ostride;
+  const double s = (double) ((int) sign);
+
+  for (k = 0; k < q; k++)
+    {
+      __m128d w1r, w1i;
+
+      fft_sse2_twiddle (twiddle, q, k, 1, s, &w1r, &w1i);
+
+      for (k1 = 0; k1 < p_1; k1++)
+        {
+          const double *ip = in + i * is;
+          double *op = out + j * os;
+          const __m128d z0 = _mm_loadu_pd (ip);
+          const __m128d z1 = _mm_loadu_pd (ip + m * is);
+
+          _mm_storeu_pd (op, _mm_add_pd (z0, z1));
+          _mm_storeu_pd (op + p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (z0, z1), w1r, w1i));
+          i++;
+          j++;
+        }
+      j += jump;
+    }
+
+  return 0;
+}
+
+static int
+fft_complex_pass_4_sse2 (const double in[],
+                         const size_t istride,
+                         double out[],
+                         const size_t ostride,
+                         const gsl_fft_direction sign,
+                         const size_t product,
+                         const size_t n,
+                         const gsl_complex twiddle[])
+{
+  size_t i = 0, j = 0;
+  size_t k, k1;
+
+  const size_t factor = 4;
+  const size_t m = n / factor;
+  const size_t q = n / product;
+  const size_t p_1 = product / factor;
+  const size_t jump = (factor - 1) * p_1;
+  const size_t is = 2 * istride, os = 2 * ostride;
+  const double s = (double) ((int) sign);
+  const __m128d isign = _mm_set_pd (s, -s);
+
+  for (k = 0; k < q; k++)
+    {
+      __m128d w1r, w1i, w2r, w2i, w3r, w3i;
+
+      fft_sse2_twiddle (twiddle, q, k, 1, s, &w1r, &w1i);
+      fft_sse2_twiddle (twiddle, q, k, 2, s, &w2r, &w2i);
+      fft_sse2_twiddle (twiddle, q, k, 3, s, &w3r, &w3i);
+
+      for (k1 = 0; k1 < p_1; k1++)
+        {
+          const double *ip = in + i * is;
+          double *op = out + j * os;
+          const __m128d z0 = _mm_loadu_pd (ip);
+          const __m128d z1 = _mm_loadu_pd (ip + m * is);
+          const __m128d z2 = _mm_loadu_pd (ip + 2 * m * is);
+          const __m128d z3 = _mm_loadu_pd (ip + 3 * m * is);
+
+          /* x = W(4) z, as in fft_complex_pass_4 */
+          const __m128d t1 = _mm_add_pd (z0, z2);
+          const __m128d t2 = _mm_add_pd (z1, z3);
+          const __m128d t3 = _mm_sub_pd (z0, z2);
+          const __m128d t4 = fft_sse2_rot (_mm_sub_pd (z1, z3), isign);
+
+          _mm_storeu_pd (op, _mm_add_pd (t1, t2));
+          _mm_storeu_pd (op + p_1 * os,
+                         fft_sse2_mul (_mm_add_pd (t3, t4), w1r, w1i));
+          _mm_storeu_pd (op + 2 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (t1, t2), w2r, w2i));
+          _mm_storeu_pd (op + 3 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (t3, t4), w3r, w3i));
+          i++;
+          j++;
+        }
+      j += jump;
+    }
+
+  return 0;
+}
+
+/* The 8-point butterfly is split into two 4-point butterflies on the
+   even and odd inputs, combined with exp(+/- 2 pi i l / 8), which
+   takes at most one real multiplication per component. */
+
+static int
+fft_complex_pass_8_sse2 (const double in[],
+                         const size_t istride,
+                         double out[],
+                         const size_t ostride,
+                         const gsl_fft_direction sign,
+                         const size_t product,
+                         const size_t n,
+                         const gsl_complex twiddle[])
+{
+  size_t i = 0, j = 0;
+  size_t k, k1, l;
+
+  const size_t factor = 8;
+  const size_t m = n / factor;
+  const size_t q = n / product;
+  const size_t p_1 = product / factor;
+  const size_t jump = (factor - 1) * p_1;
+  const size_t is = 2 * istride, os = 2 * ostride;
+  const double s = (double) ((int) sign);
+  const __m128d isign = _mm_set_pd (s, -s);
+  const __m128d c8 = _mm_set1_pd (M_SQRT1_2);
+
+  for (k = 0; k < q; k++)
+    {
+      __m128d wr[8], wi[8];
+
+      for (l = 1; l < factor; l++)
+        fft_sse2_twiddle (twiddle, q, k, l, s, &wr[l], &wi[l]);
+
+      for (k1 = 0; k1 < p_1; k1++)
+        {
+          const double *ip = in + i * is;
+          double *op = out + j * os;
+          const __m128d z0 = _mm_loadu_pd (ip);
+          const __m128d z1 = _mm_loadu_pd (ip + m * is);
+          const __m128d z2 = _mm_loadu_pd (ip + 2 * m * is);
+          const __m128d z3 = _mm_loadu_pd (ip + 3 * m * is);
+          const __m128d z4 = _mm_loadu_pd (ip + 4 * m * is);
+          const __m128d z5 = _mm_loadu_pd (ip + 5 * m * is);
+          const __m128d z6 = _mm_loadu_pd (ip + 6 * m * is);
+          const __m128d z7 = _mm_loadu_pd (ip + 7 * m * is);
+
+          /* a = W(4) (z0, z2, z4, z6) */
+          const __m128d t1 = _mm_add_pd (z0, z4);
+          const __m128d t2 = _mm_add_pd (z2, z6);
+          const __m128d t3 = _mm_sub_pd (z0, z4);
+          const __m128d t4 = fft_sse2_rot (_mm_sub_pd (z2, z6), isign);
+          const __m128d a0 = _mm_add_pd (t1, t2);
+          const __m128d a1 = _mm_add_pd (t3, t4);
+          const __m128d a2 = _mm_sub_pd (t1, t2);
+          const __m128d a3 = _mm_sub_pd (t3, t4);
+
+          /* b = W(4) (z1, z3, z5, z7) */
+          const __m128d u1 = _mm_add_pd (z1, z5);
+          const __m128d u2 = _mm_add_pd (z3, z7);
+          const __m128d u3 = _mm_sub_pd (z1, z5);
+          const __m128d u4 = fft_sse2_rot (_mm_sub_pd (z3, z7), isign);
+          const __m128d b0 = _mm_add_pd (u1, u2);
+          const __m128d b1 = _mm_add_pd (u3, u4);
+          const __m128d b2 = _mm_sub_pd (u1, u2);
+          const __m128d b3 = _mm_sub_pd (u3, u4);
+
+          /* c_l = exp(+/- 2 pi i l / 8) b_l */
+          const __m128d c1 = _mm_mul_pd (c8, _mm_add_pd (b1, fft_sse2_rot (b1, isign)));
+          const __m128d c2 = fft_sse2_rot (b2, isign);
+          const __m128d c3 = _mm_mul_pd (c8, _mm_sub_pd (fft_sse2_rot (b3, isign), b3));
+
+          /* x_l = a_l + c_l, x_(l+4) = a_l - c_l, times the twiddles */
+          _mm_storeu_pd (op, _mm_add_pd (a0, b0));
+          _mm_storeu_pd (op + p_1 * os,
+                         fft_sse2_mul (_mm_add_pd (a1, c1), wr[1], wi[1]));
+          _mm_storeu_pd (op + 2 * p_1 * os,
+                         fft_sse2_mul (_mm_add_pd (a2, c2), wr[2], wi[2]));
+          _mm_storeu_pd (op + 3 * p_1 * os,
+                         fft_sse2_mul (_mm_add_pd (a3, c3), wr[3], wi[3]));
+          _mm_storeu_pd (op + 4 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (a0, b0), wr[4], wi[4]));
+          _mm_storeu_pd (op + 5 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (a1, c1), wr[5], wi[5]));
+          _mm_storeu_pd (op + 6 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (a2, c2), wr[6], wi[6]));
+          _mm_storeu_pd (op + 7 * p_1 * os,
+                         fft_sse2_mul (_mm_sub_pd (a3, c3), wr[7], wi[7]));
+          i++;
+          j++;
+        }
+      j += jump;
+    }
+
+  return 0;
+}
+
+#endif /* __SSE2__ */
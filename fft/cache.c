@@ -0,0 +1,375 @@
+/* fft/cache.c
+ * 
+ * Copyright (C) 2016 The GSL Team
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Process-wide cache of wavetables, shared read-only between the
+   threads which use them, and per-thread workspaces for the
+   *_workspace_get functions.
+
+   Wavetables are keyed by their length and kind (complex, real or
+   halfcomplex, in double or single precision) and counted: a table
+   stays in the cache after its last release, so that recurring
+   lengths are only set up once, and is freed by gsl_fft_cache_clear
+   when nothing holds it. The list is protected by a POSIX mutex.
+   Without one the tables are not shared: each get creates a new table
+   and its release frees it.
+
+   Each thread keeps its own list of workspaces, one per kind and
+   length, so a workspace stays valid while the thread asks for others
+   of different lengths. With POSIX threads the list is also attached
+   to a thread-specific key, whose destructor frees it when the thread
+   exits. */
+
+#if HAVE_PTHREAD_MUTEX
+#include <pthread.h>
+#endif
+
+enum
+  {
+    FFT_CACHE_COMPLEX = 0,
+    FFT_CACHE_COMPLEX_FLOAT = 1,
+    FFT_CACHE_REAL = 2,
+    FFT_CACHE_REAL_FLOAT = 3,
+    FFT_CACHE_HALFCOMPLEX = 4,
+    FFT_CACHE_HALFCOMPLEX_FLOAT = 5,
+    FFT_CACHE_NKINDS = 6
+  };
+
+/* kind of the current template instantiation */
+#define FFT_CACHE_KIND(k) ((k) + (sizeof (ATOMIC) == sizeof (float)))
+
+typedef struct fft_cache_entry_struct
+{
+  int kind;
+  size_t n;
+  size_t count;                 /* number of unreleased references */
+  void * table;
+  void (*table_free) (void * table);
+  struct fft_cache_entry_struct * next;
+} fft_cache_entry;
+
+#if HAVE_PTHREAD_MUTEX
+static fft_cache_entry * fft_cache_list = NULL;
+static pthread_mutex_t fft_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#ifdef GSL_TLS
+static GSL_TLS fft_cache_entry * fft_cache_workspaces = NULL;
+#endif
+
+#if defined(GSL_TLS) && HAVE_PTHREAD_MUTEX
+static pthread_key_t fft_cache_key;
+static pthread_once_t fft_cache_key_once = PTHREAD_ONCE_INIT;
+static int fft_cache_key_status = -1;
+#endif
+
+/* create a table with the default allocator, since it may outlive any
+   allocator installed by the calling thread */
+
+static void *
+fft_cache_alloc (const size_t n, void * (*table_alloc) (size_t n))
+{
+  const gsl_allocator * a = gsl_set_allocator (NULL);
+  void * table = table_alloc (n);
+
+  gsl_set_allocator (a);
+
+  return table;
+}
+
+#if HAVE_PTHREAD_MUTEX
+/* find the entry of the given kind and length and take a reference to
+   it; the caller holds fft_cache_lock */
+
+static void *
+fft_cache_find (const int kind, const size_t n)
+{
+  fft_cache_entry * e;
+
+  for (e = fft_cache_list; e != NULL; e = e->next)
+    {
+      if (e->kind == kind && e->n == n)
+        {
+          e->count++;
+          return e->table;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/*
+fft_cache_get()
+  Return the cached table of the given kind and length, creating it
+with table_alloc if it is not in the cache yet
+
+Notes:
+1) The table is created outside the lock, so that setting up a long
+table does not hold up threads using other lengths. If another thread
+has added the same length in the meantime, its table is used and the
+new one is freed
+*/
+
+static void *
+fft_cache_get (const int kind, const size_t n,
+               void * (*table_alloc) (size_t n),
+               void (*table_free) (void * table))
+{
+#if HAVE_PTHREAD_MUTEX
+  fft_cache_entry * e;
+  void * table;
+
+  pthread_mutex_lock (&fft_cache_lock);
+  table = fft_cache_find (kind, n);
+  pthread_mutex_unlock (&fft_cache_lock);
+
+  if (table != NULL)
+    {
+      return table;
+    }
+
+  e = (fft_cache_entry *) malloc (sizeof (fft_cache_entry));
+
+  if (e == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate cache entry", GSL_ENOMEM);
+    }
+
+  e->table = fft_cache_alloc (n, table_alloc);
+
+  if (e->table == NULL)
+    {
+      free (e);
+      return NULL;
+    }
+
+  pthread_mutex_lock (&fft_cache_lock);
+
+  table = fft_cache_find (kind, n);
+
+  if (table == NULL)
+    {
+      e->kind = kind;
+      e->n = n;
+      e->count = 1;
+      e->table_free = table_free;
+      e->next = fft_cache_list;
+      fft_cache_list = e;
+      table = e->table;
+      e = NULL;
+    }
+
+  pthread_mutex_unlock (&fft_cache_lock);
+
+  if (e != NULL)
+    {
+      (table_free) (e->table);
+      free (e);
+    }
+
+  return table;
+#else
+  (void) kind;
+  (void) table_free;
+  return fft_cache_alloc (n, table_alloc);
+#endif
+}
+
+static void
+fft_cache_release (const void * table, void (*table_free) (void * table))
+{
+#if HAVE_PTHREAD_MUTEX
+  fft_cache_entry * e;
+  int found = 0;
+
+  (void) table_free;
+
+  pthread_mutex_lock (&fft_cache_lock);
+
+  for (e = fft_cache_list; e != NULL; e = e->next)
+    {
+      if (e->table == table && e->count > 0)
+        {
+          e->count--;
+          found = 1;
+          break;
+        }
+    }
+
+  pthread_mutex_unlock (&fft_cache_lock);
+
+  if (!found)
+    {
+      GSL_ERROR_VOID ("wavetable was not obtained from the cache", GSL_EINVAL);
+    }
+#else
+  (table_free) ((void *) table);
+#endif
+}
+
+#ifdef GSL_TLS
+/* free a list of workspaces */
+
+static void
+fft_cache_workspaces_free (void * list)
+{
+  fft_cache_entry * e = (fft_cache_entry *) list;
+
+  while (e != NULL)
+    {
+      fft_cache_entry * next = e->next;
+
+      (e->table_free) (e->table);
+      free (e);
+      e = next;
+    }
+}
+
+#if HAVE_PTHREAD_MUTEX
+static void
+fft_cache_key_create (void)
+{
+  fft_cache_key_status = pthread_key_create (&fft_cache_key,
+                                             &fft_cache_workspaces_free);
+}
+#endif
+
+/* record the head of the workspace list of the calling thread with the
+   thread-specific key, so that it is freed when the thread exits */
+
+static void
+fft_cache_workspaces_set (fft_cache_entry * list)
+{
+  fft_cache_workspaces = list;
+
+#if HAVE_PTHREAD_MUTEX
+  pthread_once (&fft_cache_key_once, &fft_cache_key_create);
+
+  if (fft_cache_key_status == 0)
+    {
+      pthread_setspecific (fft_cache_key, list);
+    }
+#endif
+}
+#endif
+
+/*
+fft_cache_workspace()
+  Return the workspace of the given kind and length owned by the
+calling thread, creating it with workspace_alloc on first use
+*/
+
+static void *
+fft_cache_workspace (const int kind, const size_t n,
+                     void * (*workspace_alloc) (size_t n),
+                     void (*workspace_free) (void * workspace))
+{
+#ifdef GSL_TLS
+  fft_cache_entry * e;
+
+  for (e = fft_cache_workspaces; e != NULL; e = e->next)
+    {
+      if (e->kind == kind && e->n == n)
+        {
+          return e->table;
+        }
+    }
+
+  e = (fft_cache_entry *) malloc (sizeof (fft_cache_entry));
+
+  if (e == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate cache entry", GSL_ENOMEM);
+    }
+
+  e->table = fft_cache_alloc (n, workspace_alloc);
+
+  if (e->table == NULL)
+    {
+      free (e);
+      return NULL;
+    }
+
+  e->kind = kind;
+  e->n = n;
+  e->count = 1;
+  e->table_free = workspace_free;
+  e->next = fft_cache_workspaces;
+  fft_cache_workspaces_set (e);
+
+  return e->table;
+#else
+  (void) kind;
+  (void) n;
+  (void) workspace_alloc;
+  (void) workspace_free;
+  GSL_ERROR_NULL ("thread-local storage is not available", GSL_EUNSUP);
+#endif
+}
+
+void
+gsl_fft_cache_clear (void)
+{
+#if HAVE_PTHREAD_MUTEX
+  fft_cache_entry * unused = NULL;
+  fft_cache_entry ** p;
+
+  pthread_mutex_lock (&fft_cache_lock);
+
+  p = &fft_cache_list;
+
+  while (*p != NULL)
+    {
+      fft_cache_entry * e = *p;
+
+      if (e->count == 0)
+        {
+          *p = e->next;
+          e->next = unused;
+          unused = e;
+        }
+      else
+        {
+          p = &e->next;
+        }
+    }
+
+  pthread_mutex_unlock (&fft_cache_lock);
+
+  while (unused != NULL)
+    {
+      fft_cache_entry * e = unused;
+
+      unused = e->next;
+      (e->table_free) (e->table);
+      free (e);
+    }
+#endif
+}
+
+void
+gsl_fft_cache_thread_free (void)
+{
+#ifdef GSL_TLS
+  fft_cache_entry * list = fft_cache_workspaces;
+
+  fft_cache_workspaces_set (NULL);
+  fft_cache_workspaces_free (list);
+#endif
+}
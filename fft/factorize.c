@@ -148,6 +148,44 @@ fft_factorize (const size_t n,
 }
 
 
+/* prime factors of at least this size are transformed with
+   Bluestein's algorithm instead of the O(f^2) general module; below
+   it the general module is faster */
+
+#define FFT_BLUESTEIN_MIN_FACTOR 100
+
+/* length of the cyclic convolutions used for the factors transformed
+   with Bluestein's algorithm, the smallest power of 2 which is at
+   least 2f-1 for the largest such factor f, or 0 if there are none */
+
+static size_t
+fft_bluestein_length (const size_t nf, const size_t factors[])
+{
+  size_t i;
+  size_t fmax = 0;
+  size_t nb = 1;
+
+  for (i = 0; i < nf; i++)
+    {
+      if (factors[i] >= FFT_BLUESTEIN_MIN_FACTOR && factors[i] > fmax)
+        {
+          fmax = factors[i];
+        }
+    }
+
+  if (fmax == 0)
+    {
+      return 0;
+    }
+
+  while (nb < 2 * fmax - 1)
+    {
+      nb *= 2;
+    }
+
+  return nb;
+}
+
 static int 
 fft_binary_logn (const size_t n)
 {
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <math.h>
 
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_complex.h>
 
@@ -23,6 +24,8 @@
 #undef  BASE_FLOAT
 
 #include "factorize.c"
+#include "cache.c"
+#include "c_pass_sse2.c"
 
 #define BASE_DOUBLE
 #include "templates_on.h"
@@ -35,7 +38,11 @@
 #include "c_pass_6.c"
 #include "c_pass_7.c"
 #include "c_pass_n.c"
+#include "c_pass_bluestein.c"
 #include "c_radix2.c"
+#include "c_md.c"
+#include "c_many.c"
+#include "real_half.c"
 #include "templates_off.h"
 #undef  BASE_DOUBLE
 
@@ -50,7 +57,11 @@
 #include "c_pass_6.c"
 #include "c_pass_7.c"
 #include "c_pass_n.c"
+#include "c_pass_bluestein.c"
 #include "c_radix2.c"
+#include "c_md.c"
+#include "c_many.c"
+#include "real_half.c"
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
@@ -99,6 +110,8 @@
 #include "real_pass_n.c"
 #include "real_radix2.c"
 #include "real_unpack.c"
+#include "real_md.c"
+#include "real_many.c"
 #include "templates_off.h"
 #undef  BASE_DOUBLE
 
@@ -113,5 +126,7 @@
 #include "real_pass_n.c"
 #include "real_radix2.c"
 #include "real_unpack.c"
+#include "real_md.c"
+#include "real_many.c"
 #include "templates_off.h"
 #undef  BASE_FLOAT
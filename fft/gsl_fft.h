@@ -46,6 +46,12 @@ gsl_fft_direction;
        
    where - is the forward transform direction and + the inverse direction */
 
+/* shared wavetable cache and per-thread workspaces */
+
+void gsl_fft_cache_clear (void);
+
+void gsl_fft_cache_thread_free (void);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_H__ */
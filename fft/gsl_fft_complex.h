@@ -25,6 +25,7 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft.h>
+#include <gsl/gsl_matrix_complex_double.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -84,6 +85,7 @@ typedef struct
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    void *bluestein;    /* private state for Bluestein's algorithm, or NULL */
   }
 gsl_fft_complex_wavetable;
 
@@ -103,6 +105,12 @@ gsl_fft_complex_workspace *gsl_fft_complex_workspace_alloc (size_t n);
 
 void gsl_fft_complex_workspace_free (gsl_fft_complex_workspace * workspace);
 
+const gsl_fft_complex_wavetable *gsl_fft_complex_wavetable_get (size_t n);
+
+void gsl_fft_complex_wavetable_release (const gsl_fft_complex_wavetable * wavetable);
+
+gsl_fft_complex_workspace *gsl_fft_complex_workspace_get (size_t n);
+
 int gsl_fft_complex_memcpy (gsl_fft_complex_wavetable * dest,
                             gsl_fft_complex_wavetable * src);
 
@@ -131,6 +139,122 @@ int gsl_fft_complex_transform (gsl_complex_packed_array data,
                                gsl_fft_complex_workspace * work,
                                const gsl_fft_direction sign);
 
+/*  Two and three dimensional transforms  */
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  const gsl_fft_complex_wavetable *wavetable[2];
+  gsl_fft_complex_workspace *work[2];
+  double *block;
+}
+gsl_fft_complex_workspace_2d;
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  size_t n3;
+  const gsl_fft_complex_wavetable *wavetable[3];
+  gsl_fft_complex_workspace *work[3];
+  double *block;
+}
+gsl_fft_complex_workspace_3d;
+
+gsl_fft_complex_workspace_2d *gsl_fft_complex_workspace_2d_alloc (size_t n1, size_t n2);
+
+void gsl_fft_complex_workspace_2d_free (gsl_fft_complex_workspace_2d * w);
+
+gsl_fft_complex_workspace_3d *gsl_fft_complex_workspace_3d_alloc (size_t n1, size_t n2, size_t n3);
+
+void gsl_fft_complex_workspace_3d_free (gsl_fft_complex_workspace_3d * w);
+
+int gsl_fft_complex_forward_2d (gsl_complex_packed_array data,
+                                const size_t tda, const size_t n1, const size_t n2,
+                                gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_backward_2d (gsl_complex_packed_array data,
+                                 const size_t tda, const size_t n1, const size_t n2,
+                                 gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_inverse_2d (gsl_complex_packed_array data,
+                                const size_t tda, const size_t n1, const size_t n2,
+                                gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_transform_2d (gsl_complex_packed_array data,
+                                  const size_t tda, const size_t n1, const size_t n2,
+                                  gsl_fft_complex_workspace_2d * w,
+                                  const gsl_fft_direction sign);
+
+int gsl_fft_complex_forward_3d (gsl_complex_packed_array data,
+                                const size_t n1, const size_t n2, const size_t n3,
+                                gsl_fft_complex_workspace_3d * w);
+
+int gsl_fft_complex_backward_3d (gsl_complex_packed_array data,
+                                 const size_t n1, const size_t n2, const size_t n3,
+                                 gsl_fft_complex_workspace_3d * w);
+
+int gsl_fft_complex_inverse_3d (gsl_complex_packed_array data,
+                                const size_t n1, const size_t n2, const size_t n3,
+                                gsl_fft_complex_workspace_3d * w);
+
+int gsl_fft_complex_transform_3d (gsl_complex_packed_array data,
+                                  const size_t n1, const size_t n2, const size_t n3,
+                                  gsl_fft_complex_workspace_3d * w,
+                                  const gsl_fft_direction sign);
+
+int gsl_fft_complex_matrix_forward (gsl_matrix_complex * m,
+                                    gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_matrix_backward (gsl_matrix_complex * m,
+                                     gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_matrix_inverse (gsl_matrix_complex * m,
+                                    gsl_fft_complex_workspace_2d * w);
+
+int gsl_fft_complex_matrix_transform (gsl_matrix_complex * m,
+                                      gsl_fft_complex_workspace_2d * w,
+                                      const gsl_fft_direction sign);
+
+/*  Batches of transforms  */
+
+typedef struct
+{
+  size_t n;
+  size_t nblock;
+  size_t nthreads;
+  const gsl_fft_complex_wavetable *wavetable;
+  double *scratch;
+  int *status;                  /* status of each thread's share */
+}
+gsl_fft_complex_workspace_many;
+
+gsl_fft_complex_workspace_many *gsl_fft_complex_workspace_many_alloc (size_t n, size_t nthreads);
+
+void gsl_fft_complex_workspace_many_free (gsl_fft_complex_workspace_many * w);
+
+int gsl_fft_complex_forward_many (gsl_complex_packed_array data,
+                                  const size_t stride, const size_t n,
+                                  const size_t dist, const size_t count,
+                                  gsl_fft_complex_workspace_many * w);
+
+int gsl_fft_complex_backward_many (gsl_complex_packed_array data,
+                                   const size_t stride, const size_t n,
+                                   const size_t dist, const size_t count,
+                                   gsl_fft_complex_workspace_many * w);
+
+int gsl_fft_complex_inverse_many (gsl_complex_packed_array data,
+                                  const size_t stride, const size_t n,
+                                  const size_t dist, const size_t count,
+                                  gsl_fft_complex_workspace_many * w);
+
+int gsl_fft_complex_transform_many (gsl_complex_packed_array data,
+                                    const size_t stride, const size_t n,
+                                    const size_t dist, const size_t count,
+                                    gsl_fft_complex_workspace_many * w,
+                                    const gsl_fft_direction sign);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_COMPLEX_H__ */
@@ -25,6 +25,7 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft.h>
+#include <gsl/gsl_matrix_complex_float.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -84,6 +85,7 @@ typedef struct
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    void *bluestein;    /* private state for Bluestein's algorithm, or NULL */
   }
 gsl_fft_complex_wavetable_float;
 
@@ -103,6 +105,12 @@ gsl_fft_complex_workspace_float *gsl_fft_complex_workspace_float_alloc (size_t n
 
 void gsl_fft_complex_workspace_float_free (gsl_fft_complex_workspace_float * workspace);
 
+const gsl_fft_complex_wavetable_float *gsl_fft_complex_wavetable_float_get (size_t n);
+
+void gsl_fft_complex_wavetable_float_release (const gsl_fft_complex_wavetable_float * wavetable);
+
+gsl_fft_complex_workspace_float *gsl_fft_complex_workspace_float_get (size_t n);
+
 
 int gsl_fft_complex_float_memcpy (gsl_fft_complex_wavetable_float * dest,
                                gsl_fft_complex_wavetable_float * src);
@@ -132,6 +140,122 @@ int gsl_fft_complex_float_transform (gsl_complex_packed_array_float data,
                                      gsl_fft_complex_workspace_float * work,
                                      const gsl_fft_direction sign);
 
+/*  Two and three dimensional transforms  */
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  const gsl_fft_complex_wavetable_float *wavetable[2];
+  gsl_fft_complex_workspace_float *work[2];
+  float *block;
+}
+gsl_fft_complex_workspace_2d_float;
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  size_t n3;
+  const gsl_fft_complex_wavetable_float *wavetable[3];
+  gsl_fft_complex_workspace_float *work[3];
+  float *block;
+}
+gsl_fft_complex_workspace_3d_float;
+
+gsl_fft_complex_workspace_2d_float *gsl_fft_complex_workspace_2d_float_alloc (size_t n1, size_t n2);
+
+void gsl_fft_complex_workspace_2d_float_free (gsl_fft_complex_workspace_2d_float * w);
+
+gsl_fft_complex_workspace_3d_float *gsl_fft_complex_workspace_3d_float_alloc (size_t n1, size_t n2, size_t n3);
+
+void gsl_fft_complex_workspace_3d_float_free (gsl_fft_complex_workspace_3d_float * w);
+
+int gsl_fft_complex_float_forward_2d (gsl_complex_packed_array_float data,
+                                      const size_t tda, const size_t n1, const size_t n2,
+                                      gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_backward_2d (gsl_complex_packed_array_float data,
+                                       const size_t tda, const size_t n1, const size_t n2,
+                                       gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_inverse_2d (gsl_complex_packed_array_float data,
+                                      const size_t tda, const size_t n1, const size_t n2,
+                                      gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_transform_2d (gsl_complex_packed_array_float data,
+                                        const size_t tda, const size_t n1, const size_t n2,
+                                        gsl_fft_complex_workspace_2d_float * w,
+                                        const gsl_fft_direction sign);
+
+int gsl_fft_complex_float_forward_3d (gsl_complex_packed_array_float data,
+                                      const size_t n1, const size_t n2, const size_t n3,
+                                      gsl_fft_complex_workspace_3d_float * w);
+
+int gsl_fft_complex_float_backward_3d (gsl_complex_packed_array_float data,
+                                       const size_t n1, const size_t n2, const size_t n3,
+                                       gsl_fft_complex_workspace_3d_float * w);
+
+int gsl_fft_complex_float_inverse_3d (gsl_complex_packed_array_float data,
+                                      const size_t n1, const size_t n2, const size_t n3,
+                                      gsl_fft_complex_workspace_3d_float * w);
+
+int gsl_fft_complex_float_transform_3d (gsl_complex_packed_array_float data,
+                                        const size_t n1, const size_t n2, const size_t n3,
+                                        gsl_fft_complex_workspace_3d_float * w,
+                                        const gsl_fft_direction sign);
+
+int gsl_fft_complex_float_matrix_forward (gsl_matrix_complex_float * m,
+                                          gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_matrix_backward (gsl_matrix_complex_float * m,
+                                           gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_matrix_inverse (gsl_matrix_complex_float * m,
+                                          gsl_fft_complex_workspace_2d_float * w);
+
+int gsl_fft_complex_float_matrix_transform (gsl_matrix_complex_float * m,
+                                            gsl_fft_complex_workspace_2d_float * w,
+                                            const gsl_fft_direction sign);
+
+/*  Batches of transforms  */
+
+typedef struct
+{
+  size_t n;
+  size_t nblock;
+  size_t nthreads;
+  const gsl_fft_complex_wavetable_float *wavetable;
+  float *scratch;
+  int *status;                  /* status of each thread's share */
+}
+gsl_fft_complex_workspace_many_float;
+
+gsl_fft_complex_workspace_many_float *gsl_fft_complex_workspace_many_float_alloc (size_t n, size_t nthreads);
+
+void gsl_fft_complex_workspace_many_float_free (gsl_fft_complex_workspace_many_float * w);
+
+int gsl_fft_complex_float_forward_many (gsl_complex_packed_array_float data,
+                                        const size_t stride, const size_t n,
+                                        const size_t dist, const size_t count,
+                                        gsl_fft_complex_workspace_many_float * w);
+
+int gsl_fft_complex_float_backward_many (gsl_complex_packed_array_float data,
+                                         const size_t stride, const size_t n,
+                                         const size_t dist, const size_t count,
+                                         gsl_fft_complex_workspace_many_float * w);
+
+int gsl_fft_complex_float_inverse_many (gsl_complex_packed_array_float data,
+                                        const size_t stride, const size_t n,
+                                        const size_t dist, const size_t count,
+                                        gsl_fft_complex_workspace_many_float * w);
+
+int gsl_fft_complex_float_transform_many (gsl_complex_packed_array_float data,
+                                          const size_t stride, const size_t n,
+                                          const size_t dist, const size_t count,
+                                          gsl_fft_complex_workspace_many_float * w,
+                                          const gsl_fft_direction sign);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_COMPLEX_FLOAT_H__ */
@@ -43,13 +43,15 @@ int gsl_fft_halfcomplex_radix2_backward (double data[], const size_t stride, con
 int gsl_fft_halfcomplex_radix2_inverse (double data[], const size_t stride, const size_t n);
 int gsl_fft_halfcomplex_radix2_transform (double data[], const size_t stride, const size_t n);
 
-typedef struct
+typedef struct gsl_fft_halfcomplex_wavetable_struct
   {
     size_t n;
     size_t nf;
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    gsl_fft_complex_wavetable *half;
+    gsl_complex *half_trig;
   }
 gsl_fft_halfcomplex_wavetable;
 
@@ -58,6 +60,11 @@ gsl_fft_halfcomplex_wavetable * gsl_fft_halfcomplex_wavetable_alloc (size_t n);
 void
 gsl_fft_halfcomplex_wavetable_free (gsl_fft_halfcomplex_wavetable * wavetable);
 
+const gsl_fft_halfcomplex_wavetable * gsl_fft_halfcomplex_wavetable_get (size_t n);
+
+void
+gsl_fft_halfcomplex_wavetable_release (const gsl_fft_halfcomplex_wavetable * wavetable);
+
 
 int gsl_fft_halfcomplex_backward (double data[], const size_t stride, const size_t n,
                                   const gsl_fft_halfcomplex_wavetable * wavetable,
@@ -81,6 +88,38 @@ gsl_fft_halfcomplex_radix2_unpack (const double halfcomplex_coefficient[],
                                    double complex_coefficient[],
                                    const size_t stride, const size_t n);
 
+/*  Two and three dimensional transforms  */
+
+int gsl_fft_halfcomplex_backward_2d (double data[], const size_t tda,
+                                     const size_t n1, const size_t n2,
+                                     gsl_fft_real_workspace_2d * w);
+
+int gsl_fft_halfcomplex_inverse_2d (double data[], const size_t tda,
+                                    const size_t n1, const size_t n2,
+                                    gsl_fft_real_workspace_2d * w);
+
+int gsl_fft_halfcomplex_backward_3d (double data[],
+                                     const size_t n1, const size_t n2, const size_t n3,
+                                     gsl_fft_real_workspace_3d * w);
+
+int gsl_fft_halfcomplex_inverse_3d (double data[],
+                                    const size_t n1, const size_t n2, const size_t n3,
+                                    gsl_fft_real_workspace_3d * w);
+
+int gsl_fft_halfcomplex_matrix_backward (gsl_matrix * m,
+                                         gsl_fft_real_workspace_2d * w);
+
+int gsl_fft_halfcomplex_matrix_inverse (gsl_matrix * m,
+                                        gsl_fft_real_workspace_2d * w);
+
+int gsl_fft_halfcomplex_backward_many (double data[], const size_t stride, const size_t n,
+                                       const size_t dist, const size_t count,
+                                       gsl_fft_real_workspace_many * w);
+
+int gsl_fft_halfcomplex_inverse_many (double data[], const size_t stride, const size_t n,
+                                      const size_t dist, const size_t count,
+                                      gsl_fft_real_workspace_many * w);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_HALFCOMPLEX_H__ */
@@ -43,13 +43,15 @@ int gsl_fft_halfcomplex_float_radix2_backward (float data[], const size_t stride
 int gsl_fft_halfcomplex_float_radix2_inverse (float data[], const size_t stride, const size_t n);
 int gsl_fft_halfcomplex_float_radix2_transform (float data[], const size_t stride, const size_t n);
 
-typedef struct
+typedef struct gsl_fft_halfcomplex_wavetable_float_struct
   {
     size_t n;
     size_t nf;
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    gsl_fft_complex_wavetable_float *half;
+    gsl_complex_float *half_trig;
   }
 gsl_fft_halfcomplex_wavetable_float;
 
@@ -59,6 +61,11 @@ gsl_fft_halfcomplex_wavetable_float * gsl_fft_halfcomplex_wavetable_float_alloc
 void
 gsl_fft_halfcomplex_wavetable_float_free (gsl_fft_halfcomplex_wavetable_float * wavetable);
 
+const gsl_fft_halfcomplex_wavetable_float * gsl_fft_halfcomplex_wavetable_float_get (size_t n);
+
+void
+gsl_fft_halfcomplex_wavetable_float_release (const gsl_fft_halfcomplex_wavetable_float * wavetable);
+
 int gsl_fft_halfcomplex_float_backward (float data[], const size_t stride, const size_t n,
                                         const gsl_fft_halfcomplex_wavetable_float * wavetable,
                                         gsl_fft_real_workspace_float * work);
@@ -81,6 +88,38 @@ gsl_fft_halfcomplex_float_radix2_unpack (const float halfcomplex_coefficient[],
                                          float complex_coefficient[],
                                          const size_t stride, const size_t n);
 
+/*  Two and three dimensional transforms  */
+
+int gsl_fft_halfcomplex_float_backward_2d (float data[], const size_t tda,
+                                           const size_t n1, const size_t n2,
+                                           gsl_fft_real_workspace_2d_float * w);
+
+int gsl_fft_halfcomplex_float_inverse_2d (float data[], const size_t tda,
+                                          const size_t n1, const size_t n2,
+                                          gsl_fft_real_workspace_2d_float * w);
+
+int gsl_fft_halfcomplex_float_backward_3d (float data[],
+                                           const size_t n1, const size_t n2, const size_t n3,
+                                           gsl_fft_real_workspace_3d_float * w);
+
+int gsl_fft_halfcomplex_float_inverse_3d (float data[],
+                                          const size_t n1, const size_t n2, const size_t n3,
+                                          gsl_fft_real_workspace_3d_float * w);
+
+int gsl_fft_halfcomplex_float_matrix_backward (gsl_matrix_float * m,
+                                               gsl_fft_real_workspace_2d_float * w);
+
+int gsl_fft_halfcomplex_float_matrix_inverse (gsl_matrix_float * m,
+                                              gsl_fft_real_workspace_2d_float * w);
+
+int gsl_fft_halfcomplex_float_backward_many (float data[], const size_t stride, const size_t n,
+                                             const size_t dist, const size_t count,
+                                             gsl_fft_real_workspace_many_float * w);
+
+int gsl_fft_halfcomplex_float_inverse_many (float data[], const size_t stride, const size_t n,
+                                            const size_t dist, const size_t count,
+                                            gsl_fft_real_workspace_many_float * w);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_HALFCOMPLEX_FLOAT_H__ */
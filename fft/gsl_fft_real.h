@@ -25,6 +25,8 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_matrix_double.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -47,6 +49,8 @@ typedef struct
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    gsl_fft_complex_wavetable *half;
+    gsl_complex *half_trig;
   }
 gsl_fft_real_wavetable;
 
@@ -65,16 +69,93 @@ gsl_fft_real_workspace * gsl_fft_real_workspace_alloc (size_t n);
 
 void  gsl_fft_real_workspace_free (gsl_fft_real_workspace * workspace);
 
+const gsl_fft_real_wavetable * gsl_fft_real_wavetable_get (size_t n);
+
+void  gsl_fft_real_wavetable_release (const gsl_fft_real_wavetable * wavetable);
+
+gsl_fft_real_workspace * gsl_fft_real_workspace_get (size_t n);
+
 
 int gsl_fft_real_transform (double data[], const size_t stride, const size_t n,
                             const gsl_fft_real_wavetable * wavetable,
                             gsl_fft_real_workspace * work);
 
 
+int gsl_fft_real_transform_complex (const double data[],
+                                    double complex_coefficient[],
+                                    const size_t stride, const size_t n,
+                                    const gsl_fft_real_wavetable * wavetable,
+                                    gsl_fft_real_workspace * work);
+
 int gsl_fft_real_unpack (const double real_coefficient[],
                          double complex_coefficient[],
                          const size_t stride, const size_t n);
 
+/*  Two and three dimensional transforms  */
+
+typedef struct
+  {
+    size_t n1;
+    size_t n2;
+    const gsl_fft_real_wavetable *real[2];
+    const struct gsl_fft_halfcomplex_wavetable_struct *halfcomplex[2];
+    gsl_fft_real_workspace *work[2];
+    const gsl_fft_complex_wavetable *cwavetable;
+    gsl_fft_complex_workspace *cwork;
+    double *block;
+  }
+gsl_fft_real_workspace_2d;
+
+typedef struct
+  {
+    size_t n1;
+    size_t n2;
+    size_t n3;
+    const gsl_fft_real_wavetable *real[3];
+    const struct gsl_fft_halfcomplex_wavetable_struct *halfcomplex[3];
+    gsl_fft_real_workspace *work[3];
+    const gsl_fft_complex_wavetable *cwavetable[2];
+    gsl_fft_complex_workspace *cwork[2];
+    double *block;
+  }
+gsl_fft_real_workspace_3d;
+
+gsl_fft_real_workspace_2d * gsl_fft_real_workspace_2d_alloc (size_t n1, size_t n2);
+
+void  gsl_fft_real_workspace_2d_free (gsl_fft_real_workspace_2d * w);
+
+gsl_fft_real_workspace_3d * gsl_fft_real_workspace_3d_alloc (size_t n1, size_t n2, size_t n3);
+
+void  gsl_fft_real_workspace_3d_free (gsl_fft_real_workspace_3d * w);
+
+int gsl_fft_real_transform_2d (double data[], const size_t tda,
+                               const size_t n1, const size_t n2,
+                               gsl_fft_real_workspace_2d * w);
+
+int gsl_fft_real_transform_3d (double data[],
+                               const size_t n1, const size_t n2, const size_t n3,
+                               gsl_fft_real_workspace_3d * w);
+
+int gsl_fft_real_matrix_transform (gsl_matrix * m,
+                                   gsl_fft_real_workspace_2d * w);
+
+/*  Batches of transforms  */
+
+typedef struct
+  {
+    size_t n;
+    gsl_fft_complex_workspace_many *cwork;
+  }
+gsl_fft_real_workspace_many;
+
+gsl_fft_real_workspace_many * gsl_fft_real_workspace_many_alloc (size_t n, size_t nthreads);
+
+void  gsl_fft_real_workspace_many_free (gsl_fft_real_workspace_many * w);
+
+int gsl_fft_real_transform_many (double data[], const size_t stride, const size_t n,
+                                 const size_t dist, const size_t count,
+                                 gsl_fft_real_workspace_many * w);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_REAL_H__ */
@@ -25,6 +25,8 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex_float.h>
+#include <gsl/gsl_matrix_float.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -47,6 +49,8 @@ typedef struct
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    gsl_fft_complex_wavetable_float *half;
+    gsl_complex_float *half_trig;
   }
 gsl_fft_real_wavetable_float;
 
@@ -65,15 +69,92 @@ gsl_fft_real_workspace_float * gsl_fft_real_workspace_float_alloc (size_t n);
 
 void  gsl_fft_real_workspace_float_free (gsl_fft_real_workspace_float * workspace);
 
+const gsl_fft_real_wavetable_float * gsl_fft_real_wavetable_float_get (size_t n);
+
+void  gsl_fft_real_wavetable_float_release (const gsl_fft_real_wavetable_float * wavetable);
+
+gsl_fft_real_workspace_float * gsl_fft_real_workspace_float_get (size_t n);
+
 int gsl_fft_real_float_transform (float data[], const size_t stride, const size_t n,
                                   const gsl_fft_real_wavetable_float * wavetable,
                                   gsl_fft_real_workspace_float * work);
 
 
+int gsl_fft_real_float_transform_complex (const float data[],
+                                          float complex_coefficient[],
+                                          const size_t stride, const size_t n,
+                                          const gsl_fft_real_wavetable_float * wavetable,
+                                          gsl_fft_real_workspace_float * work);
+
 int gsl_fft_real_float_unpack (const float real_float_coefficient[],
                                float complex_coefficient[],
                                const size_t stride, const size_t n);
 
+/*  Two and three dimensional transforms  */
+
+typedef struct
+  {
+    size_t n1;
+    size_t n2;
+    const gsl_fft_real_wavetable_float *real[2];
+    const struct gsl_fft_halfcomplex_wavetable_float_struct *halfcomplex[2];
+    gsl_fft_real_workspace_float *work[2];
+    const gsl_fft_complex_wavetable_float *cwavetable;
+    gsl_fft_complex_workspace_float *cwork;
+    float *block;
+  }
+gsl_fft_real_workspace_2d_float;
+
+typedef struct
+  {
+    size_t n1;
+    size_t n2;
+    size_t n3;
+    const gsl_fft_real_wavetable_float *real[3];
+    const struct gsl_fft_halfcomplex_wavetable_float_struct *halfcomplex[3];
+    gsl_fft_real_workspace_float *work[3];
+    const gsl_fft_complex_wavetable_float *cwavetable[2];
+    gsl_fft_complex_workspace_float *cwork[2];
+    float *block;
+  }
+gsl_fft_real_workspace_3d_float;
+
+gsl_fft_real_workspace_2d_float * gsl_fft_real_workspace_2d_float_alloc (size_t n1, size_t n2);
+
+void  gsl_fft_real_workspace_2d_float_free (gsl_fft_real_workspace_2d_float * w);
+
+gsl_fft_real_workspace_3d_float * gsl_fft_real_workspace_3d_float_alloc (size_t n1, size_t n2, size_t n3);
+
+void  gsl_fft_real_workspace_3d_float_free (gsl_fft_real_workspace_3d_float * w);
+
+int gsl_fft_real_float_transform_2d (float data[], const size_t tda,
+                                     const size_t n1, const size_t n2,
+                                     gsl_fft_real_workspace_2d_float * w);
+
+int gsl_fft_real_float_transform_3d (float data[],
+                                     const size_t n1, const size_t n2, const size_t n3,
+                                     gsl_fft_real_workspace_3d_float * w);
+
+int gsl_fft_real_float_matrix_transform (gsl_matrix_float * m,
+                                         gsl_fft_real_workspace_2d_float * w);
+
+/*  Batches of transforms  */
+
+typedef struct
+  {
+    size_t n;
+    gsl_fft_complex_workspace_many_float *cwork;
+  }
+gsl_fft_real_workspace_many_float;
+
+gsl_fft_real_workspace_many_float * gsl_fft_real_workspace_many_float_alloc (size_t n, size_t nthreads);
+
+void  gsl_fft_real_workspace_many_float_free (gsl_fft_real_workspace_many_float * w);
+
+int gsl_fft_real_float_transform_many (float data[], const size_t stride, const size_t n,
+                                       const size_t dist, const size_t count,
+                                       gsl_fft_real_workspace_many_float * w);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_REAL_FLOAT_H__ */
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <math.h>
 
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_complex.h>
 
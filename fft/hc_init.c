@@ -34,20 +34,20 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
     }
 
   wavetable = (TYPE(gsl_fft_halfcomplex_wavetable) *) 
-    malloc(sizeof(TYPE(gsl_fft_halfcomplex_wavetable)));
+    gsl_malloc(sizeof(TYPE(gsl_fft_halfcomplex_wavetable)));
 
   if (wavetable == NULL)
     {
       GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
     }
 
-  wavetable->trig = (TYPE(gsl_complex) *) malloc (n * sizeof (TYPE(gsl_complex)));
+  wavetable->trig = (TYPE(gsl_complex) *) gsl_malloc (n * sizeof (TYPE(gsl_complex)));
 
   if (wavetable->trig == NULL)
     {
       /* error in constructor, prevent memory leak */
 
-      free(wavetable) ; 
+      gsl_free(wavetable) ; 
 
       GSL_ERROR_VAL ("failed to allocate trigonometric lookup table", 
                         GSL_ENOMEM, 0);
@@ -61,8 +61,8 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
     {
       /* error in constructor, prevent memory leak */
 
-      free(wavetable->trig) ; 
-      free(wavetable) ; 
+      gsl_free(wavetable->trig) ; 
+      gsl_free(wavetable) ; 
 
       GSL_ERROR_VAL ("factorization failed", GSL_EFACTOR, 0);
     }
@@ -104,12 +104,27 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
     {
       /* error in constructor, prevent memory leak */
 
-      free(wavetable->trig) ; 
-      free(wavetable) ; 
+      gsl_free(wavetable->trig) ; 
+      gsl_free(wavetable) ; 
 
       GSL_ERROR_VAL ("overflowed trigonometric lookup table", GSL_ESANITY, 0);
     }
 
+  status = FUNCTION(fft_real,half_alloc) (n, wavetable->nf, wavetable->factor,
+                                          &wavetable->half,
+                                          &wavetable->half_trig);
+
+  if (status)
+    {
+      /* error in constructor, prevent memory leak */
+
+      gsl_free(wavetable->trig);
+      gsl_free(wavetable) ; 
+
+      GSL_ERROR_VAL ("failed to allocate half length wavetable",
+                        GSL_ENOMEM, 0);
+    }
+
   return wavetable;
 }
 
@@ -120,9 +135,45 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,free) (TYPE(gsl_fft_halfcomplex_wavetable
   RETURN_IF_NULL (wavetable);
   /* release trigonometric lookup tables */
 
-  free (wavetable->trig);
+  gsl_free (wavetable->trig);
   wavetable->trig = NULL;
 
-  free (wavetable);
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->half);
+  gsl_free (wavetable->half_trig);
+
+  gsl_free (wavetable);
+}
+
+
+static void *
+FUNCTION(fft_halfcomplex,cache_alloc) (size_t n)
+{
+  return FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (n);
+}
+
+static void
+FUNCTION(fft_halfcomplex,cache_free) (void * wavetable)
+{
+  FUNCTION(gsl_fft_halfcomplex_wavetable,free) ((TYPE(gsl_fft_halfcomplex_wavetable) *) wavetable);
+}
+
+const TYPE(gsl_fft_halfcomplex_wavetable) *
+FUNCTION(gsl_fft_halfcomplex_wavetable,get) (size_t n)
+{
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  return (const TYPE(gsl_fft_halfcomplex_wavetable) *)
+    fft_cache_get (FFT_CACHE_KIND(FFT_CACHE_HALFCOMPLEX), n,
+                   &FUNCTION(fft_halfcomplex,cache_alloc),
+                   &FUNCTION(fft_halfcomplex,cache_free));
 }
 
+void
+FUNCTION(gsl_fft_halfcomplex_wavetable,release) (const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable)
+{
+  RETURN_IF_NULL (wavetable);
+  fft_cache_release (wavetable, &FUNCTION(fft_halfcomplex,cache_free));
+}
@@ -103,6 +103,43 @@ FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->half != NULL)
+    {
+      /* even length, through a complex transform of length n/2 */
+
+      BASE * const a = (stride == 1) ? data : scratch;
+      const BASE xh = data[stride*(n - 1)];
+      int status;
+
+      /* move X_{n/2} from the end to a[1], working down so that data
+         can be rearranged in place */
+
+      for (i = n / 2 - 1; i > 0; i--)
+        {
+          a[2 * i + 1] = data[stride*(2 * i)];
+          a[2 * i] = data[stride*(2 * i - 1)];
+        }
+
+      a[0] = data[0];
+      a[1] = xh;
+
+      status = FUNCTION(fft_real,half_backward) (a, n, wavetable->half,
+                                                 wavetable->half_trig,
+                                                 scratch + n);
+
+      if (status)
+        {
+          return status;
+        }
+
+      for (i = 0; a != data && i < n; i++)
+        {
+          data[stride*i] = a[i];
+        }
+
+      return 0;
+    }
+
   nf = wavetable->nf;
   product = 1;
   state = 0;
@@ -0,0 +1,259 @@
+/* fft/real_half.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Real transforms of even length n through a complex transform of
+   length h = n/2.
+
+   The real sequence x is read as the complex sequence z_j = x_{2j} +
+   i x_{2j+1}, whose transform Z holds the transforms E and O of the
+   even and odd elements of x,
+
+     E_k = (Z_k + conj(Z_{h-k})) / 2,   O_k = (Z_k - conj(Z_{h-k})) / 2i
+
+   and the transform of x follows from X_k = E_k + W^k O_k and X_{h-k}
+   = conj(E_k - W^k O_k), with W = exp(-2 pi i / n).  This lets the
+   real transforms use the complex passes, which cover more radices,
+   are vectorized and handle large prime factors with Bluestein's
+   algorithm, where the real passes are limited to radices 2 to 5.
+
+   The functions below work in place on n contiguous elements holding
+   the transform in the order X_0, X_h, Re X_1, Im X_1, ..., Re X_{h-1},
+   Im X_{h-1}; X_0 and X_h are real. */
+
+#ifndef FFT_REAL_HALF_MIN
+#define FFT_REAL_HALF_MIN 2048  /* smallest length using the complex passes */
+#endif
+
+/*
+fft_real_half_alloc()
+  Set up the complex wavetable for n/2 and the factors W^k for
+k = 0 .. n/4, or set both to NULL when length n is transformed by the
+real passes
+
+Inputs: n         - length of the real transforms
+        nf        - number of factors of n for the real passes
+        factor    - the factors
+        half      - (output) complex wavetable for n/2, or NULL
+        half_trig - (output) cos and sin of 2 pi k / n, or NULL
+
+Return: success or GSL_ENOMEM
+
+Notes:
+1) The real passes are faster for short lengths made of their own
+radices.  Lengths with a factor above 5, which the real passes
+transform with an O(p^2) generic pass, and long lengths, which
+benefit from the radix-8 and vectorized complex passes, go through
+the complex transform.  The single precision complex passes are not
+vectorized, so their threshold is higher.
+*/
+
+static int
+FUNCTION(fft_real,half_alloc) (const size_t n, const size_t nf,
+                               const size_t factor[],
+                               TYPE(gsl_fft_complex_wavetable) ** half,
+                               TYPE(gsl_complex) ** half_trig)
+{
+  const double d_theta = 2.0 * M_PI / ((double) n);
+  const size_t nmin = (sizeof (ATOMIC) == sizeof (double)) ?
+    FFT_REAL_HALF_MIN : 4 * FFT_REAL_HALF_MIN;
+  int generic = 0;
+  size_t k;
+
+  *half = NULL;
+  *half_trig = NULL;
+
+  for (k = 0; k < nf; k++)
+    {
+      if (factor[k] > 5)
+        generic = 1;
+    }
+
+  if (n % 2 != 0 || (n < nmin && !generic))
+    {
+      return GSL_SUCCESS;
+    }
+
+  *half = FUNCTION(gsl_fft_complex_wavetable,alloc) (n / 2);
+  *half_trig = (TYPE(gsl_complex) *)
+    gsl_malloc ((n / 4 + 1) * sizeof (TYPE(gsl_complex)));
+
+  if (*half == NULL || *half_trig == NULL)
+    {
+      FUNCTION(gsl_fft_complex_wavetable,free) (*half);
+      gsl_free (*half_trig);
+      *half = NULL;
+      *half_trig = NULL;
+      return GSL_ENOMEM;
+    }
+
+  for (k = 0; k <= n / 4; k++)
+    {
+      const double theta = d_theta * k;
+      GSL_REAL((*half_trig)[k]) = cos (theta);
+      GSL_IMAG((*half_trig)[k]) = sin (theta);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+fft_real_half_forward()
+  Replace the real sequence a of even length n by its transform
+
+Inputs: a         - (input/output) the sequence
+        n         - length of the sequence
+        half      - complex wavetable for length n/2
+        half_trig - cos and sin of 2 pi k / n, k = 0 .. n/4
+        work      - scratch space for a complex transform of length n/2
+
+Return: success, or the error status of the complex transform
+*/
+
+static int
+FUNCTION(fft_real,half_forward) (BASE a[], const size_t n,
+                                 const TYPE(gsl_fft_complex_wavetable) * half,
+                                 const TYPE(gsl_complex) * half_trig,
+                                 BASE work[])
+{
+  const size_t h = n / 2;
+  TYPE(gsl_fft_complex_workspace) cwork;
+  size_t k;
+  int status;
+
+  cwork.n = h;
+  cwork.scratch = work;
+
+  status = FUNCTION(gsl_fft_complex,transform) (a, 1, h, half, &cwork,
+                                                gsl_fft_forward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  {
+    const ATOMIC zr = a[0];
+    const ATOMIC zi = a[1];
+
+    a[0] = zr + zi;
+    a[1] = zr - zi;
+  }
+
+  for (k = 1; k < h - k; k++)
+    {
+      const ATOMIC zr = a[2 * k];
+      const ATOMIC zi = a[2 * k + 1];
+      const ATOMIC yr = a[2 * (h - k)];
+      const ATOMIC yi = a[2 * (h - k) + 1];
+
+      const ATOMIC er = (zr + yr) / 2;
+      const ATOMIC ei = (zi - yi) / 2;
+      const ATOMIC qr = (zi + yi) / 2;
+      const ATOMIC qi = (yr - zr) / 2;
+
+      /* t = W^k O_k */
+
+      const ATOMIC wr = GSL_REAL(half_trig[k]);
+      const ATOMIC wi = -GSL_IMAG(half_trig[k]);
+      const ATOMIC tr = wr * qr - wi * qi;
+      const ATOMIC ti = wr * qi + wi * qr;
+
+      a[2 * k] = er + tr;
+      a[2 * k + 1] = ei + ti;
+      a[2 * (h - k)] = er - tr;
+      a[2 * (h - k) + 1] = ti - ei;
+    }
+
+  if (k == h - k)
+    {
+      /* X_{h/2} = conj(Z_{h/2}) */
+      a[2 * k + 1] = -a[2 * k + 1];
+    }
+
+  return 0;
+}
+
+/*
+fft_real_half_backward()
+  Replace the transform a of a real sequence of even length n by the
+sequence, scaled by n
+
+Inputs: as for fft_real_half_forward
+
+Return: success, or the error status of the complex transform
+*/
+
+static int
+FUNCTION(fft_real,half_backward) (BASE a[], const size_t n,
+                                  const TYPE(gsl_fft_complex_wavetable) * half,
+                                  const TYPE(gsl_complex) * half_trig,
+                                  BASE work[])
+{
+  const size_t h = n / 2;
+  TYPE(gsl_fft_complex_workspace) cwork;
+  size_t k;
+
+  /* Z_k = 2 E_k + 2 i O_k, giving n x after a backward transform of
+     length h */
+
+  {
+    const ATOMIC x0 = a[0];
+    const ATOMIC xh = a[1];
+
+    a[0] = x0 + xh;
+    a[1] = x0 - xh;
+  }
+
+  for (k = 1; k < h - k; k++)
+    {
+      const ATOMIC xr = a[2 * k];
+      const ATOMIC xi = a[2 * k + 1];
+      const ATOMIC yr = a[2 * (h - k)];
+      const ATOMIC yi = a[2 * (h - k) + 1];
+
+      const ATOMIC sr = xr + yr;
+      const ATOMIC si = xi - yi;
+      const ATOMIC dr = xr - yr;
+      const ATOMIC di = xi + yi;
+
+      /* t = conj(W^k) (X_k - conj(X_{h-k})) = 2 O_k */
+
+      const ATOMIC wr = GSL_REAL(half_trig[k]);
+      const ATOMIC wi = GSL_IMAG(half_trig[k]);
+      const ATOMIC tr = wr * dr - wi * di;
+      const ATOMIC ti = wr * di + wi * dr;
+
+      a[2 * k] = sr - ti;
+      a[2 * k + 1] = si + tr;
+      a[2 * (h - k)] = sr + ti;
+      a[2 * (h - k) + 1] = tr - si;
+    }
+
+  if (k == h - k)
+    {
+      a[2 * k] = 2 * a[2 * k];
+      a[2 * k + 1] = -2 * a[2 * k + 1];
+    }
+
+  cwork.n = h;
+  cwork.scratch = work;
+
+  return FUNCTION(gsl_fft_complex,transform) (a, 1, h, half, &cwork,
+                                              gsl_fft_backward);
+}
@@ -34,7 +34,7 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
     }
 
   wavetable = (TYPE(gsl_fft_real_wavetable) *) 
-    malloc(sizeof(TYPE(gsl_fft_real_wavetable)));
+    gsl_malloc(sizeof(TYPE(gsl_fft_real_wavetable)));
 
   if (wavetable == NULL)
     {
@@ -48,13 +48,13 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
   else
     {
       wavetable->trig = (TYPE(gsl_complex) *) 
-        malloc ((n / 2) * sizeof (TYPE(gsl_complex)));
+        gsl_malloc ((n / 2) * sizeof (TYPE(gsl_complex)));
       
       if (wavetable->trig == NULL)
         {
           /* error in constructor, prevent memory leak */
           
-          free(wavetable) ; 
+          gsl_free(wavetable) ; 
 
           GSL_ERROR_VAL ("failed to allocate trigonometric lookup table", 
                             GSL_ENOMEM, 0);
@@ -69,8 +69,8 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
     {
       /* error in constructor, prevent memory leak */
       
-      free(wavetable->trig);
-      free(wavetable) ; 
+      gsl_free(wavetable->trig);
+      gsl_free(wavetable) ; 
 
       GSL_ERROR_VAL ("factorization failed", GSL_EFACTOR, 0);
     }
@@ -112,16 +112,42 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
     {
       /* error in constructor, prevent memory leak */
 
-      free(wavetable->trig);
-      free(wavetable) ; 
+      gsl_free(wavetable->trig);
+      gsl_free(wavetable) ; 
 
       GSL_ERROR_VAL ("overflowed trigonometric lookup table", 
                         GSL_ESANITY, 0);
     }
 
+  status = FUNCTION(fft_real,half_alloc) (n, wavetable->nf, wavetable->factor,
+                                          &wavetable->half,
+                                          &wavetable->half_trig);
+
+  if (status)
+    {
+      /* error in constructor, prevent memory leak */
+
+      gsl_free(wavetable->trig);
+      gsl_free(wavetable) ; 
+
+      GSL_ERROR_VAL ("failed to allocate half length wavetable",
+                        GSL_ENOMEM, 0);
+    }
+
   return wavetable;
 }
 
+/* number of elements of scratch space for a real transform of length
+   n; the transforms through a complex transform of length n/2 keep the
+   data in the first n elements and use the rest as the scratch space
+   of the complex transform */
+
+static size_t
+FUNCTION(fft_real,scratch_size) (size_t n)
+{
+  return n + ((n % 2 == 0) ? FUNCTION(fft_complex,scratch_size) (n / 2) : n);
+}
+
 TYPE(gsl_fft_real_workspace) *
 FUNCTION(gsl_fft_real_workspace,alloc) (size_t n)
 {
@@ -133,7 +159,7 @@ FUNCTION(gsl_fft_real_workspace,alloc) (size_t n)
     }
 
   workspace = (TYPE(gsl_fft_real_workspace) *) 
-    malloc(sizeof(TYPE(gsl_fft_real_workspace)));
+    gsl_malloc(sizeof(TYPE(gsl_fft_real_workspace)));
 
   if (workspace == NULL)
     {
@@ -142,13 +168,14 @@ FUNCTION(gsl_fft_real_workspace,alloc) (size_t n)
 
   workspace->n = n;
 
-  workspace->scratch = (BASE *) malloc (n * sizeof (BASE));
+  workspace->scratch = (BASE *) 
+    gsl_malloc (FUNCTION(fft_real,scratch_size) (n) * sizeof (BASE));
 
   if (workspace->scratch == NULL)
     {
       /* error in constructor, prevent memory leak */
       
-      free(workspace) ; 
+      gsl_free(workspace) ; 
 
       GSL_ERROR_VAL ("failed to allocate scratch space", GSL_ENOMEM, 0);
     }
@@ -164,10 +191,13 @@ FUNCTION(gsl_fft_real_wavetable,free) (TYPE(gsl_fft_real_wavetable) * wavetable)
   RETURN_IF_NULL (wavetable);
   /* release trigonometric lookup tables */
 
-  free (wavetable->trig);
+  gsl_free (wavetable->trig);
   wavetable->trig = NULL;
 
-  free (wavetable) ;
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->half);
+  gsl_free (wavetable->half_trig);
+
+  gsl_free (wavetable) ;
 }
 
 void
@@ -176,8 +206,68 @@ FUNCTION(gsl_fft_real_workspace,free) (TYPE(gsl_fft_real_workspace) * workspace)
   RETURN_IF_NULL (workspace);
   /* release scratch space */
 
-  free (workspace->scratch);
+  gsl_free (workspace->scratch);
   workspace->scratch = NULL;
 
-  free (workspace) ;
+  gsl_free (workspace) ;
+}
+
+
+static void *
+FUNCTION(fft_real,cache_alloc) (size_t n)
+{
+  return FUNCTION(gsl_fft_real_wavetable,alloc) (n);
+}
+
+static void
+FUNCTION(fft_real,cache_free) (void * wavetable)
+{
+  FUNCTION(gsl_fft_real_wavetable,free) ((TYPE(gsl_fft_real_wavetable) *) wavetable);
+}
+
+static void *
+FUNCTION(fft_real,cache_workspace_alloc) (size_t n)
+{
+  return FUNCTION(gsl_fft_real_workspace,alloc) (n);
+}
+
+static void
+FUNCTION(fft_real,cache_workspace_free) (void * workspace)
+{
+  FUNCTION(gsl_fft_real_workspace,free) ((TYPE(gsl_fft_real_workspace) *) workspace);
+}
+
+const TYPE(gsl_fft_real_wavetable) *
+FUNCTION(gsl_fft_real_wavetable,get) (size_t n)
+{
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  return (const TYPE(gsl_fft_real_wavetable) *)
+    fft_cache_get (FFT_CACHE_KIND(FFT_CACHE_REAL), n,
+                   &FUNCTION(fft_real,cache_alloc),
+                   &FUNCTION(fft_real,cache_free));
+}
+
+void
+FUNCTION(gsl_fft_real_wavetable,release) (const TYPE(gsl_fft_real_wavetable) * wavetable)
+{
+  RETURN_IF_NULL (wavetable);
+  fft_cache_release (wavetable, &FUNCTION(fft_real,cache_free));
+}
+
+TYPE(gsl_fft_real_workspace) *
+FUNCTION(gsl_fft_real_workspace,get) (size_t n)
+{
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  return (TYPE(gsl_fft_real_workspace) *)
+    fft_cache_workspace (FFT_CACHE_KIND(FFT_CACHE_REAL), n,
+                         &FUNCTION(fft_real,cache_workspace_alloc),
+                         &FUNCTION(fft_real,cache_workspace_free));
 }
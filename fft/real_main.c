@@ -26,6 +26,7 @@
 #include <gsl/gsl_fft_real.h>
 
 #include "real_pass.h"
+#include "complex_internal.h"
 
 int
 FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t n,
@@ -69,6 +70,44 @@ FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->half != NULL)
+    {
+      /* even length, through a complex transform of length n/2 */
+
+      BASE * const a = (stride == 1) ? data : scratch;
+      BASE xh;
+      int status;
+
+      for (i = 0; a != data && i < n; i++)
+        {
+          a[i] = data[stride*i];
+        }
+
+      status = FUNCTION(fft_real,half_forward) (a, n, wavetable->half,
+                                                wavetable->half_trig,
+                                                scratch + n);
+
+      if (status)
+        {
+          return status;
+        }
+
+      /* move X_{n/2} from a[1] to the end, in halfcomplex order */
+
+      xh = a[1];
+      data[0] = a[0];
+
+      for (i = 1; i < n / 2; i++)
+        {
+          data[stride*(2 * i - 1)] = a[2 * i];
+          data[stride*(2 * i)] = a[2 * i + 1];
+        }
+
+      data[stride*(n - 1)] = xh;
+
+      return 0;
+    }
+
   for (i = 0; i < nf; i++)
     {
       const size_t factor = wavetable->factor[i];
@@ -143,3 +182,90 @@ FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t
   return 0;
 
 }
+
+int
+FUNCTION(gsl_fft_real,transform_complex) (const BASE data[],
+                                          BASE complex_coefficient[],
+                                          const size_t stride, const size_t n,
+                                          const TYPE(gsl_fft_real_wavetable) * wavetable,
+                                          TYPE(gsl_fft_real_workspace) * work)
+{
+  BASE * const a = work->scratch;
+  size_t i;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (n != wavetable->n)
+    {
+      GSL_ERROR ("wavetable does not match length of data", GSL_EINVAL);
+    }
+
+  if (n != work->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      a[i] = data[stride*i];
+    }
+
+  if (wavetable->half != NULL)
+    {
+      const size_t h = n / 2;
+      int status = FUNCTION(fft_real,half_forward) (a, n, wavetable->half,
+                                                    wavetable->half_trig, a + n);
+
+      if (status)
+        {
+          return status;
+        }
+
+      REAL(complex_coefficient,stride,0) = a[0];
+      IMAG(complex_coefficient,stride,0) = 0.0;
+      REAL(complex_coefficient,stride,h) = a[1];
+      IMAG(complex_coefficient,stride,h) = 0.0;
+
+      for (i = 1; i < h; i++)
+        {
+          REAL(complex_coefficient,stride,i) = a[2 * i];
+          IMAG(complex_coefficient,stride,i) = a[2 * i + 1];
+          REAL(complex_coefficient,stride,n - i) = a[2 * i];
+          IMAG(complex_coefficient,stride,n - i) = -a[2 * i + 1];
+        }
+    }
+  else
+    {
+      /* transform the copy with the real passes, which only use n
+         elements of scratch space, and expand the halfcomplex result */
+
+      TYPE(gsl_fft_real_workspace) rwork;
+
+      rwork.n = n;
+      rwork.scratch = a + n;
+
+      FUNCTION(gsl_fft_real,transform) (a, 1, n, wavetable, &rwork);
+
+      REAL(complex_coefficient,stride,0) = a[0];
+      IMAG(complex_coefficient,stride,0) = 0.0;
+
+      for (i = 1; i < n - i; i++)
+        {
+          REAL(complex_coefficient,stride,i) = a[2 * i - 1];
+          IMAG(complex_coefficient,stride,i) = a[2 * i];
+          REAL(complex_coefficient,stride,n - i) = a[2 * i - 1];
+          IMAG(complex_coefficient,stride,n - i) = -a[2 * i];
+        }
+
+      if (i == n - i)
+        {
+          REAL(complex_coefficient,stride,i) = a[n - 1];
+          IMAG(complex_coefficient,stride,i) = 0.0;
+        }
+    }
+
+  return 0;
+}
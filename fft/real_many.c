@@ -0,0 +1,307 @@
+/* fft/real_many.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Batches of real transforms of the same length.
+
+   Two real sequences a and b are transformed together as the real
+   and imaginary parts of one complex sequence z = a + i b.  Since a
+   and b are real their transforms are conjugate-symmetric, and are
+   separated again using
+
+     A_k = (Z_k + conj(Z_{n-k})) / 2,   B_k = (Z_k - conj(Z_{n-k})) / 2i
+
+   The complex sequences go through the interleaved blocks of
+   c_many.c, so a block of nblock complex transforms carries 2*nblock
+   real ones.  In the other direction the halfcomplex sequences are
+   combined into Z_k = A_k + i B_k, and after the complex backward
+   transform a and b are the real and imaginary parts of the result.
+   An odd sequence left over at the end of the batch is paired with
+   zeros. */
+
+TYPE(gsl_fft_real_workspace_many) *
+FUNCTION(gsl_fft_real_workspace_many,alloc) (size_t n, size_t nthreads)
+{
+  TYPE(gsl_fft_real_workspace_many) * w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("length n must be positive integer", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_real_workspace_many) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_real_workspace_many)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+  w->n = n;
+  w->cwork = FUNCTION(gsl_fft_complex_workspace_many,alloc) (n, nthreads);
+
+  if (w->cwork == NULL)
+    {
+      gsl_free (w);
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_real_workspace_many,free) (TYPE(gsl_fft_real_workspace_many) * w)
+{
+  RETURN_IF_NULL (w);
+
+  FUNCTION(gsl_fft_complex_workspace_many,free) (w->cwork);
+  gsl_free (w);
+}
+
+/*
+fft_real_many()
+  Transform count real sequences of length n to halfcomplex form, or
+count halfcomplex sequences back to real data scaled by norm
+
+Inputs: data   - first element of the first sequence
+        stride - distance between successive elements of a sequence
+        n      - length of each sequence
+        dist   - distance between the first elements of successive
+                 sequences
+        count  - number of sequences
+        w      - workspace for length n
+        sign   - gsl_fft_forward for real to halfcomplex transforms,
+                 gsl_fft_backward for halfcomplex to real
+        norm   - scale factor of the backward transforms
+*/
+
+static int
+FUNCTION(fft_real,many) (BASE data[], const size_t stride, const size_t n,
+                         const size_t dist, const size_t count,
+                         TYPE(gsl_fft_real_workspace_many) * w,
+                         const gsl_fft_direction sign, const ATOMIC norm)
+{
+  TYPE(gsl_fft_complex_workspace_many) * const cwork = w->cwork;
+  const TYPE(gsl_fft_complex_wavetable) * const wavetable = cwork->wavetable;
+  const size_t nblock = cwork->nblock;
+  const size_t npairs = (count + 1) / 2;
+  const size_t nblocks = (npairs + nblock - 1) / nblock;
+  const size_t size = FUNCTION(fft_complex,many_scratch_size) (wavetable, nblock);
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (n != w->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (n == 1)
+    {                           /* FFT of 1 data point is the identity */
+      return 0;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(cwork->nthreads) if (cwork->nthreads > 1 && count * n >= 2 * FFT_MANY_PARALLEL)
+#endif
+  {
+    size_t t, nteam, s;
+    BASE * x, * y, * work;
+
+    FUNCTION(fft_complex,many_thread) (cwork->nthreads, &t, &nteam);
+
+    x = cwork->scratch + t * size;
+    y = x + 2 * n * nblock;
+    work = y + 2 * n * nblock;
+
+    for (s = t; s < cwork->nthreads; s += nteam)
+      {
+        size_t start, end, k;
+        int status = 0;
+
+        FUNCTION(fft_complex,many_range) (nblocks, cwork->nthreads, s,
+                                          &start, &end);
+
+        for (k = start; k < end && status == 0; k++)
+          {
+            const size_t first = k * nblock;
+            const size_t m = GSL_MIN (nblock, npairs - first);
+            BASE * r;
+            size_t p, j;
+
+            if (sign == gsl_fft_forward)
+              {
+                for (p = 0; p < m; p++)
+                  {
+                    const size_t ia = 2 * (first + p);
+                    const BASE * const a = data + ia * dist;
+                    const BASE * const b = a + dist;
+
+                    for (j = 0; j < n; j++)
+                      {
+                        x[2 * (j * m + p)] = a[j * stride];
+                        x[2 * (j * m + p) + 1] = (ia + 1 < count) ? b[j * stride] : 0;
+                      }
+                  }
+
+                status = FUNCTION(fft_complex,interleaved) (x, y, n, m, wavetable,
+                                                            work, gsl_fft_forward,
+                                                            &r);
+
+                if (status)
+                  {
+                    break;
+                  }
+
+                for (p = 0; p < m; p++)
+                  {
+                    const size_t ia = 2 * (first + p);
+                    BASE * const a = data + ia * dist;
+                    BASE * const b = a + dist;
+                    const int has_b = (ia + 1 < count);
+
+                    a[0] = r[2 * p];
+                    if (has_b)
+                      b[0] = r[2 * p + 1];
+
+                    for (j = 1; j < n - j; j++)
+                      {
+                        const ATOMIC zr = r[2 * (j * m + p)];
+                        const ATOMIC zi = r[2 * (j * m + p) + 1];
+                        const ATOMIC yr = r[2 * ((n - j) * m + p)];
+                        const ATOMIC yi = r[2 * ((n - j) * m + p) + 1];
+
+                        a[(2 * j - 1) * stride] = (zr + yr) / 2;
+                        a[2 * j * stride] = (zi - yi) / 2;
+
+                        if (has_b)
+                          {
+                            b[(2 * j - 1) * stride] = (zi + yi) / 2;
+                            b[2 * j * stride] = (yr - zr) / 2;
+                          }
+                      }
+
+                    if (j == n - j)
+                      {
+                        a[(n - 1) * stride] = r[2 * (j * m + p)];
+                        if (has_b)
+                          b[(n - 1) * stride] = r[2 * (j * m + p) + 1];
+                      }
+                  }
+              }
+            else
+              {
+                for (p = 0; p < m; p++)
+                  {
+                    const size_t ia = 2 * (first + p);
+                    const BASE * const a = data + ia * dist;
+                    const BASE * const b = a + dist;
+                    const int has_b = (ia + 1 < count);
+
+                    x[2 * p] = a[0];
+                    x[2 * p + 1] = has_b ? b[0] : 0;
+
+                    for (j = 1; j < n - j; j++)
+                      {
+                        const ATOMIC ar = a[(2 * j - 1) * stride];
+                        const ATOMIC ai = a[2 * j * stride];
+                        const ATOMIC br = has_b ? b[(2 * j - 1) * stride] : 0;
+                        const ATOMIC bi = has_b ? b[2 * j * stride] : 0;
+
+                        /* Z_j = A_j + i B_j, Z_{n-j} = conj(A_j) + i conj(B_j) */
+
+                        x[2 * (j * m + p)] = ar - bi;
+                        x[2 * (j * m + p) + 1] = ai + br;
+                        x[2 * ((n - j) * m + p)] = ar + bi;
+                        x[2 * ((n - j) * m + p) + 1] = br - ai;
+                      }
+
+                    if (j == n - j)
+                      {
+                        x[2 * (j * m + p)] = a[(n - 1) * stride];
+                        x[2 * (j * m + p) + 1] = has_b ? b[(n - 1) * stride] : 0;
+                      }
+                  }
+
+                status = FUNCTION(fft_complex,interleaved) (x, y, n, m, wavetable,
+                                                            work, gsl_fft_backward,
+                                                            &r);
+
+                if (status)
+                  {
+                    break;
+                  }
+
+                for (p = 0; p < m; p++)
+                  {
+                    const size_t ia = 2 * (first + p);
+                    BASE * const a = data + ia * dist;
+                    BASE * const b = a + dist;
+
+                    for (j = 0; j < n; j++)
+                      a[j * stride] = norm * r[2 * (j * m + p)];
+
+                    if (ia + 1 < count)
+                      {
+                        for (j = 0; j < n; j++)
+                          b[j * stride] = norm * r[2 * (j * m + p) + 1];
+                      }
+                  }
+              }
+          }
+
+        cwork->status[s] = status;
+      }
+  }
+
+  return FUNCTION(fft_complex,many_status) (cwork);
+}
+
+int
+FUNCTION(gsl_fft_real,transform_many) (BASE data[], const size_t stride,
+                                       const size_t n, const size_t dist,
+                                       const size_t count,
+                                       TYPE(gsl_fft_real_workspace_many) * w)
+{
+  return FUNCTION(fft_real,many) (data, stride, n, dist, count, w,
+                                  gsl_fft_forward, ONE);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,backward_many) (BASE data[], const size_t stride,
+                                             const size_t n, const size_t dist,
+                                             const size_t count,
+                                             TYPE(gsl_fft_real_workspace_many) * w)
+{
+  return FUNCTION(fft_real,many) (data, stride, n, dist, count, w,
+                                  gsl_fft_backward, ONE);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,inverse_many) (BASE data[], const size_t stride,
+                                            const size_t n, const size_t dist,
+                                            const size_t count,
+                                            TYPE(gsl_fft_real_workspace_many) * w)
+{
+  /* normalize inverse fft with 1/n */
+
+  return FUNCTION(fft_real,many) (data, stride, n, dist, count, w,
+                                  gsl_fft_backward, ONE / (ATOMIC) n);
+}
@@ -0,0 +1,574 @@
+/* fft/real_md.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Two and three dimensional transforms of real data.
+
+   The rows along the last dimension are transformed in place to
+   halfcomplex form.  The columns holding the real coefficients of the
+   rows (k = 0 and, for even lengths, k = n/2) contain real data again
+   and are transformed recursively in the same way, while each pair of
+   columns holding the real and imaginary parts of a complex
+   coefficient is transformed as one complex column.  The result takes
+   the same number of elements as the input.  The columns are
+   transformed through contiguous blocks as in c_md.c. */
+
+static int
+FUNCTION(fft_real,line) (BASE data[], const size_t n,
+                         const TYPE(gsl_fft_real_wavetable) * real,
+                         const TYPE(gsl_fft_halfcomplex_wavetable) * halfcomplex,
+                         TYPE(gsl_fft_real_workspace) * work,
+                         const gsl_fft_direction sign)
+{
+  if (sign == gsl_fft_forward)
+    {
+      return FUNCTION(gsl_fft_real,transform) (data, 1, n, real, work);
+    }
+  else
+    {
+      return FUNCTION(gsl_fft_halfcomplex,transform) (data, 1, n, halfcomplex, work);
+    }
+}
+
+/*
+fft_real_lines()
+  Transform count real sequences, or count halfcomplex sequences
+back to real data
+
+Inputs: data   - first element of the first sequence
+        n      - length of each sequence
+        stride - distance between successive elements of a sequence
+        count  - number of sequences
+        dist   - distance between the first elements of successive
+                 sequences
+        real, halfcomplex - wavetables for length n
+        work   - workspace for length n
+        block  - scratch space of FFT_MD_BLOCK * n elements
+        sign   - gsl_fft_forward for real to halfcomplex transforms,
+                 gsl_fft_backward for halfcomplex to real
+*/
+
+static int
+FUNCTION(fft_real,lines) (BASE data[], const size_t n, const size_t stride,
+                          const size_t count, const size_t dist,
+                          const TYPE(gsl_fft_real_wavetable) * real,
+                          const TYPE(gsl_fft_halfcomplex_wavetable) * halfcomplex,
+                          TYPE(gsl_fft_real_workspace) * work,
+                          BASE block[], const gsl_fft_direction sign)
+{
+  size_t t;
+
+  if (n == 1)
+    {
+      return 0;
+    }
+
+  if (stride == 1)
+    {
+      for (t = 0; t < count; t++)
+        {
+          int status = FUNCTION(fft_real,line) (data + t * dist, n, real,
+                                                halfcomplex, work, sign);
+          if (status)
+            return status;
+        }
+
+      return 0;
+    }
+
+  for (t = 0; t < count; t += FFT_MD_BLOCK)
+    {
+      const size_t nb = GSL_MIN (FFT_MD_BLOCK, count - t);
+      BASE * const d = data + t * dist;
+      size_t b, j;
+
+      for (j = 0; j < n; j++)
+        {
+          const BASE * const x = d + j * stride;
+
+          for (b = 0; b < nb; b++)
+            {
+              block[b * n + j] = x[b * dist];
+            }
+        }
+
+      for (b = 0; b < nb; b++)
+        {
+          int status = FUNCTION(fft_real,line) (block + b * n, n, real,
+                                                halfcomplex, work, sign);
+          if (status)
+            return status;
+        }
+
+      for (j = 0; j < n; j++)
+        {
+          BASE * const x = d + j * stride;
+
+          for (b = 0; b < nb; b++)
+            {
+              x[b * dist] = block[b * n + j];
+            }
+        }
+    }
+
+  return 0;
+}
+
+/*
+fft_real_planes()
+  Transform a two-dimensional real array of n1 x n2 elements, or its
+transform back to real data
+
+Inputs: data   - element (0,0) of the array
+        n1, s1 - number of rows and distance between rows
+        n2, s2 - number of columns and distance between columns
+        real, halfcomplex, work - wavetables and workspaces for
+                 lengths n1 and n2
+        cwavetable, cwork - complex wavetable and workspace for length n1
+        block  - scratch space of 2 * FFT_MD_BLOCK * max(n1,n2) elements
+        sign   - direction of the transform
+*/
+
+static int
+FUNCTION(fft_real,planes) (BASE data[],
+                           const size_t n1, const size_t s1,
+                           const size_t n2, const size_t s2,
+                           const TYPE(gsl_fft_real_wavetable) * const real[],
+                           const TYPE(gsl_fft_halfcomplex_wavetable) * const halfcomplex[],
+                           TYPE(gsl_fft_real_workspace) * const work[],
+                           const TYPE(gsl_fft_complex_wavetable) * cwavetable,
+                           TYPE(gsl_fft_complex_workspace) * cwork,
+                           BASE block[], const gsl_fft_direction sign)
+{
+  /* number of real columns (k2 = 0 and n2/2) and complex columns */
+  const size_t nr = (n2 % 2 == 0) ? 2 : 1;
+  const size_t nc = (n2 - 1) / 2;
+  int status;
+
+  if (sign == gsl_fft_forward)
+    {
+      status = FUNCTION(fft_real,lines) (data, n2, s2, n1, s1, real[1],
+                                         halfcomplex[1], work[1], block, sign);
+      if (status)
+        return status;
+    }
+
+  status = FUNCTION(fft_real,lines) (data, n1, s1, nr, (n2 - 1) * s2, real[0],
+                                     halfcomplex[0], work[0], block, sign);
+  if (status)
+    return status;
+
+  status = FUNCTION(fft_complex,lines) (data + s2, n1, s1, nc, 2 * s2, s2,
+                                        cwavetable, cwork, block, sign);
+  if (status)
+    return status;
+
+  if (sign == gsl_fft_backward)
+    {
+      status = FUNCTION(fft_real,lines) (data, n2, s2, n1, s1, real[1],
+                                         halfcomplex[1], work[1], block, sign);
+    }
+
+  return status;
+}
+
+TYPE(gsl_fft_real_workspace_2d) *
+FUNCTION(gsl_fft_real_workspace_2d,alloc) (size_t n1, size_t n2)
+{
+  TYPE(gsl_fft_real_workspace_2d) * w;
+  size_t i;
+
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_real_workspace_2d) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_real_workspace_2d)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+
+  for (i = 0; i < 2; i++)
+    {
+      const size_t n = (i == 0) ? n1 : n2;
+
+      w->real[i] = FUNCTION(gsl_fft_real_wavetable,get) (n);
+      w->halfcomplex[i] = FUNCTION(gsl_fft_halfcomplex_wavetable,get) (n);
+      w->work[i] = FUNCTION(gsl_fft_real_workspace,alloc) (n);
+
+      if (w->real[i] == NULL || w->halfcomplex[i] == NULL || w->work[i] == NULL)
+        {
+          FUNCTION(gsl_fft_real_workspace_2d,free) (w);
+          GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+        }
+    }
+
+  w->cwavetable = FUNCTION(gsl_fft_complex_wavetable,get) (n1);
+  w->cwork = FUNCTION(gsl_fft_complex_workspace,alloc) (n1);
+  w->block = (BASE *) gsl_malloc (2 * FFT_MD_BLOCK * n1 * sizeof (BASE));
+
+  if (w->cwavetable == NULL || w->cwork == NULL || w->block == NULL)
+    {
+      FUNCTION(gsl_fft_real_workspace_2d,free) (w);
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_real_workspace_2d,free) (TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 2; i++)
+    {
+      if (w->real[i])
+        FUNCTION(gsl_fft_real_wavetable,release) (w->real[i]);
+
+      if (w->halfcomplex[i])
+        FUNCTION(gsl_fft_halfcomplex_wavetable,release) (w->halfcomplex[i]);
+
+      if (w->work[i])
+        FUNCTION(gsl_fft_real_workspace,free) (w->work[i]);
+    }
+
+  if (w->cwavetable)
+    FUNCTION(gsl_fft_complex_wavetable,release) (w->cwavetable);
+
+  if (w->cwork)
+    FUNCTION(gsl_fft_complex_workspace,free) (w->cwork);
+
+  gsl_free (w->block);
+  gsl_free (w);
+}
+
+TYPE(gsl_fft_real_workspace_3d) *
+FUNCTION(gsl_fft_real_workspace_3d,alloc) (size_t n1, size_t n2, size_t n3)
+{
+  TYPE(gsl_fft_real_workspace_3d) * w;
+  size_t i;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = (TYPE(gsl_fft_real_workspace_3d) *)
+    gsl_calloc (1, sizeof (TYPE(gsl_fft_real_workspace_3d)));
+
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate struct", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+  w->n3 = n3;
+
+  for (i = 0; i < 3; i++)
+    {
+      const size_t n = (i == 0) ? n1 : (i == 1) ? n2 : n3;
+
+      w->real[i] = FUNCTION(gsl_fft_real_wavetable,get) (n);
+      w->halfcomplex[i] = FUNCTION(gsl_fft_halfcomplex_wavetable,get) (n);
+      w->work[i] = FUNCTION(gsl_fft_real_workspace,alloc) (n);
+
+      if (w->real[i] == NULL || w->halfcomplex[i] == NULL || w->work[i] == NULL)
+        {
+          FUNCTION(gsl_fft_real_workspace_3d,free) (w);
+          GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+        }
+    }
+
+  for (i = 0; i < 2; i++)
+    {
+      const size_t n = (i == 0) ? n1 : n2;
+
+      w->cwavetable[i] = FUNCTION(gsl_fft_complex_wavetable,get) (n);
+      w->cwork[i] = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+
+      if (w->cwavetable[i] == NULL || w->cwork[i] == NULL)
+        {
+          FUNCTION(gsl_fft_real_workspace_3d,free) (w);
+          GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+        }
+    }
+
+  w->block = (BASE *) gsl_malloc (2 * FFT_MD_BLOCK * GSL_MAX (n1, n2) * sizeof (BASE));
+
+  if (w->block == NULL)
+    {
+      FUNCTION(gsl_fft_real_workspace_3d,free) (w);
+      GSL_ERROR_NULL ("failed to allocate block space", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+FUNCTION(gsl_fft_real_workspace_3d,free) (TYPE(gsl_fft_real_workspace_3d) * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 3; i++)
+    {
+      if (w->real[i])
+        FUNCTION(gsl_fft_real_wavetable,release) (w->real[i]);
+
+      if (w->halfcomplex[i])
+        FUNCTION(gsl_fft_halfcomplex_wavetable,release) (w->halfcomplex[i]);
+
+      if (w->work[i])
+        FUNCTION(gsl_fft_real_workspace,free) (w->work[i]);
+    }
+
+  for (i = 0; i < 2; i++)
+    {
+      if (w->cwavetable[i])
+        FUNCTION(gsl_fft_complex_wavetable,release) (w->cwavetable[i]);
+
+      if (w->cwork[i])
+        FUNCTION(gsl_fft_complex_workspace,free) (w->cwork[i]);
+    }
+
+  gsl_free (w->block);
+  gsl_free (w);
+}
+
+static int
+FUNCTION(fft_real,transform_2d) (BASE data[], const size_t tda,
+                                 const size_t n1, const size_t n2,
+                                 TYPE(gsl_fft_real_workspace_2d) * w,
+                                 const gsl_fft_direction sign)
+{
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  if (n1 != w->n1 || n2 != w->n2)
+    {
+      GSL_ERROR ("workspace does not match dimensions of data", GSL_EINVAL);
+    }
+
+  if (tda < n2)
+    {
+      GSL_ERROR ("row stride tda must be at least n2", GSL_EINVAL);
+    }
+
+  return FUNCTION(fft_real,planes) (data, n1, tda, n2, 1,
+                                    w->real, w->halfcomplex, w->work,
+                                    w->cwavetable, w->cwork, w->block, sign);
+}
+
+static int
+FUNCTION(fft_real,transform_3d) (BASE data[],
+                                 const size_t n1, const size_t n2,
+                                 const size_t n3,
+                                 TYPE(gsl_fft_real_workspace_3d) * w,
+                                 const gsl_fft_direction sign)
+{
+  const size_t s1 = n2 * n3, s2 = n3;
+  const size_t nr = (n3 % 2 == 0) ? 2 : 1;
+  const size_t nc = (n3 - 1) / 2;
+  size_t r;
+  int status;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  if (n1 != w->n1 || n2 != w->n2 || n3 != w->n3)
+    {
+      GSL_ERROR ("workspace does not match dimensions of data", GSL_EINVAL);
+    }
+
+  if (sign == gsl_fft_forward)
+    {
+      status = FUNCTION(fft_real,lines) (data, n3, 1, n1 * n2, n3, w->real[2],
+                                         w->halfcomplex[2], w->work[2],
+                                         w->block, sign);
+      if (status)
+        return status;
+    }
+
+  /* the real coefficients of the rows form n1 x n2 real arrays */
+
+  for (r = 0; r < nr; r++)
+    {
+      status = FUNCTION(fft_real,planes) (data + r * (n3 - 1), n1, s1, n2, s2,
+                                          w->real, w->halfcomplex, w->work,
+                                          w->cwavetable[0], w->cwork[0],
+                                          w->block, sign);
+      if (status)
+        return status;
+    }
+
+  /* and the complex coefficients n1 x n2 complex arrays */
+
+  status = FUNCTION(fft_complex,planes) (data + 1, n1, s1, n2, s2, nc, 2, 1,
+                                         w->cwavetable[0], w->cwork[0],
+                                         w->cwavetable[1], w->cwork[1],
+                                         w->block, sign);
+  if (status)
+    return status;
+
+  if (sign == gsl_fft_backward)
+    {
+      status = FUNCTION(fft_real,lines) (data, n3, 1, n1 * n2, n3, w->real[2],
+                                         w->halfcomplex[2], w->work[2],
+                                         w->block, sign);
+    }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_real,transform_2d) (BASE data[], const size_t tda,
+                                     const size_t n1, const size_t n2,
+                                     TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  return FUNCTION(fft_real,transform_2d) (data, tda, n1, n2, w,
+                                          gsl_fft_forward);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,backward_2d) (BASE data[], const size_t tda,
+                                           const size_t n1, const size_t n2,
+                                           TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  return FUNCTION(fft_real,transform_2d) (data, tda, n1, n2, w,
+                                          gsl_fft_backward);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,inverse_2d) (BASE data[], const size_t tda,
+                                          const size_t n1, const size_t n2,
+                                          TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  int status = FUNCTION(fft_real,transform_2d) (data, tda, n1, n2, w,
+                                                gsl_fft_backward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/(n1 n2) */
+
+  {
+    const ATOMIC norm = ONE / ((ATOMIC) n1 * (ATOMIC) n2);
+    size_t i, j;
+
+    for (i = 0; i < n1; i++)
+      {
+        for (j = 0; j < n2; j++)
+          {
+            data[i * tda + j] *= norm;
+          }
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_real,transform_3d) (BASE data[],
+                                     const size_t n1, const size_t n2,
+                                     const size_t n3,
+                                     TYPE(gsl_fft_real_workspace_3d) * w)
+{
+  return FUNCTION(fft_real,transform_3d) (data, n1, n2, n3, w,
+                                          gsl_fft_forward);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,backward_3d) (BASE data[],
+                                           const size_t n1, const size_t n2,
+                                           const size_t n3,
+                                           TYPE(gsl_fft_real_workspace_3d) * w)
+{
+  return FUNCTION(fft_real,transform_3d) (data, n1, n2, n3, w,
+                                          gsl_fft_backward);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,inverse_3d) (BASE data[],
+                                          const size_t n1, const size_t n2,
+                                          const size_t n3,
+                                          TYPE(gsl_fft_real_workspace_3d) * w)
+{
+  int status = FUNCTION(fft_real,transform_3d) (data, n1, n2, n3, w,
+                                                gsl_fft_backward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/(n1 n2 n3) */
+
+  {
+    const size_t n = n1 * n2 * n3;
+    const ATOMIC norm = ONE / (ATOMIC) n;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+      {
+        data[i] *= norm;
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_real,matrix_transform) (TYPE(gsl_matrix) * m,
+                                         TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_real,transform_2d) (m->data, m->tda,
+                                              m->size1, m->size2, w);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,matrix_backward) (TYPE(gsl_matrix) * m,
+                                               TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_halfcomplex,backward_2d) (m->data, m->tda,
+                                                    m->size1, m->size2, w);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,matrix_inverse) (TYPE(gsl_matrix) * m,
+                                              TYPE(gsl_fft_real_workspace_2d) * w)
+{
+  return FUNCTION(gsl_fft_halfcomplex,inverse_2d) (m->data, m->tda,
+                                                   m->size1, m->size2, w);
+}
@@ -35,6 +35,7 @@
 #include <gsl/gsl_fft_halfcomplex.h>
 #include <gsl/gsl_fft_halfcomplex_float.h>
 #include <gsl/gsl_ieee_utils.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_test.h>
 
 void my_error_handler (const char *reason, const char *file,
@@ -53,6 +54,8 @@ void my_error_handler (const char *reason, const char *file,
 #include "test_complex_source.c"
 #include "test_real_source.c"
 #include "test_trap_source.c"
+#include "test_md_source.c"
+#include "test_many_source.c"
 #include "templates_off.h"
 #undef  BASE_DOUBLE
 
@@ -63,9 +66,160 @@ void my_error_handler (const char *reason, const char *file,
 #include "test_complex_source.c"
 #include "test_real_source.c"
 #include "test_trap_source.c"
+#include "test_md_source.c"
+#include "test_many_source.c"
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
+/* check that cached wavetables are shared, that transforms with them
+   and the per-thread workspaces agree with freshly allocated ones, and
+   that concurrent use gives the same results */
+
+static void
+test_cache (void)
+{
+  const size_t n = 60;
+  const gsl_fft_complex_wavetable *cw = gsl_fft_complex_wavetable_get (n);
+  const gsl_fft_complex_wavetable *cw2 = gsl_fft_complex_wavetable_get (n);
+  const gsl_fft_complex_wavetable *cw3 = gsl_fft_complex_wavetable_get (2 * n);
+  const gsl_fft_complex_wavetable_float *fw = gsl_fft_complex_wavetable_float_get (n);
+  const gsl_fft_real_wavetable *rw = gsl_fft_real_wavetable_get (n);
+  const gsl_fft_halfcomplex_wavetable *hw = gsl_fft_halfcomplex_wavetable_get (n);
+  gsl_fft_complex_wavetable *aw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace *awork = gsl_fft_complex_workspace_alloc (n);
+  double *data = malloc (2 * n * sizeof (double));
+  double *ref = malloc (2 * n * sizeof (double));
+  size_t i;
+
+#if HAVE_PTHREAD_MUTEX
+  gsl_test (cw != cw2, "fft cache returns shared wavetable");
+#endif
+  gsl_test (cw == cw3, "fft cache separates lengths");
+  gsl_test (fw == NULL || (const void *) fw == (const void *) cw,
+            "fft cache separates precisions");
+  gsl_test (rw == NULL || hw == NULL || (const void *) rw == (const void *) hw,
+            "fft cache separates types");
+
+  for (i = 0; i < 2 * n; i++)
+    {
+      ref[i] = data[i] = sin (0.1 * i) + 0.5 * cos (0.37 * i * i);
+    }
+
+  gsl_fft_complex_forward (ref, 1, n, aw, awork);
+
+#ifdef GSL_TLS
+  {
+    gsl_fft_complex_workspace *work = gsl_fft_complex_workspace_get (n);
+    gsl_fft_real_workspace *rwork = gsl_fft_real_workspace_get (n);
+    double *rdata = malloc (n * sizeof (double));
+    double err = 0.0;
+
+    gsl_fft_complex_forward (data, 1, n, cw, work);
+    gsl_test (memcmp (data, ref, 2 * n * sizeof (double)) != 0,
+              "fft cache complex transform matches");
+
+    for (i = 0; i < n; i++)
+      rdata[i] = data[2 * i];
+
+    gsl_fft_real_transform (rdata, 1, n, rw, rwork);
+    gsl_fft_halfcomplex_inverse (rdata, 1, n, hw, rwork);
+
+    for (i = 0; i < n; i++)
+      err = GSL_MAX (err, fabs (rdata[i] - data[2 * i]));
+
+    gsl_test (err > 1.0e-12, "fft cache real round trip err=%g", err);
+
+    free (rdata);
+  }
+
+  /* a workspace stays valid when the thread asks for other lengths */
+  {
+    gsl_fft_complex_workspace *work = gsl_fft_complex_workspace_get (n);
+    gsl_fft_complex_workspace *work2 = gsl_fft_complex_workspace_get (4 * n);
+
+    for (i = 0; i < 2 * n; i++)
+      data[i] = ref[i];
+
+    gsl_fft_complex_backward (data, 1, n, cw, work);
+    gsl_fft_complex_forward (data, 1, n, cw, work);
+
+    gsl_test (work == work2 || work->n != n || work2->n != 4 * n
+              || gsl_fft_complex_workspace_get (n) != work,
+              "fft cache keeps one workspace per length");
+
+    for (i = 0; i < 2 * n; i++)
+      {
+        if (fabs (data[i] - n * ref[i]) > 1.0e-10 * n)
+          break;
+      }
+
+    gsl_test (i != 2 * n, "fft cache workspace round trip");
+  }
+
+  /* concurrent transforms of several lengths */
+  {
+    const size_t nt = 64;
+    int nerr = 0;
+    int t;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:nerr)
+#endif
+    for (t = 0; t < (int) nt; t++)
+      {
+        const size_t len = n / 2 * (1 + t % 4);
+        const gsl_fft_complex_wavetable *w = gsl_fft_complex_wavetable_get (len);
+        gsl_fft_complex_workspace *work = gsl_fft_complex_workspace_get (len);
+        double *x = malloc (2 * len * sizeof (double));
+        size_t j;
+
+        for (j = 0; j < 2 * len; j++)
+          x[j] = (j == 2) ? 1.0 : 0.0;
+
+        gsl_fft_complex_forward (x, 1, len, w, work);
+
+        /* transform of delta(1) is exp(-2 pi i k / len) */
+        for (j = 0; j < len; j++)
+          {
+            const double theta = -2.0 * M_PI * j / len;
+            if (fabs (x[2 * j] - cos (theta)) > 1.0e-12 ||
+                fabs (x[2 * j + 1] - sin (theta)) > 1.0e-12)
+              {
+                nerr++;
+                break;
+              }
+          }
+
+        free (x);
+        gsl_fft_complex_wavetable_release (w);
+      }
+
+    gsl_test (nerr != 0, "fft cache concurrent transforms");
+  }
+
+  gsl_fft_cache_thread_free ();
+#endif
+
+  gsl_fft_complex_wavetable_release (cw);
+  gsl_fft_complex_wavetable_release (cw2);
+  gsl_fft_complex_wavetable_release (cw3);
+  gsl_fft_complex_wavetable_float_release (fw);
+  gsl_fft_real_wavetable_release (rw);
+  gsl_fft_halfcomplex_wavetable_release (hw);
+  gsl_fft_cache_clear ();
+
+  /* a cleared table is created again */
+  cw = gsl_fft_complex_wavetable_get (n);
+  gsl_test (cw == NULL || cw->n != n, "fft cache get after clear");
+  gsl_fft_complex_wavetable_release (cw);
+  gsl_fft_cache_clear ();
+
+  gsl_fft_complex_wavetable_free (aw);
+  gsl_fft_complex_workspace_free (awork);
+  free (data);
+  free (ref);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -111,6 +265,95 @@ main (int argc, char *argv[])
         }
     }
 
+  if (n == 0)
+    {
+      /* longer transforms, which use several radix-8 passes */
+      for (i = 128 ; i <= 2048 ; i *= 2)
+        {
+          test_complex_func (1, i) ;
+          test_complex_func (2, 3 * i) ;
+        }
+
+      /* large prime factors, which use Bluestein's algorithm */
+      for (stride = 1 ; stride < 4 ; stride++)
+        {
+          test_complex_func (stride, 101) ;
+          test_complex_func (stride, 2 * 127) ;
+          test_complex_func (stride, 3 * 257) ;
+          test_complex_float_func (stride, 101) ;
+          test_complex_float_func (stride, 4 * 131) ;
+        }
+
+      /* even real lengths, through complex transforms of half length */
+      for (stride = 1 ; stride < 3 ; stride++)
+        {
+          test_real_func (stride, 4096) ;
+          test_real_func (stride, 2 * 101) ;
+          test_real_func (stride, 4 * 3 * 257) ;
+          test_real_float_func (stride, 2 * 3 * 5 * 7) ;
+          test_real_float_func (stride, 4 * 131) ;
+          test_real_float_func (stride, 8192) ;
+        }
+    }
+
+  if (n == 0)
+    {
+      /* two and three dimensional transforms, with enough columns
+         to fill several blocks */
+      test_complex_2d (1, 1, 1) ;
+      test_complex_2d (6, 10, 10) ;
+      test_complex_2d (7, 45, 49) ;
+      test_complex_2d (40, 3, 5) ;
+      test_complex_float_2d (12, 35, 37) ;
+      test_complex_3d (1, 1, 7) ;
+      test_complex_3d (3, 4, 5) ;
+      test_complex_3d (5, 1, 6) ;
+      test_complex_3d (4, 6, 20) ;
+      test_complex_float_3d (6, 5, 18) ;
+
+      test_real_2d (1, 1, 1) ;
+      test_real_2d (1, 8, 8) ;
+      test_real_2d (9, 1, 2) ;
+      test_real_2d (6, 10, 11) ;
+      test_real_2d (7, 45, 45) ;
+      test_real_2d (40, 2, 4) ;
+      test_real_float_2d (12, 36, 40) ;
+      test_real_3d (1, 1, 1) ;
+      test_real_3d (3, 4, 5) ;
+      test_real_3d (4, 6, 2) ;
+      test_real_3d (5, 1, 6) ;
+      test_real_3d (3, 7, 40) ;
+      test_real_3d (6, 20, 9) ;
+      test_real_float_3d (4, 10, 36) ;
+    }
+
+  if (n == 0)
+    {
+      /* batches, with odd counts, partial blocks, gaps between the
+         sequences, Bluestein lengths and several threads */
+      test_complex_many (1, 1, 1, 3, 1) ;
+      test_complex_many (8, 1, 8, 1, 1) ;
+      test_complex_many (12, 1, 12, 37, 1) ;
+      test_complex_many (30, 2, 65, 20, 1) ;
+      test_complex_many (101, 1, 101, 9, 1) ;
+      test_complex_many (4096, 1, 4096, 5, 1) ;
+      test_complex_many (64, 1, 64, 1100, 4) ;
+      test_complex_float_many (20, 3, 61, 19, 1) ;
+      test_complex_float_many (2 * 127, 1, 255, 7, 2) ;
+
+      test_real_many (1, 1, 1, 3, 1) ;
+      test_real_many (2, 1, 2, 4, 1) ;
+      test_real_many (15, 1, 15, 1, 1) ;
+      test_real_many (16, 1, 16, 33, 1) ;
+      test_real_many (30, 2, 64, 21, 1) ;
+      test_real_many (3 * 101, 1, 303, 6, 1) ;
+      test_real_many (128, 1, 128, 1100, 4) ;
+      test_real_float_many (36, 3, 110, 11, 1) ;
+      test_real_float_many (45, 1, 45, 41, 2) ;
+    }
+
+  test_cache () ;
+
   gsl_set_error_handler (&my_error_handler);
   test_trap () ;
   test_float_trap () ;
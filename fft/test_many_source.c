@@ -0,0 +1,159 @@
+/* fft/test_many_source.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests of the batched transforms against the same sequences
+   transformed one at a time */
+
+void FUNCTION(test_complex,many) (size_t n, size_t stride, size_t dist,
+                                  size_t count, size_t nthreads);
+void FUNCTION(test_real,many) (size_t n, size_t stride, size_t dist,
+                               size_t count, size_t nthreads);
+
+/* maximum difference of the arrays x and y, relative to the largest
+   element of y */
+
+static double
+FUNCTION(test_many,err) (const BASE x[], const BASE y[], size_t len)
+{
+  double emax = 0.0, ymax = 0.0;
+  size_t i;
+
+  for (i = 0; i < len; i++)
+    {
+      emax = GSL_MAX (emax, fabs ((double) x[i] - (double) y[i]));
+      ymax = GSL_MAX (ymax, fabs ((double) y[i]));
+    }
+
+  return (ymax > 0) ? emax / ymax : emax;
+}
+
+#define TEST_MANY_TOL (1.0e3 * BASE_EPSILON)
+
+void
+FUNCTION(test_complex,many) (size_t n, size_t stride, size_t dist,
+                             size_t count, size_t nthreads)
+{
+  const size_t len = 2 * dist * count;
+  BASE *data = (BASE *) malloc (len * sizeof (BASE));
+  BASE *orig = (BASE *) malloc (len * sizeof (BASE));
+  BASE *ref = (BASE *) malloc (len * sizeof (BASE));
+  TYPE(gsl_fft_complex_workspace_many) * w = FUNCTION(gsl_fft_complex_workspace_many,alloc) (n, nthreads);
+  TYPE(gsl_fft_complex_wavetable) * wt = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+  TYPE(gsl_fft_complex_workspace) * work = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+  size_t k;
+  int status;
+
+  for (k = 0; k < len; k++)
+    {
+      orig[k] = data[k] = ref[k] = (BASE) (sin (0.3 * k) + 0.1 * (k % 7));
+    }
+
+  for (k = 0; k < count; k++)
+    FUNCTION(gsl_fft_complex,forward) (ref + 2 * k * dist, stride, n, wt, work);
+
+  status = FUNCTION(gsl_fft_complex,forward_many) (data, stride, n, dist, count, w);
+
+  /* elements between the sequences are unchanged in both */
+
+  gsl_test (status || FUNCTION(test_many,err) (data, ref, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_complex) "_forward_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  for (k = 0; k < count; k++)
+    FUNCTION(gsl_fft_complex,backward) (ref + 2 * k * dist, stride, n, wt, work);
+
+  FUNCTION(gsl_fft_complex,backward_many) (data, stride, n, dist, count, w);
+
+  gsl_test (FUNCTION(test_many,err) (data, ref, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_complex) "_backward_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  memcpy (data, orig, len * sizeof (BASE));
+
+  FUNCTION(gsl_fft_complex,transform_many) (data, stride, n, dist, count, w,
+                                            gsl_fft_forward);
+  FUNCTION(gsl_fft_complex,inverse_many) (data, stride, n, dist, count, w);
+
+  gsl_test (FUNCTION(test_many,err) (data, orig, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_complex) "_inverse_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  FUNCTION(gsl_fft_complex_workspace_many,free) (w);
+  FUNCTION(gsl_fft_complex_wavetable,free) (wt);
+  FUNCTION(gsl_fft_complex_workspace,free) (work);
+  free (data);
+  free (orig);
+  free (ref);
+}
+
+void
+FUNCTION(test_real,many) (size_t n, size_t stride, size_t dist,
+                          size_t count, size_t nthreads)
+{
+  const size_t len = dist * count;
+  BASE *data = (BASE *) malloc (len * sizeof (BASE));
+  BASE *orig = (BASE *) malloc (len * sizeof (BASE));
+  BASE *ref = (BASE *) malloc (len * sizeof (BASE));
+  TYPE(gsl_fft_real_workspace_many) * w = FUNCTION(gsl_fft_real_workspace_many,alloc) (n, nthreads);
+  TYPE(gsl_fft_real_wavetable) * rt = FUNCTION(gsl_fft_real_wavetable,alloc) (n);
+  TYPE(gsl_fft_halfcomplex_wavetable) * ht = FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (n);
+  TYPE(gsl_fft_real_workspace) * work = FUNCTION(gsl_fft_real_workspace,alloc) (n);
+  size_t k;
+  int status;
+
+  for (k = 0; k < len; k++)
+    {
+      orig[k] = data[k] = ref[k] = (BASE) (sin (0.3 * k) + 0.1 * (k % 7));
+    }
+
+  for (k = 0; k < count; k++)
+    FUNCTION(gsl_fft_real,transform) (ref + k * dist, stride, n, rt, work);
+
+  status = FUNCTION(gsl_fft_real,transform_many) (data, stride, n, dist, count, w);
+
+  gsl_test (status || FUNCTION(test_many,err) (data, ref, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_real) "_transform_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  for (k = 0; k < count; k++)
+    FUNCTION(gsl_fft_halfcomplex,backward) (ref + k * dist, stride, n, ht, work);
+
+  FUNCTION(gsl_fft_halfcomplex,backward_many) (data, stride, n, dist, count, w);
+
+  gsl_test (FUNCTION(test_many,err) (data, ref, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_halfcomplex) "_backward_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  memcpy (data, orig, len * sizeof (BASE));
+
+  FUNCTION(gsl_fft_real,transform_many) (data, stride, n, dist, count, w);
+  FUNCTION(gsl_fft_halfcomplex,inverse_many) (data, stride, n, dist, count, w);
+
+  gsl_test (FUNCTION(test_many,err) (data, orig, len) > TEST_MANY_TOL,
+            NAME(gsl_fft_halfcomplex) "_inverse_many, n = %d, stride = %d, dist = %d, count = %d, nthreads = %d",
+            n, stride, dist, count, nthreads);
+
+  FUNCTION(gsl_fft_real_workspace_many,free) (w);
+  FUNCTION(gsl_fft_real_wavetable,free) (rt);
+  FUNCTION(gsl_fft_halfcomplex_wavetable,free) (ht);
+  FUNCTION(gsl_fft_real_workspace,free) (work);
+  free (data);
+  free (orig);
+  free (ref);
+}
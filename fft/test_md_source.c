@@ -0,0 +1,403 @@
+/* fft/test_md_source.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests of the two and three dimensional transforms against a
+   separable discrete Fourier transform computed in double precision */
+
+void FUNCTION(test_complex,2d) (size_t n1, size_t n2, size_t tda);
+void FUNCTION(test_complex,3d) (size_t n1, size_t n2, size_t n3);
+void FUNCTION(test_real,2d) (size_t n1, size_t n2, size_t tda);
+void FUNCTION(test_real,3d) (size_t n1, size_t n2, size_t n3);
+
+/* in-place forward DFT of the contiguous complex n1 x n2 x n3 array x */
+
+static void
+FUNCTION(test_md,dft) (double x[], size_t n1, size_t n2, size_t n3)
+{
+  const size_t n[3] = { n1, n2, n3 };
+  const size_t s[3] = { n2 * n3, n3, 1 };
+  const size_t len = n1 * n2 * n3;
+  double *y = (double *) malloc (2 * GSL_MAX (n1, GSL_MAX (n2, n3)) * sizeof (double));
+  size_t d, p, k, j;
+
+  for (d = 0; d < 3; d++)
+    {
+      for (p = 0; p < len; p++)
+        {
+          /* skip all but the first element of each line along d */
+          if ((p / s[d]) % n[d] != 0)
+            continue;
+
+          for (k = 0; k < n[d]; k++)
+            {
+              double re = 0.0, im = 0.0;
+
+              for (j = 0; j < n[d]; j++)
+                {
+                  const double theta = -2.0 * M_PI * (double) ((j * k) % n[d]) / n[d];
+                  const double xr = x[2 * (p + j * s[d])];
+                  const double xi = x[2 * (p + j * s[d]) + 1];
+                  re += xr * cos (theta) - xi * sin (theta);
+                  im += xr * sin (theta) + xi * cos (theta);
+                }
+
+              y[2 * k] = re;
+              y[2 * k + 1] = im;
+            }
+
+          for (k = 0; k < n[d]; k++)
+            {
+              x[2 * (p + k * s[d])] = y[2 * k];
+              x[2 * (p + k * s[d]) + 1] = y[2 * k + 1];
+            }
+        }
+    }
+
+  free (y);
+}
+
+/* coefficient k of the halfcomplex sequence x of length n */
+
+static void
+FUNCTION(test_md,hc_get) (const BASE x[], size_t stride, size_t n, size_t k,
+                          double *re, double *im)
+{
+  if (k == 0)
+    {
+      *re = x[0];
+      *im = 0.0;
+    }
+  else if (2 * k == n)
+    {
+      *re = x[(n - 1) * stride];
+      *im = 0.0;
+    }
+  else if (2 * k < n)
+    {
+      *re = x[(2 * k - 1) * stride];
+      *im = x[2 * k * stride];
+    }
+  else
+    {
+      FUNCTION(test_md,hc_get) (x, stride, n, n - k, re, im);
+      *im = -*im;
+    }
+}
+
+/* coefficient (k1,k2) of the transform of a real n1 x n2 array, stored
+   with rows and columns s1 and s2 apart */
+
+static void
+FUNCTION(test_md,hc_get2) (const BASE x[], size_t n1, size_t s1,
+                           size_t n2, size_t s2, size_t k1, size_t k2,
+                           double *re, double *im)
+{
+  if (2 * k2 > n2)
+    {
+      FUNCTION(test_md,hc_get2) (x, n1, s1, n2, s2, (n1 - k1) % n1, n2 - k2, re, im);
+      *im = -*im;
+    }
+  else if (k2 == 0 || 2 * k2 == n2)
+    {
+      FUNCTION(test_md,hc_get) (x + (k2 == 0 ? 0 : (n2 - 1) * s2), s1, n1, k1, re, im);
+    }
+  else
+    {
+      *re = x[k1 * s1 + (2 * k2 - 1) * s2];
+      *im = x[k1 * s1 + 2 * k2 * s2];
+    }
+}
+
+/* maximum difference of the complex n1 x n2 x n3 arrays x and y,
+   relative to the largest element of y */
+
+static double
+FUNCTION(test_md,err) (const double x[], const double y[], size_t len)
+{
+  double emax = 0.0, ymax = 0.0;
+  size_t i;
+
+  for (i = 0; i < 2 * len; i++)
+    {
+      emax = GSL_MAX (emax, fabs (x[i] - y[i]));
+      ymax = GSL_MAX (ymax, fabs (y[i]));
+    }
+
+  return (ymax > 0) ? emax / ymax : emax;
+}
+
+#define TEST_MD_TOL (1.0e3 * BASE_EPSILON)
+
+void
+FUNCTION(test_complex,2d) (size_t n1, size_t n2, size_t tda)
+{
+  const size_t len = n1 * n2;
+  BASE *data = (BASE *) malloc (2 * n1 * tda * sizeof (BASE));
+  BASE *orig = (BASE *) malloc (2 * n1 * tda * sizeof (BASE));
+  double *ref = (double *) malloc (2 * len * sizeof (double));
+  double *out = (double *) malloc (2 * len * sizeof (double));
+  TYPE(gsl_fft_complex_workspace_2d) * w = FUNCTION(gsl_fft_complex_workspace_2d,alloc) (n1, n2);
+  VIEW(gsl_matrix_complex,view) m = FUNCTION(gsl_matrix_complex,view_array_with_tda) (data, n1, n2, tda);
+  size_t i, j, k;
+  int pad;
+
+  for (k = 0; k < 2 * n1 * tda; k++)
+    {
+      orig[k] = data[k] = (BASE) (sin (0.3 * k) + 0.1 * (k % 7));
+    }
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < 2 * n2; j++)
+      ref[2 * i * n2 + j] = data[2 * i * tda + j];
+
+  FUNCTION(test_md,dft) (ref, n1, n2, 1);
+
+  FUNCTION(gsl_fft_complex,forward_2d) (data, tda, n1, n2, w);
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < 2 * n2; j++)
+      out[2 * i * n2 + j] = data[2 * i * tda + j];
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_complex) "_forward_2d, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  /* elements beyond the end of each row must be unchanged */
+
+  pad = 0;
+
+  for (i = 0; i < n1; i++)
+    for (j = 2 * n2; j < 2 * tda; j++)
+      pad |= (data[2 * i * tda + j] != orig[2 * i * tda + j]);
+
+  gsl_test (pad, NAME(gsl_fft_complex) "_forward_2d padding, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  FUNCTION(gsl_fft_complex,matrix_inverse) (&m.matrix, w);
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < 2 * n2; j++)
+      {
+        out[2 * i * n2 + j] = data[2 * i * tda + j];
+        ref[2 * i * n2 + j] = orig[2 * i * tda + j];
+      }
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_complex) "_matrix_inverse, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  FUNCTION(gsl_fft_complex_workspace_2d,free) (w);
+  free (data);
+  free (orig);
+  free (ref);
+  free (out);
+}
+
+void
+FUNCTION(test_complex,3d) (size_t n1, size_t n2, size_t n3)
+{
+  const size_t len = n1 * n2 * n3;
+  BASE *data = (BASE *) malloc (2 * len * sizeof (BASE));
+  double *ref = (double *) malloc (2 * len * sizeof (double));
+  double *out = (double *) malloc (2 * len * sizeof (double));
+  TYPE(gsl_fft_complex_workspace_3d) * w = FUNCTION(gsl_fft_complex_workspace_3d,alloc) (n1, n2, n3);
+  size_t k;
+
+  for (k = 0; k < 2 * len; k++)
+    {
+      ref[k] = data[k] = (BASE) (cos (0.7 * k) - 0.05 * (k % 11));
+    }
+
+  FUNCTION(test_md,dft) (ref, n1, n2, n3);
+
+  FUNCTION(gsl_fft_complex,forward_3d) (data, n1, n2, n3, w);
+
+  for (k = 0; k < 2 * len; k++)
+    out[k] = data[k];
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_complex) "_forward_3d, n1 = %d, n2 = %d, n3 = %d",
+            n1, n2, n3);
+
+  FUNCTION(gsl_fft_complex,inverse_3d) (data, n1, n2, n3, w);
+
+  for (k = 0; k < 2 * len; k++)
+    {
+      out[k] = data[k];
+      ref[k] = (BASE) (cos (0.7 * k) - 0.05 * (k % 11));
+    }
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_complex) "_inverse_3d, n1 = %d, n2 = %d, n3 = %d",
+            n1, n2, n3);
+
+  FUNCTION(gsl_fft_complex_workspace_3d,free) (w);
+  free (data);
+  free (ref);
+  free (out);
+}
+
+void
+FUNCTION(test_real,2d) (size_t n1, size_t n2, size_t tda)
+{
+  const size_t len = n1 * n2;
+  BASE *data = (BASE *) malloc (n1 * tda * sizeof (BASE));
+  BASE *orig = (BASE *) malloc (n1 * tda * sizeof (BASE));
+  double *ref = (double *) malloc (2 * len * sizeof (double));
+  double *out = (double *) malloc (2 * len * sizeof (double));
+  TYPE(gsl_fft_real_workspace_2d) * w = FUNCTION(gsl_fft_real_workspace_2d,alloc) (n1, n2);
+  VIEW(gsl_matrix,view) m = FUNCTION(gsl_matrix,view_array_with_tda) (data, n1, n2, tda);
+  size_t i, j, k;
+  int pad;
+
+  for (k = 0; k < n1 * tda; k++)
+    {
+      orig[k] = data[k] = (BASE) (sin (0.9 * k) + 0.2 * (k % 5));
+    }
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < n2; j++)
+      {
+        ref[2 * (i * n2 + j)] = data[i * tda + j];
+        ref[2 * (i * n2 + j) + 1] = 0.0;
+      }
+
+  FUNCTION(test_md,dft) (ref, n1, n2, 1);
+
+  FUNCTION(gsl_fft_real,matrix_transform) (&m.matrix, w);
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < n2; j++)
+      FUNCTION(test_md,hc_get2) (data, n1, tda, n2, 1, i, j,
+                                 &out[2 * (i * n2 + j)], &out[2 * (i * n2 + j) + 1]);
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_real) "_transform_2d, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  pad = 0;
+
+  for (i = 0; i < n1; i++)
+    for (j = n2; j < tda; j++)
+      pad |= (data[i * tda + j] != orig[i * tda + j]);
+
+  gsl_test (pad, NAME(gsl_fft_real) "_transform_2d padding, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  FUNCTION(gsl_fft_halfcomplex,inverse_2d) (data, tda, n1, n2, w);
+
+  for (i = 0; i < n1; i++)
+    for (j = 0; j < n2; j++)
+      {
+        out[2 * (i * n2 + j)] = data[i * tda + j];
+        ref[2 * (i * n2 + j)] = orig[i * tda + j];
+        out[2 * (i * n2 + j) + 1] = ref[2 * (i * n2 + j) + 1] = 0.0;
+      }
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_halfcomplex) "_inverse_2d, n1 = %d, n2 = %d, tda = %d",
+            n1, n2, tda);
+
+  FUNCTION(gsl_fft_real_workspace_2d,free) (w);
+  free (data);
+  free (orig);
+  free (ref);
+  free (out);
+}
+
+void
+FUNCTION(test_real,3d) (size_t n1, size_t n2, size_t n3)
+{
+  const size_t len = n1 * n2 * n3;
+  BASE *data = (BASE *) malloc (len * sizeof (BASE));
+  double *ref = (double *) malloc (2 * len * sizeof (double));
+  double *out = (double *) malloc (2 * len * sizeof (double));
+  TYPE(gsl_fft_real_workspace_3d) * w = FUNCTION(gsl_fft_real_workspace_3d,alloc) (n1, n2, n3);
+  size_t i1, i2, i3, k;
+
+  for (k = 0; k < len; k++)
+    {
+      data[k] = (BASE) (cos (1.3 * k) + 0.3 * (k % 3));
+      ref[2 * k] = data[k];
+      ref[2 * k + 1] = 0.0;
+    }
+
+  FUNCTION(test_md,dft) (ref, n1, n2, n3);
+
+  FUNCTION(gsl_fft_real,transform_3d) (data, n1, n2, n3, w);
+
+  for (i1 = 0; i1 < n1; i1++)
+    for (i2 = 0; i2 < n2; i2++)
+      for (i3 = 0; i3 < n3; i3++)
+        {
+          double *y = out + 2 * ((i1 * n2 + i2) * n3 + i3);
+
+          if (2 * i3 > n3)
+            {
+              /* conjugate of coefficient (-i1, -i2, n3 - i3) */
+              k = (((n1 - i1) % n1) * n2 + (n2 - i2) % n2) * n3 + n3 - i3;
+            }
+          else
+            {
+              k = (i1 * n2 + i2) * n3 + i3;
+            }
+
+          if (k % n3 == 0 || 2 * (k % n3) == n3)
+            {
+              const size_t c = (k % n3 == 0) ? 0 : n3 - 1;
+
+              FUNCTION(test_md,hc_get2) (data + c, n1, n2 * n3, n2, n3,
+                                         k / (n2 * n3), (k / n3) % n2, &y[0], &y[1]);
+            }
+          else
+            {
+              const size_t c = 2 * (k % n3) - 1;
+
+              y[0] = data[k - k % n3 + c];
+              y[1] = data[k - k % n3 + c + 1];
+            }
+
+          if (2 * i3 > n3)
+            y[1] = -y[1];
+        }
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_real) "_transform_3d, n1 = %d, n2 = %d, n3 = %d",
+            n1, n2, n3);
+
+  FUNCTION(gsl_fft_halfcomplex,inverse_3d) (data, n1, n2, n3, w);
+
+  for (k = 0; k < len; k++)
+    {
+      out[2 * k] = data[k];
+      ref[2 * k] = (BASE) (cos (1.3 * k) + 0.3 * (k % 3));
+      out[2 * k + 1] = ref[2 * k + 1] = 0.0;
+    }
+
+  gsl_test (FUNCTION(test_md,err) (out, ref, len) > TEST_MD_TOL,
+            NAME(gsl_fft_halfcomplex) "_inverse_3d, n1 = %d, n2 = %d, n3 = %d",
+            n1, n2, n3);
+
+  FUNCTION(gsl_fft_real_workspace_3d,free) (w);
+  free (data);
+  free (ref);
+  free (out);
+}
+
+#undef TEST_MD_TOL
@@ -38,10 +38,12 @@ void FUNCTION(test_real,func) (size_t stride, size_t n)
   BASE * complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
   BASE * complex_tmp = (BASE *) malloc (2 * n * stride * sizeof (BASE));
   BASE * fft_complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+  BASE * real_tmp = (BASE *) malloc (n * stride * sizeof (BASE));
 
   for (i = 0 ; i < n * stride ; i++)
     {
       real_data[i] = (BASE)i ;
+      real_tmp[i] = (BASE)(i + 4000.0) ;
     }
 
   for (i = 0 ; i < 2 * n * stride ; i++)
@@ -80,6 +82,21 @@ void FUNCTION(test_real,func) (size_t stride, size_t n)
   gsl_test (status, NAME(gsl_fft_real) 
             " with signal_real_noise, n = %d, stride = %d", n, stride);
   
+  /* transform directly to complex-packed output */
+
+  for (i = 0; i < n; i++)
+    {
+      real_tmp[i*stride] = REAL(complex_tmp,stride,i);
+    }
+
+  FUNCTION(gsl_fft_real,transform_complex) (real_tmp, complex_data, stride, n, rw, rwork);
+
+  status = FUNCTION(compare_complex,results) ("dft", fft_complex_data,
+                                              "fft of noise", complex_data,
+                                              stride, n, 1e6);
+  gsl_test (status, NAME(gsl_fft_real) 
+            "_transform_complex with signal_real_noise, n = %d, stride = %d", n, stride);
+
   /* compute the inverse fft */
 
   hcw = FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (n);
@@ -110,6 +127,7 @@ void FUNCTION(test_real,func) (size_t stride, size_t n)
   free(complex_data) ;
   free(complex_tmp) ;
   free(fft_complex_data) ;
+  free(real_tmp) ;
 }
 
 
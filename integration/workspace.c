@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_integration.h>
 #include <gsl/gsl_errno.h>
 
@@ -34,7 +35,7 @@ gsl_integration_workspace_alloc (const size_t n)
     }
 
   w = (gsl_integration_workspace *) 
-    malloc (sizeof (gsl_integration_workspace));
+    gsl_malloc (sizeof (gsl_integration_workspace));
 
   if (w == 0)
     {
@@ -42,77 +43,77 @@ gsl_integration_workspace_alloc (const size_t n)
                         GSL_ENOMEM, 0);
     }
 
-  w->alist = (double *) malloc (n * sizeof (double));
+  w->alist = (double *) gsl_malloc (n * sizeof (double));
 
   if (w->alist == 0)
     {
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for alist ranges",
                         GSL_ENOMEM, 0);
     }
 
-  w->blist = (double *) malloc (n * sizeof (double));
+  w->blist = (double *) gsl_malloc (n * sizeof (double));
 
   if (w->blist == 0)
     {
-      free (w->alist);
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w->alist);
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for blist ranges",
                         GSL_ENOMEM, 0);
     }
 
-  w->rlist = (double *) malloc (n * sizeof (double));
+  w->rlist = (double *) gsl_malloc (n * sizeof (double));
 
   if (w->rlist == 0)
     {
-      free (w->blist);
-      free (w->alist);
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w->blist);
+      gsl_free (w->alist);
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for rlist ranges",
                         GSL_ENOMEM, 0);
     }
 
 
-  w->elist = (double *) malloc (n * sizeof (double));
+  w->elist = (double *) gsl_malloc (n * sizeof (double));
 
   if (w->elist == 0)
     {
-      free (w->rlist);
-      free (w->blist);
-      free (w->alist);
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w->rlist);
+      gsl_free (w->blist);
+      gsl_free (w->alist);
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for elist ranges",
                         GSL_ENOMEM, 0);
     }
 
-  w->order = (size_t *) malloc (n * sizeof (size_t));
+  w->order = (size_t *) gsl_malloc (n * sizeof (size_t));
 
   if (w->order == 0)
     {
-      free (w->elist);
-      free (w->rlist);
-      free (w->blist);
-      free (w->alist);
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w->elist);
+      gsl_free (w->rlist);
+      gsl_free (w->blist);
+      gsl_free (w->alist);
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for order ranges",
                         GSL_ENOMEM, 0);
     }
 
-  w->level = (size_t *) malloc (n * sizeof (size_t));
+  w->level = (size_t *) gsl_malloc (n * sizeof (size_t));
 
   if (w->level == 0)
     {
-      free (w->order);
-      free (w->elist);
-      free (w->rlist);
-      free (w->blist);
-      free (w->alist);
-      free (w);         /* exception in constructor, avoid memory leak */
+      gsl_free (w->order);
+      gsl_free (w->elist);
+      gsl_free (w->rlist);
+      gsl_free (w->blist);
+      gsl_free (w->alist);
+      gsl_free (w);         /* exception in constructor, avoid memory leak */
 
       GSL_ERROR_VAL ("failed to allocate space for order ranges",
                         GSL_ENOMEM, 0);
@@ -129,13 +130,13 @@ void
 gsl_integration_workspace_free (gsl_integration_workspace * w)
 {
   RETURN_IF_NULL (w);
-  free (w->level) ;
-  free (w->order) ;
-  free (w->elist) ;
-  free (w->rlist) ;
-  free (w->blist) ;
-  free (w->alist) ;
-  free (w) ;
+  gsl_free (w->level) ;
+  gsl_free (w->order) ;
+  gsl_free (w->elist) ;
+  gsl_free (w->rlist) ;
+  gsl_free (w->blist) ;
+  gsl_free (w->alist) ;
+  gsl_free (w) ;
 }
 
 /*
@@ -27,6 +27,8 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_inline.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_blas_types.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -172,6 +174,65 @@ gsl_linalg_SV_solve (const gsl_matrix * U,
 
 int gsl_linalg_SV_leverage(const gsl_matrix *U, gsl_vector *h);
 
+/* Randomized low-rank Singular Value Decomposition
+ *
+ * The matrix A is accessed only through the operator mult, which
+ * must compute Y = op(A) X for a block of vectors X, where
+ * op(A) = A (CblasNoTrans) or A^T (CblasTrans). This allows dense,
+ * sparse and matrix-free representations of A.
+ */
+
+typedef struct
+{
+  int (* mult) (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                gsl_matrix * Y, void * params);
+  size_t size1;  /* number of rows of A */
+  size_t size2;  /* number of columns of A */
+  void * params;
+} gsl_linalg_operator;
+
+typedef struct
+{
+  size_t M;      /* number of rows of A */
+  size_t N;      /* number of columns of A */
+  size_t k;      /* target rank */
+  size_t l;      /* number of samples, k + oversampling */
+  gsl_matrix * Y;      /* sample matrix / range basis, M-by-l */
+  gsl_matrix * Z;      /* A^T Q and random test matrix, N-by-l */
+  gsl_matrix * V;      /* right singular vectors of Q^T A, l-by-l */
+  gsl_vector * S;      /* singular values of Q^T A, size l */
+  gsl_vector * tau;    /* Householder scalars, size l */
+  gsl_vector * work;   /* additional workspace, size l */
+} gsl_linalg_rsvd_workspace;
+
+gsl_linalg_rsvd_workspace *
+gsl_linalg_rsvd_alloc (const size_t M, const size_t N,
+                       const size_t k, const size_t p);
+
+void gsl_linalg_rsvd_free (gsl_linalg_rsvd_workspace * w);
+
+int gsl_linalg_rsvd_range (const gsl_linalg_operator * A,
+                           const size_t nsweep,
+                           const gsl_rng * r,
+                           gsl_matrix * Q,
+                           gsl_linalg_rsvd_workspace * w);
+
+int gsl_linalg_rsvd_decomp (const gsl_linalg_operator * A,
+                            const size_t nsweep,
+                            const gsl_rng * r,
+                            gsl_matrix * U,
+                            gsl_vector * S,
+                            gsl_matrix * V,
+                            gsl_linalg_rsvd_workspace * w);
+
+int gsl_linalg_rsvd_decomp_matrix (const gsl_matrix * A,
+                                   const size_t nsweep,
+                                   const gsl_rng * r,
+                                   gsl_matrix * U,
+                                   gsl_vector * S,
+                                   gsl_matrix * V,
+                                   gsl_linalg_rsvd_workspace * w);
+
 
 /* LU Decomposition, Gaussian elimination with partial pivoting
  */
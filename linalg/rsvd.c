@@ -0,0 +1,397 @@
+/* linalg/rsvd.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * This module computes a rank-k approximation to the SVD of an
+ * M-by-N matrix A,
+ *
+ * A ~ U S V^T
+ *
+ * using the randomized range finder of Halko, Martinsson and Tropp.
+ * A random N-by-l Gaussian test matrix Omega (l = k + p, where p is
+ * the oversampling parameter) is used to sample the range of A,
+ *
+ * Y = (A A^T)^q A Omega
+ *
+ * and Q is an orthonormal basis for range(Y). Each power sweep is
+ * re-orthonormalized to avoid loss of accuracy in the smaller singular
+ * values. Then B = Q^T A is a small l-by-N matrix whose SVD gives the
+ * approximate decomposition of A. Only O((M+N) l) storage is needed.
+ *
+ * The matrix A is never accessed directly - only through the user
+ * supplied operator which computes A X or A^T X for a block X
+ *
+ * References:
+ *
+ * [1] N. Halko, P. G. Martinsson and J. A. Tropp, Finding structure
+ *     with randomness: Probabilistic algorithms for constructing
+ *     approximate matrix decompositions, SIAM Review 53(2), 2011.
+ */
+
+static int rsvd_orth (gsl_matrix * A, gsl_vector * tau);
+static int rsvd_dense_mult (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                            gsl_matrix * Y, void * params);
+
+gsl_linalg_rsvd_workspace *
+gsl_linalg_rsvd_alloc (const size_t M, const size_t N,
+                       const size_t k, const size_t p)
+{
+  gsl_linalg_rsvd_workspace *w;
+  const size_t l = k + p;
+
+  if (k == 0)
+    {
+      GSL_ERROR_NULL ("rank k must be positive", GSL_EINVAL);
+    }
+  else if (l > GSL_MIN (M, N))
+    {
+      GSL_ERROR_NULL ("k + p must not exceed MIN(M,N)", GSL_EBADLEN);
+    }
+
+  w = gsl_calloc (1, sizeof (gsl_linalg_rsvd_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for rsvd workspace",
+                      GSL_ENOMEM);
+    }
+
+  w->M = M;
+  w->N = N;
+  w->k = k;
+  w->l = l;
+
+  w->Y = gsl_matrix_alloc (M, l);
+  if (w->Y == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for Y", GSL_ENOMEM);
+    }
+
+  w->Z = gsl_matrix_alloc (N, l);
+  if (w->Z == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for Z", GSL_ENOMEM);
+    }
+
+  w->V = gsl_matrix_alloc (l, l);
+  if (w->V == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for V", GSL_ENOMEM);
+    }
+
+  w->S = gsl_vector_alloc (l);
+  if (w->S == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for S", GSL_ENOMEM);
+    }
+
+  w->tau = gsl_vector_alloc (l);
+  if (w->tau == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for tau", GSL_ENOMEM);
+    }
+
+  w->work = gsl_vector_alloc (l);
+  if (w->work == 0)
+    {
+      gsl_linalg_rsvd_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_linalg_rsvd_free (gsl_linalg_rsvd_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->Y)
+    gsl_matrix_free (w->Y);
+
+  if (w->Z)
+    gsl_matrix_free (w->Z);
+
+  if (w->V)
+    gsl_matrix_free (w->V);
+
+  if (w->S)
+    gsl_vector_free (w->S);
+
+  if (w->tau)
+    gsl_vector_free (w->tau);
+
+  if (w->work)
+    gsl_vector_free (w->work);
+
+  gsl_free (w);
+}
+
+/*
+gsl_linalg_rsvd_range()
+  Compute an orthonormal basis Q for the approximate range
+of A using a Gaussian sketch and nsweep power iterations
+
+Inputs: A      - operator for M-by-N matrix A
+        nsweep - number of power iterations q (0, 1 or 2 is
+                 usually sufficient)
+        r      - random number generator for the test matrix
+        Q      - (output) orthonormal basis for range(A), M-by-l
+        w      - workspace
+*/
+
+int
+gsl_linalg_rsvd_range (const gsl_linalg_operator * A,
+                       const size_t nsweep,
+                       const gsl_rng * r,
+                       gsl_matrix * Q,
+                       gsl_linalg_rsvd_workspace * w)
+{
+  if (A->size1 != w->M || A->size2 != w->N)
+    {
+      GSL_ERROR ("operator size does not match workspace", GSL_EBADLEN);
+    }
+  else if (Q->size1 != w->M || Q->size2 != w->l)
+    {
+      GSL_ERROR ("Q matrix must be M-by-(k+p)", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      size_t i, j;
+      size_t sweep;
+
+      /* random test matrix Omega, stored in Z */
+      for (j = 0; j < w->l; ++j)
+        {
+          for (i = 0; i < w->N; ++i)
+            gsl_matrix_set (w->Z, i, j, gsl_ran_gaussian (r, 1.0));
+        }
+
+      /* Q = orth(A Omega) */
+      status = (*(A->mult)) (CblasNoTrans, w->Z, Q, A->params);
+      if (status)
+        return status;
+
+      status = rsvd_orth (Q, w->tau);
+      if (status)
+        return status;
+
+      for (sweep = 0; sweep < nsweep; ++sweep)
+        {
+          /* Z = orth(A^T Q) */
+          status = (*(A->mult)) (CblasTrans, Q, w->Z, A->params);
+          if (status)
+            return status;
+
+          status = rsvd_orth (w->Z, w->tau);
+          if (status)
+            return status;
+
+          /* Q = orth(A Z) */
+          status = (*(A->mult)) (CblasNoTrans, w->Z, Q, A->params);
+          if (status)
+            return status;
+
+          status = rsvd_orth (Q, w->tau);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_rsvd_decomp()
+  Compute the rank-k randomized SVD of A,
+
+A ~ U S V^T
+
+Inputs: A      - operator for M-by-N matrix A
+        nsweep - number of power iterations
+        r      - random number generator
+        U      - (output) left singular vectors, M-by-k
+        S      - (output) singular values in decreasing order, size k
+        V      - (output) right singular vectors, N-by-k
+        w      - workspace
+*/
+
+int
+gsl_linalg_rsvd_decomp (const gsl_linalg_operator * A,
+                        const size_t nsweep,
+                        const gsl_rng * r,
+                        gsl_matrix * U,
+                        gsl_vector * S,
+                        gsl_matrix * V,
+                        gsl_linalg_rsvd_workspace * w)
+{
+  const size_t M = w->M;
+  const size_t N = w->N;
+  const size_t k = w->k;
+
+  if (U->size1 != M || U->size2 != k)
+    {
+      GSL_ERROR ("U matrix must be M-by-k", GSL_EBADLEN);
+    }
+  else if (S->size != k)
+    {
+      GSL_ERROR ("S vector must have length k", GSL_EBADLEN);
+    }
+  else if (V->size1 != N || V->size2 != k)
+    {
+      GSL_ERROR ("V matrix must be N-by-k", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      gsl_matrix_const_view Vk = gsl_matrix_const_submatrix (w->V, 0, 0, w->l, k);
+      gsl_matrix_const_view Zk = gsl_matrix_const_submatrix (w->Z, 0, 0, N, k);
+      gsl_vector_const_view Sk = gsl_vector_const_subvector (w->S, 0, k);
+
+      status = gsl_linalg_rsvd_range (A, nsweep, r, w->Y, w);
+      if (status)
+        return status;
+
+      /* Z = B^T = A^T Q, N-by-l */
+      status = (*(A->mult)) (CblasTrans, w->Y, w->Z, A->params);
+      if (status)
+        return status;
+
+      /* B^T = U_B S V_B^T with U_B stored in Z, so that A ~ (Q V_B) S U_B^T */
+      status = gsl_linalg_SV_decomp (w->Z, w->V, w->S, w->work);
+      if (status)
+        return status;
+
+      /* U = Q V_B(:,1:k) */
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, w->Y, &Vk.matrix, 0.0, U);
+
+      gsl_matrix_memcpy (V, &Zk.matrix);
+      gsl_vector_memcpy (S, &Sk.vector);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_rsvd_decomp_matrix()
+  Compute the randomized SVD of a dense matrix A
+*/
+
+int
+gsl_linalg_rsvd_decomp_matrix (const gsl_matrix * A,
+                               const size_t nsweep,
+                               const gsl_rng * r,
+                               gsl_matrix * U,
+                               gsl_vector * S,
+                               gsl_matrix * V,
+                               gsl_linalg_rsvd_workspace * w)
+{
+  gsl_linalg_operator op;
+
+  op.mult = &rsvd_dense_mult;
+  op.size1 = A->size1;
+  op.size2 = A->size2;
+  op.params = (void *) A;
+
+  return gsl_linalg_rsvd_decomp (&op, nsweep, r, U, S, V, w);
+}
+
+/*
+rsvd_orth()
+  Replace the M-by-l matrix A (M >= l) by an orthonormal basis
+for its column space, using a Householder QR decomposition
+followed by accumulation of the thin factor Q in place
+
+Inputs: A   - on input, matrix to orthonormalize
+              on output, thin Q factor
+        tau - workspace of length l
+*/
+
+static int
+rsvd_orth (gsl_matrix * A, gsl_vector * tau)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  int status;
+  size_t i;
+
+  status = gsl_linalg_QR_decomp (A, tau);
+  if (status)
+    return status;
+
+  for (i = N; i-- > 0;)
+    {
+      gsl_vector_view c = gsl_matrix_column (A, i);
+      gsl_vector_view h = gsl_vector_subvector (&c.vector, i, M - i);
+      double ti = gsl_vector_get (tau, i);
+
+      if (i + 1 < N)
+        {
+          /* apply H_i to the columns of Q already formed */
+          gsl_matrix_view m = gsl_matrix_submatrix (A, i, i + 1, M - i, N - i - 1);
+          gsl_vector_view r = gsl_matrix_row (&m.matrix, 0);
+
+          gsl_vector_set_zero (&r.vector);
+          gsl_linalg_householder_hm (ti, &h.vector, &m.matrix);
+        }
+
+      /* column i of Q is H_i e_i */
+      if (i + 1 < M)
+        {
+          gsl_vector_view v = gsl_vector_subvector (&c.vector, i + 1, M - i - 1);
+          gsl_vector_scale (&v.vector, -ti);
+        }
+
+      gsl_vector_set (&c.vector, i, 1.0 - ti);
+
+      if (i > 0)
+        {
+          gsl_vector_view v = gsl_vector_subvector (&c.vector, 0, i);
+          gsl_vector_set_zero (&v.vector);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Y = op(A) X for a dense matrix A */
+static int
+rsvd_dense_mult (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                 gsl_matrix * Y, void * params)
+{
+  const gsl_matrix * A = (const gsl_matrix *) params;
+
+  return gsl_blas_dgemm (TransA, CblasNoTrans, 1.0, A, X, 0.0, Y);
+}
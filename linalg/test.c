@@ -29,6 +29,7 @@
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_complex_math.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_rng.h>
 
 #define TEST_SVD_4X4 1
 
@@ -92,6 +93,11 @@ int test_SV_decomp_mod_dim(const gsl_matrix * m, double eps);
 int test_SV_decomp_mod(void);
 int test_SV_decomp_jacobi_dim(const gsl_matrix * m, double eps);
 int test_SV_decomp_jacobi(void);
+int test_rsvd_decomp_dim(const size_t M, const size_t N, const size_t rank,
+                         const size_t k, const size_t p, const size_t nsweep,
+                         double eps);
+int test_rsvd_operator(void);
+int test_rsvd_decomp(void);
 int test_cholesky_solve_dim(const gsl_matrix * m, const double * actual, double eps);
 int test_cholesky_solve(void);
 int test_cholesky_decomp_dim(const gsl_matrix * m, double eps);
@@ -4240,6 +4246,230 @@ int test_bidiag_decomp(void)
   return s;
 }
 
+/* A = U0 diag(s) V0^T with random orthogonal U0, V0 and s_i = 1/(i+1), i < rank */
+static gsl_matrix *
+create_lowrank_matrix(const size_t M, const size_t N, const size_t rank,
+                      const gsl_rng * r)
+{
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_matrix * U0 = gsl_matrix_alloc(M, M);
+  gsl_matrix * V0 = gsl_matrix_alloc(N, N);
+  gsl_matrix * X = gsl_matrix_alloc(GSL_MAX(M, N), GSL_MAX(M, N));
+  gsl_matrix * R = gsl_matrix_alloc(GSL_MAX(M, N), GSL_MAX(M, N));
+  gsl_vector * tau = gsl_vector_alloc(GSL_MAX(M, N));
+  size_t i, j, n;
+
+  for (n = 0; n < 2; ++n)
+    {
+      size_t dim = (n == 0) ? M : N;
+      gsl_matrix_view x = gsl_matrix_submatrix(X, 0, 0, dim, dim);
+      gsl_matrix_view rr = gsl_matrix_submatrix(R, 0, 0, dim, dim);
+      gsl_vector_view t = gsl_vector_subvector(tau, 0, dim);
+
+      for (i = 0; i < dim; ++i)
+        for (j = 0; j < dim; ++j)
+          gsl_matrix_set(&x.matrix, i, j, gsl_rng_uniform(r) - 0.5);
+
+      gsl_linalg_QR_decomp(&x.matrix, &t.vector);
+      gsl_linalg_QR_unpack(&x.matrix, &t.vector, (n == 0) ? U0 : V0, &rr.matrix);
+    }
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double sum = 0.0;
+
+          for (n = 0; n < rank; ++n)
+            sum += gsl_matrix_get(U0, i, n) * gsl_matrix_get(V0, j, n) / (n + 1.0);
+
+          gsl_matrix_set(A, i, j, sum);
+        }
+    }
+
+  gsl_matrix_free(U0);
+  gsl_matrix_free(V0);
+  gsl_matrix_free(X);
+  gsl_matrix_free(R);
+  gsl_vector_free(tau);
+
+  return A;
+}
+
+/* check A ~ U S V^T, U^T U = I and V^T V = I */
+static int
+test_rsvd_check(const gsl_matrix * A, const gsl_matrix * U, const gsl_vector * S,
+                const gsl_matrix * V, const size_t rank, double eps)
+{
+  int s = 0;
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t k = S->size;
+  size_t i, j, n;
+
+  for (i = 0; i < k; ++i)
+    {
+      double si = gsl_vector_get(S, i);
+      double expected = (i < rank) ? 1.0 / (i + 1.0) : 0.0;
+      int foo = check(si, expected, eps);
+      if (foo)
+        printf("(%3lu,%3lu) S[%lu]: %22.18g   %22.18g\n", M, N, i, si, expected);
+      s += foo;
+    }
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double aij = 0.0, mij = gsl_matrix_get(A, i, j);
+          int foo;
+
+          for (n = 0; n < k; ++n)
+            aij += gsl_matrix_get(U, i, n) * gsl_vector_get(S, n) * gsl_matrix_get(V, j, n);
+
+          /* absolute error since A has small entries */
+          foo = check(aij - mij, 0.0, eps);
+          if (foo)
+            printf("(%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n", M, N, i, j, aij, mij);
+          s += foo;
+        }
+    }
+
+  for (i = 0; i < rank; ++i)
+    {
+      for (j = 0; j < rank; ++j)
+        {
+          gsl_vector_const_view ui = gsl_matrix_const_column(U, i);
+          gsl_vector_const_view uj = gsl_matrix_const_column(U, j);
+          gsl_vector_const_view vi = gsl_matrix_const_column(V, i);
+          gsl_vector_const_view vj = gsl_matrix_const_column(V, j);
+          double uu, vv;
+
+          gsl_blas_ddot(&ui.vector, &uj.vector, &uu);
+          gsl_blas_ddot(&vi.vector, &vj.vector, &vv);
+
+          s += check(uu, (i == j) ? 1.0 : 0.0, eps);
+          s += check(vv, (i == j) ? 1.0 : 0.0, eps);
+        }
+    }
+
+  return s;
+}
+
+int
+test_rsvd_decomp_dim(const size_t M, const size_t N, const size_t rank,
+                     const size_t k, const size_t p, const size_t nsweep,
+                     double eps)
+{
+  int s = 0;
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  gsl_matrix * A = create_lowrank_matrix(M, N, rank, r);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_linalg_rsvd_workspace * w = gsl_linalg_rsvd_alloc(M, N, k, p);
+
+  s += gsl_linalg_rsvd_decomp_matrix(A, nsweep, r, U, S, V, w);
+  s += test_rsvd_check(A, U, S, V, rank, eps);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_linalg_rsvd_free(w);
+  gsl_rng_free(r);
+
+  return s;
+}
+
+/* matrix-free operator for a rectangular diagonal matrix A_ii = d_i */
+static int
+test_rsvd_diag_mult(CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                    gsl_matrix * Y, void * params)
+{
+  const gsl_vector * d = (const gsl_vector *) params;
+  size_t i, j;
+
+  (void) TransA; /* A^T has the same nonzero diagonal */
+
+  gsl_matrix_set_zero(Y);
+
+  for (i = 0; i < d->size && i < X->size1 && i < Y->size1; ++i)
+    {
+      for (j = 0; j < X->size2; ++j)
+        gsl_matrix_set(Y, i, j, gsl_vector_get(d, i) * gsl_matrix_get(X, i, j));
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+test_rsvd_operator(void)
+{
+  int s = 0;
+  const size_t M = 40, N = 25, rank = 4, k = 5, p = 5;
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  gsl_vector * d = gsl_vector_calloc(N);
+  gsl_matrix * A = gsl_matrix_calloc(M, N);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_linalg_rsvd_workspace * w = gsl_linalg_rsvd_alloc(M, N, k, p);
+  gsl_linalg_operator op;
+  size_t i;
+
+  /* unsorted diagonal, singular values 1, 1/2, 1/3, 1/4 */
+  gsl_vector_set(d, 3, 0.5);
+  gsl_vector_set(d, 7, 1.0);
+  gsl_vector_set(d, 11, 0.25);
+  gsl_vector_set(d, 20, 1.0 / 3.0);
+
+  for (i = 0; i < N; ++i)
+    gsl_matrix_set(A, i, i, gsl_vector_get(d, i));
+
+  op.mult = &test_rsvd_diag_mult;
+  op.size1 = M;
+  op.size2 = N;
+  op.params = d;
+
+  s += gsl_linalg_rsvd_decomp(&op, 1, r, U, S, V, w);
+  s += test_rsvd_check(A, U, S, V, rank, 1.0e3 * GSL_DBL_EPSILON);
+
+  gsl_vector_free(d);
+  gsl_matrix_free(A);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_linalg_rsvd_free(w);
+  gsl_rng_free(r);
+
+  return s;
+}
+
+int test_rsvd_decomp(void)
+{
+  int f;
+  int s = 0;
+
+  f = test_rsvd_decomp_dim(50, 30, 5, 5, 5, 0, 1.0e3 * GSL_DBL_EPSILON);
+  gsl_test(f, "  rsvd_decomp (50,30) rank 5, q = 0");
+  s += f;
+
+  f = test_rsvd_decomp_dim(30, 50, 5, 8, 4, 2, 1.0e3 * GSL_DBL_EPSILON);
+  gsl_test(f, "  rsvd_decomp (30,50) rank 5, q = 2");
+  s += f;
+
+  f = test_rsvd_decomp_dim(20, 20, 8, 10, 10, 1, 1.0e3 * GSL_DBL_EPSILON);
+  gsl_test(f, "  rsvd_decomp (20,20) rank 8, full sample");
+  s += f;
+
+  f = test_rsvd_operator();
+  gsl_test(f, "  rsvd_decomp matrix-free operator");
+  s += f;
+
+  return s;
+}
+
 void
 my_error_handler (const char *reason, const char *file, int line, int err)
 {
@@ -4333,6 +4563,7 @@ int main(void)
   gsl_test(test_SV_decomp_jacobi(),        "Singular Value Decomposition (Jacobi)");
   gsl_test(test_SV_decomp_mod(),         "Singular Value Decomposition (Mod)");
   gsl_test(test_SV_solve(),              "SVD Solve");
+  gsl_test(test_rsvd_decomp(),           "Randomized Singular Value Decomposition");
   gsl_test(test_cholesky_decomp(),       "Cholesky Decomposition");
   gsl_test(test_cholesky_decomp_unit(),  "Cholesky Decomposition [unit triangular]");
   gsl_test(test_cholesky_solve(),        "Cholesky Solve");
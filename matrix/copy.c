@@ -1,4 +1,5 @@
 #include <config.h>
+#include <string.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_errno.h>
 
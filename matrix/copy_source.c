@@ -36,6 +36,14 @@ FUNCTION (gsl_matrix, memcpy) (TYPE (gsl_matrix) * dest,
     const size_t dest_tda = dest->tda ;
     size_t i, j;
 
+    if (src_tda == src_size2 && dest_tda == dest_size2)
+      {
+        /* both matrices are contiguous, copy as a single block */
+        memmove (dest->data, src->data,
+                MULTIPLICITY * src_size1 * src_size2 * sizeof (ATOMIC));
+        return GSL_SUCCESS;
+      }
+
     for (i = 0; i < src_size1 ; i++)
       {
         for (j = 0; j < MULTIPLICITY * src_size2; j++)
@@ -1,4 +1,5 @@
 #include <config.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
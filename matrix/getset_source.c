@@ -181,7 +181,7 @@ FUNCTION (gsl_vector, alloc_row_from_matrix) (TYPE(gsl_matrix) * m,
       GSL_ERROR_VAL ("row index is out of range", GSL_EINVAL, 0);
     }
 
-  v = (TYPE (gsl_vector) *) malloc (sizeof (TYPE (gsl_vector)));
+  v = (TYPE (gsl_vector) *) gsl_malloc (sizeof (TYPE (gsl_vector)));
 
   if (v == 0)
     {
@@ -210,7 +210,7 @@ FUNCTION (gsl_vector, alloc_col_from_matrix) (TYPE(gsl_matrix) * m,
       GSL_ERROR_VAL ("column index is out of range", GSL_EINVAL, 0);
     }
 
-  v = (TYPE (gsl_vector) *) malloc (sizeof (TYPE (gsl_vector)));
+  v = (TYPE (gsl_vector) *) gsl_malloc (sizeof (TYPE (gsl_vector)));
 
   if (v == 0)
     {
@@ -68,6 +68,9 @@ typedef const _gsl_matrix_char_const_view gsl_matrix_char_const_view;
 gsl_matrix_char * 
 gsl_matrix_char_alloc (const size_t n1, const size_t n2);
 
+gsl_matrix_char * 
+gsl_matrix_char_alloc_mode (const size_t n1, const size_t n2, const size_t mode);
+
 gsl_matrix_char * 
 gsl_matrix_char_calloc (const size_t n1, const size_t n2);
 
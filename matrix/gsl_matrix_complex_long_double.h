@@ -69,6 +69,9 @@ typedef const _gsl_matrix_complex_long_double_const_view gsl_matrix_complex_long
 gsl_matrix_complex_long_double * 
 gsl_matrix_complex_long_double_alloc (const size_t n1, const size_t n2);
 
+gsl_matrix_complex_long_double * 
+gsl_matrix_complex_long_double_alloc_mode (const size_t n1, const size_t n2, const size_t mode);
+
 gsl_matrix_complex_long_double * 
 gsl_matrix_complex_long_double_calloc (const size_t n1, const size_t n2);
 
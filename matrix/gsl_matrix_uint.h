@@ -68,6 +68,9 @@ typedef const _gsl_matrix_uint_const_view gsl_matrix_uint_const_view;
 gsl_matrix_uint * 
 gsl_matrix_uint_alloc (const size_t n1, const size_t n2);
 
+gsl_matrix_uint * 
+gsl_matrix_uint_alloc_mode (const size_t n1, const size_t n2, const size_t mode);
+
 gsl_matrix_uint * 
 gsl_matrix_uint_calloc (const size_t n1, const size_t n2);
 
@@ -1,5 +1,6 @@
 #include <config.h>
 #include <string.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_matrix.h>
 
@@ -19,9 +19,17 @@
 
 TYPE (gsl_matrix) *
 FUNCTION (gsl_matrix, alloc) (const size_t n1, const size_t n2)
+{
+  return FUNCTION (gsl_matrix, alloc_mode) (n1, n2, gsl_block_get_alloc_mode ());
+}
+
+TYPE (gsl_matrix) *
+FUNCTION (gsl_matrix, alloc_mode) (const size_t n1, const size_t n2,
+                                   const size_t mode)
 {
   TYPE (gsl_block) * block;
   TYPE (gsl_matrix) * m;
+  size_t tda = n2;
 
   if (n1 == 0)
     {
@@ -34,7 +42,7 @@ FUNCTION (gsl_matrix, alloc) (const size_t n1, const size_t n2)
                         GSL_EINVAL, 0);
     }
 
-  m = (TYPE (gsl_matrix) *) malloc (sizeof (TYPE (gsl_matrix)));
+  m = (TYPE (gsl_matrix) *) gsl_malloc (sizeof (TYPE (gsl_matrix)));
 
   if (m == 0)
     {
@@ -42,9 +50,24 @@ FUNCTION (gsl_matrix, alloc) (const size_t n1, const size_t n2)
                         GSL_ENOMEM, 0);
     }
 
+  if ((mode & GSL_BLOCK_ALLOC_PADDED) && n1 > 1
+      && GSL_BLOCK_ALIGNMENT % (MULTIPLICITY * sizeof (ATOMIC)) == 0)
+    {
+      /* pad rows to a whole number of cache lines, and avoid row
+         lengths which are a multiple of the page size since these
+         map every row of a column onto the same cache set */
+      const size_t line = GSL_BLOCK_ALIGNMENT / (MULTIPLICITY * sizeof (ATOMIC));
+      const size_t page = 4096 / (MULTIPLICITY * sizeof (ATOMIC));
+
+      tda = ((n2 + line - 1) / line) * line;
+
+      if (tda % page == 0)
+        tda += line;
+    }
+
   /* FIXME: n1*n2 could overflow for large dimensions */
 
-  block = FUNCTION(gsl_block, alloc) (n1 * n2) ;
+  block = FUNCTION(gsl_block, alloc_mode) (n1 * tda, mode) ;
 
   if (block == 0)
     {
@@ -55,7 +78,7 @@ FUNCTION (gsl_matrix, alloc) (const size_t n1, const size_t n2)
   m->data = block->data;
   m->size1 = n1;
   m->size2 = n2;
-  m->tda = n2; 
+  m->tda = tda; 
   m->block = block;
   m->owner = 1;
 
@@ -72,10 +95,10 @@ FUNCTION (gsl_matrix, calloc) (const size_t n1, const size_t n2)
   if (m == 0)
     return 0;
 
-  /* initialize matrix to zero */
-  memset(m->data, 0, MULTIPLICITY * n1 * n2 * sizeof(ATOMIC));
+  /* initialize matrix to zero, including any row padding */
+  memset(m->data, 0, MULTIPLICITY * m->block->size * sizeof(ATOMIC));
 
-  for (i = 0; i < MULTIPLICITY * n1 * n2; i++)
+  for (i = 0; i < MULTIPLICITY * m->block->size; i++)
     {
       m->data[i] = 0;
     }
@@ -113,7 +136,7 @@ FUNCTION (gsl_matrix, alloc_from_block) (TYPE(gsl_block) * block,
                         GSL_EINVAL, 0);
     }
 
-  m = (TYPE (gsl_matrix) *) malloc (sizeof (TYPE (gsl_matrix)));
+  m = (TYPE (gsl_matrix) *) gsl_malloc (sizeof (TYPE (gsl_matrix)));
 
   if (m == 0)
     {
@@ -162,7 +185,7 @@ FUNCTION (gsl_matrix, alloc_from_matrix) (TYPE(gsl_matrix) * mm,
                         GSL_EINVAL, 0);
     }
 
-  m = (TYPE (gsl_matrix) *) malloc (sizeof (TYPE (gsl_matrix)));
+  m = (TYPE (gsl_matrix) *) gsl_malloc (sizeof (TYPE (gsl_matrix)));
 
   if (m == 0)
     {
@@ -190,7 +213,7 @@ FUNCTION (gsl_matrix, free) (TYPE (gsl_matrix) * m)
       FUNCTION(gsl_block, free) (m->block);
     }
 
-  free (m);
+  gsl_free (m);
 }
 void
 FUNCTION (gsl_matrix, set_identity) (TYPE (gsl_matrix) * m)
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "view.h"
 
 #define BASE_LONG_DOUBLE
 #include "templates_on.h"
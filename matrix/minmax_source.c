@@ -29,6 +29,13 @@ FUNCTION (gsl_matrix, max) (const TYPE (gsl_matrix) * m)
   BASE max = m->data[0 * tda + 0];
   size_t i, j;
 
+  if (tda == N && M * N > 0)
+    {
+      TYPE (gsl_vector) v;
+      FLAT_VECTOR (v, m);
+      return FUNCTION (gsl_vector, max) (&v);
+    }
+
   for (i = 0; i < M; i++)
     {
       for (j = 0; j < N; j++)
@@ -58,6 +65,13 @@ FUNCTION (gsl_matrix, min) (const TYPE (gsl_matrix) * m)
   BASE min = m->data[0 * tda + 0];
   size_t i, j;
 
+  if (tda == N && M * N > 0)
+    {
+      TYPE (gsl_vector) v;
+      FLAT_VECTOR (v, m);
+      return FUNCTION (gsl_vector, min) (&v);
+    }
+
   for (i = 0; i < M; i++)
     {
       for (j = 0; j < N; j++)
@@ -92,6 +106,14 @@ FUNCTION (gsl_matrix, minmax) (const TYPE (gsl_matrix) * m,
 
   size_t i, j;
 
+  if (tda == N && M * N > 0)
+    {
+      TYPE (gsl_vector) v;
+      FLAT_VECTOR (v, m);
+      FUNCTION (gsl_vector, minmax) (&v, min_out, max_out);
+      return;
+    }
+
   for (i = 0; i < M; i++)
     {
       for (j = 0; j < N; j++)
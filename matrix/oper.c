@@ -3,6 +3,9 @@
 #include <math.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "view.h"
 
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
@@ -27,6 +27,15 @@ FUNCTION(gsl_matrix, add) (TYPE(gsl_matrix) * a, const TYPE(gsl_matrix) * b)
     {
       GSL_ERROR ("matrices must have same dimensions", GSL_EBADLEN);
     }
+  else if (a->tda == N && b->tda == N)
+    {
+      TYPE(gsl_vector) va, vb;
+
+      FLAT_VECTOR (va, a);
+      FLAT_VECTOR (vb, b);
+
+      return FUNCTION(gsl_vector, add) (&va, &vb);
+    }
   else 
     {
       const size_t tda_a = a->tda;
@@ -56,6 +65,15 @@ FUNCTION(gsl_matrix, sub) (TYPE(gsl_matrix) * a, const TYPE(gsl_matrix) * b)
     {
       GSL_ERROR ("matrices must have same dimensions", GSL_EBADLEN);
     }
+  else if (a->tda == N && b->tda == N)
+    {
+      TYPE(gsl_vector) va, vb;
+
+      FLAT_VECTOR (va, a);
+      FLAT_VECTOR (vb, b);
+
+      return FUNCTION(gsl_vector, sub) (&va, &vb);
+    }
   else 
     {
       const size_t tda_a = a->tda;
@@ -85,6 +103,15 @@ FUNCTION(gsl_matrix, mul_elements) (TYPE(gsl_matrix) * a, const TYPE(gsl_matrix)
     {
       GSL_ERROR ("matrices must have same dimensions", GSL_EBADLEN);
     }
+  else if (a->tda == N && b->tda == N)
+    {
+      TYPE(gsl_vector) va, vb;
+
+      FLAT_VECTOR (va, a);
+      FLAT_VECTOR (vb, b);
+
+      return FUNCTION(gsl_vector, mul) (&va, &vb);
+    }
   else 
     {
       const size_t tda_a = a->tda;
@@ -114,6 +141,15 @@ FUNCTION(gsl_matrix, div_elements) (TYPE(gsl_matrix) * a, const TYPE(gsl_matrix)
     {
       GSL_ERROR ("matrices must have same dimensions", GSL_EBADLEN);
     }
+  else if (a->tda == N && b->tda == N)
+    {
+      TYPE(gsl_vector) va, vb;
+
+      FLAT_VECTOR (va, a);
+      FLAT_VECTOR (vb, b);
+
+      return FUNCTION(gsl_vector, div) (&va, &vb);
+    }
   else 
     {
       const size_t tda_a = a->tda;
@@ -142,6 +178,13 @@ FUNCTION(gsl_matrix, scale) (TYPE(gsl_matrix) * a, const double x)
   
   size_t i, j;
   
+  if (tda == N)
+    {
+      TYPE(gsl_vector) v;
+      FLAT_VECTOR (v, a);
+      return FUNCTION(gsl_vector, scale) (&v, x);
+    }
+
   for (i = 0; i < M; i++)
     {
       for (j = 0; j < N; j++)
@@ -162,6 +205,13 @@ FUNCTION(gsl_matrix, add_constant) (TYPE(gsl_matrix) * a, const double x)
 
   size_t i, j;
 
+  if (tda == N)
+    {
+      TYPE(gsl_vector) v;
+      FLAT_VECTOR (v, a);
+      return FUNCTION(gsl_vector, add_constant) (&v, x);
+    }
+
   for (i = 0; i < M; i++)
     {
       for (j = 0; j < N; j++)
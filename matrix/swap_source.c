@@ -17,6 +17,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+static int FUNCTION (transpose, cycles) (TYPE (gsl_matrix) * m);
+
 int
 FUNCTION (gsl_matrix, swap_rows) (TYPE (gsl_matrix) * m,
                                  const size_t i, const size_t j)
@@ -148,25 +150,54 @@ FUNCTION (gsl_matrix, transpose) (TYPE (gsl_matrix) * m)
   const size_t size1 = m->size1;
   const size_t size2 = m->size2;
   size_t i, j, k;
+  size_t ib, jb;
 
   if (size1 != size2)
     {
-      GSL_ERROR ("matrix must be square to take transpose", GSL_ENOTSQR);
+      /* the dimensions of a view cannot be exchanged without changing
+         the layout of its parent, and the rows of a padded matrix do
+         not fit the transposed shape */
+
+      if (!m->owner)
+        {
+          GSL_ERROR ("matrix view must be square to take transpose",
+                     GSL_ENOTSQR);
+        }
+
+      if (m->tda != size2)
+        {
+          GSL_ERROR ("matrix must be square or unpadded to take transpose",
+                     GSL_ENOTSQR);
+        }
+
+      return FUNCTION (transpose, cycles) (m);
     }
 
-  for (i = 0; i < size1; i++)
+  /* swap the tiles (ib,jb) and (jb,ib) so that both stay in cache */
+
+  for (ib = 0; ib < size1; ib += TRANSPOSE_BLOCK)
     {
-      for (j = i + 1 ; j < size2 ; j++) 
+      const size_t imax = GSL_MIN (ib + TRANSPOSE_BLOCK, size1);
+
+      for (jb = ib; jb < size2; jb += TRANSPOSE_BLOCK)
         {
-          for (k = 0; k < MULTIPLICITY; k++)
+          const size_t jmax = GSL_MIN (jb + TRANSPOSE_BLOCK, size2);
+
+          for (i = ib; i < imax; i++)
             {
-              size_t e1 = (i *  m->tda + j) * MULTIPLICITY + k ;
-              size_t e2 = (j *  m->tda + i) * MULTIPLICITY + k ;
-              {
-                ATOMIC tmp = m->data[e1] ;
-                m->data[e1] = m->data[e2] ;
-                m->data[e2] = tmp ;
-              }
+              for (j = (jb == ib) ? i + 1 : jb; j < jmax; j++)
+                {
+                  for (k = 0; k < MULTIPLICITY; k++)
+                    {
+                      size_t e1 = (i *  m->tda + j) * MULTIPLICITY + k ;
+                      size_t e2 = (j *  m->tda + i) * MULTIPLICITY + k ;
+                      {
+                        ATOMIC tmp = m->data[e1] ;
+                        m->data[e1] = m->data[e2] ;
+                        m->data[e2] = tmp ;
+                      }
+                    }
+                }
             }
         }
     }
@@ -185,6 +216,7 @@ FUNCTION (gsl_matrix, transpose_memcpy) (TYPE (gsl_matrix) * dest,
   const size_t dest_size2 = dest->size2;
 
   size_t i, j, k;
+  size_t ib, jb;
 
   if (dest_size2 != src_size1 || dest_size1 != src_size2)
     {
@@ -192,19 +224,103 @@ FUNCTION (gsl_matrix, transpose_memcpy) (TYPE (gsl_matrix) * dest,
                  GSL_EBADLEN);
     }
 
-  for (i = 0; i < dest_size1; i++)
+  /* copy tile by tile, so that the strided reads from src reuse
+     the cache lines and TLB entries of the previous row */
+
+  for (ib = 0; ib < dest_size1; ib += TRANSPOSE_BLOCK)
+    {
+      const size_t imax = GSL_MIN (ib + TRANSPOSE_BLOCK, dest_size1);
+
+      for (jb = 0; jb < dest_size2; jb += TRANSPOSE_BLOCK)
+        {
+          const size_t jmax = GSL_MIN (jb + TRANSPOSE_BLOCK, dest_size2);
+
+          for (i = ib; i < imax; i++)
+            {
+              for (j = jb; j < jmax; j++) 
+                {
+                  for (k = 0; k < MULTIPLICITY; k++)
+                    {
+                      size_t e1 = (i *  dest->tda + j) * MULTIPLICITY + k ;
+                      size_t e2 = (j *  src->tda + i) * MULTIPLICITY + k ;
+
+                      dest->data[e1] = src->data[e2] ;
+                    }
+                }
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* In-place transpose of an unpadded (tda = size2) non-square matrix
+ * by following the cycles of the permutation
+ *
+ *   k -> k size1 mod (size1 size2 - 1)
+ *
+ * which maps the position of element (i,j) in the size1-by-size2
+ * matrix to its position in the size2-by-size1 transpose. A bit
+ * array records the elements already moved. On output the
+ * dimensions of m are exchanged.
+ */
+
+static int
+FUNCTION (transpose, cycles) (TYPE (gsl_matrix) * m)
+{
+  const size_t size1 = m->size1;
+  const size_t size2 = m->size2;
+  const size_t n = size1 * size2;
+  unsigned char *moved;
+  size_t s, k;
+
+  if (n > 2)
     {
-      for (j = 0 ; j < dest_size2; j++) 
+      moved = gsl_calloc ((n + 7) / 8, sizeof (unsigned char));
+
+      if (moved == 0)
         {
+          GSL_ERROR ("failed to allocate space for transpose", GSL_ENOMEM);
+        }
+
+      /* the first and last elements are fixed points */
+
+      for (s = 1; s < n - 1; s++)
+        {
+          size_t cur, src;
+          ATOMIC tmp[MULTIPLICITY];
+
+          if (moved[s / 8] & (1 << (s % 8)))
+            continue;
+
           for (k = 0; k < MULTIPLICITY; k++)
+            tmp[k] = m->data[s * MULTIPLICITY + k];
+
+          cur = s;
+          src = (s * size2) % (n - 1);
+
+          while (src != s)
             {
-              size_t e1 = (i *  dest->tda + j) * MULTIPLICITY + k ;
-              size_t e2 = (j *  src->tda + i) * MULTIPLICITY + k ;
+              for (k = 0; k < MULTIPLICITY; k++)
+                m->data[cur * MULTIPLICITY + k] = m->data[src * MULTIPLICITY + k];
 
-              dest->data[e1] = src->data[e2] ;
+              moved[cur / 8] |= (1 << (cur % 8));
+              cur = src;
+              src = (cur * size2) % (n - 1);
             }
+
+          for (k = 0; k < MULTIPLICITY; k++)
+            m->data[cur * MULTIPLICITY + k] = tmp[k];
+
+          moved[cur / 8] |= (1 << (cur % 8));
         }
+
+      gsl_free (moved);
     }
 
+  m->size1 = size2;
+  m->size2 = size1;
+  m->tda = size1;
+
   return GSL_SUCCESS;
 }
@@ -46,84 +46,98 @@ int status = 0;
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "test_complex_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_GSL_COMPLEX_LONG
 
 #define BASE_GSL_COMPLEX
 #include "templates_on.h"
 #include "test_complex_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_GSL_COMPLEX
 
 #define BASE_GSL_COMPLEX_FLOAT
 #include "templates_on.h"
 #include "test_complex_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_GSL_COMPLEX_FLOAT
 
 #define BASE_LONG_DOUBLE
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_LONG_DOUBLE
 
 #define BASE_DOUBLE
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_DOUBLE
 
 #define BASE_FLOAT
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
 #define BASE_ULONG
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_ULONG
 
 #define BASE_LONG
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_LONG
 
 #define BASE_UINT
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_UINT
 
 #define BASE_INT
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_INT
 
 #define BASE_USHORT
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_USHORT
 
 #define BASE_SHORT
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_SHORT
 
 #define BASE_UCHAR
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_UCHAR
 
 #define BASE_CHAR
 #include "templates_on.h"
 #include "test_source.c"
+#include "test_transpose_source.c"
 #include "templates_off.h"
 #undef  BASE_CHAR
 
@@ -153,6 +167,21 @@ main (void)
   test_complex_float_func (M, N);
   test_complex_long_double_func (M, N);
 
+  test_transpose (M, N);
+  test_float_transpose (M, N);
+  test_long_double_transpose (M, N);
+  test_ulong_transpose (M, N);
+  test_long_transpose (M, N);
+  test_uint_transpose (M, N);
+  test_int_transpose (M, N);
+  test_ushort_transpose (M, N);
+  test_short_transpose (M, N);
+  test_uchar_transpose (M, N);
+  test_char_transpose (M, N);
+  test_complex_transpose (M, N);
+  test_complex_float_transpose (M, N);
+  test_complex_long_double_transpose (M, N);
+
   test_ops (M, N);
   test_float_ops (M, N);
   test_long_double_ops (M, N);
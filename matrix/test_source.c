@@ -409,6 +409,40 @@ FUNCTION (test, func) (const size_t M, const size_t N)
   }
 #endif
 
+  {
+    const size_t mode = GSL_BLOCK_ALLOC_ALIGNED | GSL_BLOCK_ALLOC_PADDED;
+    const size_t esize = MULTIPLICITY * sizeof (ATOMIC);
+    TYPE (gsl_matrix) * a = FUNCTION (gsl_matrix, alloc_mode) (M, N, mode);
+
+    status = (a->size1 != M || a->size2 != N || a->tda < N);
+    status |= !GSL_BLOCK_IS_ALIGNED (a->data);
+
+    if (GSL_BLOCK_ALIGNMENT % esize == 0)
+      {
+        status |= ((a->tda * esize) % GSL_BLOCK_ALIGNMENT != 0);
+        status |= ((a->tda * esize) % 4096 == 0);
+      }
+
+    for (i = 0; i < M; i++)
+      {
+        for (j = 0; j < N; j++)
+          FUNCTION (gsl_matrix, set) (a, i, j, (BASE) (i + j));
+      }
+
+    for (i = 0; i < M; i++)
+      {
+        for (j = 0; j < N; j++)
+          {
+            if (FUNCTION (gsl_matrix, get) (a, i, j) != (BASE) (i + j))
+              status = 1;
+          }
+      }
+
+    TEST (status, "_alloc_mode padded");
+
+    FUNCTION (gsl_matrix, free) (a);
+  }
+
   FUNCTION (gsl_matrix, free) (m);
   FUNCTION (gsl_vector, free) (v);
 }
@@ -606,6 +640,38 @@ FUNCTION (test, ops) (const size_t M, const size_t N)
       }
     gsl_test (status, NAME (gsl_matrix) "_swap");
   }
+
+  {
+    /* non-contiguous matrices use the row by row loops */
+    TYPE (gsl_matrix) * l = FUNCTION (gsl_matrix, calloc) (M, N + 1);
+    VIEW (gsl_matrix, view) v = FUNCTION (gsl_matrix, submatrix) (l, 0, 0, M, N);
+    int status = 0;
+
+    FUNCTION (gsl_matrix, memcpy) (&v.matrix, a);
+
+    status |= (FUNCTION (gsl_matrix, max) (&v.matrix) != FUNCTION (gsl_matrix, max) (a));
+    status |= (FUNCTION (gsl_matrix, min) (&v.matrix) != FUNCTION (gsl_matrix, min) (a));
+
+    FUNCTION (gsl_matrix, add) (&v.matrix, b);
+    FUNCTION (gsl_matrix, sub) (&v.matrix, b);
+
+    for (i = 0; i < M; i++)
+      {
+        status |= (FUNCTION (gsl_matrix, get) (l, i, N) != (BASE) 0);
+
+        for (j = 0; j < N; j++)
+          {
+            BASE x = FUNCTION (gsl_matrix, get) (&v.matrix, i, j);
+            BASE y = FUNCTION (gsl_matrix, get) (a, i, j);
+            if (x != y)
+              status = 1;
+          }
+      }
+
+    gsl_test (status, NAME (gsl_matrix) "_add and _sub non-contiguous");
+
+    FUNCTION (gsl_matrix, free) (l);
+  }
       
 
   FUNCTION(gsl_matrix, free) (a);
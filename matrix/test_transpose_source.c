@@ -0,0 +1,122 @@
+/* matrix/test_transpose_source.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests of the transpose functions, shared by the real and complex
+   types.  TEST is defined by test_source.c or test_complex_source.c */
+
+void FUNCTION (test, transpose) (const size_t M, const size_t N);
+
+void
+FUNCTION (test, transpose) (const size_t M, const size_t N)
+{
+  TYPE (gsl_matrix) * a = FUNCTION (gsl_matrix, alloc) (M, N);
+  TYPE (gsl_matrix) * b = FUNCTION (gsl_matrix, alloc) (N, M);
+  TYPE (gsl_matrix) * c = FUNCTION (gsl_matrix, alloc) (M, M);
+  TYPE (gsl_matrix) * d = FUNCTION (gsl_matrix, alloc) (M, M);
+  size_t i, j, n, l;
+  int status;
+
+  for (n = 0; n < MULTIPLICITY * M * N; n++)
+    a->data[n] = (ATOMIC) (n % 101);
+
+  for (n = 0; n < MULTIPLICITY * M * M; n++)
+    c->data[n] = (ATOMIC) (n % 103);
+
+  FUNCTION (gsl_matrix, transpose_memcpy) (b, a);
+
+  status = 0;
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          for (l = 0; l < MULTIPLICITY; l++)
+            {
+              if (b->data[MULTIPLICITY * (j * M + i) + l] !=
+                  a->data[MULTIPLICITY * (i * N + j) + l])
+                status = 1;
+            }
+        }
+    }
+
+  TEST (status, "_transpose_memcpy");
+
+  FUNCTION (gsl_matrix, memcpy) (d, c);
+  FUNCTION (gsl_matrix, transpose) (c);
+
+  status = 0;
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < M; j++)
+        {
+          for (l = 0; l < MULTIPLICITY; l++)
+            {
+              if (c->data[MULTIPLICITY * (i * M + j) + l] !=
+                  d->data[MULTIPLICITY * (j * M + i) + l])
+                status = 1;
+            }
+        }
+    }
+
+  TEST (status, "_transpose square");
+
+  FUNCTION (gsl_matrix, transpose) (a);
+
+  status = (a->size1 != N || a->size2 != M || a->tda != M);
+  for (n = 0; n < MULTIPLICITY * M * N; n++)
+    {
+      if (a->data[n] != b->data[n])
+        status = 1;
+    }
+
+  TEST (status, "_transpose non-square");
+
+  /* non-square views and padded matrices cannot be transposed in
+     place, and are left unchanged */
+
+  {
+    gsl_error_handler_t *handler = gsl_set_error_handler_off ();
+    TYPE (gsl_matrix) * p =
+      FUNCTION (gsl_matrix, alloc_mode) (M, N, GSL_BLOCK_ALLOC_PADDED);
+    QUALIFIED_VIEW (gsl_matrix, view) v =
+      FUNCTION (gsl_matrix, view_array) (b->data, M, N);
+    int s;
+
+    s = FUNCTION (gsl_matrix, transpose) (&v.matrix);
+
+    status = (s != GSL_ENOTSQR || v.matrix.size1 != M
+              || v.matrix.size2 != N || v.matrix.tda != N);
+
+    TEST (status, "_transpose non-square view");
+
+    s = FUNCTION (gsl_matrix, transpose) (p);
+
+    status = (p->tda != N) ? (s != GSL_ENOTSQR || p->size1 != M
+                              || p->size2 != N) : (s != GSL_SUCCESS);
+
+    TEST (status, "_transpose padded");
+
+    FUNCTION (gsl_matrix, free) (p);
+    gsl_set_error_handler (handler);
+  }
+
+  FUNCTION (gsl_matrix, free) (a);
+  FUNCTION (gsl_matrix, free) (b);
+  FUNCTION (gsl_matrix, free) (c);
+  FUNCTION (gsl_matrix, free) (d);
+}
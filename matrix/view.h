@@ -3,3 +3,14 @@
 
 #define NULL_MATRIX {0, 0, 0, 0, 0, 0}
 #define NULL_MATRIX_VIEW {{0, 0, 0, 0, 0, 0}}
+
+/* make the vector v a unit stride view of all the elements of the
+   matrix m, which must have contiguous rows (tda == size2) */
+#define FLAT_VECTOR(v, m)                       \
+  do {                                          \
+    (v).size = (m)->size1 * (m)->size2;         \
+    (v).stride = 1;                             \
+    (v).data = (m)->data;                       \
+    (v).block = 0;                              \
+    (v).owner = 0;                              \
+  } while (0)
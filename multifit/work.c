@@ -18,6 +18,7 @@
  */
 
 #include <config.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_multifit.h>
 
@@ -26,7 +27,7 @@ gsl_multifit_linear_alloc (const size_t nmax, const size_t pmax)
 {
   gsl_multifit_linear_workspace *w;
 
-  w = calloc (1, sizeof (gsl_multifit_linear_workspace));
+  w = gsl_calloc (1, sizeof (gsl_multifit_linear_workspace));
 
   if (w == 0)
     {
@@ -145,6 +146,6 @@ gsl_multifit_linear_free (gsl_multifit_linear_workspace * w)
   if (w->LTtau)
     gsl_vector_free (w->LTtau);
 
-  free (w);
+  gsl_free (w);
 }
 
@@ -40,6 +40,24 @@
 
 __BEGIN_DECLS
 
+/*
+ * Level schedule and copy of a sparse triangular matrix op(A), used
+ * by gsl_spblas_dtrsv
+ */
+typedef struct
+{
+  size_t n;          /* size of system */
+  size_t nlevels;    /* number of levels */
+  size_t *level_ptr; /* rows of level k: row[level_ptr[k] .. level_ptr[k+1]-1] */
+  size_t *row;       /* rows of op(A) sorted by level, length n */
+  size_t *tp;        /* off-diagonal elements of row[s]: [tp[s], tp[s+1]) */
+  size_t *ti;        /* column indices of off-diagonal elements */
+  double *td;        /* values of off-diagonal elements */
+  double *dinv;      /* inverse diagonal, length n */
+  size_t nz;         /* number of off-diagonal elements */
+  size_t nzmax;      /* allocated length of ti and td */
+} gsl_spblas_trsv_workspace;
+
 /*
  * Prototypes
  */
@@ -47,12 +65,27 @@ __BEGIN_DECLS
 int gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
                      const gsl_spmatrix *A, const gsl_vector *x,
                      const double beta, gsl_vector *y);
+int gsl_spblas_dgemm_dense(const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                           const gsl_spmatrix *A, const gsl_matrix *B,
+                           const double beta, gsl_matrix *C);
 int gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
                      const gsl_spmatrix *B, gsl_spmatrix *C);
+int gsl_spblas_dgemm_symbolic(const gsl_spmatrix *A, const gsl_spmatrix *B,
+                              gsl_spmatrix *C);
+int gsl_spblas_dgemm_numeric(const double alpha, const gsl_spmatrix *A,
+                             const gsl_spmatrix *B, gsl_spmatrix *C);
 size_t gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j,
                           const double alpha, size_t *w, double *x,
                           const size_t mark, gsl_spmatrix *C, size_t nz);
 
+gsl_spblas_trsv_workspace *gsl_spblas_trsv_alloc(const size_t n);
+void gsl_spblas_trsv_free(gsl_spblas_trsv_workspace *w);
+int gsl_spblas_dtrsv_analysis(const CBLAS_UPLO_t Uplo,
+                              const CBLAS_TRANSPOSE_t TransA,
+                              const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                              gsl_spblas_trsv_workspace *w);
+int gsl_spblas_dtrsv(gsl_vector *x, const gsl_spblas_trsv_workspace *w);
+
 __END_DECLS
 
 #endif /* __GSL_SPBLAS_H__ */
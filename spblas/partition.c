@@ -0,0 +1,86 @@
+/* spblas/partition.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Work splitting for the threaded sparse kernels. Threads are only
+ * started for matrices with at least SPBLAS_PARALLEL_NNZ non-zero
+ * elements, below which the cost of starting them outweighs the gain.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define SPBLAS_PARALLEL_NNZ     (32768)
+
+/*
+partition_start()
+  Find the first outer index (row for CRS, column for CCS) of part t
+out of nparts, so that each part holds about the same number of
+non-zero elements
+
+Inputs: p      - outer pointers of compressed matrix, length n + 1
+        n      - outer dimension
+        t      - part index, 0 <= t <= nparts
+        nparts - number of parts
+
+Return: first outer index of part t; part t covers the outer indices
+[partition_start(t), partition_start(t + 1))
+*/
+
+static size_t
+partition_start(const size_t *p, const size_t n, const size_t t,
+                const size_t nparts)
+{
+  const double target = (double) p[n] * (double) t / (double) nparts;
+  size_t lo = 0, hi = n;
+
+  if (t >= nparts)
+    return n;
+
+  /* smallest r with p[r] >= target */
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if ((double) p[mid] < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return lo;
+} /* partition_start() */
+
+/*
+partition_thread()
+  Return the index and number of parts for the calling thread
+*/
+
+static void
+partition_thread(size_t *t, size_t *nparts)
+{
+#ifdef _OPENMP
+  *t = (size_t) omp_get_thread_num();
+  *nparts = (size_t) omp_get_num_threads();
+#else
+  *t = 0;
+  *nparts = 1;
+#endif
+} /* partition_thread() */
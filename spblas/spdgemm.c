@@ -20,10 +20,54 @@
 #include <config.h>
 #include <stdlib.h>
 #include <math.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_errno.h>
 
+#include "partition.c"
+
+/*
+ * Accumulator for one column (CCS) or row (CRS) of C. Columns whose
+ * number of multiply-adds is small compared to the inner dimension use
+ * an open addressing hash table sized for that column, so their cost
+ * does not depend on the matrix dimension; denser columns use arrays
+ * indexed directly by row, cleared lazily with a stamp.
+ */
+
+typedef struct
+{
+  size_t M;       /* inner dimension */
+  size_t *mark;   /* dense: stamp of the column in which index i was seen */
+  size_t *pos;    /* dense: position of index i within the column */
+  size_t stamp;   /* dense: stamp of the current column */
+  size_t *hkey;   /* hash: index stored in each slot, SPGEMM_EMPTY if none */
+  size_t *hpos;   /* hash: position of hkey within the column */
+  size_t hmax;    /* hash: allocated number of slots */
+  size_t hsize;   /* hash: slots used for the current column, power of 2 */
+} spgemm_acc;
+
+/* use the dense accumulator when flops * SPGEMM_DENSE_RATIO >= M */
+#define SPGEMM_DENSE_RATIO  (8)
+#define SPGEMM_EMPTY        ((size_t) -1)
+
+#define SPGEMM_SYMBOLIC     (1)  /* compute the pattern of C only */
+#define SPGEMM_NUMERIC      (2)  /* compute values on the pattern of C */
+
+static int spgemm(const double alpha, const gsl_spmatrix *A,
+                  const gsl_spmatrix *B, gsl_spmatrix *C, const int mode);
+static int spgemm_check(const gsl_spmatrix *A, const gsl_spmatrix *B,
+                        const gsl_spmatrix *C);
+static int spgemm_column(spgemm_acc *acc, const int pass,
+                         const gsl_spmatrix *S, const gsl_spmatrix *W,
+                         const size_t j, const size_t flops,
+                         const double alpha, size_t *Ci, double *Cd,
+                         size_t *nj);
+static int acc_prepare(spgemm_acc *acc, const size_t n);
+static size_t acc_slot(const spgemm_acc *acc, const size_t i);
+static void acc_free(spgemm_acc *acc);
+
 /*
 gsl_spblas_dgemm()
   Multiply two sparse matrices
@@ -36,92 +80,80 @@ Inputs: alpha - scalar factor
 Return: success or error
 
 Notes:
-1) based on CSparse routine cs_multiply
+1) The product is formed in two phases with Gustavson's algorithm:
+a symbolic phase counts the non-zeros of each column of C, so that
+C is allocated once and each column has a known place, and a numeric
+phase computes the columns independently of each other. Both phases
+split the columns between threads by their number of multiply-adds.
+
+2) The elements within each column (CCS) or row (CRS) of C are
+stored in order of first appearance, not sorted
 */
 
 int
 gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
                  const gsl_spmatrix *B, gsl_spmatrix *C)
 {
-  if (A->size2 != B->size1 || A->size1 != C->size1 || B->size2 != C->size2)
-    {
-      GSL_ERROR("matrix dimensions do not match", GSL_EBADLEN);
-    }
-  else if (A->sptype != B->sptype || A->sptype != C->sptype)
-    {
-      GSL_ERROR("matrix storage formats do not match", GSL_EINVAL);
-    }
-  else if (!GSL_SPMATRIX_ISCCS(A))
-    {
-      GSL_ERROR("compressed column format required", GSL_EINVAL);
-    }
-  else
-    {
-      int status = GSL_SUCCESS;
-      const size_t M = A->size1;
-      const size_t N = B->size2;
-      size_t *Bi = B->i;
-      size_t *Bp = B->p;
-      double *Bd = B->data;
-      size_t *w = (size_t *) A->work; /* workspace of length M */
-      double *x = (double *) C->work; /* workspace of length M */
-      size_t *Cp, *Ci;
-      double *Cd;
-      size_t j, p;
-      size_t nz = 0;
-
-      if (C->nzmax < A->nz + B->nz)
-        {
-          status = gsl_spmatrix_realloc(A->nz + B->nz, C);
-          if (status)
-            {
-              GSL_ERROR("unable to realloc matrix C", status);
-            }
-        }
+  int status = spgemm_check(A, B, C);
 
-      /* initialize workspace to 0 */
-      for (j = 0; j < M; ++j)
-        w[j] = 0;
+  if (status)
+    return status;
 
-      Cp = C->p;
-      Ci = C->i;
-      Cd = C->data;
+  return spgemm(alpha, A, B, C, SPGEMM_SYMBOLIC | SPGEMM_NUMERIC);
+} /* gsl_spblas_dgemm() */
 
-      for (j = 0; j < N; ++j)
-        {
-          if (nz + M > C->nzmax)
-            {
-              status = gsl_spmatrix_realloc(2 * C->nzmax + M, C);
-              if (status)
-                {
-                  GSL_ERROR("unable to realloc matrix C", status);
-                }
+/*
+gsl_spblas_dgemm_symbolic()
+  Compute the non-zero pattern of the product C = A B, without
+computing its values, which are set to zero
 
-              /* these pointers could have changed due to reallocation */
-              Ci = C->i;
-              Cd = C->data;
-            }
+Inputs: A - sparse matrix
+        B - sparse matrix
+        C - (output) pattern of A * B
 
-          Cp[j] = nz; /* column j of C starts here */
+Return: success or error
+*/
 
-          for (p = Bp[j]; p < Bp[j + 1]; ++p)
-            {
-              nz = gsl_spblas_scatter(A, Bi[p], Bd[p], w, x, j + 1, C, nz);
-            }
+int
+gsl_spblas_dgemm_symbolic(const gsl_spmatrix *A, const gsl_spmatrix *B,
+                          gsl_spmatrix *C)
+{
+  int status = spgemm_check(A, B, C);
 
-          for (p = Cp[j]; p < nz; ++p)
-            Cd[p] = x[Ci[p]];
-        }
+  if (status)
+    return status;
 
-      Cp[N] = nz;
-      C->nz = nz;
+  return spgemm(1.0, A, B, C, SPGEMM_SYMBOLIC);
+} /* gsl_spblas_dgemm_symbolic() */
 
-      /* scale by alpha */
-      gsl_spmatrix_scale(C, alpha);
+/*
+gsl_spblas_dgemm_numeric()
+  Compute the values of the product C = alpha A B on the pattern of C
+previously computed by gsl_spblas_dgemm_symbolic. A and B may have
+different values than in the symbolic phase, but must have the same
+patterns.
 
-      return status;
-    }
-} /* gsl_spblas_dgemm() */
+Inputs: alpha - scalar factor
+        A     - sparse matrix
+        B     - sparse matrix
+        C     - (input/output) on input, pattern of A * B;
+                on output, C = alpha * A * B
+
+Return: success or error; GSL_EINVAL if a non-zero of A * B is
+not in the pattern of C
+*/
+
+int
+gsl_spblas_dgemm_numeric(const double alpha, const gsl_spmatrix *A,
+                         const gsl_spmatrix *B, gsl_spmatrix *C)
+{
+  int status = spgemm_check(A, B, C);
+
+  if (status)
+    return status;
+
+  return spgemm(alpha, A, B, C, SPGEMM_NUMERIC);
+} /* gsl_spblas_dgemm_numeric() */
 
 /*
 gsl_spblas_scatter()
@@ -148,7 +180,10 @@ Notes:
 matrices together. Column j of C is stored contiguously as per CCS but not
 necessarily in order - ie: the row indices C->i may not be in ascending order.
 
-2) based on CSparse routine cs_scatter
+2) For a matrix in compressed row format, the same operation accumulates
+row j of A, with w and x indexed by column
+
+3) based on CSparse routine cs_scatter
 */
 
 size_t
@@ -180,3 +215,394 @@ gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j, const double alpha,
 
   return (nz) ;
 } /* gsl_spblas_scatter() */
+
+static int
+spgemm_check(const gsl_spmatrix *A, const gsl_spmatrix *B,
+             const gsl_spmatrix *C)
+{
+  if (A->size2 != B->size1 || A->size1 != C->size1 || B->size2 != C->size2)
+    {
+      GSL_ERROR("matrix dimensions do not match", GSL_EBADLEN);
+    }
+  else if (A->sptype != B->sptype || A->sptype != C->sptype)
+    {
+      GSL_ERROR("matrix storage formats do not match", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(A) && !GSL_SPMATRIX_ISCRS(A))
+    {
+      GSL_ERROR("compressed format required", GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+} /* spgemm_check() */
+
+/*
+spgemm()
+  Driver for the symbolic and numeric phases
+
+Inputs: alpha - scalar factor
+        A     - sparse matrix
+        B     - sparse matrix
+        C     - (input/output) product matrix
+        mode  - SPGEMM_SYMBOLIC, SPGEMM_NUMERIC or both
+
+Notes:
+1) for CCS, column j of C is a combination of columns of A
+weighted by B(:,j); for CRS, row j of C is a combination of
+rows of B weighted by A(j,:). Both are handled as "columns" below.
+*/
+
+static int
+spgemm(const double alpha, const gsl_spmatrix *A, const gsl_spmatrix *B,
+       gsl_spmatrix *C, const int mode)
+{
+  const int ccs = GSL_SPMATRIX_ISCCS(A);
+  const gsl_spmatrix *S = ccs ? A : B; /* matrix being scattered */
+  const gsl_spmatrix *W = ccs ? B : A; /* matrix of weights */
+  const size_t M = ccs ? A->size1 : B->size2; /* inner dimension */
+  const size_t N = ccs ? B->size2 : A->size1; /* outer dimension */
+  size_t *flops; /* flops[j] = multiply-adds in columns 0..j-1 of C */
+  size_t *Cp = C->p;
+  int pass;
+  int status = GSL_SUCCESS;
+  size_t j, p;
+
+  flops = gsl_malloc((N + 1) * sizeof(size_t));
+  if (!flops)
+    {
+      GSL_ERROR("failed to allocate space for flop counts", GSL_ENOMEM);
+    }
+
+  for (j = 0; j < N; ++j)
+    {
+      size_t f = 0;
+
+      for (p = W->p[j]; p < W->p[j + 1]; ++p)
+        {
+          size_t k = W->i[p];
+          f += S->p[k + 1] - S->p[k];
+        }
+
+      flops[j] = f;
+    }
+
+  gsl_spmatrix_cumsum(N, flops);
+
+  /*
+   * pass 0 counts the non-zeros of each column; pass 1 stores the
+   * indices (and values, unless only the pattern is wanted); pass 2
+   * computes values on an existing pattern
+   */
+  for (pass = 0; pass < 3 && status == GSL_SUCCESS; ++pass)
+    {
+      if ((pass < 2 && !(mode & SPGEMM_SYMBOLIC)) ||
+          (pass == 2 && mode != SPGEMM_NUMERIC))
+        continue;
+
+      if (pass == 1)
+        {
+          /* Cp[j] now holds the number of non-zeros in column j */
+          gsl_spmatrix_cumsum(N, Cp);
+
+          if (C->nzmax < Cp[N])
+            {
+              status = gsl_spmatrix_realloc(Cp[N], C);
+              if (status)
+                {
+                  gsl_free(flops);
+                  GSL_ERROR("unable to realloc matrix C", status);
+                }
+            }
+
+          C->nz = Cp[N];
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel if (flops[N] >= SPBLAS_PARALLEL_NNZ)
+#endif
+      {
+        spgemm_acc acc;
+        size_t t, nparts, start, end, k;
+        int s = GSL_SUCCESS;
+
+        acc.M = M;
+        acc.mark = NULL;
+        acc.pos = NULL;
+        acc.stamp = 0;
+        acc.hkey = NULL;
+        acc.hpos = NULL;
+        acc.hmax = 0;
+        acc.hsize = 0;
+
+        partition_thread(&t, &nparts);
+        start = partition_start(flops, N, t, nparts);
+        end = partition_start(flops, N, t + 1, nparts);
+
+        for (k = start; k < end && s == GSL_SUCCESS; ++k)
+          {
+            const size_t fk = flops[k + 1] - flops[k];
+
+            if (pass == 0)
+              {
+                s = spgemm_column(&acc, pass, S, W, k, fk, alpha,
+                                  NULL, NULL, &Cp[k]);
+              }
+            else
+              {
+                size_t nk = Cp[k + 1] - Cp[k];
+                double *Cd = (mode & SPGEMM_NUMERIC) ? C->data + Cp[k] : NULL;
+
+                s = spgemm_column(&acc, pass, S, W, k, fk, alpha,
+                                  C->i + Cp[k], Cd, &nk);
+              }
+          }
+
+        acc_free(&acc);
+
+        if (s != GSL_SUCCESS)
+          {
+#ifdef _OPENMP
+#pragma omp critical (spgemm_status)
+#endif
+            status = s;
+          }
+      }
+    }
+
+  gsl_free(flops);
+
+  if (status == GSL_ENOMEM)
+    {
+      GSL_ERROR("failed to allocate space for accumulator", status);
+    }
+  else if (status)
+    {
+      GSL_ERROR("pattern of C does not contain A * B", status);
+    }
+
+  if (mode == SPGEMM_SYMBOLIC)
+    {
+      for (p = 0; p < C->nz; ++p)
+        C->data[p] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+} /* spgemm() */
+
+/*
+spgemm_column()
+  Process column j of C = alpha S W
+
+Inputs: acc   - accumulator of the calling thread
+        pass  - 0: count the non-zeros of the column into *nj
+                1: store the indices into Ci, and values into Cd
+                   unless Cd is NULL
+                2: compute values into Cd for the *nj indices in Ci
+        S     - matrix being scattered
+        W     - matrix of weights
+        j     - column index
+        flops - number of multiply-adds in column j
+        alpha - scalar factor
+        Ci    - indices of column j of C
+        Cd    - values of column j of C
+        nj    - (input/output) number of non-zeros in column j
+
+Return: success, GSL_ENOMEM, or GSL_EINVAL if pass 2 finds an index
+which is not in Ci
+*/
+
+static int
+spgemm_column(spgemm_acc *acc, const int pass, const gsl_spmatrix *S,
+              const gsl_spmatrix *W, const size_t j, const size_t flops,
+              const double alpha, size_t *Ci, double *Cd, size_t *nj)
+{
+  const int dense = (flops * SPGEMM_DENSE_RATIO >= acc->M);
+  const size_t *Si = S->i;
+  const size_t *Sp = S->p;
+  const double *Sd = S->data;
+  size_t n = 0;
+  size_t p, q, h;
+
+  if (flops == 0)
+    {
+      if (pass == 0)
+        *nj = 0;
+      else if (pass == 2)
+        {
+          for (n = 0; n < *nj; ++n)
+            Cd[n] = 0.0;
+        }
+
+      return GSL_SUCCESS;
+    }
+
+  /* a column has at most flops distinct indices */
+  if (acc_prepare(acc, dense ? 0 : ((pass == 2) ? GSL_MAX(flops, *nj) : flops)))
+    return GSL_ENOMEM;
+
+  if (pass == 2)
+    {
+      /* enter the existing pattern into the accumulator */
+      for (n = 0; n < *nj; ++n)
+        {
+          size_t i = Ci[n];
+
+          if (dense)
+            {
+              acc->mark[i] = acc->stamp;
+              acc->pos[i] = n;
+            }
+          else
+            {
+              h = acc_slot(acc, i);
+
+              acc->hkey[h] = i;
+              acc->hpos[h] = n;
+            }
+
+          Cd[n] = 0.0;
+        }
+    }
+
+  for (p = W->p[j]; p < W->p[j + 1]; ++p)
+    {
+      const size_t k = W->i[p];
+      const double a = alpha * W->data[p];
+
+      for (q = Sp[k]; q < Sp[k + 1]; ++q)
+        {
+          const size_t i = Si[q];
+          size_t *slot; /* position of i in the column, if known */
+
+          if (dense)
+            {
+              slot = (acc->mark[i] == acc->stamp) ? &acc->pos[i] : NULL;
+              if (!slot && pass != 2)
+                {
+                  acc->mark[i] = acc->stamp;
+                  acc->pos[i] = n;
+                }
+            }
+          else
+            {
+              h = acc_slot(acc, i);
+
+              slot = (acc->hkey[h] == i) ? &acc->hpos[h] : NULL;
+              if (!slot && pass != 2)
+                {
+                  acc->hkey[h] = i;
+                  acc->hpos[h] = n;
+                }
+            }
+
+          if (slot)
+            {
+              if (Cd)
+                Cd[*slot] += a * Sd[q];
+            }
+          else if (pass == 2)
+            {
+              return GSL_EINVAL;
+            }
+          else
+            {
+              /* new non-zero in column j */
+              if (pass == 1)
+                {
+                  Ci[n] = i;
+                  if (Cd)
+                    Cd[n] = a * Sd[q];
+                }
+
+              ++n;
+            }
+        }
+    }
+
+  if (pass == 0)
+    *nj = n;
+
+  return GSL_SUCCESS;
+} /* spgemm_column() */
+
+/*
+acc_prepare()
+  Prepare the accumulator for a new column: the dense accumulator is
+used if n = 0, otherwise a hash table with at least 2n slots
+*/
+
+static int
+acc_prepare(spgemm_acc *acc, const size_t n)
+{
+  if (n == 0)
+    {
+      if (!acc->mark)
+        {
+          acc->mark = gsl_calloc(acc->M, sizeof(size_t));
+          acc->pos = gsl_malloc(acc->M * sizeof(size_t));
+          if (!acc->mark || !acc->pos)
+            return GSL_ENOMEM;
+        }
+
+      /* a new stamp marks every index as unseen */
+      ++acc->stamp;
+    }
+  else
+    {
+      size_t h;
+
+      acc->hsize = 1;
+      while (acc->hsize < 2 * n)
+        acc->hsize <<= 1;
+
+      if (acc->hsize > acc->hmax)
+        {
+          gsl_free(acc->hkey);
+          gsl_free(acc->hpos);
+
+          acc->hkey = gsl_malloc(acc->hsize * sizeof(size_t));
+          acc->hpos = gsl_malloc(acc->hsize * sizeof(size_t));
+          acc->hmax = acc->hsize;
+          if (!acc->hkey || !acc->hpos)
+            {
+              acc->hmax = 0;
+              return GSL_ENOMEM;
+            }
+        }
+
+      for (h = 0; h < acc->hsize; ++h)
+        acc->hkey[h] = SPGEMM_EMPTY;
+    }
+
+  return GSL_SUCCESS;
+} /* acc_prepare() */
+
+/*
+acc_slot()
+  Return the hash table slot holding index i, or the empty slot
+where it should be inserted
+*/
+
+static size_t
+acc_slot(const spgemm_acc *acc, const size_t i)
+{
+  const size_t mask = acc->hsize - 1;
+  size_t h = i * 2654435761UL;
+
+  /* fold the well mixed high bits into the low bits used as index */
+  h = (h ^ (h >> 16)) & mask;
+
+  while (acc->hkey[h] != SPGEMM_EMPTY && acc->hkey[h] != i)
+    h = (h + 1) & mask;
+
+  return h;
+} /* acc_slot() */
+
+static void
+acc_free(spgemm_acc *acc)
+{
+  gsl_free(acc->mark);
+  gsl_free(acc->pos);
+  gsl_free(acc->hkey);
+  gsl_free(acc->hpos);
+} /* acc_free() */
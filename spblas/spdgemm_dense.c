@@ -0,0 +1,171 @@
+/* spblas/spdgemm_dense.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+
+#include "partition.c"
+
+static void row_axpy(const double a, const double *x, double *y,
+                     const size_t n);
+
+/*
+gsl_spblas_dgemm_dense()
+  Multiply a sparse matrix and a dense matrix
+
+C = alpha*op(A)*B + beta*C
+
+Inputs: TransA - operation op(A) to be performed
+        alpha  - scalar factor
+        A      - sparse matrix
+        B      - dense matrix
+        beta   - scalar factor
+        C      - (input/output) dense matrix
+
+Return: success or error
+
+Notes:
+1) Each non-zero element of A contributes a multiple of a whole row of
+B to a row of C, so both dense matrices are accessed by contiguous rows
+
+2) When rows of op(A) are stored contiguously (CRS with
+TransA = CblasNoTrans or CCS with TransA = CblasTrans), different rows of
+C are computed by different threads
+*/
+
+int
+gsl_spblas_dgemm_dense(const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                       const gsl_spmatrix *A, const gsl_matrix *B,
+                       const double beta, gsl_matrix *C)
+{
+  const size_t M = (TransA == CblasNoTrans) ? A->size1 : A->size2;
+  const size_t K = (TransA == CblasNoTrans) ? A->size2 : A->size1;
+
+  if (K != B->size1)
+    {
+      GSL_ERROR("invalid number of rows in B", GSL_EBADLEN);
+    }
+  else if (M != C->size1 || B->size2 != C->size2)
+    {
+      GSL_ERROR("invalid dimensions of C", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = C->size2;
+      const size_t tdaB = B->tda;
+      const size_t tdaC = C->tda;
+      const double *Ad = A->data;
+      const double *Bd = B->data;
+      double *Cd = C->data;
+
+      /* form C := beta*C */
+      if (beta == 0.0)
+        gsl_matrix_set_zero(C);
+      else if (beta != 1.0)
+        gsl_matrix_scale(C, beta);
+
+      if (alpha == 0.0 || N == 0)
+        return GSL_SUCCESS;
+
+      if ((GSL_SPMATRIX_ISCRS(A) && TransA == CblasNoTrans) ||
+          (GSL_SPMATRIX_ISCCS(A) && TransA == CblasTrans))
+        {
+          /* rows of op(A) are contiguous: C(k,:) += alpha * A(k,:) B */
+          const size_t *Ap = A->p;
+          const size_t *Ai = A->i;
+
+#ifdef _OPENMP
+#pragma omp parallel if (A->nz >= SPBLAS_PARALLEL_NNZ)
+#endif
+          {
+            size_t t, nparts, start, end, k, p;
+
+            partition_thread(&t, &nparts);
+            start = partition_start(Ap, M, t, nparts);
+            end = partition_start(Ap, M, t + 1, nparts);
+
+            for (k = start; k < end; ++k)
+              {
+                for (p = Ap[k]; p < Ap[k + 1]; ++p)
+                  {
+                    row_axpy(alpha * Ad[p], Bd + Ai[p] * tdaB,
+                             Cd + k * tdaC, N);
+                  }
+              }
+          }
+        }
+      else if (GSL_SPMATRIX_ISCCS(A) || GSL_SPMATRIX_ISCRS(A))
+        {
+          /* columns of op(A) are contiguous: C(:,k) A(k,:) updates */
+          const size_t *Ap = A->p;
+          const size_t *Ai = A->i;
+          size_t k, p;
+
+          for (k = 0; k < K; ++k)
+            {
+              const double *Bk = Bd + k * tdaB;
+
+              for (p = Ap[k]; p < Ap[k + 1]; ++p)
+                row_axpy(alpha * Ad[p], Bk, Cd + Ai[p] * tdaC, N);
+            }
+        }
+      else if (GSL_SPMATRIX_ISTRIPLET(A))
+        {
+          const size_t *Ai, *Aj;
+          size_t p;
+
+          if (TransA == CblasNoTrans)
+            {
+              Ai = A->i;
+              Aj = A->p;
+            }
+          else
+            {
+              Ai = A->p;
+              Aj = A->i;
+            }
+
+          for (p = 0; p < A->nz; ++p)
+            row_axpy(alpha * Ad[p], Bd + Aj[p] * tdaB, Cd + Ai[p] * tdaC, N);
+        }
+      else
+        {
+          GSL_ERROR("unsupported matrix type", GSL_EINVAL);
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dgemm_dense() */
+
+/* y := a*x + y for contiguous rows of length n */
+
+static void
+row_axpy(const double a, const double *x, double *y, const size_t n)
+{
+  size_t j;
+
+  for (j = 0; j < n; ++j)
+    y[j] += a * x[j];
+} /* row_axpy() */
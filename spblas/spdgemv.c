@@ -28,6 +28,21 @@
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_blas.h>
 
+#include "partition.c"
+
+static void spmv_gather(const double alpha, const gsl_spmatrix *A,
+                        const size_t n, const double *X, const size_t incX,
+                        double *Y, const size_t incY);
+static void spmv_scatter(const double alpha, const gsl_spmatrix *A,
+                         const size_t n, const double *X, const size_t incX,
+                         double *Y, const size_t incY);
+static void spmv_sell(const double alpha, const gsl_spmatrix *A,
+                      const double *X, const size_t incX,
+                      double *Y, const size_t incY);
+static void spmv_sell_trans(const double alpha, const gsl_spmatrix *A,
+                            const double *X, const size_t incX,
+                            double *Y, const size_t incY);
+
 /*
 gsl_spblas_dgemv()
   Multiply a sparse matrix and a vector
@@ -66,7 +81,7 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
       size_t lenX, lenY;
       double *X, *Y;
       double *Ad;
-      size_t *Ap, *Ai, *Aj;
+      size_t *Ai, *Aj;
 
       if (TransA == CblasNoTrans)
         {
@@ -107,35 +122,28 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
         return GSL_SUCCESS;
 
       /* form y := alpha*A*x + y */
-      Ap = A->p;
       Ad = A->data;
       X = x->data;
       incX = x->stride;
 
-      if (GSL_SPMATRIX_ISCCS(A))
+      if (GSL_SPMATRIX_ISCCS(A) || GSL_SPMATRIX_ISCRS(A))
+        {
+          /*
+           * A y = A x product with CRS, or A^T x with CCS, reads one
+           * row of op(A) at a time and produces one element of y;
+           * the other two cases scatter each column of op(A) into y
+           */
+          if (GSL_SPMATRIX_ISCRS(A) == (TransA == CblasNoTrans))
+            spmv_gather(alpha, A, lenY, X, incX, Y, incY);
+          else
+            spmv_scatter(alpha, A, lenX, X, incX, Y, incY);
+        }
+      else if (GSL_SPMATRIX_ISSELL(A))
         {
-          Ai = A->i;
-
           if (TransA == CblasNoTrans)
-            {
-              for (j = 0; j < lenX; ++j)
-                {
-                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
-                    {
-                      Y[Ai[p] * incY] += alpha * Ad[p] * X[j * incX];
-                    }
-                }
-            }
+            spmv_sell(alpha, A, X, incX, Y, incY);
           else
-            {
-              for (j = 0; j < lenY; ++j)
-                {
-                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
-                    {
-                      Y[j * incY] += alpha * Ad[p] * X[Ai[p] * incX];
-                    }
-                }
-            }
+            spmv_sell_trans(alpha, A, X, incX, Y, incY);
         }
       else if (GSL_SPMATRIX_ISTRIPLET(A))
         {
@@ -163,3 +171,185 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
       return GSL_SUCCESS;
     }
 } /* gsl_spblas_dgemv() */
+
+/*
+spmv_gather()
+  Compute y_k += alpha * sum_p A->data[p] x[A->i[p]] for each outer
+index k of a compressed matrix. The outer indices are split between
+threads so that each thread handles about the same number of non-zero
+elements; every element of y is written by exactly one thread.
+
+Inputs: alpha - scalar factor
+        A     - compressed matrix
+        n     - outer dimension of A (length of y)
+        X     - x vector data
+        incX  - x stride
+        Y     - y vector data
+        incY  - y stride
+*/
+
+static void
+spmv_gather(const double alpha, const gsl_spmatrix *A, const size_t n,
+            const double *X, const size_t incX, double *Y,
+            const size_t incY)
+{
+  const size_t *Ap = A->p;
+  const size_t *Ai = A->i;
+  const double *Ad = A->data;
+
+#ifdef _OPENMP
+#pragma omp parallel if (A->nz >= SPBLAS_PARALLEL_NNZ)
+#endif
+  {
+    size_t t, nparts, start, end, k, p;
+
+    partition_thread(&t, &nparts);
+    start = partition_start(Ap, n, t, nparts);
+    end = partition_start(Ap, n, t + 1, nparts);
+
+    for (k = start; k < end; ++k)
+      {
+        double tmp = 0.0;
+
+        for (p = Ap[k]; p < Ap[k + 1]; ++p)
+          tmp += Ad[p] * X[Ai[p] * incX];
+
+        Y[k * incY] += alpha * tmp;
+      }
+  }
+} /* spmv_gather() */
+
+/*
+spmv_scatter()
+  Compute y[A->i[p]] += alpha * A->data[p] x_k for each outer index k
+of a compressed matrix. Different outer indices update the same
+elements of y, so this runs on a single thread.
+*/
+
+static void
+spmv_scatter(const double alpha, const gsl_spmatrix *A, const size_t n,
+             const double *X, const size_t incX, double *Y,
+             const size_t incY)
+{
+  const size_t *Ap = A->p;
+  const size_t *Ai = A->i;
+  const double *Ad = A->data;
+  size_t k, p;
+
+  for (k = 0; k < n; ++k)
+    {
+      const double axk = alpha * X[k * incX];
+
+      for (p = Ap[k]; p < Ap[k + 1]; ++p)
+        Y[Ai[p] * incY] += Ad[p] * axk;
+    }
+} /* spmv_scatter() */
+
+/*
+spmv_sell()
+  Compute y += alpha A x for a matrix in SELL-C-sigma format. The C
+rows of a slice are accumulated together: each step of the inner
+loop reads C consecutive matrix elements and column indices, which a
+vectorizing compiler turns into vector loads and gathers. Slices are
+split between threads by the number of stored elements.
+*/
+
+static void
+spmv_sell(const double alpha, const gsl_spmatrix *A, const double *X,
+          const size_t incX, double *Y, const size_t incY)
+{
+  const size_t C = A->slice;
+  const size_t M = A->size1;
+  const size_t nslices = gsl_spmatrix_sell_nslices(A);
+  const size_t *Ap = A->p;
+  const size_t *Ai = A->i;
+  const double *Ad = A->data;
+
+#ifdef _OPENMP
+#pragma omp parallel if (A->nz >= SPBLAS_PARALLEL_NNZ)
+#endif
+  {
+    double tmp[GSL_SPMATRIX_SELL_CMAX];
+    size_t t, nparts, start, end, k, l, r;
+
+    partition_thread(&t, &nparts);
+    start = partition_start(Ap, nslices, t, nparts);
+    end = partition_start(Ap, nslices, t + 1, nparts);
+
+    for (k = start; k < end; ++k)
+      {
+        const size_t s0 = k * C;
+        const size_t ns = GSL_MIN(C, M - s0);
+        const size_t width = (Ap[k + 1] - Ap[k]) / C;
+        const size_t *ci = Ai + Ap[k];
+        const double *cd = Ad + Ap[k];
+
+        for (r = 0; r < C; ++r)
+          tmp[r] = 0.0;
+
+        if (incX == 1)
+          {
+            for (l = 0; l < width; ++l)
+              {
+                for (r = 0; r < C; ++r)
+                  tmp[r] += cd[r] * X[ci[r]];
+
+                ci += C;
+                cd += C;
+              }
+          }
+        else
+          {
+            for (l = 0; l < width; ++l)
+              {
+                for (r = 0; r < C; ++r)
+                  tmp[r] += cd[r] * X[ci[r] * incX];
+
+                ci += C;
+                cd += C;
+              }
+          }
+
+        for (r = 0; r < ns; ++r)
+          Y[A->perm[s0 + r] * incY] += alpha * tmp[r];
+      }
+  }
+} /* spmv_sell() */
+
+/*
+spmv_sell_trans()
+  Compute y += alpha A^T x for a matrix in SELL-C-sigma format. The
+padding elements are zero and so do not change y.
+*/
+
+static void
+spmv_sell_trans(const double alpha, const gsl_spmatrix *A, const double *X,
+                const size_t incX, double *Y, const size_t incY)
+{
+  const size_t C = A->slice;
+  const size_t M = A->size1;
+  const size_t nslices = gsl_spmatrix_sell_nslices(A);
+  double ax[GSL_SPMATRIX_SELL_CMAX];
+  size_t k, l, r;
+
+  for (k = 0; k < nslices; ++k)
+    {
+      const size_t s0 = k * C;
+      const size_t ns = GSL_MIN(C, M - s0);
+      const size_t width = (A->p[k + 1] - A->p[k]) / C;
+      const size_t *ci = A->i + A->p[k];
+      const double *cd = A->data + A->p[k];
+
+      for (r = 0; r < ns; ++r)
+        ax[r] = alpha * X[A->perm[s0 + r] * incX];
+
+      for (l = 0; l < width; ++l)
+        {
+          for (r = 0; r < ns; ++r)
+            Y[ci[r] * incY] += cd[r] * ax[r];
+
+          ci += C;
+          cd += C;
+        }
+    }
+} /* spmv_sell_trans() */
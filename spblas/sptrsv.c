@@ -0,0 +1,451 @@
+/* spblas/sptrsv.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * Sparse triangular solve with level scheduling
+ *
+ * Row i of a lower triangular system depends on the rows j < i with
+ * L(i,j) != 0. Assigning each row the level
+ *
+ *   level(i) = 1 + max { level(j) : L(i,j) != 0, j != i }
+ *
+ * (0 for rows with no off-diagonal elements), all rows of one level
+ * only depend on rows of lower levels and can be solved concurrently.
+ * The analysis computes the levels and stores the strictly triangular
+ * part of op(A) row by row in level order, so that the solve streams
+ * through contiguous arrays; upper triangular systems are handled the
+ * same way with the order of the rows reversed.
+ *
+ * [1] E. Anderson and Y. Saad, Solving sparse triangular linear systems
+ *     on parallel computers, Int. J. High Speed Computing 1(1), 1989.
+ */
+
+/*
+ * minimum number of off-diagonal elements, and average number of rows
+ * per level, for a threaded solve
+ */
+#define SPBLAS_TRSV_NNZ         (32768)
+#define SPBLAS_TRSV_WIDTH       (64)
+
+static void trsv_entry(const gsl_spmatrix *A, const int trans,
+                       const size_t outer, const size_t n,
+                       size_t *r, size_t *c);
+
+/*
+gsl_spblas_trsv_alloc()
+  Allocate a workspace for solving triangular systems of size n
+
+Inputs: n - size of system
+
+Return: pointer to workspace
+*/
+
+gsl_spblas_trsv_workspace *
+gsl_spblas_trsv_alloc(const size_t n)
+{
+  gsl_spblas_trsv_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = gsl_calloc(1, sizeof(gsl_spblas_trsv_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate trsv workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->level_ptr = gsl_malloc((n + 1) * sizeof(size_t));
+  w->row = gsl_malloc(n * sizeof(size_t));
+  w->tp = gsl_malloc((n + 1) * sizeof(size_t));
+  w->dinv = gsl_malloc(n * sizeof(double));
+  if (!w->level_ptr || !w->row || !w->tp || !w->dinv)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate trsv arrays", GSL_ENOMEM);
+    }
+
+  return w;
+} /* gsl_spblas_trsv_alloc() */
+
+void
+gsl_spblas_trsv_free(gsl_spblas_trsv_workspace *w)
+{
+  if (w->level_ptr)
+    gsl_free(w->level_ptr);
+
+  if (w->row)
+    gsl_free(w->row);
+
+  if (w->tp)
+    gsl_free(w->tp);
+
+  if (w->ti)
+    gsl_free(w->ti);
+
+  if (w->td)
+    gsl_free(w->td);
+
+  if (w->dinv)
+    gsl_free(w->dinv);
+
+  gsl_free(w);
+} /* gsl_spblas_trsv_free() */
+
+/*
+gsl_spblas_dtrsv_analysis()
+  Compute the level schedule of a sparse triangular matrix, for
+subsequent solves with gsl_spblas_dtrsv()
+
+Inputs: Uplo   - CblasLower or CblasUpper: triangle of A to use
+        TransA - CblasNoTrans or CblasTrans: solve with A or A^T
+        Diag   - CblasNonUnit or CblasUnit: use the diagonal of A, or
+                 assume a unit diagonal
+        A      - square sparse matrix in triplet, compressed column or
+                 compressed row format; elements outside the triangle
+                 Uplo are ignored
+        w      - workspace
+
+Return: success/error
+
+Notes:
+1) The values of A are copied into the workspace, so the analysis
+must be repeated when A changes; the workspace may then be reused
+without further allocation when the number of elements does not grow
+
+2) Returns GSL_ESING if Diag is CblasNonUnit and a diagonal element is
+zero or missing
+*/
+
+int
+gsl_spblas_dtrsv_analysis(const CBLAS_UPLO_t Uplo,
+                          const CBLAS_TRANSPOSE_t TransA,
+                          const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                          gsl_spblas_trsv_workspace *w)
+{
+  const size_t N = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != N)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (GSL_SPMATRIX_ISSELL(A))
+    {
+      GSL_ERROR("matrix must be in triplet or compressed format", GSL_EINVAL);
+    }
+  else
+    {
+      /* op(A) is lower triangular for (Lower, NoTrans) and (Upper, Trans) */
+      const int lower = (Uplo == CblasLower) == (TransA == CblasNoTrans);
+      const int trans = (TransA == CblasTrans);
+      const size_t nouter = GSL_SPMATRIX_ISCRS(A) ? A->size1 : A->size2;
+      size_t *rp, *ri, *level, *cnt;
+      double *rd;
+      size_t i, k, n, q, nz = 0, nlevels = 0;
+
+      /* rows of the strict triangle of op(A), in natural order */
+      rp = gsl_calloc(N + 1, sizeof(size_t));
+      level = gsl_malloc(2 * (N + 1) * sizeof(size_t));
+      if (!rp || !level)
+        {
+          gsl_free(rp);
+          gsl_free(level);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      cnt = level + N + 1;
+
+      for (i = 0; i < N; ++i)
+        w->dinv[i] = 0.0;
+
+      for (k = 0; k < (GSL_SPMATRIX_ISTRIPLET(A) ? 1 : nouter); ++k)
+        {
+          const size_t start = GSL_SPMATRIX_ISTRIPLET(A) ? 0 : A->p[k];
+          const size_t end = GSL_SPMATRIX_ISTRIPLET(A) ? A->nz : A->p[k + 1];
+
+          for (n = start; n < end; ++n)
+            {
+              size_t r, c;
+
+              trsv_entry(A, trans, k, n, &r, &c);
+
+              if (r == c)
+                w->dinv[r] += A->data[n];
+              else if ((c < r) == lower)
+                rp[r + 1]++;
+            }
+        }
+
+      for (i = 0; i < N; ++i)
+        rp[i + 1] += rp[i];
+
+      nz = rp[N];
+
+      ri = gsl_malloc((nz + 1) * sizeof(size_t));
+      rd = gsl_malloc((nz + 1) * sizeof(double));
+      if (!ri || !rd)
+        {
+          gsl_free(rp);
+          gsl_free(level);
+          gsl_free(ri);
+          gsl_free(rd);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < N; ++i)
+        cnt[i] = rp[i];
+
+      for (k = 0; k < (GSL_SPMATRIX_ISTRIPLET(A) ? 1 : nouter); ++k)
+        {
+          const size_t start = GSL_SPMATRIX_ISTRIPLET(A) ? 0 : A->p[k];
+          const size_t end = GSL_SPMATRIX_ISTRIPLET(A) ? A->nz : A->p[k + 1];
+
+          for (n = start; n < end; ++n)
+            {
+              size_t r, c;
+
+              trsv_entry(A, trans, k, n, &r, &c);
+
+              if (r != c && (c < r) == lower)
+                {
+                  q = cnt[r]++;
+                  ri[q] = c;
+                  rd[q] = A->data[n];
+                }
+            }
+        }
+
+      /* levels, visiting the rows in dependency order */
+      for (k = 0; k < N; ++k)
+        {
+          const size_t r = lower ? k : N - 1 - k;
+          size_t lev = 0;
+
+          for (q = rp[r]; q < rp[r + 1]; ++q)
+            lev = GSL_MAX(lev, level[ri[q]] + 1);
+
+          level[r] = lev;
+          nlevels = GSL_MAX(nlevels, lev + 1);
+        }
+
+      /* diagonal */
+      for (i = 0; i < N; ++i)
+        {
+          if (Diag == CblasUnit)
+            {
+              w->dinv[i] = 1.0;
+            }
+          else if (w->dinv[i] == 0.0)
+            {
+              gsl_free(rp);
+              gsl_free(level);
+              gsl_free(ri);
+              gsl_free(rd);
+              GSL_ERROR("matrix is singular", GSL_ESING);
+            }
+          else
+            {
+              w->dinv[i] = 1.0 / w->dinv[i];
+            }
+        }
+
+      /* sort rows by level */
+      for (k = 0; k <= nlevels; ++k)
+        w->level_ptr[k] = 0;
+
+      for (i = 0; i < N; ++i)
+        w->level_ptr[level[i] + 1]++;
+
+      for (k = 0; k < nlevels; ++k)
+        w->level_ptr[k + 1] += w->level_ptr[k];
+
+      for (k = 0; k < nlevels; ++k)
+        cnt[k] = w->level_ptr[k];
+
+      for (k = 0; k < N; ++k)
+        {
+          const size_t r = lower ? k : N - 1 - k;
+          w->row[cnt[level[r]]++] = r;
+        }
+
+      /* copy the rows in level order */
+      if (nz > w->nzmax || !w->ti)
+        {
+          gsl_free(w->ti);
+          gsl_free(w->td);
+          w->ti = gsl_malloc((nz + 1) * sizeof(size_t));
+          w->td = gsl_malloc((nz + 1) * sizeof(double));
+          w->nzmax = nz;
+
+          if (!w->ti || !w->td)
+            {
+              gsl_free(rp);
+              gsl_free(level);
+              gsl_free(ri);
+              gsl_free(rd);
+              w->nzmax = 0;
+              GSL_ERROR("failed to allocate trsv arrays", GSL_ENOMEM);
+            }
+        }
+
+      w->tp[0] = 0;
+      for (k = 0; k < N; ++k)
+        {
+          const size_t r = w->row[k];
+          size_t len = w->tp[k];
+
+          for (q = rp[r]; q < rp[r + 1]; ++q)
+            {
+              w->ti[len] = ri[q];
+              w->td[len] = rd[q];
+              ++len;
+            }
+
+          w->tp[k + 1] = len;
+        }
+
+      w->nz = nz;
+      w->nlevels = nlevels;
+
+      gsl_free(rp);
+      gsl_free(level);
+      gsl_free(ri);
+      gsl_free(rd);
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dtrsv_analysis() */
+
+/*
+gsl_spblas_dtrsv()
+  Solve a sparse triangular system op(A) x = b, using the schedule
+computed by gsl_spblas_dtrsv_analysis()
+
+Inputs: x - (input/output) on input, right hand side b; on output,
+            solution x
+        w - workspace holding the analysis of A
+
+Return: success/error
+
+Notes:
+1) The rows of each level are solved concurrently when OpenMP is
+available and the levels are wide enough on average; the threads
+synchronize once per level
+*/
+
+int
+gsl_spblas_dtrsv(gsl_vector *x, const gsl_spblas_trsv_workspace *w)
+{
+  if (x->size != w->n)
+    {
+      GSL_ERROR("vector length does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t *lptr = w->level_ptr;
+      const size_t *row = w->row;
+      const size_t *tp = w->tp;
+      const size_t *ti = w->ti;
+      const double *td = w->td;
+      const double *dinv = w->dinv;
+      const size_t nlevels = w->nlevels;
+      const size_t stride = x->stride;
+      double *X = x->data;
+      int parallel = 0;
+
+#ifdef _OPENMP
+      parallel = (w->nz >= SPBLAS_TRSV_NNZ &&
+                  w->n >= SPBLAS_TRSV_WIDTH * nlevels);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel if (parallel)
+#endif
+      {
+        size_t k, s;
+
+        for (k = 0; k < nlevels; ++k)
+          {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (s = lptr[k]; s < lptr[k + 1]; ++s)
+              {
+                const size_t r = row[s];
+                double sum = 0.0;
+                size_t q;
+
+                for (q = tp[s]; q < tp[s + 1]; ++q)
+                  sum += td[q] * X[ti[q] * stride];
+
+                X[r * stride] = (X[r * stride] - sum) * dinv[r];
+              }
+          }
+      }
+
+      (void) parallel;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dtrsv() */
+
+/* row r and column c in op(A) of element n of A, in outer index outer */
+static void
+trsv_entry(const gsl_spmatrix *A, const int trans, const size_t outer,
+           const size_t n, size_t *r, size_t *c)
+{
+  size_t i, j;
+
+  if (GSL_SPMATRIX_ISTRIPLET(A))
+    {
+      i = A->i[n];
+      j = A->p[n];
+    }
+  else if (GSL_SPMATRIX_ISCCS(A))
+    {
+      i = A->i[n];
+      j = outer;
+    }
+  else
+    {
+      i = outer;
+      j = A->i[n];
+    }
+
+  *r = trans ? j : i;
+  *c = trans ? i : j;
+}
@@ -159,6 +159,27 @@ test_dgemv(const size_t N, const size_t M, const double alpha,
   test_vectors(y_sp, y_gsl, 1.0e-10,
                "test_dgemv: compressed column format");
 
+  gsl_spmatrix_free(C);
+
+  /* compute y = alpha*op(A)*x + beta*y0 with spblas/comprow */
+  C = gsl_spmatrix_comprow(A);
+  gsl_vector_memcpy(y_sp, y);
+  gsl_spblas_dgemv(TransA, alpha, C, x, beta, y_sp);
+
+  /* test y_sp = y_gsl */
+  test_vectors(y_sp, y_gsl, 1.0e-10,
+               "test_dgemv: compressed row format");
+
+  gsl_spmatrix_free(C);
+
+  /* compute y = alpha*op(A)*x + beta*y0 with spblas/SELL-C-sigma */
+  C = gsl_spmatrix_sell(A, 4, 8);
+  gsl_vector_memcpy(y_sp, y);
+  gsl_spblas_dgemv(TransA, alpha, C, x, beta, y_sp);
+
+  /* test y_sp = y_gsl */
+  test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: SELL format");
+
   gsl_spmatrix_free(A);
   gsl_spmatrix_free(C);
   gsl_matrix_free(A_dense);
@@ -178,6 +199,7 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
   gsl_matrix *B_dense = gsl_matrix_alloc(max, N);
   gsl_matrix *C_dense = gsl_matrix_alloc(M, N);
   gsl_spmatrix *C = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CCS);
+  gsl_spmatrix *CR = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
 
   for (k = 1; k <= max; ++k)
     {
@@ -187,10 +209,15 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
       gsl_spmatrix *TB = create_random_sparse(k, N, 0.2, r);
       gsl_spmatrix *A = gsl_spmatrix_compcol(TA);
       gsl_spmatrix *B = gsl_spmatrix_compcol(TB);
+      gsl_spmatrix *AR = gsl_spmatrix_comprow(TA);
+      gsl_spmatrix *BR = gsl_spmatrix_comprow(TB);
 
       gsl_spmatrix_set_zero(C);
       gsl_spblas_dgemm(alpha, A, B, C);
 
+      gsl_spmatrix_set_zero(CR);
+      gsl_spblas_dgemm(alpha, AR, BR, CR);
+
       /* make dense matrices and use standard dgemm to multiply them */
       gsl_spmatrix_sp2d(&Ad.matrix, TA);
       gsl_spmatrix_sp2d(&Bd.matrix, TB);
@@ -203,9 +230,11 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
           for (j = 0; j < N; ++j)
             {
               double Cij = gsl_spmatrix_get(C, i, j);
+              double CRij = gsl_spmatrix_get(CR, i, j);
               double Dij = gsl_matrix_get(C_dense, i, j);
 
               gsl_test_rel(Cij, Dij, 1.0e-12, "test_dgemm: _dgemm");
+              gsl_test_rel(CRij, Dij, 1.0e-12, "test_dgemm: _dgemm compressed row");
             }
         }
 
@@ -213,14 +242,348 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
       gsl_spmatrix_free(TB);
       gsl_spmatrix_free(A);
       gsl_spmatrix_free(B);
+      gsl_spmatrix_free(AR);
+      gsl_spmatrix_free(BR);
     }
 
   gsl_spmatrix_free(C);
+  gsl_spmatrix_free(CR);
   gsl_matrix_free(A_dense);
   gsl_matrix_free(B_dense);
   gsl_matrix_free(C_dense);
 } /* test_dgemm() */
 
+/*
+test_dgemm_large()
+  Check C = alpha*A*B for matrices large enough to use the hash
+accumulator and several threads, by comparing C x against A (B x);
+then check that the symbolic pattern can be reused for new values
+*/
+
+static void
+test_dgemm_large(const size_t N, const size_t sptype, const gsl_rng *r)
+{
+  const char *desc = (sptype == GSL_SPMATRIX_CCS) ? "CCS" : "CRS";
+  gsl_spmatrix *TA = create_random_sparse(N, N, 6.0 / N, r);
+  gsl_spmatrix *TB = create_random_sparse(N, N, 6.0 / N, r);
+  gsl_spmatrix *A, *B, *C, *D;
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_vector *z = gsl_vector_alloc(N);
+  gsl_vector *w = gsl_vector_alloc(N);
+  gsl_error_handler_t *old_handler;
+  size_t i, p;
+  int status;
+
+  /* a dense column/row in B to give some columns of C many entries */
+  for (i = 0; i < N; i += 3)
+    gsl_spmatrix_set(TB, i, 7, 1.0);
+
+  if (sptype == GSL_SPMATRIX_CCS)
+    {
+      A = gsl_spmatrix_compcol(TA);
+      B = gsl_spmatrix_compcol(TB);
+    }
+  else
+    {
+      A = gsl_spmatrix_comprow(TA);
+      B = gsl_spmatrix_comprow(TB);
+    }
+
+  C = gsl_spmatrix_alloc_nzmax(N, N, 1, sptype);
+  D = gsl_spmatrix_alloc_nzmax(N, N, 1, sptype);
+  create_random_vector(x, r);
+
+  /* z = 2.5 A (B x) */
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, B, x, 0.0, w);
+  gsl_spblas_dgemv(CblasNoTrans, 2.5, A, w, 0.0, z);
+
+  gsl_spblas_dgemm(2.5, A, B, C);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, C, x, 0.0, y);
+  test_vectors(y, z, 1.0e-10, "test_dgemm_large: dgemm");
+
+  /* no duplicate indices within a column or row of C */
+  status = 0;
+  for (i = 0; i < N; ++i)
+    {
+      gsl_vector_set_zero(w);
+      for (p = C->p[i]; p < C->p[i + 1]; ++p)
+        {
+          status |= (gsl_vector_get(w, C->i[p]) != 0.0);
+          gsl_vector_set(w, C->i[p], 1.0);
+        }
+    }
+
+  gsl_test(status, "test_dgemm_large: %s N=%zu duplicates", desc, N);
+
+  /* reuse the pattern with new values of A */
+  gsl_spblas_dgemm_symbolic(A, B, D);
+  status = (D->nz != C->nz);
+  gsl_test(status, "test_dgemm_large: %s N=%zu symbolic nnz", desc, N);
+
+  gsl_spmatrix_scale(A, -3.0);
+  gsl_spblas_dgemm_numeric(1.0, A, B, D);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, D, x, 0.0, y);
+  gsl_vector_scale(z, -3.0 / 2.5);
+  test_vectors(y, z, 1.0e-10, "test_dgemm_large: numeric");
+
+  /* a product which does not fit in the pattern is rejected */
+  old_handler = gsl_set_error_handler_off();
+  status = gsl_spblas_dgemm_numeric(1.0, B, A, D);
+  gsl_set_error_handler(old_handler);
+  gsl_test(status != GSL_EINVAL,
+           "test_dgemm_large: %s N=%zu numeric pattern mismatch", desc, N);
+
+  gsl_spmatrix_free(TA);
+  gsl_spmatrix_free(TB);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_spmatrix_free(C);
+  gsl_spmatrix_free(D);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_vector_free(w);
+} /* test_dgemm_large() */
+
+static void
+test_dgemm_dense(const size_t M, const size_t N, const size_t K,
+                 const double alpha, const double beta,
+                 const CBLAS_TRANSPOSE_t TransA, const gsl_rng *r)
+{
+  /* op(A) is M-by-K */
+  const size_t nrows = (TransA == CblasNoTrans) ? M : K;
+  const size_t ncols = (TransA == CblasNoTrans) ? K : M;
+  gsl_spmatrix *A = create_random_sparse(nrows, ncols, 0.2, r);
+  gsl_matrix *A_dense = gsl_matrix_alloc(nrows, ncols);
+  gsl_matrix *B = gsl_matrix_alloc(K, N);
+  gsl_matrix *C = gsl_matrix_alloc(M, N);
+  gsl_matrix *C_gsl = gsl_matrix_alloc(M, N);
+  gsl_matrix *C_sp = gsl_matrix_alloc(M, N);
+  gsl_spmatrix *S[3];
+  const char *desc[3] = { "triplet", "compressed column", "compressed row" };
+  size_t i, j, k;
+
+  for (i = 0; i < K; ++i)
+    for (j = 0; j < N; ++j)
+      gsl_matrix_set(B, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+
+  for (i = 0; i < M; ++i)
+    for (j = 0; j < N; ++j)
+      gsl_matrix_set(C, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+
+  gsl_spmatrix_sp2d(A_dense, A);
+
+  gsl_matrix_memcpy(C_gsl, C);
+  gsl_blas_dgemm(TransA, CblasNoTrans, alpha, A_dense, B, beta, C_gsl);
+
+  S[0] = A;
+  S[1] = gsl_spmatrix_compcol(A);
+  S[2] = gsl_spmatrix_comprow(A);
+
+  for (k = 0; k < 3; ++k)
+    {
+      gsl_matrix_memcpy(C_sp, C);
+      gsl_spblas_dgemm_dense(TransA, alpha, S[k], B, beta, C_sp);
+
+      for (i = 0; i < M; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              gsl_test_rel(gsl_matrix_get(C_sp, i, j),
+                           gsl_matrix_get(C_gsl, i, j), 1.0e-10,
+                           "test_dgemm_dense: %s format M=%zu N=%zu K=%zu trans=%d",
+                           desc[k], M, N, K, TransA == CblasTrans);
+            }
+        }
+    }
+
+  gsl_spmatrix_free(S[0]);
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_matrix_free(A_dense);
+  gsl_matrix_free(B);
+  gsl_matrix_free(C);
+  gsl_matrix_free(C_gsl);
+  gsl_matrix_free(C_sp);
+} /* test_dgemm_dense() */
+
+/* large enough to use several threads in the compressed kernels */
+static void
+test_dgemv_large(const size_t N, const gsl_rng *r)
+{
+  gsl_spmatrix *T = gsl_spmatrix_alloc_nzmax(N, N, 5 * N, GSL_SPMATRIX_TRIPLET);
+  gsl_spmatrix *A, *AR, *AS;
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_vector *y_ccs = gsl_vector_alloc(N);
+  gsl_vector *y_crs = gsl_vector_alloc(N);
+  size_t i;
+
+  /* pentadiagonal matrix plus a dense first row to unbalance the rows */
+  for (i = 0; i < N; ++i)
+    {
+      gsl_spmatrix_set(T, i, i, 4.0 + gsl_rng_uniform(r));
+      if (i > 0)
+        gsl_spmatrix_set(T, i, i - 1, -1.0);
+      if (i + 1 < N)
+        gsl_spmatrix_set(T, i, i + 1, -1.0);
+      if (i > 9)
+        gsl_spmatrix_set(T, i, i - 10, gsl_rng_uniform(r));
+      if (i + 10 < N)
+        gsl_spmatrix_set(T, i, i + 10, gsl_rng_uniform(r));
+      if (i > 10)
+        gsl_spmatrix_set(T, 0, i, 0.5);
+    }
+
+  A = gsl_spmatrix_compcol(T);
+  AR = gsl_spmatrix_comprow(T);
+  create_random_vector(x, r);
+
+  /* row-oriented product of each format against the triplet result */
+  gsl_spblas_dgemv(CblasNoTrans, 1.5, T, x, 0.0, y);
+  gsl_spblas_dgemv(CblasNoTrans, 1.5, AR, x, 0.0, y_crs);
+  test_vectors(y_crs, y, 1.0e-10, "test_dgemv_large: compressed row");
+
+  AS = gsl_spmatrix_sell(A, 8, 64);
+  gsl_spblas_dgemv(CblasNoTrans, 1.5, AS, x, 0.0, y_crs);
+  test_vectors(y_crs, y, 1.0e-10, "test_dgemv_large: SELL");
+  gsl_spmatrix_free(AS);
+
+  gsl_spblas_dgemv(CblasTrans, 1.5, T, x, 0.0, y);
+  gsl_spblas_dgemv(CblasTrans, 1.5, A, x, 0.0, y_ccs);
+  test_vectors(y_ccs, y, 1.0e-10, "test_dgemv_large: compressed column");
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(AR);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(y_ccs);
+  gsl_vector_free(y_crs);
+} /* test_dgemv_large() */
+
+/*
+test_dtrsv()
+  Compare gsl_spblas_dtrsv with gsl_blas_dtrsv for a random triangular
+matrix; the full matrix is passed to the analysis, so that the elements
+outside the triangle must be ignored
+*/
+
+static void
+test_dtrsv(const size_t N, const double density, const CBLAS_UPLO_t Uplo,
+           const CBLAS_TRANSPOSE_t TransA, const CBLAS_DIAG_t Diag,
+           const gsl_rng *r)
+{
+  gsl_spmatrix *T = create_random_sparse(N, N, density, r);
+  gsl_spmatrix *A[3];
+  gsl_matrix *D = gsl_matrix_alloc(N, N);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *x_gsl = gsl_vector_alloc(N);
+  gsl_spblas_trsv_workspace *w = gsl_spblas_trsv_alloc(N);
+  char str[128];
+  size_t i, k, l;
+
+  /* well conditioned diagonal */
+  for (i = 0; i < N; ++i)
+    gsl_spmatrix_set(T, i, i, 1.0 + N * density + gsl_rng_uniform(r));
+
+  A[0] = T;
+  A[1] = gsl_spmatrix_compcol(T);
+  A[2] = gsl_spmatrix_comprow(T);
+
+  gsl_spmatrix_sp2d(D, T);
+
+  for (k = 0; k < 3; ++k)
+    {
+      gsl_spblas_dtrsv_analysis(Uplo, TransA, Diag, A[k], w);
+
+      /* the schedule is reused for several right hand sides */
+      for (l = 0; l < 2; ++l)
+        {
+          create_random_vector(b, r);
+
+          gsl_vector_memcpy(x_gsl, b);
+          gsl_blas_dtrsv(Uplo, TransA, Diag, D, x_gsl);
+
+          gsl_vector_memcpy(x, b);
+          gsl_spblas_dtrsv(x, w);
+
+          sprintf(str, "test_dtrsv: Uplo=%d TransA=%d Diag=%d format=%zu rhs=%zu",
+                  Uplo, TransA, Diag, k, l);
+          test_vectors(x, x_gsl, 1.0e-12, str);
+        }
+    }
+
+  gsl_spmatrix_free(A[0]);
+  gsl_spmatrix_free(A[1]);
+  gsl_spmatrix_free(A[2]);
+  gsl_matrix_free(D);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(x_gsl);
+  gsl_spblas_trsv_free(w);
+} /* test_dtrsv() */
+
+/*
+test_dtrsv_large()
+  Solve a large lower triangular system with wide levels, so that
+the threaded solve is used, and check the residual
+*/
+
+static void
+test_dtrsv_large(const size_t N, const size_t W, const gsl_rng *r)
+{
+  gsl_spmatrix *T = gsl_spmatrix_alloc_nzmax(N, N, 4 * N, GSL_SPMATRIX_TRIPLET);
+  gsl_spmatrix *A;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_spblas_trsv_workspace *w = gsl_spblas_trsv_alloc(N);
+  size_t i, m;
+  int status;
+
+  /* row i depends on rows i - m W, giving about N / W levels */
+  for (i = 0; i < N; ++i)
+    {
+      gsl_spmatrix_set(T, i, i, 4.0);
+
+      for (m = 1; m <= 3 && m * W <= i; ++m)
+        {
+          size_t j = i - m * W;
+          size_t d = (size_t) (gsl_rng_uniform(r) * W / 2);
+
+          gsl_spmatrix_set(T, i, j - GSL_MIN(d, j), -gsl_rng_uniform(r));
+        }
+    }
+
+  A = gsl_spmatrix_comprow(T);
+
+  status = gsl_spblas_dtrsv_analysis(CblasLower, CblasNoTrans, CblasNonUnit,
+                                     A, w);
+  gsl_test(status, "test_dtrsv_large: analysis");
+  gsl_test(w->nlevels > 2 * N / W, "test_dtrsv_large: nlevels=%zu",
+           w->nlevels);
+
+  create_random_vector(b, r);
+  gsl_vector_memcpy(x, b);
+  gsl_spblas_dtrsv(x, w);
+
+  /* y = A x - b */
+  gsl_vector_memcpy(y, b);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, x, -1.0, y);
+  gsl_test_abs(gsl_blas_dnrm2(y) / gsl_blas_dnrm2(b), 0.0, 1.0e-14,
+               "test_dtrsv_large: residual");
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_spblas_trsv_free(w);
+} /* test_dtrsv_large() */
+
 int
 main()
 {
@@ -248,6 +611,29 @@ main()
   test_dgemm(1.8, 12, 30, r);
   test_dgemm(0.4, 45, 35, r);
 
+  test_dgemm_large(3000, GSL_SPMATRIX_CCS, r);
+  test_dgemm_large(3000, GSL_SPMATRIX_CRS, r);
+
+  test_dgemm_dense(10, 7, 12, 1.0, 0.0, CblasNoTrans, r);
+  test_dgemm_dense(10, 7, 12, 1.0, 0.0, CblasTrans, r);
+  test_dgemm_dense(25, 40, 13, -2.1, 0.5, CblasNoTrans, r);
+  test_dgemm_dense(25, 40, 13, -2.1, 0.5, CblasTrans, r);
+  test_dgemm_dense(33, 1, 50, 0.7, 1.0, CblasNoTrans, r);
+  test_dgemm_dense(33, 1, 50, 0.7, 1.0, CblasTrans, r);
+
+  test_dgemv_large(20000, r);
+
+  for (m = 1; m <= 30; m += 7)
+    {
+      test_dtrsv(m, 0.3, CblasLower, CblasNoTrans, CblasNonUnit, r);
+      test_dtrsv(m, 0.3, CblasLower, CblasTrans, CblasNonUnit, r);
+      test_dtrsv(m, 0.3, CblasUpper, CblasNoTrans, CblasNonUnit, r);
+      test_dtrsv(m, 0.3, CblasUpper, CblasTrans, CblasUnit, r);
+      test_dtrsv(m, 0.1, CblasLower, CblasNoTrans, CblasUnit, r);
+    }
+
+  test_dtrsv_large(50000, 2000, r);
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
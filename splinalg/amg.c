@@ -0,0 +1,851 @@
+/* splinalg/amg.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+#include <gsl/gsl_blas.h>
+
+#include "common.h"
+
+/*
+ * Smoothed aggregation algebraic multigrid preconditioner
+ *
+ * The setup builds a hierarchy of matrices A_0 = A, A_{l+1} =
+ * R_l A_l P_l. The nodes of each level are grouped into aggregates
+ * of strongly connected neighbours; the tentative prolongator T_l
+ * interpolates constants on each aggregate, and is smoothed by one
+ * damped Jacobi step, P_l = (I - w D^{-1} A_l) T_l, with R_l = P_l^T.
+ * The preconditioner is one V-cycle with zero initial guess, with
+ * an LU factorization on the coarsest level. Forward Gauss-Seidel
+ * before and backward Gauss-Seidel after the coarse correction (or
+ * damped Jacobi on both sides) keep M symmetric for symmetric A. See
+ *
+ * [1] P. Vanek, J. Mandel and M. Brezina, Algebraic multigrid by
+ *     smoothed aggregation for second and fourth order elliptic
+ *     problems, Computing 56, 179-196, 1996.
+ */
+
+#define AMG_MAX_LEVELS     20
+
+/* Lanczos steps for estimating the spectral radius of D^{-1} A */
+#define AMG_LANCZOS_STEPS  15
+
+/* aggregate index of a node not yet aggregated */
+#define AMG_FREE           ((size_t) -1)
+
+typedef struct
+{
+  gsl_spmatrix *A;  /* level matrix, compressed row with sorted indices */
+  gsl_spmatrix *P;  /* prolongator to this level from the next coarser */
+  gsl_spmatrix *R;  /* restriction P^T */
+  double *dinv;     /* inverse diagonal of A */
+  double omega;     /* damping factor 4 / (3 rho(D^{-1} A)) */
+  gsl_vector *x;    /* solution on this level */
+  gsl_vector *b;    /* right hand side on this level */
+  gsl_vector *r;    /* residual on this level */
+} amg_level_t;
+
+typedef struct
+{
+  size_t n;
+  double theta;       /* strength of connection threshold */
+  int smoother;       /* GSL_SPLINALG_AMG_JACOBI or GSL_SPLINALG_AMG_GS */
+  size_t nsweeps;     /* smoothing sweeps before and after correction */
+  size_t coarse_size; /* maximum size of the coarsest level */
+  size_t nlevels;     /* number of levels, 0 if not initialized */
+  amg_level_t level[AMG_MAX_LEVELS];
+  gsl_splinalg_LU_workspace *lu; /* LU factors of the coarsest level */
+  size_t *agg;        /* aggregate of each node, size n */
+} amg_state_t;
+
+static void amg_free(void *vstate);
+static void amg_clear(amg_state_t *state);
+static int amg_level_init(amg_level_t *lev);
+static double amg_rho(const amg_level_t *lev, const double rho_max);
+static void amg_tridiag_eig(const double *alpha, const double *beta,
+                            const size_t k, double *lmin, double *lmax);
+static size_t amg_aggregate(const gsl_spmatrix *A, const double *dinv,
+                            const double theta, size_t *agg);
+static gsl_spmatrix *amg_prolongator(const gsl_spmatrix *A,
+                                     const double *dinv, const double omega,
+                                     const size_t *agg, const size_t nagg);
+static gsl_spmatrix *amg_galerkin(const gsl_spmatrix *A,
+                                  const gsl_spmatrix *P,
+                                  const gsl_spmatrix *R);
+static void amg_smooth(const amg_level_t *lev, const int smoother,
+                       const int backward, gsl_vector *x);
+
+static void *
+amg_alloc(const size_t n, const gsl_splinalg_precon_params *params)
+{
+  amg_state_t *state;
+
+  if (params->theta < 0.0 || params->theta >= 1.0)
+    {
+      GSL_ERROR_NULL("theta must be in [0,1)", GSL_EINVAL);
+    }
+  else if (params->smoother != GSL_SPLINALG_AMG_JACOBI &&
+           params->smoother != GSL_SPLINALG_AMG_GS)
+    {
+      GSL_ERROR_NULL("unknown smoother", GSL_EINVAL);
+    }
+  else if (params->nsweeps == 0)
+    {
+      GSL_ERROR_NULL("nsweeps must be positive", GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(amg_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate amg state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->theta = params->theta;
+  state->smoother = params->smoother;
+  state->nsweeps = params->nsweeps;
+  state->coarse_size = GSL_MAX(params->coarse_size, 1);
+
+  state->agg = gsl_malloc(n * sizeof(size_t));
+  if (!state->agg)
+    {
+      amg_free(state);
+      GSL_ERROR_NULL("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return state;
+} /* amg_alloc() */
+
+static void
+amg_free(void *vstate)
+{
+  amg_state_t *state = (amg_state_t *) vstate;
+
+  amg_clear(state);
+
+  if (state->agg)
+    gsl_free(state->agg);
+
+  gsl_free(state);
+} /* amg_free() */
+
+/* free the hierarchy of a previous call to amg_init() */
+static void
+amg_clear(amg_state_t *state)
+{
+  size_t l;
+
+  for (l = 0; l < AMG_MAX_LEVELS; ++l)
+    {
+      amg_level_t *lev = &state->level[l];
+
+      if (lev->A)
+        gsl_spmatrix_free(lev->A);
+      if (lev->P)
+        gsl_spmatrix_free(lev->P);
+      if (lev->R)
+        gsl_spmatrix_free(lev->R);
+      if (lev->dinv)
+        gsl_free(lev->dinv);
+      if (lev->x)
+        gsl_vector_free(lev->x);
+      if (lev->b)
+        gsl_vector_free(lev->b);
+      if (lev->r)
+        gsl_vector_free(lev->r);
+
+      lev->A = lev->P = lev->R = NULL;
+      lev->dinv = NULL;
+      lev->x = lev->b = lev->r = NULL;
+    }
+
+  if (state->lu)
+    {
+      gsl_splinalg_LU_free(state->lu);
+      state->lu = NULL;
+    }
+
+  state->nlevels = 0;
+} /* amg_clear() */
+
+/*
+amg_init()
+  Build the multigrid hierarchy for A
+
+Notes:
+1) Coarsening stops when a level has at most coarse_size rows,
+when the aggregation no longer reduces the size, or after
+AMG_MAX_LEVELS levels
+*/
+
+static int
+amg_init(const gsl_spmatrix *A, void *vstate)
+{
+  amg_state_t *state = (amg_state_t *) vstate;
+  size_t l = 0;
+  int status;
+
+  amg_clear(state);
+
+  state->level[0].A = splinalg_precon_crs(A);
+  if (!state->level[0].A)
+    {
+      GSL_ERROR("failed to copy matrix", GSL_ENOMEM);
+    }
+
+  while (1)
+    {
+      amg_level_t *lev = &state->level[l];
+      amg_level_t *next = &state->level[l + 1];
+      const size_t n = lev->A->size1;
+      size_t nagg;
+
+      status = amg_level_init(lev);
+      if (status)
+        break;
+
+      if (n <= state->coarse_size || l + 1 == AMG_MAX_LEVELS)
+        break;
+
+      nagg = amg_aggregate(lev->A, lev->dinv, state->theta, state->agg);
+      if (nagg == 0 || nagg >= n)
+        break;
+
+      lev->P = amg_prolongator(lev->A, lev->dinv, lev->omega,
+                               state->agg, nagg);
+      if (!lev->P)
+        {
+          status = GSL_ENOMEM;
+          break;
+        }
+
+      lev->R = gsl_spmatrix_alloc_nzmax(nagg, n, lev->P->nz,
+                                        GSL_SPMATRIX_CRS);
+      if (!lev->R)
+        {
+          status = GSL_ENOMEM;
+          break;
+        }
+
+      status = gsl_spmatrix_transpose_memcpy(lev->R, lev->P);
+      if (status)
+        break;
+
+      next->A = amg_galerkin(lev->A, lev->P, lev->R);
+      if (!next->A)
+        {
+          status = GSL_ENOMEM;
+          break;
+        }
+
+      ++l;
+    }
+
+  state->nlevels = l + 1;
+
+  if (status)
+    {
+      amg_clear(state);
+      GSL_ERROR("failed to build multigrid hierarchy", status);
+    }
+
+  /* the last level has no prolongator */
+  if (state->level[l].P)
+    {
+      gsl_spmatrix_free(state->level[l].P);
+      state->level[l].P = NULL;
+    }
+
+  if (state->level[l].R)
+    {
+      gsl_spmatrix_free(state->level[l].R);
+      state->level[l].R = NULL;
+    }
+
+  state->lu = gsl_splinalg_LU_alloc(state->level[l].A->size1);
+  if (!state->lu)
+    {
+      amg_clear(state);
+      GSL_ERROR("failed to allocate coarse LU workspace", GSL_ENOMEM);
+    }
+
+  status = gsl_splinalg_LU_decomp(state->level[l].A, state->lu);
+  if (status)
+    {
+      amg_clear(state);
+      GSL_ERROR("coarsest level matrix is singular", status);
+    }
+
+  return GSL_SUCCESS;
+} /* amg_init() */
+
+/*
+amg_apply()
+  Compute x := M^{-1} x with one V-cycle
+*/
+
+static int
+amg_apply(gsl_vector *x, void *vstate)
+{
+  amg_state_t *state = (amg_state_t *) vstate;
+  const size_t L = state->nlevels;
+  size_t l, k;
+  int status;
+
+  if (L == 0)
+    {
+      GSL_ERROR("preconditioner has not been initialized", GSL_EFAILED);
+    }
+
+  gsl_vector_memcpy(state->level[0].b, x);
+
+  /* downward sweep: pre-smooth and restrict the residual */
+  for (l = 0; l + 1 < L; ++l)
+    {
+      amg_level_t *lev = &state->level[l];
+
+      gsl_vector_set_zero(lev->x);
+
+      for (k = 0; k < state->nsweeps; ++k)
+        amg_smooth(lev, state->smoother, 0, lev->x);
+
+      gsl_vector_memcpy(lev->r, lev->b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, lev->A, lev->x, 1.0, lev->r);
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, lev->R, lev->r, 0.0,
+                       state->level[l + 1].b);
+    }
+
+  status = gsl_splinalg_LU_solve(state->lu, state->level[L - 1].b,
+                                 state->level[L - 1].x);
+  if (status)
+    return status;
+
+  /* upward sweep: prolong the correction and post-smooth */
+  for (l = L - 1; l > 0; --l)
+    {
+      amg_level_t *lev = &state->level[l - 1];
+
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, lev->P, state->level[l].x,
+                       1.0, lev->x);
+
+      for (k = 0; k < state->nsweeps; ++k)
+        amg_smooth(lev, state->smoother, 1, lev->x);
+    }
+
+  gsl_vector_memcpy(x, state->level[0].x);
+
+  return GSL_SUCCESS;
+} /* amg_apply() */
+
+/*
+amg_level_init()
+  Compute the inverse diagonal and damping factor of a level, and
+allocate its vectors
+*/
+
+static int
+amg_level_init(amg_level_t *lev)
+{
+  const gsl_spmatrix *A = lev->A;
+  const size_t n = A->size1;
+  double rho = 0.0;
+  size_t i, p;
+  int status;
+
+  lev->dinv = gsl_malloc(n * sizeof(double));
+  lev->x = gsl_vector_alloc(n);
+  lev->b = gsl_vector_alloc(n);
+  lev->r = gsl_vector_alloc(n);
+  if (!lev->dinv || !lev->x || !lev->b || !lev->r)
+    {
+      GSL_ERROR("failed to allocate level workspace", GSL_ENOMEM);
+    }
+
+  status = splinalg_precon_diag(A, lev->dinv, NULL);
+  if (status)
+    return status;
+
+  /* Gershgorin bound on the spectral radius of D^{-1} A */
+  for (i = 0; i < n; ++i)
+    {
+      double sum = 0.0;
+
+      for (p = A->p[i]; p < A->p[i + 1]; ++p)
+        sum += fabs(A->data[p]);
+
+      rho = GSL_MAX(rho, sum * fabs(lev->dinv[i]));
+    }
+
+  lev->omega = 4.0 / (3.0 * amg_rho(lev, rho));
+
+  return GSL_SUCCESS;
+} /* amg_level_init() */
+
+/*
+amg_rho()
+  Estimate the spectral radius of D^{-1} A on a level by a few
+Lanczos steps on |D|^{-1/2} A |D|^{-1/2}
+
+Inputs: lev     - level, with dinv computed; its vectors are used
+                  as workspace
+        rho_max - upper bound on the spectral radius
+
+Return: estimate of the spectral radius, at most rho_max
+
+Notes:
+1) The Gershgorin bound is often 50% too large on the coarse
+levels, which makes the smoothed prolongator and the Jacobi
+smoother much less effective; the largest Ritz value converges
+within a few steps for symmetric A
+*/
+
+static double
+amg_rho(const amg_level_t *lev, const double rho_max)
+{
+  const size_t n = lev->A->size1;
+  const size_t k = GSL_MIN(n, AMG_LANCZOS_STEPS);
+  double alpha[AMG_LANCZOS_STEPS], beta[AMG_LANCZOS_STEPS];
+  gsl_vector *v = lev->x;
+  gsl_vector *w = lev->b;
+  gsl_vector *v_old = lev->r;
+  double lmin = 0.0, lmax = 0.0, rho;
+  size_t i, j, m = 0;
+
+  /* deterministic starting vector with all frequencies present */
+  for (i = 0; i < n; ++i)
+    gsl_vector_set(v, i, (double) ((i * 7919) % 101) / 101.0 - 0.5);
+
+  gsl_vector_scale(v, 1.0 / gsl_blas_dnrm2(v));
+  gsl_vector_set_zero(v_old);
+
+  for (j = 0; j < k; ++j)
+    {
+      gsl_vector *tmp;
+
+      /* w = S A S v, S = |D|^{-1/2} */
+      for (i = 0; i < n; ++i)
+        {
+          double *vi = gsl_vector_ptr(v, i);
+          *vi *= sqrt(fabs(lev->dinv[i]));
+        }
+
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, lev->A, v, 0.0, w);
+
+      for (i = 0; i < n; ++i)
+        {
+          const double s = sqrt(fabs(lev->dinv[i]));
+          double *vi = gsl_vector_ptr(v, i);
+          double *wi = gsl_vector_ptr(w, i);
+
+          *vi /= s;
+          *wi *= s;
+        }
+
+      /* w <- w - alpha v - beta v_old */
+      gsl_blas_ddot(v, w, &alpha[j]);
+      gsl_blas_daxpy(-alpha[j], v, w);
+      if (j > 0)
+        gsl_blas_daxpy(-beta[j - 1], v_old, w);
+
+      m = j + 1;
+      beta[j] = gsl_blas_dnrm2(w);
+      if (beta[j] <= GSL_DBL_EPSILON * fabs(alpha[j]))
+        break;
+
+      /* v_old <- v, v <- w / beta */
+      gsl_vector_scale(w, 1.0 / beta[j]);
+      tmp = v_old;
+      v_old = v;
+      v = w;
+      w = tmp;
+    }
+
+  amg_tridiag_eig(alpha, beta, m, &lmin, &lmax);
+  rho = GSL_MAX(fabs(lmin), fabs(lmax));
+
+  return (rho > 0.0 && rho < rho_max) ? rho : rho_max;
+} /* amg_rho() */
+
+/*
+amg_tridiag_eig()
+  Compute the extreme eigenvalues of the symmetric tridiagonal
+matrix with diagonal alpha and off-diagonal beta by bisection on
+Sturm sequences
+
+Inputs: alpha - diagonal, length k
+        beta  - off-diagonal, length k - 1
+        k     - size of matrix
+        lmin  - (output) smallest eigenvalue
+        lmax  - (output) largest eigenvalue
+*/
+
+static void
+amg_tridiag_eig(const double *alpha, const double *beta, const size_t k,
+                double *lmin, double *lmax)
+{
+  double lo = alpha[0], hi = alpha[0];
+  size_t i, side;
+
+  for (i = 0; i < k; ++i)
+    {
+      double r = (i > 0 ? fabs(beta[i - 1]) : 0.0) +
+                 (i + 1 < k ? fabs(beta[i]) : 0.0);
+
+      lo = GSL_MIN(lo, alpha[i] - r);
+      hi = GSL_MAX(hi, alpha[i] + r);
+    }
+
+  /* side = 0: smallest eigenvalue, side = 1: largest */
+  for (side = 0; side < 2; ++side)
+    {
+      double a = lo, b = hi;
+      size_t iter;
+
+      for (iter = 0; iter < 64; ++iter)
+        {
+          const double x = 0.5 * (a + b);
+          double q = 1.0;
+          size_t count = 0; /* number of eigenvalues less than x */
+
+          for (i = 0; i < k; ++i)
+            {
+              if (i > 0)
+                q = alpha[i] - x - beta[i - 1] * beta[i - 1] / q;
+              else
+                q = alpha[i] - x;
+
+              if (q == 0.0)
+                q = -GSL_DBL_EPSILON;
+              if (q < 0.0)
+                ++count;
+            }
+
+          if ((side == 0 && count == 0) || (side == 1 && count < k))
+            a = x;
+          else
+            b = x;
+        }
+
+      if (side == 0)
+        *lmin = a;
+      else
+        *lmax = b;
+    }
+} /* amg_tridiag_eig() */
+
+/*
+amg_aggregate()
+  Group the nodes of A into aggregates. Node j is strongly connected
+to node i if |a_ij| >= theta sqrt(|a_ii a_jj|)
+
+Inputs: A     - compressed row matrix
+        dinv  - inverse diagonal of A
+        theta - strength threshold
+        agg   - (output) aggregate of each node
+
+Return: number of aggregates
+
+Notes:
+1) In the first pass, each node whose strong neighbours are all free
+forms an aggregate with them. In the second pass, the remaining free
+nodes join the aggregate of a strong neighbour, and in the third, the
+nodes still free form new aggregates with their free strong
+neighbours. Nodes without strong connections become singletons.
+*/
+
+static size_t
+amg_aggregate(const gsl_spmatrix *A, const double *dinv, const double theta,
+              size_t *agg)
+{
+  const size_t n = A->size1;
+  const size_t *Ap = A->p;
+  const size_t *Aj = A->i;
+  const double *Ad = A->data;
+  const double theta2 = theta * theta;
+  size_t nagg = 0;
+  size_t i, p;
+
+#define AMG_STRONG(i, p) \
+  (Aj[p] != (i) && Ad[p] * Ad[p] * fabs(dinv[i] * dinv[Aj[p]]) >= theta2)
+
+  for (i = 0; i < n; ++i)
+    agg[i] = AMG_FREE;
+
+  /* pass 1: aggregates of whole free neighbourhoods */
+  for (i = 0; i < n; ++i)
+    {
+      int nstrong = 0;
+
+      if (agg[i] != AMG_FREE)
+        continue;
+
+      for (p = Ap[i]; p < Ap[i + 1]; ++p)
+        {
+          if (AMG_STRONG(i, p))
+            {
+              if (agg[Aj[p]] != AMG_FREE)
+                break;
+              ++nstrong;
+            }
+        }
+
+      if (p < Ap[i + 1] || nstrong == 0)
+        continue;
+
+      agg[i] = nagg;
+      for (p = Ap[i]; p < Ap[i + 1]; ++p)
+        {
+          if (AMG_STRONG(i, p))
+            agg[Aj[p]] = nagg;
+        }
+
+      ++nagg;
+    }
+
+  /* pass 2: attach free nodes to a neighbouring aggregate */
+  for (i = 0; i < n; ++i)
+    {
+      if (agg[i] != AMG_FREE)
+        continue;
+
+      for (p = Ap[i]; p < Ap[i + 1]; ++p)
+        {
+          if (AMG_STRONG(i, p) && agg[Aj[p]] != AMG_FREE)
+            {
+              agg[i] = agg[Aj[p]];
+              break;
+            }
+        }
+    }
+
+  /* pass 3: aggregate what is left */
+  for (i = 0; i < n; ++i)
+    {
+      if (agg[i] != AMG_FREE)
+        continue;
+
+      agg[i] = nagg;
+      for (p = Ap[i]; p < Ap[i + 1]; ++p)
+        {
+          if (AMG_STRONG(i, p) && agg[Aj[p]] == AMG_FREE)
+            agg[Aj[p]] = nagg;
+        }
+
+      ++nagg;
+    }
+
+#undef AMG_STRONG
+
+  return nagg;
+} /* amg_aggregate() */
+
+/*
+amg_prolongator()
+  Compute the smoothed prolongator P = (I - omega D^{-1} A) T, where
+T(i,agg[i]) = 1 / sqrt(size of aggregate agg[i]) is the tentative
+prolongator
+
+Inputs: A     - n-by-n compressed row matrix
+        dinv  - inverse diagonal of A
+        omega - damping factor
+        agg   - aggregate of each node
+        nagg  - number of aggregates
+
+Return: P, n-by-nagg in compressed row format
+*/
+
+static gsl_spmatrix *
+amg_prolongator(const gsl_spmatrix *A, const double *dinv, const double omega,
+                const size_t *agg, const size_t nagg)
+{
+  const size_t n = A->size1;
+  gsl_spmatrix *P;
+  double *t;
+  size_t *mark;
+  size_t i, p, nz = 0;
+
+  /* row i of P has at most one more element than row i of A */
+  P = gsl_spmatrix_alloc_nzmax(n, nagg, A->nz + n, GSL_SPMATRIX_CRS);
+  t = gsl_calloc(nagg, sizeof(double));
+  mark = gsl_malloc(nagg * sizeof(size_t));
+  if (!P || !t || !mark)
+    {
+      if (P)
+        gsl_spmatrix_free(P);
+      if (t)
+        gsl_free(t);
+      if (mark)
+        gsl_free(mark);
+      GSL_ERROR_NULL("failed to allocate prolongator", GSL_ENOMEM);
+    }
+
+  /* t[c] = 1 / sqrt(size of aggregate c) */
+  for (i = 0; i < n; ++i)
+    t[agg[i]] += 1.0;
+
+  for (i = 0; i < nagg; ++i)
+    {
+      t[i] = 1.0 / sqrt(t[i]);
+      mark[i] = AMG_FREE;
+    }
+
+  for (i = 0; i < n; ++i)
+    {
+      const size_t row_start = nz;
+      const double s = -omega * dinv[i];
+
+      P->p[i] = nz;
+
+      /* mark[c] is the position of column c in the current row */
+      mark[agg[i]] = nz;
+      P->i[nz] = agg[i];
+      P->data[nz++] = t[agg[i]];
+
+      for (p = A->p[i]; p < A->p[i + 1]; ++p)
+        {
+          const size_t c = agg[A->i[p]];
+          const double v = s * A->data[p] * t[c];
+
+          if (mark[c] == AMG_FREE || mark[c] < row_start)
+            {
+              mark[c] = nz;
+              P->i[nz] = c;
+              P->data[nz++] = v;
+            }
+          else
+            {
+              P->data[mark[c]] += v;
+            }
+        }
+    }
+
+  P->p[n] = nz;
+  P->nz = nz;
+
+  gsl_free(t);
+  gsl_free(mark);
+
+  return P;
+} /* amg_prolongator() */
+
+/*
+amg_galerkin()
+  Compute the coarse level matrix R A P, with sorted indices
+*/
+
+static gsl_spmatrix *
+amg_galerkin(const gsl_spmatrix *A, const gsl_spmatrix *P,
+             const gsl_spmatrix *R)
+{
+  gsl_spmatrix *AP, *RAP, *C = NULL;
+
+  AP = gsl_spmatrix_alloc_nzmax(A->size1, P->size2, P->nz,
+                                GSL_SPMATRIX_CRS);
+  RAP = gsl_spmatrix_alloc_nzmax(R->size1, P->size2, P->nz,
+                                 GSL_SPMATRIX_CRS);
+
+  if (AP && RAP &&
+      gsl_spblas_dgemm(1.0, A, P, AP) == GSL_SUCCESS &&
+      gsl_spblas_dgemm(1.0, R, AP, RAP) == GSL_SUCCESS)
+    {
+      /* the product indices are unsorted */
+      C = splinalg_precon_crs(RAP);
+    }
+
+  if (AP)
+    gsl_spmatrix_free(AP);
+  if (RAP)
+    gsl_spmatrix_free(RAP);
+
+  return C;
+} /* amg_galerkin() */
+
+/*
+amg_smooth()
+  Apply one smoothing sweep to A x = b on a level
+
+Inputs: lev      - level
+        smoother - GSL_SPLINALG_AMG_JACOBI or GSL_SPLINALG_AMG_GS
+        backward - for Gauss-Seidel, sweep from the last row to the
+                   first
+        x        - (input/output) approximate solution
+*/
+
+static void
+amg_smooth(const amg_level_t *lev, const int smoother, const int backward,
+           gsl_vector *x)
+{
+  const gsl_spmatrix *A = lev->A;
+  const size_t n = A->size1;
+  const size_t *Ap = A->p;
+  const size_t *Aj = A->i;
+  const double *Ad = A->data;
+  size_t i, p;
+
+  if (smoother == GSL_SPLINALG_AMG_JACOBI)
+    {
+      /* x := x + omega D^{-1} (b - A x) */
+      gsl_vector_memcpy(lev->r, lev->b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, lev->r);
+
+      for (i = 0; i < n; ++i)
+        {
+          double *xi = gsl_vector_ptr(x, i);
+          *xi += lev->omega * lev->dinv[i] * gsl_vector_get(lev->r, i);
+        }
+    }
+  else
+    {
+      size_t k;
+
+      for (k = 0; k < n; ++k)
+        {
+          double sum;
+
+          i = backward ? n - 1 - k : k;
+          sum = gsl_vector_get(lev->b, i);
+
+          for (p = Ap[i]; p < Ap[i + 1]; ++p)
+            {
+              if (Aj[p] != i)
+                sum -= Ad[p] * gsl_vector_get(x, Aj[p]);
+            }
+
+          gsl_vector_set(x, i, sum * lev->dinv[i]);
+        }
+    }
+} /* amg_smooth() */
+
+static const gsl_splinalg_precon_type amg_type =
+{
+  "amg",
+  &amg_alloc,
+  &amg_init,
+  &amg_apply,
+  &amg_free
+};
+
+const gsl_splinalg_precon_type * gsl_splinalg_precon_amg = &amg_type;
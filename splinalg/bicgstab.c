@@ -0,0 +1,352 @@
+/* bicgstab.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Biconjugate gradient stabilized method for general nonsymmetric
+ * systems
+ *
+ * [1] H. A. van der Vorst, Bi-CGSTAB: A fast and smoothly converging
+ *     variant of Bi-CG for the solution of nonsymmetric linear systems,
+ *     SIAM J. Sci. Stat. Comput. 13(2), 1992.
+ *
+ * [2] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* iterations per call */
+  gsl_vector *r;   /* residual vector */
+  gsl_vector *r0;  /* shadow residual */
+  gsl_vector *p;   /* search direction */
+  gsl_vector *v;   /* v = A p */
+  gsl_vector *t;   /* t = A s */
+  gsl_vector *ph;  /* preconditioned search direction */
+  gsl_vector *sh;  /* preconditioned intermediate residual */
+
+  double normr;    /* residual norm ||r|| */
+} bicgstab_state_t;
+
+static void bicgstab_free(void *vstate);
+static int bicgstab_op(const gsl_spmatrix *A, gsl_splinalg_precon *P,
+                       const int side, const gsl_vector *x,
+                       gsl_vector *xh, gsl_vector *y);
+
+/*
+bicgstab_alloc()
+  Allocate a BiCGSTAB workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - maximum number of iterations in each call to
+            gsl_splinalg_itersolve_iterate; if 0, n is used
+
+Return: pointer to workspace
+*/
+
+static void *
+bicgstab_alloc(const size_t n, const size_t m)
+{
+  bicgstab_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(bicgstab_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate bicgstab state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+
+  state->r = gsl_vector_alloc(n);
+  state->r0 = gsl_vector_alloc(n);
+  state->p = gsl_vector_alloc(n);
+  state->v = gsl_vector_alloc(n);
+  state->t = gsl_vector_alloc(n);
+  state->ph = gsl_vector_alloc(n);
+  state->sh = gsl_vector_alloc(n);
+  if (!state->r || !state->r0 || !state->p || !state->v ||
+      !state->t || !state->ph || !state->sh)
+    {
+      bicgstab_free(state);
+      GSL_ERROR_NULL("failed to allocate bicgstab vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* bicgstab_alloc() */
+
+static void
+bicgstab_free(void *vstate)
+{
+  bicgstab_state_t *state = (bicgstab_state_t *) vstate;
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->r0)
+    gsl_vector_free(state->r0);
+
+  if (state->p)
+    gsl_vector_free(state->p);
+
+  if (state->v)
+    gsl_vector_free(state->v);
+
+  if (state->t)
+    gsl_vector_free(state->t);
+
+  if (state->ph)
+    gsl_vector_free(state->ph);
+
+  if (state->sh)
+    gsl_vector_free(state->sh);
+
+  gsl_free(state);
+} /* bicgstab_free() */
+
+/*
+bicgstab_iterate()
+  Solve A*x = b using the BiCGSTAB algorithm
+
+Inputs: A    - sparse square matrix
+        b    - right hand side vector
+        tol  - stopping tolerance, ||b - A*x|| <= tol * ||b||
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - preconditioner M, or NULL
+        side - GSL_SPLINALG_PRECON_LEFT: iterate on M^{-1} A x = M^{-1} b
+               GSL_SPLINALG_PRECON_RIGHT: iterate on A M^{-1} y = b
+        work - workspace
+
+Return: GSL_SUCCESS if converged, GSL_CONTINUE if the maximum number
+of iterations was reached first or the method broke down; further
+calls restart the method from the current x with a new shadow residual
+
+Notes:
+1) Algorithm 7.7 of (Saad, 2003 [2]); the intermediate residual s is
+stored in r
+
+2) With left preconditioning, the iterations stop when the
+preconditioned residual has been reduced by the factor needed to bring
+the true residual below tol * ||b||, assuming ||M^{-1} r|| / ||r|| keeps
+its initial value; a restart therefore always makes progress while the
+true residual is too large. The returned status is always based on the
+true residual
+*/
+
+static int
+bicgstab_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                 const double tol, gsl_vector *x,
+                 gsl_splinalg_precon *P, const int side,
+                 void *vstate)
+{
+  const size_t N = A->size1;
+  bicgstab_state_t *state = (bicgstab_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const int left = (P != NULL && side == GSL_SPLINALG_PRECON_LEFT);
+      const double reltol = tol * gsl_blas_dnrm2(b);
+      double inner_tol = reltol;
+      gsl_vector *r = state->r;
+      gsl_vector *r0 = state->r0;
+      gsl_vector *p = state->p;
+      gsl_vector *v = state->v;
+      gsl_vector *t = state->t;
+      double rho, rho_old = 1.0, alpha = 1.0, omega = 1.0;
+      size_t iter;
+      int status;
+
+      /* r = b - A x, or M^{-1} (b - A x) */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+
+      if (left)
+        {
+          const double normr0 = gsl_blas_dnrm2(r);
+
+          status = gsl_splinalg_precon_apply(r, r, P);
+          if (status)
+            return status;
+
+          inner_tol = (normr0 > 0.0) ?
+                      reltol * (gsl_blas_dnrm2(r) / normr0) : 0.0;
+        }
+
+      gsl_vector_memcpy(r0, r);
+      gsl_vector_set_zero(p);
+      gsl_vector_set_zero(v);
+
+      for (iter = 0; iter < state->maxit; ++iter)
+        {
+          double beta, r0v, ts, tt;
+
+          if (gsl_blas_dnrm2(r) <= inner_tol)
+            break;
+
+          gsl_blas_ddot(r0, r, &rho);
+          if (rho == 0.0)
+            break; /* breakdown, restart on next call */
+
+          /* p = r + beta (p - omega v) */
+          beta = (rho / rho_old) * (alpha / omega);
+          gsl_blas_daxpy(-omega, v, p);
+          gsl_vector_scale(p, beta);
+          gsl_vector_add(p, r);
+
+          /* v = op(p) */
+          status = bicgstab_op(A, P, side, p, state->ph, v);
+          if (status)
+            return status;
+
+          gsl_blas_ddot(r0, v, &r0v);
+          if (r0v == 0.0)
+            break;
+
+          alpha = rho / r0v;
+
+          /* s = r - alpha v, stored in r; x += alpha ph */
+          gsl_blas_daxpy(-alpha, v, r);
+          gsl_blas_daxpy(alpha, state->ph, x);
+
+          if (gsl_blas_dnrm2(r) <= inner_tol)
+            break;
+
+          /* t = op(s) */
+          status = bicgstab_op(A, P, side, r, state->sh, t);
+          if (status)
+            return status;
+
+          gsl_blas_ddot(t, r, &ts);
+          gsl_blas_ddot(t, t, &tt);
+          if (tt == 0.0)
+            break;
+
+          omega = ts / tt;
+
+          /* x += omega sh, r = s - omega t */
+          gsl_blas_daxpy(omega, state->sh, x);
+          gsl_blas_daxpy(-omega, t, r);
+
+          rho_old = rho;
+
+          if (omega == 0.0)
+            break;
+        }
+
+      /* compute true residual r = b - A*x */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      state->normr = gsl_blas_dnrm2(r);
+
+      if (state->normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* bicgstab_iterate() */
+
+/*
+bicgstab_op()
+  Apply the (preconditioned) operator to x
+
+Inputs: A    - matrix
+        P    - preconditioner, or NULL
+        side - preconditioning side
+        x    - input vector
+        xh   - (output) vector by which the solution is updated:
+               M^{-1} x for right preconditioning, x otherwise
+        y    - (output) A M^{-1} x, M^{-1} A x or A x
+*/
+
+static int
+bicgstab_op(const gsl_spmatrix *A, gsl_splinalg_precon *P, const int side,
+            const gsl_vector *x, gsl_vector *xh, gsl_vector *y)
+{
+  int status = GSL_SUCCESS;
+
+  if (P != NULL && side == GSL_SPLINALG_PRECON_RIGHT)
+    status = gsl_splinalg_precon_apply(x, xh, P);
+  else
+    gsl_vector_memcpy(xh, x);
+
+  if (status)
+    return status;
+
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, xh, 0.0, y);
+
+  if (P != NULL && side == GSL_SPLINALG_PRECON_LEFT)
+    status = gsl_splinalg_precon_apply(y, y, P);
+
+  return status;
+} /* bicgstab_op() */
+
+static double
+bicgstab_normr(const void *vstate)
+{
+  const bicgstab_state_t *state = (const bicgstab_state_t *) vstate;
+  return state->normr;
+} /* bicgstab_normr() */
+
+static const gsl_splinalg_itersolve_type bicgstab_type =
+{
+  "bicgstab",
+  &bicgstab_alloc,
+  &bicgstab_iterate,
+  &bicgstab_normr,
+  &bicgstab_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_bicgstab =
+  &bicgstab_type;
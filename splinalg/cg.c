@@ -0,0 +1,496 @@
+/* cg.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Preconditioned conjugate gradient method for symmetric positive
+ * definite systems, in its classical form and in the pipelined
+ * form of Ghysels and Vanroose, which needs a single reduction per
+ * iteration.
+ *
+ * In shared memory there is no asynchronous reduction for the
+ * pipelined form to hide behind the matrix-vector product; what it
+ * offers here is that the inner products of an iteration are merged
+ * into one pass, i.e. one synchronization point instead of two. This
+ * is the same property which gmres_cgs.c obtains for GMRES from a
+ * single product with the basis, which is why GMRES has no separate
+ * pipelined variant.
+ *
+ * [1] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003.
+ *
+ * [2] P. Ghysels and W. Vanroose, Hiding global synchronization
+ *     latency in the preconditioned conjugate gradient algorithm,
+ *     Parallel Computing 40(7), 2014.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* iterations per call */
+  int pipelined;   /* use pipelined recurrences */
+  gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_vector *u;   /* preconditioned residual u = M^{-1} r */
+  gsl_vector *p;   /* search direction */
+  gsl_vector *s;   /* s = A p */
+
+  /* additional vectors for the pipelined variant */
+  gsl_vector *w;   /* w = A u */
+  gsl_vector *m;   /* m = M^{-1} w */
+  gsl_vector *nv;  /* nv = A m */
+  gsl_vector *q;   /* q = M^{-1} s */
+  gsl_vector *z;   /* z = A q */
+
+  double normr;    /* residual norm ||r|| */
+} cg_state_t;
+
+static void *cg_alloc_type(const size_t n, const size_t m,
+                           const int pipelined);
+static void cg_free(void *vstate);
+static int cg_precon(gsl_splinalg_precon *P, const gsl_vector *r,
+                     gsl_vector *z);
+static int cg_finish(const gsl_spmatrix *A, const gsl_vector *b,
+                     const double reltol, const gsl_vector *x,
+                     cg_state_t *state);
+
+static void *
+cg_alloc(const size_t n, const size_t m)
+{
+  return cg_alloc_type(n, m, 0);
+}
+
+static void *
+cg_pipelined_alloc(const size_t n, const size_t m)
+{
+  return cg_alloc_type(n, m, 1);
+}
+
+/*
+cg_alloc_type()
+  Allocate a CG workspace for solving an n-by-n system A x = b
+
+Inputs: n         - size of system
+        m         - maximum number of iterations in each call to
+                    gsl_splinalg_itersolve_iterate; if 0, n is used
+        pipelined - allocate the vectors of the pipelined variant
+
+Return: pointer to workspace
+*/
+
+static void *
+cg_alloc_type(const size_t n, const size_t m, const int pipelined)
+{
+  cg_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(cg_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate cg state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+  state->pipelined = pipelined;
+
+  state->r = gsl_vector_alloc(n);
+  state->u = gsl_vector_alloc(n);
+  state->p = gsl_vector_alloc(n);
+  state->s = gsl_vector_alloc(n);
+  if (!state->r || !state->u || !state->p || !state->s)
+    {
+      cg_free(state);
+      GSL_ERROR_NULL("failed to allocate cg vectors", GSL_ENOMEM);
+    }
+
+  if (pipelined)
+    {
+      state->w = gsl_vector_alloc(n);
+      state->m = gsl_vector_alloc(n);
+      state->nv = gsl_vector_alloc(n);
+      state->q = gsl_vector_alloc(n);
+      state->z = gsl_vector_alloc(n);
+      if (!state->w || !state->m || !state->nv || !state->q || !state->z)
+        {
+          cg_free(state);
+          GSL_ERROR_NULL("failed to allocate pipelined cg vectors",
+                         GSL_ENOMEM);
+        }
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* cg_alloc_type() */
+
+static void
+cg_free(void *vstate)
+{
+  cg_state_t *state = (cg_state_t *) vstate;
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->u)
+    gsl_vector_free(state->u);
+
+  if (state->p)
+    gsl_vector_free(state->p);
+
+  if (state->s)
+    gsl_vector_free(state->s);
+
+  if (state->w)
+    gsl_vector_free(state->w);
+
+  if (state->m)
+    gsl_vector_free(state->m);
+
+  if (state->nv)
+    gsl_vector_free(state->nv);
+
+  if (state->q)
+    gsl_vector_free(state->q);
+
+  if (state->z)
+    gsl_vector_free(state->z);
+
+  gsl_free(state);
+} /* cg_free() */
+
+/*
+cg_iterate()
+  Solve A*x = b using the preconditioned conjugate gradient method
+
+Inputs: A    - sparse symmetric positive definite matrix
+        b    - right hand side vector
+        tol  - stopping tolerance, ||b - A*x|| <= tol * ||b||
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - symmetric positive definite preconditioner M, or NULL
+        side - ignored; left and right preconditioned CG generate
+               the same iterates
+        work - workspace
+
+Return: GSL_SUCCESS if converged, GSL_CONTINUE if the maximum number
+of iterations was reached first; further calls restart the method
+from the current x
+
+Notes:
+1) Algorithm 9.1 of (Saad, 2003 [1])
+*/
+
+static int
+cg_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+           const double tol, gsl_vector *x,
+           gsl_splinalg_precon *P, const int side,
+           void *vstate)
+{
+  const size_t N = A->size1;
+  cg_state_t *state = (cg_state_t *) vstate;
+
+  (void) side;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const double reltol = tol * gsl_blas_dnrm2(b);
+      gsl_vector *r = state->r;
+      gsl_vector *u = state->u;
+      gsl_vector *p = state->p;
+      gsl_vector *s = state->s;
+      double rho, rho_old = 0.0;
+      size_t iter;
+      int status;
+
+      /* r = b - A x */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+
+      for (iter = 0; iter < state->maxit; ++iter)
+        {
+          double pAp, alpha;
+
+          if (gsl_blas_dnrm2(r) <= reltol)
+            break;
+
+          /* u = M^{-1} r */
+          status = cg_precon(P, r, u);
+          if (status)
+            return status;
+
+          gsl_blas_ddot(r, u, &rho);
+
+          /* p = u + (rho / rho_old) p */
+          if (iter == 0)
+            {
+              gsl_vector_memcpy(p, u);
+            }
+          else
+            {
+              gsl_vector_scale(p, rho / rho_old);
+              gsl_vector_add(p, u);
+            }
+
+          /* s = A p */
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, p, 0.0, s);
+          gsl_blas_ddot(p, s, &pAp);
+
+          if (pAp <= 0.0)
+            {
+              GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+            }
+
+          alpha = rho / pAp;
+          gsl_blas_daxpy(alpha, p, x);
+          gsl_blas_daxpy(-alpha, s, r);
+
+          rho_old = rho;
+        }
+
+      return cg_finish(A, b, reltol, x, state);
+    }
+} /* cg_iterate() */
+
+/*
+cg_pipelined_iterate()
+  Solve A*x = b using the pipelined preconditioned conjugate
+gradient method
+
+Inputs: see cg_iterate()
+
+Return: see cg_iterate()
+
+Notes:
+1) Algorithm 3 of (Ghysels and Vanroose, 2014 [2]). The three inner
+products of each iteration are computed in a single pass over the
+vectors, which is followed by the preconditioner and matrix-vector
+product and a single fused pass for the vector updates. This replaces
+the two separate reductions of classical CG, and reads each vector
+once per phase.
+
+2) The recurrences for r, u and w accumulate rounding errors faster
+than those of classical CG; the final residual is recomputed from x,
+so the returned status is always based on the true residual
+*/
+
+static int
+cg_pipelined_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                     const double tol, gsl_vector *x,
+                     gsl_splinalg_precon *P, const int side,
+                     void *vstate)
+{
+  const size_t N = A->size1;
+  cg_state_t *state = (cg_state_t *) vstate;
+
+  (void) side;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const double reltol = tol * gsl_blas_dnrm2(b);
+      double *r = state->r->data;
+      double *u = state->u->data;
+      double *w = state->w->data;
+      double *m = state->m->data;
+      double *nv = state->nv->data;
+      double *p = state->p->data;
+      double *s = state->s->data;
+      double *q = state->q->data;
+      double *z = state->z->data;
+      double gamma, gamma_old = 0.0, alpha = 0.0;
+      size_t iter, i;
+      int status;
+
+      /* r = b - A x, u = M^{-1} r, w = A u */
+      gsl_vector_memcpy(state->r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, state->r);
+
+      status = cg_precon(P, state->r, state->u);
+      if (status)
+        return status;
+
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, A, state->u, 0.0, state->w);
+
+      /* the first iteration uses beta = 0 */
+      gsl_vector_set_zero(state->z);
+      gsl_vector_set_zero(state->q);
+      gsl_vector_set_zero(state->s);
+      gsl_vector_set_zero(state->p);
+
+      for (iter = 0; iter < state->maxit; ++iter)
+        {
+          double delta = 0.0, rr = 0.0, beta;
+
+          /* single reduction: gamma = (r,u), delta = (w,u), rr = (r,r) */
+          gamma = 0.0;
+          for (i = 0; i < N; ++i)
+            {
+              gamma += r[i] * u[i];
+              delta += w[i] * u[i];
+              rr += r[i] * r[i];
+            }
+
+          if (sqrt(rr) <= reltol)
+            break;
+
+          /* m = M^{-1} w, nv = A m */
+          status = cg_precon(P, state->w, state->m);
+          if (status)
+            return status;
+
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, state->m, 0.0, state->nv);
+
+          if (iter == 0)
+            {
+              beta = 0.0;
+              alpha = gamma / delta;
+            }
+          else
+            {
+              beta = gamma / gamma_old;
+              alpha = gamma / (delta - beta * gamma / alpha);
+            }
+
+          if (!(alpha > 0.0) || !gsl_finite(alpha))
+            {
+              GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+            }
+
+          /* fused updates of the search directions and recurrences */
+          for (i = 0; i < N; ++i)
+            {
+              z[i] = nv[i] + beta * z[i];
+              q[i] = m[i] + beta * q[i];
+              s[i] = w[i] + beta * s[i];
+              p[i] = u[i] + beta * p[i];
+              r[i] -= alpha * s[i];
+              u[i] -= alpha * q[i];
+              w[i] -= alpha * z[i];
+            }
+
+          gsl_blas_daxpy(alpha, state->p, x);
+
+          gamma_old = gamma;
+        }
+
+      return cg_finish(A, b, reltol, x, state);
+    }
+} /* cg_pipelined_iterate() */
+
+/* z = M^{-1} r, or z = r without a preconditioner */
+static int
+cg_precon(gsl_splinalg_precon *P, const gsl_vector *r, gsl_vector *z)
+{
+  if (P)
+    return gsl_splinalg_precon_apply(r, z, P);
+
+  gsl_vector_memcpy(z, r);
+
+  return GSL_SUCCESS;
+}
+
+/* compute the true residual norm and test for convergence */
+static int
+cg_finish(const gsl_spmatrix *A, const gsl_vector *b, const double reltol,
+          const gsl_vector *x, cg_state_t *state)
+{
+  gsl_vector_memcpy(state->r, b);
+  gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, state->r);
+  state->normr = gsl_blas_dnrm2(state->r);
+
+  if (state->normr <= reltol)
+    return GSL_SUCCESS;
+  else
+    return GSL_CONTINUE;
+}
+
+static double
+cg_normr(const void *vstate)
+{
+  const cg_state_t *state = (const cg_state_t *) vstate;
+  return state->normr;
+} /* cg_normr() */
+
+static const gsl_splinalg_itersolve_type cg_type =
+{
+  "cg",
+  &cg_alloc,
+  &cg_iterate,
+  &cg_normr,
+  &cg_free
+};
+
+static const gsl_splinalg_itersolve_type cg_pipelined_type =
+{
+  "cg-pipelined",
+  &cg_pipelined_alloc,
+  &cg_pipelined_iterate,
+  &cg_normr,
+  &cg_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg = &cg_type;
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg_pipelined =
+  &cg_pipelined_type;
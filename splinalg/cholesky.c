@@ -0,0 +1,748 @@
+/* splinalg/cholesky.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Supernodal sparse Cholesky factorization A = L L^T
+ *
+ * The symbolic phase computes the elimination tree and column counts
+ * of L, groups columns with identical structure below the diagonal
+ * into fundamental supernodes and computes the row structure of each
+ * supernode. The numeric phase is a left-looking supernodal
+ * factorization: each supernode is stored as a dense column-major
+ * block, the updates from descendant supernodes are computed with
+ * dgemm and the supernode itself is factored as a dense panel.
+ *
+ * [1] J. W. H. Liu, The role of elimination trees in sparse
+ *     factorization, SIAM J. Matrix Anal. Appl. 11(1), 1990.
+ *
+ * [2] E. G. Ng and B. W. Peyton, Block sparse Cholesky algorithms on
+ *     advanced uniprocessor computers, SIAM J. Sci. Comput. 14(5), 1993.
+ *
+ * [3] T. A. Davis, Direct methods for sparse linear systems, SIAM, 2006.
+ */
+
+static gsl_spmatrix *cholesky_ccs(const gsl_spmatrix *A);
+static int cholesky_cmp(const void *a, const void *b);
+
+/*
+gsl_splinalg_cholesky_alloc()
+  Allocate a workspace for the sparse Cholesky factorization of
+n-by-n matrices
+
+Inputs: n - size of matrices
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_cholesky_workspace *
+gsl_splinalg_cholesky_alloc(const size_t n)
+{
+  gsl_splinalg_cholesky_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = gsl_calloc(1, sizeof(gsl_splinalg_cholesky_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate cholesky workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->parent = gsl_malloc(n * sizeof(size_t));
+  w->super = gsl_malloc((n + 1) * sizeof(size_t));
+  w->snode = gsl_malloc(n * sizeof(size_t));
+  w->Lpi = gsl_malloc((n + 1) * sizeof(size_t));
+  w->Lpx = gsl_malloc((n + 1) * sizeof(size_t));
+  w->work = gsl_malloc(4 * n * sizeof(size_t));
+  if (!w->parent || !w->super || !w->snode || !w->Lpi || !w->Lpx ||
+      !w->work)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate cholesky index arrays", GSL_ENOMEM);
+    }
+
+  return w;
+} /* gsl_splinalg_cholesky_alloc() */
+
+void
+gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace *w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->parent)
+    gsl_free(w->parent);
+
+  if (w->super)
+    gsl_free(w->super);
+
+  if (w->snode)
+    gsl_free(w->snode);
+
+  if (w->Lpi)
+    gsl_free(w->Lpi);
+
+  if (w->Lpx)
+    gsl_free(w->Lpx);
+
+  if (w->Li)
+    gsl_free(w->Li);
+
+  if (w->Lx)
+    gsl_free(w->Lx);
+
+  if (w->W)
+    gsl_free(w->W);
+
+  if (w->work)
+    gsl_free(w->work);
+
+  gsl_free(w);
+} /* gsl_splinalg_cholesky_free() */
+
+/*
+gsl_splinalg_cholesky_symbolic()
+  Compute the supernodal structure of the Cholesky factor of A
+
+Inputs: A - symmetric sparse matrix in triplet or compressed format;
+            only the elements on and below the diagonal are referenced
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) After this call, w->nsuper and w->nnz give the number of
+supernodes and the number of non-zero elements of L
+*/
+
+int
+gsl_splinalg_cholesky_symbolic(const gsl_spmatrix *A,
+                               gsl_splinalg_cholesky_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_spmatrix *C = cholesky_ccs(A);
+      size_t *parent = w->parent;
+      size_t *colcount = w->work;        /* column counts of L */
+      size_t *mark = w->work + n;        /* row stamps */
+      size_t *ancestor = w->work + 2 * n;
+      size_t *Rp, *Ri;                   /* lower triangle by rows */
+      size_t *child, *cnext;             /* child supernode lists */
+      size_t i, j, k, p, s, nsuper, maxw;
+      void *ptr;
+
+      if (!C)
+        return GSL_ENOMEM;
+
+      /* row structure of the strictly lower triangle */
+      Rp = gsl_calloc(n + 1, sizeof(size_t));
+      Ri = gsl_malloc((C->nz + 1) * sizeof(size_t));
+      if (!Rp || !Ri)
+        {
+          gsl_free(Rp);
+          gsl_free(Ri);
+          if (C != A)
+            gsl_spmatrix_free(C);
+          GSL_ERROR("failed to allocate row structure", GSL_ENOMEM);
+        }
+
+      for (j = 0; j < n; ++j)
+        {
+          for (p = C->p[j]; p < C->p[j + 1]; ++p)
+            {
+              if (C->i[p] > j)
+                Rp[C->i[p] + 1]++;
+            }
+        }
+
+      for (i = 0; i < n; ++i)
+        Rp[i + 1] += Rp[i];
+
+      memcpy(mark, Rp, n * sizeof(size_t));
+
+      for (j = 0; j < n; ++j)
+        {
+          for (p = C->p[j]; p < C->p[j + 1]; ++p)
+            {
+              i = C->i[p];
+              if (i > j)
+                Ri[mark[i]++] = j;
+            }
+        }
+
+      /* elimination tree, with path compression through ancestor */
+      for (k = 0; k < n; ++k)
+        {
+          parent[k] = n;
+          ancestor[k] = n;
+
+          for (p = Rp[k]; p < Rp[k + 1]; ++p)
+            {
+              size_t r = Ri[p];
+
+              while (r != n && r < k)
+                {
+                  size_t next = ancestor[r];
+
+                  ancestor[r] = k;
+                  if (next == n)
+                    parent[r] = k;
+
+                  r = next;
+                }
+            }
+        }
+
+      /* column counts: row k of L is the union of the tree paths from
+       * the columns of row k of A up to k */
+      for (k = 0; k < n; ++k)
+        mark[k] = n;
+
+      for (k = 0; k < n; ++k)
+        {
+          colcount[k] = 1;
+          mark[k] = k;
+
+          for (p = Rp[k]; p < Rp[k + 1]; ++p)
+            {
+              size_t r = Ri[p];
+
+              while (mark[r] != k)
+                {
+                  ++colcount[r];
+                  mark[r] = k;
+                  r = parent[r];
+                }
+            }
+        }
+
+      /* fundamental supernodes: j joins the supernode of j - 1 if j - 1
+       * is the only child of j and their structures match */
+      for (j = 0; j < n; ++j)
+        ancestor[j] = 0; /* number of children */
+
+      for (j = 0; j < n; ++j)
+        {
+          if (parent[j] != n)
+            ++ancestor[parent[j]];
+        }
+
+      nsuper = 0;
+      for (j = 0; j < n; ++j)
+        {
+          if (j == 0 || parent[j - 1] != j || ancestor[j] != 1 ||
+              colcount[j - 1] != colcount[j] + 1)
+            {
+              w->super[nsuper++] = j;
+            }
+
+          w->snode[j] = nsuper - 1;
+        }
+
+      w->super[nsuper] = n;
+      w->nsuper = nsuper;
+
+      /* sizes of the row structures and value blocks */
+      w->Lpi[0] = 0;
+      w->Lpx[0] = 0;
+      w->nnz = 0;
+      maxw = 1;
+      for (s = 0; s < nsuper; ++s)
+        {
+          const size_t f = w->super[s];
+          const size_t nc = w->super[s + 1] - f;
+          const size_t nr = colcount[f];
+
+          w->Lpi[s + 1] = w->Lpi[s] + nr;
+          w->Lpx[s + 1] = w->Lpx[s] + nr * nc;
+          w->nnz += nr * nc - nc * (nc - 1) / 2;
+          maxw = GSL_MAX(maxw, nr * nc);
+        }
+
+      ptr = gsl_realloc(w->Li,
+                        GSL_MAX(w->Lpi[nsuper], 1) * sizeof(size_t));
+      if (ptr)
+        {
+          w->Li = ptr;
+          ptr = gsl_realloc(w->Lx,
+                            GSL_MAX(w->Lpx[nsuper], 1) * sizeof(double));
+        }
+
+      if (ptr)
+        {
+          w->Lx = ptr;
+          ptr = gsl_realloc(w->W, maxw * sizeof(double));
+        }
+
+      if (!ptr)
+        {
+          gsl_free(Rp);
+          gsl_free(Ri);
+          if (C != A)
+            gsl_spmatrix_free(C);
+          GSL_ERROR("failed to allocate cholesky factor", GSL_ENOMEM);
+        }
+
+      w->W = ptr;
+
+      /* row structure of each supernode: its own columns, the rows of
+       * A below the supernode, and the rows of its children below the
+       * supernode; children always precede their parent */
+      child = ancestor;
+      cnext = Rp; /* no longer needed for row lists after this point */
+      gsl_free(Ri);
+
+      for (s = 0; s < nsuper; ++s)
+        child[s] = nsuper;
+
+      for (s = 0; s < n; ++s)
+        mark[s] = nsuper;
+
+      for (s = 0; s < nsuper; ++s)
+        {
+          const size_t f = w->super[s];
+          const size_t l = w->super[s + 1] - 1;
+          size_t *rows = w->Li + w->Lpi[s];
+          size_t nr = 0, c;
+
+          for (j = f; j <= l; ++j)
+            {
+              rows[nr++] = j;
+              mark[j] = s;
+            }
+
+          for (j = f; j <= l; ++j)
+            {
+              for (p = C->p[j]; p < C->p[j + 1]; ++p)
+                {
+                  i = C->i[p];
+                  if (i > l && mark[i] != s)
+                    {
+                      rows[nr++] = i;
+                      mark[i] = s;
+                    }
+                }
+            }
+
+          for (c = child[s]; c != nsuper; c = cnext[c])
+            {
+              const size_t *crows = w->Li + w->Lpi[c];
+              const size_t cnr = w->Lpi[c + 1] - w->Lpi[c];
+
+              for (p = 0; p < cnr; ++p)
+                {
+                  i = crows[p];
+                  if (i > l && mark[i] != s)
+                    {
+                      rows[nr++] = i;
+                      mark[i] = s;
+                    }
+                }
+            }
+
+          qsort(rows + (l - f + 1), nr - (l - f + 1), sizeof(size_t),
+                cholesky_cmp);
+
+          /* link s into the child list of its parent supernode */
+          if (parent[l] != n)
+            {
+              const size_t ps = w->snode[parent[l]];
+
+              cnext[s] = child[ps];
+              child[ps] = s;
+            }
+        }
+
+      gsl_free(Rp);
+      if (C != A)
+        gsl_spmatrix_free(C);
+
+      w->factored = 0;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_cholesky_symbolic() */
+
+/*
+gsl_splinalg_cholesky_numeric()
+  Compute the numerical values of the Cholesky factor of A, whose
+structure was analyzed by gsl_splinalg_cholesky_symbolic()
+
+Inputs: A - symmetric positive definite sparse matrix; its pattern
+            must be contained in the pattern given to the symbolic
+            phase. Only elements on and below the diagonal are
+            referenced
+        w - workspace
+
+Return: success/error; GSL_EDOM if A is not positive definite and
+GSL_EINVAL if A has an element outside the analyzed pattern
+
+Notes:
+1) This function may be called repeatedly to refactor matrices with
+the same pattern and new values
+*/
+
+int
+gsl_splinalg_cholesky_numeric(const gsl_spmatrix *A,
+                              gsl_splinalg_cholesky_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (w->Li == NULL)
+    {
+      GSL_ERROR("symbolic factorization has not been computed", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t nsuper = w->nsuper;
+      gsl_spmatrix *C = cholesky_ccs(A);
+      size_t *map = w->work;             /* row to position in supernode */
+      size_t *head = w->work + n;        /* supernodes updating s */
+      size_t *next = w->work + 2 * n;
+      size_t *pos = w->work + 3 * n;     /* next row to use in update */
+      int status = GSL_SUCCESS;
+      size_t s, j, p;
+
+      if (!C)
+        return GSL_ENOMEM;
+
+      w->factored = 0;
+
+      for (j = 0; j < n; ++j)
+        map[j] = n;
+
+      for (s = 0; s < nsuper; ++s)
+        head[s] = nsuper;
+
+      for (s = 0; s < nsuper && status == GSL_SUCCESS; ++s)
+        {
+          const size_t f = w->super[s];
+          const size_t l = w->super[s + 1] - 1;
+          const size_t nc = l - f + 1;
+          const size_t nr = w->Lpi[s + 1] - w->Lpi[s];
+          const size_t *rows = w->Li + w->Lpi[s];
+          double *Ls = w->Lx + w->Lpx[s];
+          size_t d, dnext, c, c2, r;
+
+          for (r = 0; r < nr; ++r)
+            map[rows[r]] = r;
+
+          /* scatter columns f..l of the lower triangle of A */
+          memset(Ls, 0, nr * nc * sizeof(double));
+
+          for (j = f; j <= l && status == GSL_SUCCESS; ++j)
+            {
+              for (p = C->p[j]; p < C->p[j + 1]; ++p)
+                {
+                  const size_t i = C->i[p];
+
+                  if (i < j)
+                    continue;
+
+                  if (map[i] == n)
+                    {
+                      status = GSL_EINVAL;
+                      break;
+                    }
+
+                  Ls[(j - f) * nr + map[i]] += C->data[p];
+                }
+            }
+
+          /* apply the updates of all descendant supernodes d with rows
+           * in columns f..l: L(I,f:l) -= L(I,d) L(J,d)^T, where J are
+           * the rows of d in f..l and I all rows of d from J onward */
+          for (d = head[s]; d != nsuper && status == GSL_SUCCESS; d = dnext)
+            {
+              const size_t dnc = w->super[d + 1] - w->super[d];
+              const size_t dnr = w->Lpi[d + 1] - w->Lpi[d];
+              const size_t *drows = w->Li + w->Lpi[d];
+              const size_t p0 = pos[d];
+              size_t p1 = p0, nI, nJ, ii, jj;
+
+              dnext = next[d];
+
+              while (p1 < dnr && drows[p1] <= l)
+                ++p1;
+
+              nJ = p1 - p0;
+              nI = dnr - p0;
+
+              {
+                /* supernode d viewed as the dnc-by-dnr matrix L(:,d)^T */
+                gsl_matrix_view Vd =
+                  gsl_matrix_view_array(w->Lx + w->Lpx[d], dnc, dnr);
+                gsl_matrix_view Vj =
+                  gsl_matrix_submatrix(&Vd.matrix, 0, p0, dnc, nJ);
+                gsl_matrix_view Vi =
+                  gsl_matrix_submatrix(&Vd.matrix, 0, p0, dnc, nI);
+                gsl_matrix_view Wv = gsl_matrix_view_array(w->W, nJ, nI);
+
+                /* W = L(J,d) L(I,d)^T */
+                gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &Vj.matrix,
+                               &Vi.matrix, 0.0, &Wv.matrix);
+              }
+
+              for (jj = 0; jj < nJ; ++jj)
+                {
+                  double *Lcol = Ls + (drows[p0 + jj] - f) * nr;
+                  const double *Wrow = w->W + jj * nI;
+
+                  for (ii = jj; ii < nI; ++ii)
+                    Lcol[map[drows[p0 + ii]]] -= Wrow[ii];
+                }
+
+              /* move d on to the supernode of its next row */
+              pos[d] = p1;
+              if (p1 < dnr)
+                {
+                  const size_t t = w->snode[drows[p1]];
+
+                  next[d] = head[t];
+                  head[t] = d;
+                }
+            }
+
+          /* dense factorization of the supernode panel */
+          for (c = 0; c < nc && status == GSL_SUCCESS; ++c)
+            {
+              double *Lc = Ls + c * nr;
+              double lcc;
+
+              if (!(Lc[c] > 0.0)) /* also rejects NaN */
+                {
+                  status = GSL_EDOM;
+                  break;
+                }
+
+              lcc = sqrt(Lc[c]);
+              Lc[c] = lcc;
+
+              for (r = c + 1; r < nr; ++r)
+                Lc[r] /= lcc;
+
+              for (c2 = c + 1; c2 < nc; ++c2)
+                {
+                  double *Lc2 = Ls + c2 * nr;
+                  const double t = Lc[c2];
+
+                  for (r = c2; r < nr; ++r)
+                    Lc2[r] -= t * Lc[r];
+                }
+            }
+
+          for (r = 0; r < nr; ++r)
+            map[rows[r]] = n;
+
+          /* s will next update the supernode of its first off-diagonal row */
+          pos[s] = nc;
+          if (nc < nr)
+            {
+              const size_t t = w->snode[rows[nc]];
+
+              next[s] = head[t];
+              head[t] = s;
+            }
+        }
+
+      if (C != A)
+        gsl_spmatrix_free(C);
+
+      if (status == GSL_EINVAL)
+        {
+          GSL_ERROR("matrix has elements outside the symbolic pattern",
+                    GSL_EINVAL);
+        }
+      else if (status == GSL_EDOM)
+        {
+          GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+        }
+
+      w->factored = 1;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_cholesky_numeric() */
+
+/*
+gsl_splinalg_cholesky_solve()
+  Solve A x = b using the Cholesky factorization in w
+*/
+
+int
+gsl_splinalg_cholesky_solve(const gsl_splinalg_cholesky_workspace *w,
+                            const gsl_vector *b, gsl_vector *x)
+{
+  if (b->size != w->n)
+    {
+      GSL_ERROR("right hand side does not match workspace", GSL_EBADLEN);
+    }
+  else if (x->size != w->n)
+    {
+      GSL_ERROR("solution vector does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_vector_memcpy(x, b);
+      return gsl_splinalg_cholesky_svx(w, x);
+    }
+} /* gsl_splinalg_cholesky_solve() */
+
+/*
+gsl_splinalg_cholesky_svx()
+  Solve A x = b in place using the Cholesky factorization in w;
+on input x contains b
+*/
+
+int
+gsl_splinalg_cholesky_svx(const gsl_splinalg_cholesky_workspace *w,
+                          gsl_vector *x)
+{
+  if (x->size != w->n)
+    {
+      GSL_ERROR("solution vector does not match workspace", GSL_EBADLEN);
+    }
+  else if (!w->factored)
+    {
+      GSL_ERROR("numeric factorization has not been computed", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t stride = x->stride;
+      double *xd = x->data;
+      size_t s, c, r;
+
+      /* forward substitution L y = b */
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          const size_t f = w->super[s];
+          const size_t nc = w->super[s + 1] - f;
+          const size_t nr = w->Lpi[s + 1] - w->Lpi[s];
+          const size_t *rows = w->Li + w->Lpi[s];
+          const double *Ls = w->Lx + w->Lpx[s];
+
+          for (c = 0; c < nc; ++c)
+            {
+              const double *Lc = Ls + c * nr;
+              double xc = xd[(f + c) * stride] / Lc[c];
+
+              xd[(f + c) * stride] = xc;
+
+              for (r = c + 1; r < nr; ++r)
+                xd[rows[r] * stride] -= Lc[r] * xc;
+            }
+        }
+
+      /* back substitution L^T x = y */
+      for (s = w->nsuper; s-- > 0; )
+        {
+          const size_t f = w->super[s];
+          const size_t nc = w->super[s + 1] - f;
+          const size_t nr = w->Lpi[s + 1] - w->Lpi[s];
+          const size_t *rows = w->Li + w->Lpi[s];
+          const double *Ls = w->Lx + w->Lpx[s];
+
+          for (c = nc; c-- > 0; )
+            {
+              const double *Lc = Ls + c * nr;
+              double xc = xd[(f + c) * stride];
+
+              for (r = c + 1; r < nr; ++r)
+                xc -= Lc[r] * xd[rows[r] * stride];
+
+              xd[(f + c) * stride] = xc / Lc[c];
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_cholesky_svx() */
+
+/*
+cholesky_ccs()
+  Return A in compressed column format; A itself if it is already
+compressed column, otherwise a new matrix which must be freed
+*/
+
+static gsl_spmatrix *
+cholesky_ccs(const gsl_spmatrix *A)
+{
+  gsl_spmatrix *C;
+
+  if (GSL_SPMATRIX_ISCCS(A))
+    return (gsl_spmatrix *) A;
+
+  if (GSL_SPMATRIX_ISTRIPLET(A))
+    return gsl_spmatrix_compcol(A);
+
+  if (!GSL_SPMATRIX_ISCRS(A))
+    {
+      GSL_ERROR_NULL("matrix must be in triplet or compressed format",
+                     GSL_EINVAL);
+    }
+
+  C = gsl_spmatrix_alloc_nzmax(A->size1, A->size2, A->nz, GSL_SPMATRIX_CCS);
+  if (C)
+    gsl_spmatrix_switch_major(C, A);
+
+  return C;
+} /* cholesky_ccs() */
+
+static int
+cholesky_cmp(const void *a, const void *b)
+{
+  const size_t ia = *(const size_t *) a;
+  const size_t ib = *(const size_t *) b;
+
+  return (ia > ib) - (ia < ib);
+}
@@ -0,0 +1,268 @@
+/* splinalg/common.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+
+#include "common.h"
+
+/* helper routines shared by the preconditioners */
+
+/*
+precon_sell_crs()
+  Create a copy of a SELL-C-sigma matrix in compressed row format,
+undoing the row permutation and dropping the slice padding
+
+Inputs: A - sparse matrix in SELL format
+
+Return: pointer to new matrix (should be freed when finished with it)
+*/
+
+static gsl_spmatrix *
+precon_sell_crs(const gsl_spmatrix *A)
+{
+  const size_t M = A->size1;
+  const size_t C = A->slice;
+  gsl_spmatrix *R;
+  size_t s, w;
+
+  R = gsl_spmatrix_alloc_nzmax(M, A->size2, GSL_MAX(A->nz, 1),
+                               GSL_SPMATRIX_CRS);
+  if (!R)
+    return NULL;
+
+  /* stored row s holds matrix row perm[s] */
+  for (s = 0; s <= M; ++s)
+    R->p[s] = 0;
+
+  for (s = 0; s < M; ++s)
+    R->p[A->perm[s] + 1] = A->rowlen[s];
+
+  for (s = 0; s < M; ++s)
+    R->p[s + 1] += R->p[s];
+
+  for (s = 0; s < M; ++s)
+    {
+      const size_t offset = A->p[s / C] + s % C;
+      const size_t q = R->p[A->perm[s]];
+
+      for (w = 0; w < A->rowlen[s]; ++w)
+        {
+          R->i[q + w] = A->i[offset + w * C];
+          R->data[q + w] = A->data[offset + w * C];
+        }
+    }
+
+  R->nz = R->p[M];
+
+  return R;
+} /* precon_sell_crs() */
+
+/*
+splinalg_precon_crs()
+  Create a copy of A in compressed row format, with the column
+indices of each row sorted in increasing order
+
+Inputs: A - sparse matrix in triplet, compressed or SELL format
+
+Return: pointer to new matrix (should be freed when finished with it)
+*/
+
+gsl_spmatrix *
+splinalg_precon_crs(const gsl_spmatrix *A)
+{
+  gsl_spmatrix *S = NULL; /* compressed row copy of a SELL matrix */
+  gsl_spmatrix *C, *R;
+  int status = GSL_SUCCESS;
+
+  if (GSL_SPMATRIX_ISSELL(A))
+    {
+      S = precon_sell_crs(A);
+      if (!S)
+        return NULL;
+
+      A = S;
+    }
+
+  if (GSL_SPMATRIX_ISTRIPLET(A))
+    {
+      C = gsl_spmatrix_compcol(A);
+    }
+  else if (GSL_SPMATRIX_ISCCS(A))
+    {
+      C = (gsl_spmatrix *) A;
+    }
+  else if (GSL_SPMATRIX_ISCRS(A))
+    {
+      C = gsl_spmatrix_alloc_nzmax(A->size1, A->size2, GSL_MAX(A->nz, 1),
+                                   GSL_SPMATRIX_CCS);
+      if (C)
+        status = gsl_spmatrix_switch_major(C, A);
+    }
+  else
+    {
+      GSL_ERROR_NULL("matrix must be in triplet, compressed or SELL format",
+                     GSL_EINVAL);
+    }
+
+  R = NULL;
+
+  if (C && status == GSL_SUCCESS)
+    {
+      /* switching major order sorts the indices */
+      R = gsl_spmatrix_alloc_nzmax(A->size1, A->size2, GSL_MAX(C->nz, 1),
+                                   GSL_SPMATRIX_CRS);
+      if (R)
+        status = gsl_spmatrix_switch_major(R, C);
+    }
+
+  if (C && C != A)
+    gsl_spmatrix_free(C);
+
+  if (S)
+    gsl_spmatrix_free(S);
+
+  if (R && status)
+    {
+      gsl_spmatrix_free(R);
+      R = NULL;
+    }
+
+  return R;
+} /* splinalg_precon_crs() */
+
+/*
+splinalg_precon_lsolve()
+  Solve (I/dinv + omega L) x = b in place, where L is the strictly
+lower triangular part of the compressed row matrix A, whose column
+indices must be sorted; elements of A on or above the diagonal are
+ignored
+
+Inputs: A     - compressed row matrix with sorted indices
+        omega - scale factor for L
+        dinv  - inverse diagonal, or NULL for a unit diagonal
+        x     - (input/output) on input b, on output x
+*/
+
+void
+splinalg_precon_lsolve(const gsl_spmatrix *A, const double omega,
+                      const double *dinv, gsl_vector *x)
+{
+  const size_t N = A->size1;
+  const size_t *Ap = A->p;
+  const size_t *Aj = A->i;
+  const double *Ad = A->data;
+  size_t i, p;
+
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (p = Ap[i]; p < Ap[i + 1] && Aj[p] < i; ++p)
+        sum += Ad[p] * gsl_vector_get(x, Aj[p]);
+
+      sum = gsl_vector_get(x, i) - omega * sum;
+
+      gsl_vector_set(x, i, dinv ? sum * dinv[i] : sum);
+    }
+} /* splinalg_precon_lsolve() */
+
+/*
+splinalg_precon_usolve()
+  Solve (I/dinv + omega U) x = b in place, where U is the strictly
+upper triangular part of the compressed row matrix A, whose column
+indices must be sorted; elements of A on or below the diagonal are
+ignored
+
+Inputs: A     - compressed row matrix with sorted indices
+        omega - scale factor for U
+        dinv  - inverse diagonal, or NULL for a unit diagonal
+        x     - (input/output) on input b, on output x
+*/
+
+void
+splinalg_precon_usolve(const gsl_spmatrix *A, const double omega,
+                      const double *dinv, gsl_vector *x)
+{
+  const size_t N = A->size1;
+  const size_t *Ap = A->p;
+  const size_t *Aj = A->i;
+  const double *Ad = A->data;
+  size_t i, p;
+
+  for (i = N; i > 0 && i--; )
+    {
+      double sum = 0.0;
+
+      for (p = Ap[i + 1]; p > Ap[i] && Aj[p - 1] > i; --p)
+        sum += Ad[p - 1] * gsl_vector_get(x, Aj[p - 1]);
+
+      sum = gsl_vector_get(x, i) - omega * sum;
+
+      gsl_vector_set(x, i, dinv ? sum * dinv[i] : sum);
+    }
+} /* splinalg_precon_usolve() */
+
+/*
+splinalg_precon_diag()
+  Compute the inverse diagonal of a compressed row matrix, and
+optionally the position of the diagonal element in each row
+
+Inputs: A    - compressed row matrix
+        dinv - (output) 1 / A(i,i)
+        diag - (output) position of A(i,i) in A->data, or NULL
+
+Return: success, or GSL_ESING if a diagonal element is zero or missing
+*/
+
+int
+splinalg_precon_diag(const gsl_spmatrix *A, double *dinv,
+                     size_t *diag)
+{
+  size_t i, p;
+
+  for (i = 0; i < A->size1; ++i)
+    {
+      double aii = 0.0;
+
+      for (p = A->p[i]; p < A->p[i + 1]; ++p)
+        {
+          if (A->i[p] == i)
+            {
+              aii = A->data[p];
+              if (diag)
+                diag[i] = p;
+              break;
+            }
+        }
+
+      if (aii == 0.0)
+        {
+          GSL_ERROR("matrix has a zero diagonal element", GSL_ESING);
+        }
+
+      dinv[i] = 1.0 / aii;
+    }
+
+  return GSL_SUCCESS;
+} /* splinalg_precon_diag() */
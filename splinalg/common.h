@@ -0,0 +1,36 @@
+/* splinalg/common.h
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* internal routines shared by the preconditioners, see common.c */
+
+#ifndef __GSL_SPLINALG_COMMON_H__
+#define __GSL_SPLINALG_COMMON_H__
+
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_spmatrix.h>
+
+gsl_spmatrix *splinalg_precon_crs(const gsl_spmatrix *A);
+void splinalg_precon_lsolve(const gsl_spmatrix *A, const double omega,
+                            const double *dinv, gsl_vector *x);
+void splinalg_precon_usolve(const gsl_spmatrix *A, const double omega,
+                            const double *dinv, gsl_vector *x);
+int splinalg_precon_diag(const gsl_spmatrix *A, double *dinv,
+                         size_t *diag);
+
+#endif /* __GSL_SPLINALG_COMMON_H__ */
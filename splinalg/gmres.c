@@ -57,7 +57,9 @@ typedef struct
 
 static void gmres_free(void *vstate);
 static int gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
-                         const double tol, gsl_vector *x, void *vstate);
+                         const double tol, gsl_vector *x,
+                         gsl_splinalg_precon *P, const int side,
+                         void *vstate);
 
 /*
 gmres_alloc()
@@ -172,6 +174,10 @@ Inputs: A    - sparse square matrix
         tol  - stopping tolerance (see below)
         x    - (input/output) on input, initial estimate x_0;
                on output, solution vector
+        P    - preconditioner M, or NULL
+        side - GSL_SPLINALG_PRECON_LEFT: run GMRES on M^{-1} A x = M^{-1} b
+               GSL_SPLINALG_PRECON_RIGHT: run GMRES on A M^{-1} y = b,
+               with x = M^{-1} y
         work - workspace
 
 Return:
@@ -189,11 +195,19 @@ Notes:
 (Saad, 2003 [2])
 
 2) On output, work->normr contains ||b - A*x||
+
+3) With left preconditioning, the inner iterations stop when the
+preconditioned residual has been reduced by the factor needed to bring
+the true residual below tol * ||b||, assuming ||M^{-1} r|| / ||r|| keeps
+its initial value; a restart therefore always makes progress while the
+true residual is too large. The returned status is always based on the
+true residual
 */
 
 static int
 gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
               const double tol, gsl_vector *x,
+              gsl_splinalg_precon *P, const int side,
               void *vstate)
 {
   const size_t N = A->size1;
@@ -219,8 +233,11 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
     {
       int status = GSL_SUCCESS;
       const size_t maxit = state->m;
+      const int left = (P != NULL && side == GSL_SPLINALG_PRECON_LEFT);
+      const int right = (P != NULL && side == GSL_SPLINALG_PRECON_RIGHT);
       const double normb = gsl_blas_dnrm2(b); /* ||b|| */
       const double reltol = tol * normb;      /* tol*||b|| */
+      double inner_tol = reltol;              /* tolerance of inner loop */
       double normr;                           /* ||r|| */
       size_t m, k;
       double tau;                             /* householder scalar */
@@ -245,10 +262,23 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
        */
       gsl_matrix_set_zero(H);
 
-      /* Step 1a: compute r = b - A*x_0 */
+      /* Step 1a: compute r = b - A*x_0, or M^{-1} (b - A*x_0) */
       gsl_vector_memcpy(r, b);
       gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
 
+      if (left)
+        {
+          /* the Krylov residuals are those of M^{-1} A x = M^{-1} b */
+          const double normr0 = gsl_blas_dnrm2(r);
+
+          status = gsl_splinalg_precon_apply(r, r, P);
+          if (status)
+            return status;
+
+          inner_tol = (normr0 > 0.0) ?
+                      reltol * (gsl_blas_dnrm2(r) / normr0) : 0.0;
+        }
+
       /* Step 1b */
       gsl_vector_memcpy(&h0.vector, r);
       tau = gsl_linalg_householder_transform(&h0.vector);
@@ -292,9 +322,26 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
               gsl_linalg_householder_hv(tau, &uk.vector, &vk.vector);
             }
 
-          /* Step 2a: v_m <- A*v_m */
+          /* Step 2a: v_m <- A*v_m, A*M^{-1}*v_m or M^{-1}*A*v_m */
+          if (right)
+            {
+              status = gsl_splinalg_precon_apply(&vm.vector, &vm.vector, P);
+              if (status)
+                return status;
+            }
+
           gsl_spblas_dgemv(CblasNoTrans, 1.0, A, &vm.vector, 0.0, r);
-          gsl_vector_memcpy(&vm.vector, r);
+
+          if (left)
+            {
+              status = gsl_splinalg_precon_apply(r, &vm.vector, P);
+              if (status)
+                return status;
+            }
+          else
+            {
+              gsl_vector_memcpy(&vm.vector, r);
+            }
 
           /* Step 2a: v_m <- P_m ... P_1 v_m */
           for (k = 0; k <= j; ++k)
@@ -347,7 +394,7 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
 
           /* Step 2j: check residual w_{m+1} for convergence */
           normr = fabs(gsl_vector_get(w, j + 1));
-          if (normr <= reltol)
+          if (normr <= inner_tol)
             {
               /*
                * method has converged, break out of loop to compute
@@ -395,7 +442,14 @@ gmres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
           gsl_linalg_householder_hv(tau, &uk.vector, &rk.vector);
         }
 
-      /* x <- x + V_m y_m */
+      /* x <- x + V_m y_m, or x + M^{-1} V_m y_m */
+      if (right)
+        {
+          status = gsl_splinalg_precon_apply(r, r, P);
+          if (status)
+            return status;
+        }
+
       gsl_vector_add(x, r);
 
       /* compute new residual r = b - A*x */
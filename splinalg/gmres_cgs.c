@@ -0,0 +1,472 @@
+/* splinalg/gmres_cgs.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * GMRES with the Arnoldi basis orthogonalized by classical
+ * Gram-Schmidt. The basis vectors are the rows of a matrix V, so
+ * that the projections V w and the update w - V^T h of each step
+ * are single matrix-vector products on contiguous rows, instead of
+ * the sequence of reflections of the Householder variant in gmres.c.
+ *
+ * Two orthogonalizations are available:
+ *
+ * CGS:  one pass, in which the projections and ||w||^2 are computed
+ *       by a single product with the rows [V; w], and the norm of
+ *       the projected vector follows from ||w||^2 - ||h||^2. When
+ *       the projection removes more than half of ||w||^2 the vector
+ *       is orthogonalized a second time, with an explicit norm [2].
+ *
+ * CGS2: two passes in every step [1]; the second pass also computes
+ *       the norm from a single product with [V; w].
+ *
+ * With CGS the inner products of a step already form one reduction,
+ * which is all a pipelined or s-step variant would gain in shared
+ * memory, where there is no asynchronous reduction to overlap with
+ * the matrix-vector product (compare the pipelined CG in cg.c).
+ *
+ * [1] L. Giraud, J. Langou and M. Rozloznik, The loss of
+ *     orthogonality in the Gram-Schmidt orthogonalization process,
+ *     Comput. Math. Appl. 50, 2005.
+ *
+ * [2] J. W. Daniel, W. B. Gragg, L. Kaufman and G. W. Stewart,
+ *     Reorthogonalization and stable algorithms for updating the
+ *     Gram-Schmidt QR factorization, Math. Comp. 30, 1976.
+ */
+
+#define GMRES_CGS          0  /* single pass, reorthogonalize if needed */
+#define GMRES_CGS2         1  /* always two passes */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t m;        /* dimension of Krylov subspace K_m */
+  int orth;        /* GMRES_CGS or GMRES_CGS2 */
+  gsl_matrix *V;   /* Arnoldi basis, (m+1)-by-n, one vector per row */
+  gsl_matrix *H;   /* R factor of the Hessenberg matrix, (m+1)-by-m */
+  gsl_vector *g;   /* rotated right hand side ||r_0|| e_1, length m+1 */
+  gsl_vector *t;   /* projections, length m+2 */
+  gsl_vector *r;   /* residual vector r = b - A*x */
+  gsl_vector *z;   /* work vector */
+  double *c;       /* Givens rotations */
+  double *s;
+  double normr;    /* residual norm ||r|| */
+} gmres_cgs_state_t;
+
+static void *gmres_cgs_alloc_type(const size_t n, const size_t m,
+                                  const int orth);
+static void gmres_cgs_free(void *vstate);
+static double gmres_cgs_orth(gmres_cgs_state_t *state, const size_t j,
+                             gsl_vector *h);
+
+static void *
+gmres_cgs_alloc(const size_t n, const size_t m)
+{
+  return gmres_cgs_alloc_type(n, m, GMRES_CGS);
+}
+
+static void *
+gmres_cgs2_alloc(const size_t n, const size_t m)
+{
+  return gmres_cgs_alloc_type(n, m, GMRES_CGS2);
+}
+
+/*
+gmres_cgs_alloc_type()
+  Allocate a workspace for solving an n-by-n system A x = b
+
+Inputs: n    - size of system
+        m    - size of Krylov subspace (ie: number of inner iterations)
+               if this parameter is 0, the value GSL_MIN(n,10) is used
+        orth - GMRES_CGS or GMRES_CGS2
+
+Return: pointer to workspace
+*/
+
+static void *
+gmres_cgs_alloc_type(const size_t n, const size_t m, const int orth)
+{
+  gmres_cgs_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(gmres_cgs_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate gmres state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->m = (m == 0) ? GSL_MIN(n, 10) : GSL_MIN(n, m);
+  state->orth = orth;
+
+  state->V = gsl_matrix_alloc(state->m + 1, n);
+  state->H = gsl_matrix_alloc(state->m + 1, state->m);
+  state->g = gsl_vector_alloc(state->m + 1);
+  state->t = gsl_vector_alloc(state->m + 2);
+  state->r = gsl_vector_alloc(n);
+  state->z = gsl_vector_alloc(n);
+  state->c = gsl_malloc(state->m * sizeof(double));
+  state->s = gsl_malloc(state->m * sizeof(double));
+
+  if (!state->V || !state->H || !state->g || !state->t || !state->r ||
+      !state->z || !state->c || !state->s)
+    {
+      gmres_cgs_free(state);
+      GSL_ERROR_NULL("failed to allocate gmres workspace", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* gmres_cgs_alloc_type() */
+
+static void
+gmres_cgs_free(void *vstate)
+{
+  gmres_cgs_state_t *state = (gmres_cgs_state_t *) vstate;
+
+  if (state->V)
+    gsl_matrix_free(state->V);
+
+  if (state->H)
+    gsl_matrix_free(state->H);
+
+  if (state->g)
+    gsl_vector_free(state->g);
+
+  if (state->t)
+    gsl_vector_free(state->t);
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->z)
+    gsl_vector_free(state->z);
+
+  if (state->c)
+    gsl_free(state->c);
+
+  if (state->s)
+    gsl_free(state->s);
+
+  gsl_free(state);
+} /* gmres_cgs_free() */
+
+/*
+gmres_cgs_iterate()
+  Solve A*x = b using GMRES with classical Gram-Schmidt
+
+Inputs: A    - sparse square matrix
+        b    - right hand side vector
+        tol  - stopping tolerance, ||b - A*x|| <= tol * ||b||
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - preconditioner M, or NULL
+        side - GSL_SPLINALG_PRECON_LEFT or GSL_SPLINALG_PRECON_RIGHT
+        work - workspace
+
+Return: GSL_SUCCESS if converged, GSL_CONTINUE if the m inner
+iterations did not reach the tolerance; further calls restart the
+method from the current x
+
+Notes:
+1) Algorithm 6.9 of (Saad, 2003), with the Givens rotations applied
+to each new column of the Hessenberg matrix as it is formed
+
+2) The inner stopping test for left preconditioning is the same as
+in gmres.c
+*/
+
+static int
+gmres_cgs_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+                  const double tol, gsl_vector *x,
+                  gsl_splinalg_precon *P, const int side,
+                  void *vstate)
+{
+  const size_t N = A->size1;
+  gmres_cgs_state_t *state = (gmres_cgs_state_t *) vstate;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const int left = (P != NULL && side == GSL_SPLINALG_PRECON_LEFT);
+      const int right = (P != NULL && side == GSL_SPLINALG_PRECON_RIGHT);
+      const double reltol = tol * gsl_blas_dnrm2(b);
+      double inner_tol = reltol;
+      gsl_matrix *V = state->V;
+      gsl_matrix *H = state->H;
+      gsl_vector *g = state->g;
+      gsl_vector *r = state->r;
+      gsl_vector *z = state->z;
+      gsl_vector_view v0 = gsl_matrix_row(V, 0);
+      double beta;
+      size_t j, k = 0;
+      int status;
+
+      /* r = b - A x, or M^{-1} (b - A x) */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+
+      if (left)
+        {
+          const double normr0 = gsl_blas_dnrm2(r);
+
+          status = gsl_splinalg_precon_apply(r, r, P);
+          if (status)
+            return status;
+
+          inner_tol = (normr0 > 0.0) ?
+                      reltol * (gsl_blas_dnrm2(r) / normr0) : 0.0;
+        }
+
+      beta = gsl_blas_dnrm2(r);
+
+      if (beta > 0.0)
+        {
+          /* v_0 = r / beta, g = beta e_1 */
+          gsl_vector_memcpy(&v0.vector, r);
+          gsl_vector_scale(&v0.vector, 1.0 / beta);
+          gsl_vector_set_zero(g);
+          gsl_vector_set(g, 0, beta);
+
+          for (j = 0; j < state->m; ++j)
+            {
+              gsl_vector_view vj = gsl_matrix_row(V, j);
+              gsl_vector_view w = gsl_matrix_row(V, j + 1);
+              gsl_vector_view h = gsl_matrix_subcolumn(H, j, 0, j + 2);
+              double hnorm, c, s;
+              size_t i;
+
+              /* w = A v_j, A M^{-1} v_j or M^{-1} A v_j */
+              if (right)
+                {
+                  status = gsl_splinalg_precon_apply(&vj.vector, z, P);
+                  if (status)
+                    return status;
+
+                  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, z, 0.0,
+                                   &w.vector);
+                }
+              else if (left)
+                {
+                  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, &vj.vector, 0.0,
+                                   z);
+                  status = gsl_splinalg_precon_apply(z, &w.vector, P);
+                  if (status)
+                    return status;
+                }
+              else
+                {
+                  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, &vj.vector, 0.0,
+                                   &w.vector);
+                }
+
+              /* h(0:j) = V_j^T w, w <- w - V_j h, h(j+1) = ||w|| */
+              hnorm = gmres_cgs_orth(state, j, &h.vector);
+
+              if (hnorm > 0.0)
+                gsl_vector_scale(&w.vector, 1.0 / hnorm);
+
+              /* apply the previous rotations to the new column */
+              for (i = 0; i < j; ++i)
+                gsl_linalg_givens_gv(&h.vector, i, i + 1, state->c[i],
+                                     state->s[i]);
+
+              /* rotation which annihilates h(j+1) */
+              gsl_linalg_givens(gsl_vector_get(&h.vector, j), hnorm, &c, &s);
+              state->c[j] = c;
+              state->s[j] = s;
+              gsl_linalg_givens_gv(&h.vector, j, j + 1, c, s);
+              gsl_linalg_givens_gv(g, j, j + 1, c, s);
+
+              k = j + 1;
+
+              /* |g(j+1)| is the residual norm of the projected problem */
+              if (fabs(gsl_vector_get(g, j + 1)) <= inner_tol || hnorm == 0.0)
+                break;
+            }
+
+          /* solve R_k y = g(0:k-1), in place in g */
+          {
+            gsl_matrix_view Rk = gsl_matrix_submatrix(H, 0, 0, k, k);
+            gsl_vector_view yk = gsl_vector_subvector(g, 0, k);
+            gsl_matrix_view Vk = gsl_matrix_submatrix(V, 0, 0, k, N);
+
+            gsl_blas_dtrsv(CblasUpper, CblasNoTrans, CblasNonUnit,
+                           &Rk.matrix, &yk.vector);
+
+            /* x <- x + V_k^T y, or x + M^{-1} V_k^T y */
+            if (right)
+              {
+                gsl_blas_dgemv(CblasTrans, 1.0, &Vk.matrix, &yk.vector,
+                               0.0, z);
+                status = gsl_splinalg_precon_apply(z, z, P);
+                if (status)
+                  return status;
+
+                gsl_vector_add(x, z);
+              }
+            else
+              {
+                gsl_blas_dgemv(CblasTrans, 1.0, &Vk.matrix, &yk.vector,
+                               1.0, x);
+              }
+          }
+        }
+
+      /* compute true residual r = b - A*x */
+      gsl_vector_memcpy(r, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r);
+      state->normr = gsl_blas_dnrm2(r);
+
+      if (state->normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* gmres_cgs_iterate() */
+
+/*
+gmres_cgs_orth()
+  Orthogonalize row j+1 of V against rows 0..j
+
+Inputs: state - workspace
+        j     - index of last orthonormal row of V
+        h     - (output) projections h(0:j) and norm h(j+1), length j+2
+
+Return: norm of the orthogonalized vector, which is left unnormalized
+in row j+1 of V
+*/
+
+static double
+gmres_cgs_orth(gmres_cgs_state_t *state, const size_t j, gsl_vector *h)
+{
+  const size_t N = state->n;
+  gsl_matrix_view Vj = gsl_matrix_submatrix(state->V, 0, 0, j + 1, N);
+  gsl_matrix_view Vw = gsl_matrix_submatrix(state->V, 0, 0, j + 2, N);
+  gsl_vector_view w = gsl_matrix_row(state->V, j + 1);
+  gsl_vector_view hj = gsl_vector_subvector(h, 0, j + 1);
+  gsl_vector_view t = gsl_vector_subvector(state->t, 0, j + 2);
+  gsl_vector_view tj = gsl_vector_subvector(state->t, 0, j + 1);
+  double ww, hh, norm2;
+  size_t pass;
+
+  gsl_vector_set_zero(h);
+
+  for (pass = 0; pass < 2; ++pass)
+    {
+      /* t = [V_j; w] w, one product for projections and ||w||^2 */
+      gsl_blas_dgemv(CblasNoTrans, 1.0, &Vw.matrix, &w.vector, 0.0,
+                     &t.vector);
+      ww = gsl_vector_get(&t.vector, j + 1);
+      hh = gsl_blas_dnrm2(&tj.vector);
+
+      /* w <- w - V_j^T t, h <- h + t */
+      gsl_blas_dgemv(CblasTrans, -1.0, &Vj.matrix, &tj.vector, 1.0,
+                     &w.vector);
+      gsl_vector_add(&hj.vector, &tj.vector);
+
+      /* ||w - V_j^T t||^2 = ||w||^2 - ||t||^2 */
+      norm2 = ww - hh * hh;
+
+      if (state->orth == GMRES_CGS2)
+        {
+          if (pass == 1 && norm2 > 0.5 * ww)
+            break;
+        }
+      else if (norm2 > 0.5 * ww)
+        {
+          break;
+        }
+
+      if (pass == 1)
+        {
+          /* the second pass still cancelled; compute the norm directly */
+          norm2 = gsl_blas_dnrm2(&w.vector);
+          norm2 *= norm2;
+        }
+    }
+
+  norm2 = sqrt(GSL_MAX(norm2, 0.0));
+  gsl_vector_set(h, j + 1, norm2);
+
+  return norm2;
+} /* gmres_cgs_orth() */
+
+static double
+gmres_cgs_normr(const void *vstate)
+{
+  const gmres_cgs_state_t *state = (const gmres_cgs_state_t *) vstate;
+  return state->normr;
+} /* gmres_cgs_normr() */
+
+static const gsl_splinalg_itersolve_type gmres_cgs_type =
+{
+  "gmres-cgs",
+  &gmres_cgs_alloc,
+  &gmres_cgs_iterate,
+  &gmres_cgs_normr,
+  &gmres_cgs_free
+};
+
+static const gsl_splinalg_itersolve_type gmres_cgs2_type =
+{
+  "gmres-cgs2",
+  &gmres_cgs2_alloc,
+  &gmres_cgs_iterate,
+  &gmres_cgs_normr,
+  &gmres_cgs_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres_cgs =
+  &gmres_cgs_type;
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres_cgs2 =
+  &gmres_cgs2_type;
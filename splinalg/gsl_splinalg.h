@@ -39,13 +39,51 @@
 
 __BEGIN_DECLS
 
+/* preconditioner parameters */
+typedef struct
+{
+  double omega;     /* SSOR relaxation parameter, 0 < omega < 2 */
+  double droptol;   /* ILUT relative drop tolerance */
+  size_t maxfill;   /* ILUT maximum elements per row of L and of U */
+  double theta;     /* AMG strength of connection threshold */
+  int smoother;     /* AMG smoother, GSL_SPLINALG_AMG_JACOBI or _GS */
+  size_t nsweeps;   /* AMG pre- and post-smoothing sweeps per level */
+  size_t coarse_size; /* AMG size below which the level is solved by LU */
+} gsl_splinalg_precon_params;
+
+/* smoothers of the AMG preconditioner */
+#define GSL_SPLINALG_AMG_JACOBI     (0) /* damped Jacobi */
+#define GSL_SPLINALG_AMG_GS         (1) /* symmetric Gauss-Seidel */
+
+/* preconditioner type */
+typedef struct
+{
+  const char *name;
+  void * (*alloc) (const size_t n, const gsl_splinalg_precon_params *params);
+  int (*init) (const gsl_spmatrix *A, void *);
+  int (*apply) (gsl_vector *x, void *); /* x := M^{-1} x */
+  void (*free) (void *);
+} gsl_splinalg_precon_type;
+
+typedef struct
+{
+  const gsl_splinalg_precon_type * type;
+  size_t n;     /* size of matrices */
+  void * state;
+} gsl_splinalg_precon;
+
+/* side on which the preconditioner is applied */
+#define GSL_SPLINALG_PRECON_LEFT    (0) /* solve M^{-1} A x = M^{-1} b */
+#define GSL_SPLINALG_PRECON_RIGHT   (1) /* solve A M^{-1} y = b, x = M^{-1} y */
+
 /* iteration solver type */
 typedef struct
 {
   const char *name;
   void * (*alloc) (const size_t n, const size_t m);
   int (*iterate) (const gsl_spmatrix *A, const gsl_vector *b,
-                  const double tol, gsl_vector *x, void *);
+                  const double tol, gsl_vector *x,
+                  gsl_splinalg_precon *P, const int side, void *);
   double (*normr)(const void *);
   void (*free) (void *);
 } gsl_splinalg_itersolve_type;
@@ -53,12 +91,58 @@ typedef struct
 typedef struct
 {
   const gsl_splinalg_itersolve_type * type;
+  size_t n;     /* size of linear system */
   double normr; /* current residual norm || b - A x || */
+  gsl_splinalg_precon * precon; /* preconditioner, or NULL */
+  int precon_side;              /* GSL_SPLINALG_PRECON_LEFT or _RIGHT */
   void * state;
 } gsl_splinalg_itersolve;
 
+/* supernodal sparse Cholesky factorization A = L L^T */
+typedef struct
+{
+  size_t n;         /* size of matrices */
+  size_t nsuper;    /* number of supernodes */
+  size_t nnz;       /* number of non-zero elements of L */
+  size_t *parent;   /* elimination tree, parent[j] = n for roots */
+  size_t *super;    /* supernode s holds columns super[s]..super[s+1]-1 */
+  size_t *snode;    /* supernode of each column */
+  size_t *Lpi;      /* rows of supernode s are Li[Lpi[s]..Lpi[s+1]-1] */
+  size_t *Li;
+  size_t *Lpx;      /* column major block of supernode s starts at Lx[Lpx[s]] */
+  double *Lx;
+  double *W;        /* dense update workspace */
+  size_t *work;     /* integer workspace, size 4n */
+  int factored;     /* numeric factorization available */
+} gsl_splinalg_cholesky_workspace;
+
+/* left-looking sparse LU factorization P A = L U */
+typedef struct
+{
+  size_t n;         /* size of matrices */
+  double pivtol;    /* threshold for keeping the diagonal pivot */
+  gsl_spmatrix *L;  /* unit lower triangular factor, compressed column */
+  gsl_spmatrix *U;  /* upper triangular factor, compressed column */
+  size_t *pinv;     /* row i of A is row pinv[i] of P A */
+  double *x;        /* dense work vector */
+  size_t *work;     /* integer workspace, size 4n */
+  int factored;     /* factorization available */
+} gsl_splinalg_LU_workspace;
+
 /* available types */
 GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres_cgs;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_gmres_cgs2;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_cg_pipelined;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_bicgstab;
+GSL_VAR const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_minres;
+
+GSL_VAR const gsl_splinalg_precon_type * gsl_splinalg_precon_jacobi;
+GSL_VAR const gsl_splinalg_precon_type * gsl_splinalg_precon_ssor;
+GSL_VAR const gsl_splinalg_precon_type * gsl_splinalg_precon_ilu0;
+GSL_VAR const gsl_splinalg_precon_type * gsl_splinalg_precon_ilut;
+GSL_VAR const gsl_splinalg_precon_type * gsl_splinalg_precon_amg;
 
 /*
  * Prototypes
@@ -73,6 +157,41 @@ int gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A,
                                    const double tol, gsl_vector *x,
                                    gsl_splinalg_itersolve *w);
 double gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w);
+int gsl_splinalg_itersolve_set_precon(gsl_splinalg_itersolve *w,
+                                      gsl_splinalg_precon *P,
+                                      const int side);
+
+gsl_splinalg_precon_params gsl_splinalg_precon_default_params(void);
+gsl_splinalg_precon *
+gsl_splinalg_precon_alloc(const gsl_splinalg_precon_type *T,
+                          const size_t n,
+                          const gsl_splinalg_precon_params *params);
+void gsl_splinalg_precon_free(gsl_splinalg_precon *P);
+const char *gsl_splinalg_precon_name(const gsl_splinalg_precon *P);
+int gsl_splinalg_precon_init(const gsl_spmatrix *A, gsl_splinalg_precon *P);
+int gsl_splinalg_precon_apply(const gsl_vector *r, gsl_vector *z,
+                              gsl_splinalg_precon *P);
+
+gsl_splinalg_cholesky_workspace *gsl_splinalg_cholesky_alloc(const size_t n);
+void gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_symbolic(const gsl_spmatrix *A,
+                                   gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_numeric(const gsl_spmatrix *A,
+                                  gsl_splinalg_cholesky_workspace *w);
+int gsl_splinalg_cholesky_solve(const gsl_splinalg_cholesky_workspace *w,
+                                const gsl_vector *b, gsl_vector *x);
+int gsl_splinalg_cholesky_svx(const gsl_splinalg_cholesky_workspace *w,
+                              gsl_vector *x);
+
+gsl_splinalg_LU_workspace *gsl_splinalg_LU_alloc(const size_t n);
+void gsl_splinalg_LU_free(gsl_splinalg_LU_workspace *w);
+int gsl_splinalg_LU_decomp(const gsl_spmatrix *A,
+                           gsl_splinalg_LU_workspace *w);
+int gsl_splinalg_LU_refactor(const gsl_spmatrix *A,
+                             gsl_splinalg_LU_workspace *w);
+int gsl_splinalg_LU_solve(const gsl_splinalg_LU_workspace *w,
+                          const gsl_vector *b, gsl_vector *x);
+int gsl_splinalg_LU_svx(const gsl_splinalg_LU_workspace *w, gsl_vector *x);
 
 __END_DECLS
 
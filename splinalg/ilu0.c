@@ -0,0 +1,205 @@
+/* splinalg/ilu0.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+#include "common.h"
+
+/*
+ * Incomplete LU factorization with no fill, ILU(0): A ~ L U where
+ * L + U has the same pattern as A and L has a unit diagonal. This
+ * is based on algorithm 10.4 of
+ *
+ * [1] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003.
+ */
+
+typedef struct
+{
+  size_t n;
+  gsl_spmatrix *LU; /* L and U factors in compressed row format */
+  size_t *diag;     /* position of the diagonal element of each row */
+  size_t *iw;       /* position of each column in the current row + 1 */
+  gsl_spblas_trsv_workspace *lsolve; /* level schedules of L and U */
+  gsl_spblas_trsv_workspace *usolve;
+} ilu0_state_t;
+
+static void ilu0_free(void *vstate);
+
+static void *
+ilu0_alloc(const size_t n, const gsl_splinalg_precon_params *params)
+{
+  ilu0_state_t *state;
+
+  (void) params;
+
+  state = gsl_calloc(1, sizeof(ilu0_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate ilu0 state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+
+  state->diag = gsl_malloc(n * sizeof(size_t));
+  state->iw = gsl_calloc(n, sizeof(size_t));
+  state->lsolve = gsl_spblas_trsv_alloc(n);
+  state->usolve = gsl_spblas_trsv_alloc(n);
+  if (!state->diag || !state->iw || !state->lsolve || !state->usolve)
+    {
+      ilu0_free(state);
+      GSL_ERROR_NULL("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return state;
+} /* ilu0_alloc() */
+
+static void
+ilu0_free(void *vstate)
+{
+  ilu0_state_t *state = (ilu0_state_t *) vstate;
+
+  if (state->LU)
+    gsl_spmatrix_free(state->LU);
+
+  if (state->diag)
+    gsl_free(state->diag);
+
+  if (state->iw)
+    gsl_free(state->iw);
+
+  if (state->lsolve)
+    gsl_spblas_trsv_free(state->lsolve);
+
+  if (state->usolve)
+    gsl_spblas_trsv_free(state->usolve);
+
+  gsl_free(state);
+} /* ilu0_free() */
+
+static int
+ilu0_init(const gsl_spmatrix *A, void *vstate)
+{
+  ilu0_state_t *state = (ilu0_state_t *) vstate;
+  const size_t N = state->n;
+  size_t *Lp, *Lj, *iw = state->iw;
+  double *Ld;
+  size_t i, p, q;
+  int status;
+
+  if (state->LU)
+    gsl_spmatrix_free(state->LU);
+
+  state->LU = splinalg_precon_crs(A);
+  if (!state->LU)
+    {
+      GSL_ERROR("failed to copy matrix", GSL_ENOMEM);
+    }
+
+  Lp = state->LU->p;
+  Lj = state->LU->i;
+  Ld = state->LU->data;
+
+  for (i = 0; i < N; ++i)
+    {
+      /* mark the columns present in row i */
+      for (p = Lp[i]; p < Lp[i + 1]; ++p)
+        iw[Lj[p]] = p + 1;
+
+      /* eliminate with the previous rows, in increasing order */
+      for (p = Lp[i]; p < Lp[i + 1] && Lj[p] < i; ++p)
+        {
+          const size_t k = Lj[p];
+          const double ukk = Ld[state->diag[k]];
+          double lik;
+
+          lik = Ld[p] / ukk;
+          Ld[p] = lik;
+
+          /* row i -= lik * U(k,:), restricted to the pattern of row i */
+          for (q = state->diag[k] + 1; q < Lp[k + 1]; ++q)
+            {
+              if (iw[Lj[q]])
+                Ld[iw[Lj[q]] - 1] -= lik * Ld[q];
+            }
+        }
+
+      /* locate the pivot */
+      if (p == Lp[i + 1] || Lj[p] != i || Ld[p] == 0.0)
+        {
+          for (q = Lp[i]; q < Lp[i + 1]; ++q)
+            iw[Lj[q]] = 0;
+
+          GSL_ERROR("zero pivot encountered", GSL_ESING);
+        }
+
+      state->diag[i] = p;
+
+      for (p = Lp[i]; p < Lp[i + 1]; ++p)
+        iw[Lj[p]] = 0;
+    }
+
+  /* schedules for the triangular solves in ilu0_apply() */
+  status = gsl_spblas_dtrsv_analysis(CblasLower, CblasNoTrans, CblasUnit,
+                                     state->LU, state->lsolve);
+  if (status)
+    return status;
+
+  status = gsl_spblas_dtrsv_analysis(CblasUpper, CblasNoTrans, CblasNonUnit,
+                                     state->LU, state->usolve);
+
+  return status;
+} /* ilu0_init() */
+
+static int
+ilu0_apply(gsl_vector *x, void *vstate)
+{
+  ilu0_state_t *state = (ilu0_state_t *) vstate;
+  int status;
+
+  if (!state->LU)
+    {
+      GSL_ERROR("preconditioner has not been initialized", GSL_EFAILED);
+    }
+
+  status = gsl_spblas_dtrsv(x, state->lsolve);
+  if (status)
+    return status;
+
+  return gsl_spblas_dtrsv(x, state->usolve);
+} /* ilu0_apply() */
+
+static const gsl_splinalg_precon_type ilu0_type =
+{
+  "ilu0",
+  &ilu0_alloc,
+  &ilu0_init,
+  &ilu0_apply,
+  &ilu0_free
+};
+
+const gsl_splinalg_precon_type * gsl_splinalg_precon_ilu0 = &ilu0_type;
@@ -0,0 +1,470 @@
+/* splinalg/ilut.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+#include "common.h"
+
+/*
+ * Incomplete LU factorization with threshold dropping, ILUT(tau,p).
+ * Each row of A is eliminated in a dense work vector; elements smaller
+ * than tau times the norm of the row are dropped, and only the p
+ * largest elements of each row of L and of U are kept. This is
+ * algorithm 10.6 of
+ *
+ * [1] Y. Saad, Iterative methods for sparse linear systems,
+ *     2nd edition, SIAM, 2003.
+ *
+ * The columns of the lower part of w still to be eliminated are kept
+ * in a binary min-heap, so that the next column is found in
+ * O(log nw) rather than by a scan of all nw non-zeros of w.
+ */
+
+typedef struct
+{
+  size_t j;     /* column index */
+  double v;     /* value */
+} ilut_elem;
+
+typedef struct
+{
+  size_t n;
+  double droptol;   /* relative drop tolerance tau */
+  size_t maxfill;   /* maximum elements p per row of L and of U */
+  gsl_spmatrix *L;  /* strictly lower part, unit diagonal implied */
+  gsl_spmatrix *U;  /* upper part, diagonal stored first in each row */
+  double *dinv;     /* inverse diagonal of U */
+  double *w;        /* dense work row */
+  size_t *iw;       /* iw[j] = 1 if column j is non-zero in w */
+  size_t *jw;       /* list of non-zero columns of w */
+  size_t *heap;     /* min-heap of columns j < i of w to eliminate */
+  ilut_elem *elem;  /* elements of a row of L or U being selected */
+  gsl_spblas_trsv_workspace *lsolve; /* level schedules of L and U */
+  gsl_spblas_trsv_workspace *usolve;
+} ilut_state_t;
+
+static void ilut_free(void *vstate);
+static int ilut_store(const size_t i, ilut_elem *elem, const size_t nelem,
+                      const size_t maxfill, const double *diag,
+                      gsl_spmatrix *m);
+static void ilut_heap_push(size_t *heap, size_t *nheap, const size_t j);
+static size_t ilut_heap_pop(size_t *heap, size_t *nheap);
+static int compare_magnitude(const void *pa, const void *pb);
+static int compare_column(const void *pa, const void *pb);
+
+static void *
+ilut_alloc(const size_t n, const gsl_splinalg_precon_params *params)
+{
+  ilut_state_t *state;
+
+  if (params->droptol < 0.0)
+    {
+      GSL_ERROR_NULL("drop tolerance must be non-negative", GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(ilut_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate ilut state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->droptol = params->droptol;
+  state->maxfill = params->maxfill;
+
+  state->dinv = gsl_malloc(n * sizeof(double));
+  state->w = gsl_malloc(n * sizeof(double));
+  state->iw = gsl_calloc(n, sizeof(size_t));
+  state->jw = gsl_malloc(n * sizeof(size_t));
+  state->heap = gsl_malloc(n * sizeof(size_t));
+  state->elem = gsl_malloc(n * sizeof(ilut_elem));
+  state->lsolve = gsl_spblas_trsv_alloc(n);
+  state->usolve = gsl_spblas_trsv_alloc(n);
+  if (!state->dinv || !state->w || !state->iw || !state->jw || !state->heap ||
+      !state->elem ||
+      !state->lsolve || !state->usolve)
+    {
+      ilut_free(state);
+      GSL_ERROR_NULL("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  return state;
+} /* ilut_alloc() */
+
+static void
+ilut_free(void *vstate)
+{
+  ilut_state_t *state = (ilut_state_t *) vstate;
+
+  if (state->L)
+    gsl_spmatrix_free(state->L);
+
+  if (state->U)
+    gsl_spmatrix_free(state->U);
+
+  if (state->dinv)
+    gsl_free(state->dinv);
+
+  if (state->w)
+    gsl_free(state->w);
+
+  if (state->iw)
+    gsl_free(state->iw);
+
+  if (state->jw)
+    gsl_free(state->jw);
+
+  if (state->heap)
+    gsl_free(state->heap);
+
+  if (state->elem)
+    gsl_free(state->elem);
+
+  if (state->lsolve)
+    gsl_spblas_trsv_free(state->lsolve);
+
+  if (state->usolve)
+    gsl_spblas_trsv_free(state->usolve);
+
+  gsl_free(state);
+} /* ilut_free() */
+
+static int
+ilut_init(const gsl_spmatrix *A, void *vstate)
+{
+  ilut_state_t *state = (ilut_state_t *) vstate;
+  const size_t N = state->n;
+  const size_t fill = GSL_MIN(state->maxfill, N);
+  double *w = state->w;
+  size_t *iw = state->iw;
+  size_t *jw = state->jw;
+  size_t *heap = state->heap;
+  gsl_spmatrix *R;
+  size_t i, p;
+  int status = GSL_SUCCESS;
+
+  R = splinalg_precon_crs(A);
+  if (!R)
+    {
+      GSL_ERROR("failed to copy matrix", GSL_ENOMEM);
+    }
+
+  if (!state->L)
+    {
+      state->L = gsl_spmatrix_alloc_nzmax(N, N, N * fill / 2 + 1,
+                                          GSL_SPMATRIX_CRS);
+      state->U = gsl_spmatrix_alloc_nzmax(N, N, N * fill / 2 + 1,
+                                          GSL_SPMATRIX_CRS);
+      if (!state->L || !state->U)
+        {
+          gsl_spmatrix_free(R);
+          GSL_ERROR("failed to allocate factors", GSL_ENOMEM);
+        }
+    }
+
+  state->L->p[0] = 0;
+  state->U->p[0] = 0;
+  state->L->nz = 0;
+  state->U->nz = 0;
+
+  for (i = 0; i < N && status == GSL_SUCCESS; ++i)
+    {
+      size_t nw = 0;     /* number of non-zeros in w */
+      size_t nheap = 0;  /* number of columns in heap */
+      size_t nl = 0, nu = 0;
+      double norm = 0.0;
+      double tol;
+
+      /* scatter row i of A into w */
+      for (p = R->p[i]; p < R->p[i + 1]; ++p)
+        {
+          const size_t j = R->i[p];
+
+          w[j] = R->data[p];
+          iw[j] = 1;
+          jw[nw++] = j;
+          norm += R->data[p] * R->data[p];
+
+          if (j < i)
+            ilut_heap_push(heap, &nheap, j);
+        }
+
+      tol = state->droptol * sqrt(norm);
+
+      /* eliminate the lower part of w, in increasing column order */
+      while (nheap > 0)
+        {
+          const size_t k = ilut_heap_pop(heap, &nheap);
+          size_t q;
+          double wk;
+
+          wk = w[k] * state->dinv[k];
+          w[k] = wk;
+
+          if (fabs(wk) <= tol)
+            {
+              w[k] = 0.0;
+              continue;
+            }
+
+          /* w -= wk * U(k,:), skipping the diagonal */
+          for (q = state->U->p[k] + 1; q < state->U->p[k + 1]; ++q)
+            {
+              const size_t j = state->U->i[q];
+
+              if (!iw[j])
+                {
+                  iw[j] = 1;
+                  w[j] = 0.0;
+                  jw[nw++] = j;
+
+                  /* fill-in below the diagonal, j > k */
+                  if (j < i)
+                    ilut_heap_push(heap, &nheap, j);
+                }
+
+              w[j] -= wk * state->U->data[q];
+            }
+        }
+
+      /* gather the elements of L and U which survive dropping */
+      for (p = 0; p < nw; ++p)
+        {
+          const size_t j = jw[p];
+
+          if (j < i && fabs(w[j]) > tol)
+            {
+              state->elem[nl].j = j;
+              state->elem[nl++].v = w[j];
+            }
+        }
+
+      status = ilut_store(i, state->elem, nl, fill, NULL, state->L);
+
+      for (p = 0; p < nw; ++p)
+        {
+          const size_t j = jw[p];
+
+          if (j > i && fabs(w[j]) > tol)
+            {
+              state->elem[nu].j = j;
+              state->elem[nu++].v = w[j];
+            }
+        }
+
+      if (status == GSL_SUCCESS)
+        {
+          if (!iw[i] || w[i] == 0.0)
+            status = GSL_ESING;
+          else
+            state->dinv[i] = 1.0 / w[i];
+        }
+
+      if (status == GSL_SUCCESS)
+        status = ilut_store(i, state->elem, nu, fill, &w[i], state->U);
+
+      /* reset the work row */
+      for (p = 0; p < nw; ++p)
+        iw[jw[p]] = 0;
+    }
+
+  gsl_spmatrix_free(R);
+
+  if (status == GSL_ESING)
+    {
+      GSL_ERROR("zero pivot encountered", GSL_ESING);
+    }
+  else if (status)
+    {
+      GSL_ERROR("failed to store factors", status);
+    }
+
+  /* schedules for the triangular solves in ilut_apply() */
+  status = gsl_spblas_dtrsv_analysis(CblasLower, CblasNoTrans, CblasUnit,
+                                     state->L, state->lsolve);
+  if (status)
+    return status;
+
+  status = gsl_spblas_dtrsv_analysis(CblasUpper, CblasNoTrans, CblasNonUnit,
+                                     state->U, state->usolve);
+
+  return status;
+} /* ilut_init() */
+
+static int
+ilut_apply(gsl_vector *x, void *vstate)
+{
+  ilut_state_t *state = (ilut_state_t *) vstate;
+  int status;
+
+  if (!state->L)
+    {
+      GSL_ERROR("preconditioner has not been initialized", GSL_EFAILED);
+    }
+
+  status = gsl_spblas_dtrsv(x, state->lsolve);
+  if (status)
+    return status;
+
+  return gsl_spblas_dtrsv(x, state->usolve);
+} /* ilut_apply() */
+
+/*
+ilut_store()
+  Append the maxfill largest of nelem elements as row i of the
+compressed row matrix m, in increasing column order, preceded by the
+diagonal element *diag if diag is not NULL
+*/
+
+static int
+ilut_store(const size_t i, ilut_elem *elem, const size_t nelem,
+           const size_t maxfill, const double *diag, gsl_spmatrix *m)
+{
+  const size_t nkeep = GSL_MIN(nelem, maxfill);
+  size_t k;
+
+  if (nelem > maxfill)
+    qsort(elem, nelem, sizeof(ilut_elem), compare_magnitude);
+
+  qsort(elem, nkeep, sizeof(ilut_elem), compare_column);
+
+  if (m->nz + nkeep + 1 > m->nzmax)
+    {
+      int status = gsl_spmatrix_realloc(2 * m->nzmax + nkeep + 1, m);
+      if (status)
+        return status;
+    }
+
+  if (diag)
+    {
+      m->i[m->nz] = i;
+      m->data[m->nz++] = *diag;
+    }
+
+  for (k = 0; k < nkeep; ++k)
+    {
+      m->i[m->nz] = elem[k].j;
+      m->data[m->nz++] = elem[k].v;
+    }
+
+  m->p[i + 1] = m->nz;
+
+  return GSL_SUCCESS;
+} /* ilut_store() */
+
+/*
+ilut_heap_push()
+  Insert column j into the binary min-heap heap of *nheap columns
+*/
+
+static void
+ilut_heap_push(size_t *heap, size_t *nheap, const size_t j)
+{
+  size_t c = (*nheap)++;
+
+  while (c > 0)
+    {
+      const size_t parent = (c - 1) / 2;
+
+      if (heap[parent] <= j)
+        break;
+
+      heap[c] = heap[parent];
+      c = parent;
+    }
+
+  heap[c] = j;
+} /* ilut_heap_push() */
+
+/*
+ilut_heap_pop()
+  Remove and return the smallest column of the non-empty binary
+min-heap heap of *nheap columns
+*/
+
+static size_t
+ilut_heap_pop(size_t *heap, size_t *nheap)
+{
+  const size_t top = heap[0];
+  const size_t n = --(*nheap);
+  const size_t j = heap[n];
+  size_t c = 0;
+
+  while (2 * c + 1 < n)
+    {
+      size_t child = 2 * c + 1;
+
+      if (child + 1 < n && heap[child + 1] < heap[child])
+        ++child;
+
+      if (j <= heap[child])
+        break;
+
+      heap[c] = heap[child];
+      c = child;
+    }
+
+  heap[c] = j;
+
+  return top;
+} /* ilut_heap_pop() */
+
+/* sort by decreasing magnitude, ties by column */
+static int
+compare_magnitude(const void *pa, const void *pb)
+{
+  const ilut_elem *a = (const ilut_elem *) pa;
+  const ilut_elem *b = (const ilut_elem *) pb;
+
+  if (fabs(a->v) > fabs(b->v))
+    return -1;
+  else if (fabs(a->v) < fabs(b->v))
+    return 1;
+  else
+    return (a->j < b->j) ? -1 : (a->j > b->j);
+}
+
+static int
+compare_column(const void *pa, const void *pb)
+{
+  const ilut_elem *a = (const ilut_elem *) pa;
+  const ilut_elem *b = (const ilut_elem *) pb;
+
+  return (a->j < b->j) ? -1 : (a->j > b->j);
+}
+
+static const gsl_splinalg_precon_type ilut_type =
+{
+  "ilut",
+  &ilut_alloc,
+  &ilut_init,
+  &ilut_apply,
+  &ilut_free
+};
+
+const gsl_splinalg_precon_type * gsl_splinalg_precon_ilut = &ilut_type;
@@ -40,7 +40,10 @@ gsl_splinalg_itersolve_alloc(const gsl_splinalg_itersolve_type *T,
     }
 
   w->type = T;
+  w->n = n;
   w->normr = 0.0;
+  w->precon = NULL;
+  w->precon_side = GSL_SPLINALG_PRECON_LEFT;
 
   w->state = w->type->alloc(n, m);
   if (w->state == NULL)
@@ -75,7 +78,8 @@ gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A, const gsl_vector *b,
                                const double tol, gsl_vector *x,
                                gsl_splinalg_itersolve *w)
 {
-  int status = w->type->iterate(A, b, tol, x, w->state);
+  int status = w->type->iterate(A, b, tol, x, w->precon, w->precon_side,
+                                w->state);
 
   /* store current residual */
   w->normr = w->type->normr(w->state);
@@ -88,3 +92,37 @@ gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w)
 {
   return w->normr;
 }
+
+/*
+gsl_splinalg_itersolve_set_precon()
+  Use the preconditioner P in subsequent iterations, or no
+preconditioner if P is NULL. P must be initialized with
+gsl_splinalg_precon_init for the matrix being solved; it is not
+copied, and must not be freed while w uses it.
+
+Inputs: w    - solver workspace
+        P    - preconditioner
+        side - GSL_SPLINALG_PRECON_LEFT or GSL_SPLINALG_PRECON_RIGHT
+
+Return: success, or GSL_EBADLEN if P is not of the size of the solver
+*/
+
+int
+gsl_splinalg_itersolve_set_precon(gsl_splinalg_itersolve *w,
+                                  gsl_splinalg_precon *P, const int side)
+{
+  if (side != GSL_SPLINALG_PRECON_LEFT && side != GSL_SPLINALG_PRECON_RIGHT)
+    {
+      GSL_ERROR("side must be GSL_SPLINALG_PRECON_LEFT or _RIGHT",
+                GSL_EINVAL);
+    }
+  else if (P != NULL && P->n != w->n)
+    {
+      GSL_ERROR("preconditioner size does not match solver", GSL_EBADLEN);
+    }
+
+  w->precon = P;
+  w->precon_side = side;
+
+  return GSL_SUCCESS;
+}
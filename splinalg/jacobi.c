@@ -0,0 +1,153 @@
+/* splinalg/jacobi.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Jacobi (diagonal) preconditioner M = diag(A)
+ */
+
+typedef struct
+{
+  size_t n;
+  double *dinv; /* inverse diagonal of A */
+} jacobi_state_t;
+
+static void jacobi_free(void *vstate);
+
+static void *
+jacobi_alloc(const size_t n, const gsl_splinalg_precon_params *params)
+{
+  jacobi_state_t *state;
+
+  (void) params;
+
+  state = gsl_calloc(1, sizeof(jacobi_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate jacobi state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+
+  state->dinv = gsl_malloc(n * sizeof(double));
+  if (!state->dinv)
+    {
+      jacobi_free(state);
+      GSL_ERROR_NULL("failed to allocate diagonal", GSL_ENOMEM);
+    }
+
+  return state;
+} /* jacobi_alloc() */
+
+static void
+jacobi_free(void *vstate)
+{
+  jacobi_state_t *state = (jacobi_state_t *) vstate;
+
+  if (state->dinv)
+    gsl_free(state->dinv);
+
+  gsl_free(state);
+} /* jacobi_free() */
+
+static int
+jacobi_init(const gsl_spmatrix *A, void *vstate)
+{
+  jacobi_state_t *state = (jacobi_state_t *) vstate;
+  size_t i;
+
+  if (GSL_SPMATRIX_ISSELL(A))
+    {
+      for (i = 0; i < state->n; ++i)
+        state->dinv[i] = gsl_spmatrix_get(A, i, i);
+    }
+  else
+    {
+      /* accumulate the diagonal in a single pass over any format */
+      const int crs = GSL_SPMATRIX_ISCRS(A);
+      const int ccs = GSL_SPMATRIX_ISCCS(A);
+      size_t n, k;
+
+      for (i = 0; i < state->n; ++i)
+        state->dinv[i] = 0.0;
+
+      if (ccs || crs)
+        {
+          for (k = 0; k < state->n; ++k)
+            {
+              for (n = A->p[k]; n < A->p[k + 1]; ++n)
+                {
+                  if (A->i[n] == k)
+                    state->dinv[k] = A->data[n];
+                }
+            }
+        }
+      else
+        {
+          for (n = 0; n < A->nz; ++n)
+            {
+              if (A->i[n] == A->p[n])
+                state->dinv[A->i[n]] = A->data[n];
+            }
+        }
+    }
+
+  for (i = 0; i < state->n; ++i)
+    {
+      if (state->dinv[i] == 0.0)
+        {
+          GSL_ERROR("matrix has a zero diagonal element", GSL_ESING);
+        }
+
+      state->dinv[i] = 1.0 / state->dinv[i];
+    }
+
+  return GSL_SUCCESS;
+} /* jacobi_init() */
+
+static int
+jacobi_apply(gsl_vector *x, void *vstate)
+{
+  jacobi_state_t *state = (jacobi_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < state->n; ++i)
+    gsl_vector_set(x, i, gsl_vector_get(x, i) * state->dinv[i]);
+
+  return GSL_SUCCESS;
+} /* jacobi_apply() */
+
+static const gsl_splinalg_precon_type jacobi_type =
+{
+  "jacobi",
+  &jacobi_alloc,
+  &jacobi_init,
+  &jacobi_apply,
+  &jacobi_free
+};
+
+const gsl_splinalg_precon_type * gsl_splinalg_precon_jacobi = &jacobi_type;
@@ -0,0 +1,638 @@
+/* splinalg/lu.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_permute.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Left-looking sparse LU factorization P A = L U with threshold
+ * partial pivoting
+ *
+ * Column j of L and U is computed by solving the sparse triangular
+ * system L x = A(:,j) with the columns of L computed so far. The
+ * pattern of x is found beforehand by a depth-first search in the
+ * graph of L (the symbolic step), so the numeric work is proportional
+ * to the number of floating point operations.
+ *
+ * The pattern of U is stored in the topological order produced by the
+ * search, so a refactorization with the same pivot sequence can
+ * repeat the numeric steps without any graph traversal.
+ *
+ * [1] J. R. Gilbert and T. Peierls, Sparse partial pivoting in time
+ *     proportional to arithmetic operations, SIAM J. Sci. Stat. Comput.
+ *     9(5), 1988.
+ *
+ * [2] T. A. Davis, Direct methods for sparse linear systems, SIAM, 2006.
+ */
+
+static gsl_spmatrix *lu_ccs(const gsl_spmatrix *A);
+static size_t lu_reach(const gsl_spmatrix *A, const size_t j,
+                       gsl_splinalg_LU_workspace *w);
+static int lu_grow(gsl_spmatrix *m, const size_t need);
+
+/*
+gsl_splinalg_LU_alloc()
+  Allocate a workspace for the sparse LU factorization of n-by-n
+matrices
+
+Inputs: n - size of matrices
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_LU_workspace *
+gsl_splinalg_LU_alloc(const size_t n)
+{
+  gsl_splinalg_LU_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = gsl_calloc(1, sizeof(gsl_splinalg_LU_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate LU workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+  w->pivtol = 0.1;
+
+  w->pinv = gsl_malloc(n * sizeof(size_t));
+  w->x = gsl_calloc(n, sizeof(double));
+  w->work = gsl_malloc(4 * n * sizeof(size_t));
+  if (!w->pinv || !w->x || !w->work)
+    {
+      gsl_splinalg_LU_free(w);
+      GSL_ERROR_NULL("failed to allocate LU index arrays", GSL_ENOMEM);
+    }
+
+  return w;
+} /* gsl_splinalg_LU_alloc() */
+
+void
+gsl_splinalg_LU_free(gsl_splinalg_LU_workspace *w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->L)
+    gsl_spmatrix_free(w->L);
+
+  if (w->U)
+    gsl_spmatrix_free(w->U);
+
+  if (w->pinv)
+    gsl_free(w->pinv);
+
+  if (w->x)
+    gsl_free(w->x);
+
+  if (w->work)
+    gsl_free(w->work);
+
+  gsl_free(w);
+} /* gsl_splinalg_LU_free() */
+
+/*
+gsl_splinalg_LU_decomp()
+  Compute the sparse LU factorization P A = L U, choosing the pivots
+and computing the patterns of L and U
+
+Inputs: A - square sparse matrix in triplet or compressed format
+        w - workspace
+
+Return: success/error; GSL_ESING if A is singular
+
+Notes:
+1) In column j, the diagonal element is chosen as pivot if its
+magnitude is at least w->pivtol times the largest candidate in the
+column, which tends to preserve the sparsity of a diagonally dominant
+or symmetrically ordered matrix; otherwise the largest candidate is
+chosen. w->pivtol = 1 gives conventional partial pivoting.
+
+2) On output, w->L is unit lower triangular and w->U upper triangular,
+both in compressed column format with row indices referring to the
+rows of P A. The diagonal of L is the first element of each column,
+the diagonal of U the last.
+*/
+
+int
+gsl_splinalg_LU_decomp(const gsl_spmatrix *A, gsl_splinalg_LU_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_spmatrix *C = lu_ccs(A);
+      size_t *pinv = w->pinv;
+      size_t *xi = w->work;
+      double *x = w->x;
+      gsl_spmatrix *L, *U;
+      size_t i, j, p, q, lnz = 0, unz = 0;
+      int status = GSL_SUCCESS;
+
+      if (!C)
+        return GSL_ENOMEM;
+
+      w->factored = 0;
+
+      /* reuse the factors of a previous decomposition when possible */
+      if (!w->L)
+        {
+          const size_t nzmax = 2 * C->nz + n;
+
+          w->L = gsl_spmatrix_alloc_nzmax(n, n, nzmax, GSL_SPMATRIX_CCS);
+          w->U = gsl_spmatrix_alloc_nzmax(n, n, nzmax, GSL_SPMATRIX_CCS);
+          if (!w->L || !w->U)
+            {
+              if (C != A)
+                gsl_spmatrix_free(C);
+              GSL_ERROR("failed to allocate LU factors", GSL_ENOMEM);
+            }
+        }
+
+      L = w->L;
+      U = w->U;
+      L->nz = 0;
+      U->nz = 0;
+
+      for (i = 0; i < n; ++i)
+        {
+          pinv[i] = n;
+          xi[n + i] = n; /* DFS marks */
+        }
+
+      for (j = 0; j < n; ++j)
+        {
+          size_t top, ipiv = n;
+          double amax = 0.0, pivot;
+
+          L->p[j] = lnz;
+          U->p[j] = unz;
+
+          /* make room for a full column in both factors */
+          if (lu_grow(L, lnz + n - j) || lu_grow(U, unz + j + 1))
+            {
+              status = GSL_ENOMEM;
+              break;
+            }
+
+          /* symbolic: pattern of x = L \ A(:,j) in xi[top..n) */
+          top = lu_reach(C, j, w);
+
+          /* numeric: scatter A(:,j) and eliminate in topological order */
+          for (p = C->p[j]; p < C->p[j + 1]; ++p)
+            x[C->i[p]] += C->data[p];
+
+          for (p = top; p < n; ++p)
+            {
+              const size_t k = pinv[xi[p]];
+              double xk;
+
+              if (k == n)
+                continue;
+
+              xk = x[xi[p]];
+              U->i[unz] = k;
+              U->data[unz++] = xk;
+
+              /* skip the unit diagonal, stored first */
+              for (q = L->p[k] + 1; q < L->p[k + 1]; ++q)
+                x[L->i[q]] -= L->data[q] * xk;
+            }
+
+          /* choose the pivot among the rows not yet pivotal */
+          for (p = top; p < n; ++p)
+            {
+              i = xi[p];
+              if (pinv[i] == n && fabs(x[i]) > amax)
+                {
+                  amax = fabs(x[i]);
+                  ipiv = i;
+                }
+            }
+
+          if (ipiv == n || amax == 0.0)
+            {
+              for (p = top; p < n; ++p)
+                x[xi[p]] = 0.0;
+
+              status = GSL_ESING;
+              break;
+            }
+
+          if (pinv[j] == n && xi[n + j] == j && fabs(x[j]) >= w->pivtol * amax)
+            ipiv = j;
+
+          pivot = x[ipiv];
+          pinv[ipiv] = j;
+
+          U->i[unz] = j;
+          U->data[unz++] = pivot;
+
+          L->i[lnz] = ipiv;
+          L->data[lnz++] = 1.0;
+
+          for (p = top; p < n; ++p)
+            {
+              i = xi[p];
+              if (pinv[i] == n)
+                {
+                  L->i[lnz] = i;
+                  L->data[lnz++] = x[i] / pivot;
+                }
+
+              x[i] = 0.0;
+            }
+
+          /* the column of L is complete, for the searches that follow */
+          L->p[j + 1] = lnz;
+        }
+
+      if (C != A)
+        gsl_spmatrix_free(C);
+
+      if (status == GSL_ENOMEM)
+        {
+          GSL_ERROR("failed to allocate LU factors", GSL_ENOMEM);
+        }
+      else if (status == GSL_ESING)
+        {
+          GSL_ERROR("matrix is singular", GSL_ESING);
+        }
+
+      L->p[n] = lnz;
+      U->p[n] = unz;
+      L->nz = lnz;
+      U->nz = unz;
+
+      /* row indices of L in terms of the rows of P A */
+      for (p = 0; p < lnz; ++p)
+        L->i[p] = pinv[L->i[p]];
+
+      w->factored = 1;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_LU_decomp() */
+
+/*
+gsl_splinalg_LU_refactor()
+  Recompute the values of L and U for a matrix with the same pattern
+as the one given to gsl_splinalg_LU_decomp(), keeping the pivot
+sequence and the patterns of the factors
+
+Inputs: A - square sparse matrix; every element must lie in the
+            pattern of L + U (under the row permutation P)
+        w - workspace containing a factorization
+
+Return: success/error; GSL_EINVAL if A has an element outside the
+pattern, GSL_ESING if a zero pivot is encountered
+
+Notes:
+1) No pivoting is done, so the factorization may be less stable
+than that of gsl_splinalg_LU_decomp() if the values have changed a
+lot; in that case the matrix should be factored again
+*/
+
+int
+gsl_splinalg_LU_refactor(const gsl_spmatrix *A, gsl_splinalg_LU_workspace *w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (w->L == NULL || w->L->nz == 0)
+    {
+      GSL_ERROR("matrix has not been factored", GSL_EINVAL);
+    }
+  else
+    {
+      gsl_spmatrix *C = lu_ccs(A);
+      const gsl_spmatrix *L = w->L;
+      const gsl_spmatrix *U = w->U;
+      const size_t *pinv = w->pinv;
+      size_t *mark = w->work;
+      double *x = w->x;
+      size_t j, p, q;
+      int status = GSL_SUCCESS;
+
+      if (!C)
+        return GSL_ENOMEM;
+
+      w->factored = 0;
+
+      for (j = 0; j < n; ++j)
+        mark[j] = n;
+
+      for (j = 0; j < n && status == GSL_SUCCESS; ++j)
+        {
+          const size_t u0 = U->p[j], u1 = U->p[j + 1] - 1; /* u1: diagonal */
+          const size_t l0 = L->p[j], l1 = L->p[j + 1];
+          double pivot;
+
+          /* pattern of column j of L + U, in rows of P A */
+          for (p = u0; p <= u1; ++p)
+            mark[U->i[p]] = j;
+
+          for (p = l0; p < l1; ++p)
+            mark[L->i[p]] = j;
+
+          for (p = C->p[j]; p < C->p[j + 1]; ++p)
+            {
+              const size_t r = pinv[C->i[p]];
+
+              if (mark[r] != j)
+                {
+                  status = GSL_EINVAL;
+                  break;
+                }
+
+              x[r] += C->data[p];
+            }
+
+          /* eliminate in the stored topological order */
+          for (p = u0; p < u1 && status == GSL_SUCCESS; ++p)
+            {
+              const size_t k = U->i[p];
+              const double xk = x[k];
+
+              U->data[p] = xk;
+
+              for (q = L->p[k] + 1; q < L->p[k + 1]; ++q)
+                x[L->i[q]] -= L->data[q] * xk;
+            }
+
+          pivot = x[j];
+          if (status == GSL_SUCCESS && pivot == 0.0)
+            status = GSL_ESING;
+
+          U->data[u1] = pivot;
+
+          for (p = l0 + 1; p < l1; ++p)
+            L->data[p] = x[L->i[p]] / pivot;
+
+          /* clear x */
+          for (p = u0; p <= u1; ++p)
+            x[U->i[p]] = 0.0;
+
+          for (p = l0; p < l1; ++p)
+            x[L->i[p]] = 0.0;
+        }
+
+      if (C != A)
+        gsl_spmatrix_free(C);
+
+      if (status == GSL_EINVAL)
+        {
+          GSL_ERROR("matrix has elements outside the pattern of the factors",
+                    GSL_EINVAL);
+        }
+      else if (status == GSL_ESING)
+        {
+          GSL_ERROR("matrix is singular", GSL_ESING);
+        }
+
+      w->factored = 1;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_LU_refactor() */
+
+/*
+gsl_splinalg_LU_solve()
+  Solve A x = b using the LU factorization in w
+*/
+
+int
+gsl_splinalg_LU_solve(const gsl_splinalg_LU_workspace *w,
+                      const gsl_vector *b, gsl_vector *x)
+{
+  if (b->size != w->n)
+    {
+      GSL_ERROR("right hand side does not match workspace", GSL_EBADLEN);
+    }
+  else if (x->size != w->n)
+    {
+      GSL_ERROR("solution vector does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_vector_memcpy(x, b);
+      return gsl_splinalg_LU_svx(w, x);
+    }
+} /* gsl_splinalg_LU_solve() */
+
+/*
+gsl_splinalg_LU_svx()
+  Solve A x = b in place using the LU factorization in w; on input
+x contains b
+*/
+
+int
+gsl_splinalg_LU_svx(const gsl_splinalg_LU_workspace *w, gsl_vector *x)
+{
+  if (x->size != w->n)
+    {
+      GSL_ERROR("solution vector does not match workspace", GSL_EBADLEN);
+    }
+  else if (!w->factored)
+    {
+      GSL_ERROR("matrix has not been factored", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t n = w->n;
+      const size_t stride = x->stride;
+      const gsl_spmatrix *L = w->L;
+      const gsl_spmatrix *U = w->U;
+      double *y = x->data;
+      size_t j, p;
+
+      /* y = P b, in place so that w is only read and may be shared
+         by several threads */
+      gsl_permute_inverse(w->pinv, y, stride, n);
+
+      /* L z = y, unit diagonal stored first */
+      for (j = 0; j < n; ++j)
+        {
+          const double yj = y[j * stride];
+
+          for (p = L->p[j] + 1; p < L->p[j + 1]; ++p)
+            y[L->i[p] * stride] -= L->data[p] * yj;
+        }
+
+      /* U x = z, diagonal stored last */
+      for (j = n; j-- > 0; )
+        {
+          double yj;
+
+          y[j * stride] /= U->data[U->p[j + 1] - 1];
+          yj = y[j * stride];
+
+          for (p = U->p[j]; p < U->p[j + 1] - 1; ++p)
+            y[U->i[p] * stride] -= U->data[p] * yj;
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_splinalg_LU_svx() */
+
+/*
+lu_reach()
+  Find the rows reachable from the pattern of A(:,j) in the graph of
+L, where row i has edges to the rows of column pinv[i] of L if i is
+pivotal. The rows are stored in w->work[top..n) in topological order.
+
+Inputs: A - compressed column matrix
+        j - column
+        w - workspace; work[n..2n) holds the DFS marks, work[2n..4n)
+            the DFS stack and positions
+
+Return: top
+*/
+
+static size_t
+lu_reach(const gsl_spmatrix *A, const size_t j, gsl_splinalg_LU_workspace *w)
+{
+  const size_t n = w->n;
+  const gsl_spmatrix *L = w->L;
+  const size_t *pinv = w->pinv;
+  size_t *xi = w->work;
+  size_t *mark = w->work + n;
+  size_t *stack = w->work + 2 * n;
+  size_t *pstack = w->work + 3 * n;
+  size_t top = n, p;
+
+  for (p = A->p[j]; p < A->p[j + 1]; ++p)
+    {
+      size_t head;
+
+      if (mark[A->i[p]] == j)
+        continue;
+
+      /* non-recursive depth-first search from A->i[p] */
+      head = 0;
+      stack[0] = A->i[p];
+
+      while (1)
+        {
+          const size_t i = stack[head];
+          const size_t k = pinv[i];
+          const size_t end = (k == n) ? 0 : L->p[k + 1];
+          size_t q;
+          int done = 1;
+
+          if (mark[i] != j)
+            {
+              mark[i] = j;
+              pstack[head] = (k == n) ? 0 : L->p[k] + 1;
+            }
+
+          for (q = pstack[head]; q < end; ++q)
+            {
+              const size_t r = L->i[q];
+
+              if (mark[r] == j)
+                continue;
+
+              /* descend to r, resuming at q + 1 afterwards */
+              pstack[head] = q + 1;
+              stack[++head] = r;
+              done = 0;
+              break;
+            }
+
+          if (done)
+            {
+              xi[--top] = i;
+
+              if (head == 0)
+                break;
+
+              --head;
+            }
+        }
+    }
+
+  return top;
+} /* lu_reach() */
+
+/* ensure m can hold need elements */
+static int
+lu_grow(gsl_spmatrix *m, const size_t need)
+{
+  if (need <= m->nzmax)
+    return GSL_SUCCESS;
+
+  return gsl_spmatrix_realloc(GSL_MAX(need, 2 * m->nzmax), m);
+}
+
+/*
+lu_ccs()
+  Return A in compressed column format; A itself if it is already
+compressed column, otherwise a new matrix which must be freed
+*/
+
+static gsl_spmatrix *
+lu_ccs(const gsl_spmatrix *A)
+{
+  gsl_spmatrix *C;
+
+  if (GSL_SPMATRIX_ISCCS(A))
+    return (gsl_spmatrix *) A;
+
+  if (GSL_SPMATRIX_ISTRIPLET(A))
+    return gsl_spmatrix_compcol(A);
+
+  if (!GSL_SPMATRIX_ISCRS(A))
+    {
+      GSL_ERROR_NULL("matrix must be in triplet or compressed format",
+                     GSL_EINVAL);
+    }
+
+  C = gsl_spmatrix_alloc_nzmax(A->size1, A->size2, A->nz, GSL_SPMATRIX_CCS);
+  if (C)
+    gsl_spmatrix_switch_major(C, A);
+
+  return C;
+} /* lu_ccs() */
@@ -0,0 +1,352 @@
+/* minres.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * Minimum residual method for symmetric, possibly indefinite,
+ * systems, based on the Lanczos process with Givens rotations
+ *
+ * [1] C. C. Paige and M. A. Saunders, Solution of sparse indefinite
+ *     systems of linear equations, SIAM J. Numer. Anal. 12(4), 1975.
+ */
+
+typedef struct
+{
+  size_t n;        /* size of linear system */
+  size_t maxit;    /* iterations per call */
+  gsl_vector *r1;  /* previous Lanczos vector, unscaled */
+  gsl_vector *r2;  /* current Lanczos vector, unscaled */
+  gsl_vector *y;   /* M^{-1} r2 and A v */
+  gsl_vector *v;   /* normalized Lanczos vector */
+  gsl_vector *w;   /* search directions w_k, w_{k-1}, w_{k-2} */
+  gsl_vector *w1;
+  gsl_vector *w2;
+
+  double normr;    /* residual norm ||r|| */
+} minres_state_t;
+
+static void minres_free(void *vstate);
+static int minres_precon(gsl_splinalg_precon *P, const gsl_vector *r,
+                         gsl_vector *z, double *beta);
+
+/*
+minres_alloc()
+  Allocate a MINRES workspace for solving an n-by-n system A x = b
+
+Inputs: n - size of system
+        m - maximum number of iterations in each call to
+            gsl_splinalg_itersolve_iterate; if 0, n is used
+
+Return: pointer to workspace
+*/
+
+static void *
+minres_alloc(const size_t n, const size_t m)
+{
+  minres_state_t *state;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(minres_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate minres state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->maxit = (m == 0) ? n : m;
+
+  state->r1 = gsl_vector_alloc(n);
+  state->r2 = gsl_vector_alloc(n);
+  state->y = gsl_vector_alloc(n);
+  state->v = gsl_vector_alloc(n);
+  state->w = gsl_vector_alloc(n);
+  state->w1 = gsl_vector_alloc(n);
+  state->w2 = gsl_vector_alloc(n);
+  if (!state->r1 || !state->r2 || !state->y || !state->v ||
+      !state->w || !state->w1 || !state->w2)
+    {
+      minres_free(state);
+      GSL_ERROR_NULL("failed to allocate minres vectors", GSL_ENOMEM);
+    }
+
+  state->normr = 0.0;
+
+  return state;
+} /* minres_alloc() */
+
+static void
+minres_free(void *vstate)
+{
+  minres_state_t *state = (minres_state_t *) vstate;
+
+  if (state->r1)
+    gsl_vector_free(state->r1);
+
+  if (state->r2)
+    gsl_vector_free(state->r2);
+
+  if (state->y)
+    gsl_vector_free(state->y);
+
+  if (state->v)
+    gsl_vector_free(state->v);
+
+  if (state->w)
+    gsl_vector_free(state->w);
+
+  if (state->w1)
+    gsl_vector_free(state->w1);
+
+  if (state->w2)
+    gsl_vector_free(state->w2);
+
+  gsl_free(state);
+} /* minres_free() */
+
+/*
+minres_iterate()
+  Solve A*x = b using the MINRES algorithm
+
+Inputs: A    - sparse symmetric matrix
+        b    - right hand side vector
+        tol  - stopping tolerance, ||b - A*x|| <= tol * ||b||
+        x    - (input/output) on input, initial estimate x_0;
+               on output, solution vector
+        P    - symmetric positive definite preconditioner M, or NULL
+        side - ignored; the preconditioner is applied symmetrically
+        work - workspace
+
+Return: GSL_SUCCESS if converged, GSL_CONTINUE if the maximum number
+of iterations was reached first; further calls restart the method
+from the current x
+
+Notes:
+1) The Lanczos process is run on the operator M^{-1} A in the M inner
+product, so only products with M^{-1} are required. The iterations
+minimize ||b - A x|| in the M^{-1} norm, which is monitored through the
+Givens rotations at no extra cost; with M = I this is the Euclidean
+norm of the residual
+
+2) The returned status is always based on the true residual. The
+inner iterations stop when the monitored norm has been reduced by the
+factor needed to bring the true residual below tol * ||b||, assuming
+the two norms keep their initial ratio; a restart therefore always
+makes progress while the true residual is too large
+*/
+
+static int
+minres_iterate(const gsl_spmatrix *A, const gsl_vector *b,
+               const double tol, gsl_vector *x,
+               gsl_splinalg_precon *P, const int side,
+               void *vstate)
+{
+  const size_t N = A->size1;
+  minres_state_t *state = (minres_state_t *) vstate;
+
+  (void) side;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR("matrix does not match right hand side", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("matrix does not match solution vector", GSL_EBADLEN);
+    }
+  else if (N != state->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      const double reltol = tol * gsl_blas_dnrm2(b);
+      double inner_tol;
+      gsl_vector *r1 = state->r1;
+      gsl_vector *r2 = state->r2;
+      gsl_vector *y = state->y;
+      gsl_vector *v = state->v;
+      gsl_vector *w = state->w;
+      gsl_vector *w1 = state->w1;
+      gsl_vector *w2 = state->w2;
+      double beta, oldb = 0.0, normr0;
+      double dbar = 0.0, epsln = 0.0, phibar;
+      double cs = -1.0, sn = 0.0;
+      size_t iter;
+      int status;
+
+      /* r1 = b - A x, y = M^{-1} r1, beta = sqrt(r1^T y) */
+      gsl_vector_memcpy(r1, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r1);
+
+      status = minres_precon(P, r1, y, &beta);
+      if (status)
+        return status;
+
+      /* inner stopping test on the M^{-1} norm of the residual */
+      normr0 = gsl_blas_dnrm2(r1);
+      inner_tol = (normr0 > 0.0) ? reltol * (beta / normr0) : 0.0;
+
+      gsl_vector_memcpy(r2, r1);
+      gsl_vector_set_zero(w);
+      gsl_vector_set_zero(w2);
+
+      phibar = beta;
+
+      for (iter = 0; iter < state->maxit && phibar > inner_tol; ++iter)
+        {
+          double alpha, oldeps, delta, gbar, gamma, phi;
+          gsl_vector *tmp;
+
+          if (beta == 0.0)
+            break;
+
+          /* v = y / beta, y = A v - (beta / oldb) r1 */
+          gsl_vector_memcpy(v, y);
+          gsl_vector_scale(v, 1.0 / beta);
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, A, v, 0.0, y);
+
+          if (iter > 0)
+            gsl_blas_daxpy(-beta / oldb, r1, y);
+
+          /* y = y - (alpha / beta) r2 */
+          gsl_blas_ddot(v, y, &alpha);
+          gsl_blas_daxpy(-alpha / beta, r2, y);
+
+          /* r1 <- r2, r2 <- y, y <- M^{-1} r2 */
+          tmp = r1;
+          r1 = r2;
+          r2 = y;
+          y = tmp;
+
+          oldb = beta;
+          status = minres_precon(P, r2, y, &beta);
+          if (status)
+            return status;
+
+          /* apply previous rotation and compute the new one */
+          oldeps = epsln;
+          delta = cs * dbar + sn * alpha;
+          gbar = sn * dbar - cs * alpha;
+          epsln = sn * beta;
+          dbar = -cs * beta;
+
+          gamma = GSL_MAX(gsl_hypot(gbar, beta), GSL_DBL_EPSILON);
+          cs = gbar / gamma;
+          sn = beta / gamma;
+          phi = cs * phibar;
+          phibar *= sn;
+
+          /* w <- (v - oldeps w1 - delta w2) / gamma */
+          tmp = w1;
+          w1 = w2;
+          w2 = w;
+          w = tmp;
+
+          gsl_vector_memcpy(w, v);
+          gsl_blas_daxpy(-oldeps, w1, w);
+          gsl_blas_daxpy(-delta, w2, w);
+          gsl_vector_scale(w, 1.0 / gamma);
+
+          /* x <- x + phi w */
+          gsl_blas_daxpy(phi, w, x);
+        }
+
+      /* compute true residual r = b - A*x */
+      gsl_vector_memcpy(r1, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, r1);
+      state->normr = gsl_blas_dnrm2(r1);
+
+      if (state->normr <= reltol)
+        return GSL_SUCCESS;
+      else
+        return GSL_CONTINUE;
+    }
+} /* minres_iterate() */
+
+/*
+minres_precon()
+  Compute z = M^{-1} r and beta = sqrt(r^T z), the M^{-1} norm of r
+*/
+
+static int
+minres_precon(gsl_splinalg_precon *P, const gsl_vector *r, gsl_vector *z,
+              double *beta)
+{
+  double rz;
+
+  if (P)
+    {
+      int status = gsl_splinalg_precon_apply(r, z, P);
+      if (status)
+        return status;
+    }
+  else
+    {
+      gsl_vector_memcpy(z, r);
+    }
+
+  gsl_blas_ddot(r, z, &rz);
+
+  if (rz < 0.0)
+    {
+      GSL_ERROR("preconditioner is not positive definite", GSL_EDOM);
+    }
+
+  *beta = sqrt(rz);
+
+  return GSL_SUCCESS;
+} /* minres_precon() */
+
+static double
+minres_normr(const void *vstate)
+{
+  const minres_state_t *state = (const minres_state_t *) vstate;
+  return state->normr;
+} /* minres_normr() */
+
+static const gsl_splinalg_itersolve_type minres_type =
+{
+  "minres",
+  &minres_alloc,
+  &minres_iterate,
+  &minres_normr,
+  &minres_free
+};
+
+const gsl_splinalg_itersolve_type * gsl_splinalg_itersolve_minres =
+  &minres_type;
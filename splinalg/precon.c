@@ -0,0 +1,155 @@
+/* splinalg/precon.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+gsl_splinalg_precon_params
+gsl_splinalg_precon_default_params(void)
+{
+  gsl_splinalg_precon_params params;
+
+  params.omega = 1.0;
+  params.droptol = 1.0e-3;
+  params.maxfill = 10;
+  params.theta = 0.08;
+  params.smoother = GSL_SPLINALG_AMG_GS;
+  params.nsweeps = 1;
+  params.coarse_size = 100;
+
+  return params;
+}
+
+/*
+gsl_splinalg_precon_alloc()
+  Allocate a preconditioner for n-by-n matrices
+
+Inputs: T      - preconditioner type
+        n      - size of matrices
+        params - parameters, or NULL for the defaults
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_precon *
+gsl_splinalg_precon_alloc(const gsl_splinalg_precon_type *T,
+                          const size_t n,
+                          const gsl_splinalg_precon_params *params)
+{
+  gsl_splinalg_precon *P;
+  gsl_splinalg_precon_params p = params ? *params :
+                                 gsl_splinalg_precon_default_params();
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  P = gsl_calloc(1, sizeof(gsl_splinalg_precon));
+  if (P == NULL)
+    {
+      GSL_ERROR_NULL("failed to allocate space for precon struct",
+                     GSL_ENOMEM);
+    }
+
+  P->type = T;
+  P->n = n;
+
+  P->state = P->type->alloc(n, &p);
+  if (P->state == NULL)
+    {
+      gsl_splinalg_precon_free(P);
+      GSL_ERROR_NULL("failed to allocate space for precon state",
+                     GSL_ENOMEM);
+    }
+
+  return P;
+} /* gsl_splinalg_precon_alloc() */
+
+void
+gsl_splinalg_precon_free(gsl_splinalg_precon *P)
+{
+  RETURN_IF_NULL(P);
+
+  if (P->state)
+    P->type->free(P->state);
+
+  gsl_free(P);
+}
+
+const char *
+gsl_splinalg_precon_name(const gsl_splinalg_precon *P)
+{
+  return P->type->name;
+}
+
+/*
+gsl_splinalg_precon_init()
+  Compute the preconditioner M for the matrix A. This must be called
+again whenever the values of A change.
+
+Inputs: A - sparse n-by-n matrix, in triplet or compressed format
+        P - preconditioner workspace
+*/
+
+int
+gsl_splinalg_precon_init(const gsl_spmatrix *A, gsl_splinalg_precon *P)
+{
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != P->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      return P->type->init(A, P->state);
+    }
+}
+
+/*
+gsl_splinalg_precon_apply()
+  Compute z = M^{-1} r; r and z may be the same vector
+*/
+
+int
+gsl_splinalg_precon_apply(const gsl_vector *r, gsl_vector *z,
+                          gsl_splinalg_precon *P)
+{
+  if (r->size != P->n || z->size != P->n)
+    {
+      GSL_ERROR("vector does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      if (r != z)
+        gsl_vector_memcpy(z, r);
+
+      return P->type->apply(z, P->state);
+    }
+}
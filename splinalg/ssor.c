@@ -0,0 +1,145 @@
+/* splinalg/ssor.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+#include "common.h"
+
+/*
+ * Symmetric successive over-relaxation preconditioner
+ *
+ * M = 1/(omega (2 - omega)) (D + omega L) D^{-1} (D + omega U)
+ *
+ * where A = L + D + U. For symmetric positive definite A and
+ * 0 < omega < 2, M is symmetric positive definite.
+ */
+
+typedef struct
+{
+  size_t n;
+  double omega;    /* relaxation parameter */
+  gsl_spmatrix *A; /* copy of A in compressed row format */
+  double *dinv;    /* inverse diagonal of A */
+} ssor_state_t;
+
+static void ssor_free(void *vstate);
+
+static void *
+ssor_alloc(const size_t n, const gsl_splinalg_precon_params *params)
+{
+  ssor_state_t *state;
+
+  if (params->omega <= 0.0 || params->omega >= 2.0)
+    {
+      GSL_ERROR_NULL("omega must be in (0,2)", GSL_EINVAL);
+    }
+
+  state = gsl_calloc(1, sizeof(ssor_state_t));
+  if (!state)
+    {
+      GSL_ERROR_NULL("failed to allocate ssor state", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->omega = params->omega;
+
+  state->dinv = gsl_malloc(n * sizeof(double));
+  if (!state->dinv)
+    {
+      ssor_free(state);
+      GSL_ERROR_NULL("failed to allocate diagonal", GSL_ENOMEM);
+    }
+
+  return state;
+} /* ssor_alloc() */
+
+static void
+ssor_free(void *vstate)
+{
+  ssor_state_t *state = (ssor_state_t *) vstate;
+
+  if (state->A)
+    gsl_spmatrix_free(state->A);
+
+  if (state->dinv)
+    gsl_free(state->dinv);
+
+  gsl_free(state);
+} /* ssor_free() */
+
+static int
+ssor_init(const gsl_spmatrix *A, void *vstate)
+{
+  ssor_state_t *state = (ssor_state_t *) vstate;
+
+  if (state->A)
+    gsl_spmatrix_free(state->A);
+
+  state->A = splinalg_precon_crs(A);
+  if (!state->A)
+    {
+      GSL_ERROR("failed to copy matrix", GSL_ENOMEM);
+    }
+
+  return splinalg_precon_diag(state->A, state->dinv, NULL);
+} /* ssor_init() */
+
+static int
+ssor_apply(gsl_vector *x, void *vstate)
+{
+  ssor_state_t *state = (ssor_state_t *) vstate;
+  const double omega = state->omega;
+  size_t i;
+
+  if (!state->A)
+    {
+      GSL_ERROR("preconditioner has not been initialized", GSL_EFAILED);
+    }
+
+  /* solve (D + omega L) y = omega (2 - omega) x */
+  gsl_vector_scale(x, omega * (2.0 - omega));
+  splinalg_precon_lsolve(state->A, omega, state->dinv, x);
+
+  /* y <- D y */
+  for (i = 0; i < state->n; ++i)
+    gsl_vector_set(x, i, gsl_vector_get(x, i) / state->dinv[i]);
+
+  /* solve (D + omega U) x = y */
+  splinalg_precon_usolve(state->A, omega, state->dinv, x);
+
+  return GSL_SUCCESS;
+} /* ssor_apply() */
+
+static const gsl_splinalg_precon_type ssor_type =
+{
+  "ssor",
+  &ssor_alloc,
+  &ssor_init,
+  &ssor_apply,
+  &ssor_free
+};
+
+const gsl_splinalg_precon_type * gsl_splinalg_precon_ssor = &ssor_type;
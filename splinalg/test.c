@@ -94,19 +94,57 @@ create_random_vector(gsl_vector *v, const gsl_rng *r)
     }
 } /* create_random_vector() */
 
+/*
+create_poisson2d()
+  Create the 5-point Laplacian on an n-by-n grid, shifted by
+-sigma I; the matrix is symmetric positive definite for sigma = 0
+and indefinite for sigma between its smallest and largest eigenvalues,
+which lie in (0,8)
+
+Return: pointer to sparse matrix in triplet format (must be freed by caller)
+*/
+
+static gsl_spmatrix *
+create_poisson2d(const size_t n, const double sigma)
+{
+  const size_t N = n * n;
+  gsl_spmatrix *T = gsl_spmatrix_alloc_nzmax(N, N, 5 * N, GSL_SPMATRIX_TRIPLET);
+  size_t i, j;
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < n; ++j)
+        {
+          size_t row = i * n + j;
+
+          gsl_spmatrix_set(T, row, row, 4.0 - sigma);
+          if (i > 0)
+            gsl_spmatrix_set(T, row, row - n, -1.0);
+          if (i + 1 < n)
+            gsl_spmatrix_set(T, row, row + n, -1.0);
+          if (j > 0)
+            gsl_spmatrix_set(T, row, row - 1, -1.0);
+          if (j + 1 < n)
+            gsl_spmatrix_set(T, row, row + 1, -1.0);
+        }
+    }
+
+  return T;
+}
+
 /*
 test_poisson()
   Solve u''(x) = -pi^2 sin(pi*x), u(x) = sin(pi*x)
   epsrel is the relative error threshold with the exact solution
 */
 static void
-test_poisson(const size_t N, const double epsrel, const int compress)
+test_poisson(const gsl_splinalg_itersolve_type *T, const size_t N,
+             const double epsrel, const int compress)
 {
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const size_t n = N - 2;                     /* subtract 2 to exclude boundaries */
   const double h = 1.0 / (N - 1.0);           /* grid spacing */
   const double tol = 1.0e-9;
-  const size_t max_iter = 10;
+  const size_t max_iter = 20;
   size_t iter = 0;
   gsl_spmatrix *A = gsl_spmatrix_alloc(n ,n); /* triplet format */
   gsl_spmatrix *B;
@@ -146,7 +184,9 @@ test_poisson(const size_t N, const double epsrel, const int compress)
       gsl_vector_set(b, i, bi);
     }
 
-  if (compress)
+  if (compress == 2)
+    B = gsl_spmatrix_sell(A, GSL_SPMATRIX_SELL_C, 32);
+  else if (compress)
     B = gsl_spmatrix_compcol(A);
   else
     B = A;
@@ -209,13 +249,12 @@ rhs = ones(n,1)
 */
 
 static void
-test_toeplitz(const size_t N, const double a, const double b,
-              const double c)
+test_toeplitz(const gsl_splinalg_itersolve_type *T, const size_t N,
+              const double a, const double b, const double c)
 {
   int status;
   const double tol = 1.0e-10;
   const size_t max_iter = 10;
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const char *desc;
   gsl_spmatrix *A;
   gsl_vector *rhs, *x;
@@ -285,9 +324,9 @@ test_toeplitz(const size_t N, const double a, const double b,
 } /* test_toeplitz() */
 
 static void
-test_random(const size_t N, const gsl_rng *r, const int compress)
+test_random(const gsl_splinalg_itersolve_type *T, const size_t N,
+            const gsl_rng *r, const int compress)
 {
-  const gsl_splinalg_itersolve_type *T = gsl_splinalg_itersolve_gmres;
   const double tol = 1.0e-8;
   int status;
   gsl_spmatrix *A = create_random_sparse(N, N, 0.3, r);
@@ -337,35 +376,755 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
     gsl_spmatrix_free(B);
 } /* test_random() */
 
+/*
+test_solver_poisson2d()
+  Solve the shifted 5-point Laplacian system with solver T and
+preconditioner PT (or none), and check the true residual
+*/
+
+static void
+test_solver_poisson2d(const gsl_splinalg_itersolve_type *T,
+                      const size_t n, const double sigma,
+                      const gsl_splinalg_precon_type *PT, const int side,
+                      const gsl_rng *r)
+{
+  const size_t N = n * n;
+  const double tol = 1.0e-8;
+  const size_t max_iter = 100;
+  gsl_spmatrix *S = create_poisson2d(n, sigma);
+  gsl_spmatrix *A = gsl_spmatrix_comprow(S);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_calloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_itersolve *w = gsl_splinalg_itersolve_alloc(T, N, 0);
+  gsl_splinalg_precon *P = NULL;
+  const char *desc = gsl_splinalg_itersolve_name(w);
+  const char *pdesc = "none";
+  size_t iter = 0;
+  double normr;
+  int status;
+
+  if (PT)
+    {
+      P = gsl_splinalg_precon_alloc(PT, N, NULL);
+      gsl_splinalg_precon_init(A, P);
+      gsl_splinalg_itersolve_set_precon(w, P, side);
+      pdesc = gsl_splinalg_precon_name(P);
+    }
+
+  create_random_vector(b, r);
+
+  do
+    status = gsl_splinalg_itersolve_iterate(A, b, tol, x, w);
+  while (status == GSL_CONTINUE && ++iter < max_iter);
+
+  gsl_test(status, "%s/%s poisson2d n=%zu sigma=%g side=%d status",
+           desc, pdesc, n, sigma, side);
+
+  gsl_vector_memcpy(res, b);
+  gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, res);
+  normr = gsl_blas_dnrm2(res);
+
+  status = normr > tol * gsl_blas_dnrm2(b);
+  gsl_test(status, "%s/%s poisson2d n=%zu sigma=%g side=%d residual",
+           desc, pdesc, n, sigma, side);
+
+  status = gsl_fcmp(normr, gsl_splinalg_itersolve_normr(w), 1.0e-12) != 0;
+  gsl_test(status, "%s/%s poisson2d n=%zu sigma=%g side=%d normr",
+           desc, pdesc, n, sigma, side);
+
+  gsl_spmatrix_free(S);
+  gsl_spmatrix_free(A);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_itersolve_free(w);
+
+  if (P)
+    gsl_splinalg_precon_free(P);
+} /* test_solver_poisson2d() */
+
+/*
+test_precon_exact()
+  Test preconditioners on matrices for which they are exact,
+M = A, by checking M^{-1} (A x) = x
+
+Inputs: T      - preconditioner type
+        params - preconditioner parameters
+        A      - matrix for which T is exact, triplet format
+        r      - random number generator
+*/
+
+static void
+test_precon_exact(const gsl_splinalg_precon_type *T,
+                  const gsl_splinalg_precon_params *params,
+                  const gsl_spmatrix *A, const gsl_rng *r)
+{
+  const size_t N = A->size1;
+  gsl_splinalg_precon *P = gsl_splinalg_precon_alloc(T, N, params);
+  const char *desc = gsl_splinalg_precon_name(P);
+  gsl_spmatrix *S[4];
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_vector *z = gsl_vector_alloc(N);
+  size_t i, k;
+  int status;
+
+  S[0] = (gsl_spmatrix *) A;
+  S[1] = gsl_spmatrix_compcol(A);
+  S[2] = gsl_spmatrix_comprow(A);
+  S[3] = gsl_spmatrix_sell(A, GSL_SPMATRIX_SELL_C, 32);
+
+  create_random_vector(x, r);
+
+  for (k = 0; k < 4; ++k)
+    {
+      status = gsl_splinalg_precon_init(S[k], P);
+      gsl_test(status, "%s exact init N=%zu format=%zu", desc, N, k);
+
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, A, x, 0.0, y);
+      gsl_splinalg_precon_apply(y, z, P);
+
+      for (i = 0; i < N; ++i)
+        {
+          gsl_test_rel(gsl_vector_get(z, i), gsl_vector_get(x, i), 1.0e-10,
+                       "%s exact N=%zu format=%zu i=%zu", desc, N, k, i);
+        }
+
+      /* in place application */
+      gsl_splinalg_precon_apply(y, y, P);
+      status = !gsl_vector_equal(y, z);
+      gsl_test(status, "%s exact in place N=%zu format=%zu", desc, N, k);
+    }
+
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_spmatrix_free(S[3]);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_splinalg_precon_free(P);
+} /* test_precon_exact() */
+
+static void
+test_precon(const size_t N, const gsl_rng *r)
+{
+  gsl_splinalg_precon_params params = gsl_splinalg_precon_default_params();
+  gsl_spmatrix *A;
+  size_t i, j;
+
+  /* Jacobi is exact for diagonal matrices */
+  A = gsl_spmatrix_alloc(N, N);
+  for (i = 0; i < N; ++i)
+    gsl_spmatrix_set(A, i, i, 1.0 + gsl_rng_uniform(r));
+
+  test_precon_exact(gsl_splinalg_precon_jacobi, &params, A, r);
+  gsl_spmatrix_free(A);
+
+  /* SSOR with omega = 1 is exact for upper triangular matrices */
+  A = create_random_sparse(N, N, 0.2, r);
+  {
+    gsl_spmatrix *U = gsl_spmatrix_alloc(N, N);
+
+    for (i = 0; i < A->nz; ++i)
+      {
+        if (A->i[i] < A->p[i])
+          gsl_spmatrix_set(U, A->i[i], A->p[i], A->data[i]);
+      }
+
+    for (i = 0; i < N; ++i)
+      gsl_spmatrix_set(U, i, i, 1.0 + gsl_rng_uniform(r));
+
+    params.omega = 1.0;
+    test_precon_exact(gsl_splinalg_precon_ssor, &params, U, r);
+    gsl_spmatrix_free(U);
+  }
+  gsl_spmatrix_free(A);
+
+  /* ILU(0) is exact for tridiagonal matrices */
+  A = gsl_spmatrix_alloc(N, N);
+  for (i = 0; i < N; ++i)
+    {
+      gsl_spmatrix_set(A, i, i, 4.0 + gsl_rng_uniform(r));
+      if (i > 0)
+        gsl_spmatrix_set(A, i, i - 1, gsl_rng_uniform(r) - 0.5);
+      if (i + 1 < N)
+        gsl_spmatrix_set(A, i, i + 1, gsl_rng_uniform(r) - 0.5);
+    }
+
+  test_precon_exact(gsl_splinalg_precon_ilu0, &params, A, r);
+  gsl_spmatrix_free(A);
+
+  /* ILUT without dropping is a complete LU factorization */
+  A = create_random_sparse(N, N, 0.1, r);
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < A->nz; ++j)
+        {
+          if (A->i[j] == i)
+            sum += fabs(A->data[j]);
+        }
+
+      gsl_spmatrix_set(A, i, i, 1.0 + sum);
+    }
+
+  params.droptol = 0.0;
+  params.maxfill = N;
+  test_precon_exact(gsl_splinalg_precon_ilut, &params, A, r);
+
+  /* AMG is a direct solve when A is no larger than the coarsest level */
+  params.coarse_size = N;
+  test_precon_exact(gsl_splinalg_precon_amg, &params, A, r);
+  gsl_spmatrix_free(A);
+} /* test_precon() */
+
+/*
+test_precon_poisson2d()
+  Solve the 5-point Laplacian on an n-by-n grid with restarted
+GMRES and a preconditioner, and check that it converges in no more
+restarts than without the preconditioner
+*/
+
+static void
+test_precon_poisson2d(const size_t n, const gsl_splinalg_precon_type *PT,
+                      const int side, const gsl_rng *r)
+{
+  const size_t N = n * n;
+  const double tol = 1.0e-8;
+  const size_t max_iter = 2000;
+  gsl_spmatrix *T = create_poisson2d(n, 0.0);
+  gsl_spmatrix *A;
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_itersolve *w =
+    gsl_splinalg_itersolve_alloc(gsl_splinalg_itersolve_gmres, N, 20);
+  gsl_splinalg_precon *P = gsl_splinalg_precon_alloc(PT, N, NULL);
+  const char *desc = gsl_splinalg_precon_name(P);
+  size_t iter[2];
+  int k, status;
+
+  A = gsl_spmatrix_compcol(T);
+  create_random_vector(b, r);
+  gsl_splinalg_precon_init(A, P);
+
+  /* k = 0: no preconditioner, k = 1: preconditioned */
+  for (k = 0; k < 2; ++k)
+    {
+      gsl_splinalg_itersolve_set_precon(w, k ? P : NULL, side);
+      gsl_vector_set_zero(x);
+      iter[k] = 0;
+
+      do
+        status = gsl_splinalg_itersolve_iterate(A, b, tol, x, w);
+      while (status == GSL_CONTINUE && ++iter[k] < max_iter);
+
+      gsl_test(status, "gmres/%s poisson2d side=%d n=%zu status", desc,
+               side, n);
+
+      gsl_vector_memcpy(res, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, res);
+      status = gsl_blas_dnrm2(res) > tol * gsl_blas_dnrm2(b);
+      gsl_test(status, "gmres/%s poisson2d side=%d n=%zu residual", desc,
+               side, n);
+    }
+
+  status = iter[1] > iter[0];
+  gsl_test(status, "gmres/%s poisson2d side=%d n=%zu restarts %zu/%zu",
+           desc, side, n, iter[1], iter[0]);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_itersolve_free(w);
+  gsl_splinalg_precon_free(P);
+} /* test_precon_poisson2d() */
+
+/*
+test_amg_poisson2d()
+  Solve the 5-point Laplacian on an n-by-n grid with CG and the AMG
+preconditioner, for several right hand sides with one setup, and
+check that the number of iterations does not grow with n
+*/
+
+static void
+test_amg_poisson2d(const size_t n, const int smoother, const gsl_rng *r)
+{
+  const size_t N = n * n;
+  const double tol = 1.0e-8;
+  const size_t max_iter = 25;
+  gsl_spmatrix *T = create_poisson2d(n, 0.0);
+  gsl_spmatrix *A = gsl_spmatrix_compcol(T);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_vector *res = gsl_vector_alloc(N);
+  gsl_splinalg_precon_params params = gsl_splinalg_precon_default_params();
+  gsl_splinalg_itersolve *w =
+    gsl_splinalg_itersolve_alloc(gsl_splinalg_itersolve_cg, N, 1);
+  gsl_splinalg_precon *P;
+  size_t iter, k;
+  int status;
+
+  params.smoother = smoother;
+  params.coarse_size = 50;
+  P = gsl_splinalg_precon_alloc(gsl_splinalg_precon_amg, N, &params);
+
+  status = gsl_splinalg_precon_init(A, P);
+  gsl_test(status, "cg/amg poisson2d n=%zu smoother=%d init", n, smoother);
+
+  gsl_splinalg_itersolve_set_precon(w, P, GSL_SPLINALG_PRECON_LEFT);
+
+  for (k = 0; k < 3; ++k)
+    {
+      create_random_vector(b, r);
+      gsl_vector_set_zero(x);
+      iter = 0;
+
+      do
+        status = gsl_splinalg_itersolve_iterate(A, b, tol, x, w);
+      while (status == GSL_CONTINUE && ++iter < max_iter);
+
+      gsl_test(status, "cg/amg poisson2d n=%zu smoother=%d rhs=%zu iter=%zu",
+               n, smoother, k, iter);
+
+      gsl_vector_memcpy(res, b);
+      gsl_spblas_dgemv(CblasNoTrans, -1.0, A, x, 1.0, res);
+      status = gsl_blas_dnrm2(res) > tol * gsl_blas_dnrm2(b);
+      gsl_test(status, "cg/amg poisson2d n=%zu smoother=%d rhs=%zu residual",
+               n, smoother, k);
+    }
+
+  /* a preconditioner of another size is rejected */
+  {
+    gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
+    gsl_splinalg_precon *Q =
+      gsl_splinalg_precon_alloc(gsl_splinalg_precon_jacobi, N + 1, NULL);
+
+    status = gsl_splinalg_itersolve_set_precon(w, Q, GSL_SPLINALG_PRECON_LEFT)
+             != GSL_EBADLEN || w->precon != P;
+    gsl_test(status, "cg/amg poisson2d n=%zu smoother=%d precon size",
+             n, smoother);
+
+    gsl_splinalg_precon_free(Q);
+    gsl_set_error_handler(old_handler);
+  }
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+  gsl_splinalg_itersolve_free(w);
+  gsl_splinalg_precon_free(P);
+} /* test_amg_poisson2d() */
+
+/* check that x = x_exact, using relative tolerance tol */
+static void
+test_solution(const gsl_vector *x, const gsl_vector *x_exact,
+              const double tol, const char *desc, const char *name)
+{
+  gsl_vector *d = gsl_vector_alloc(x->size);
+  double err;
+
+  gsl_vector_memcpy(d, x);
+  gsl_vector_sub(d, x_exact);
+  err = gsl_blas_dnrm2(d) / gsl_blas_dnrm2(x_exact);
+  gsl_test(!(err <= tol), "%s %s N=%zu error=%e", desc, name, x->size, err);
+
+  gsl_vector_free(d);
+}
+
+/*
+test_cholesky()
+  Test the sparse Cholesky factorization on the SPD matrix A given in
+triplet format with full symmetric storage
+*/
+
+static void
+test_cholesky(const gsl_spmatrix *A, const char *name, const gsl_rng *r)
+{
+  const size_t N = A->size1;
+  gsl_splinalg_cholesky_workspace *w = gsl_splinalg_cholesky_alloc(N);
+  gsl_vector *x_exact = gsl_vector_alloc(N);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_spmatrix *S[3], *A2;
+  double a00;
+  gsl_error_handler_t *old_handler;
+  size_t i, k;
+  int status;
+
+  S[0] = (gsl_spmatrix *) A;
+  S[1] = gsl_spmatrix_compcol(A);
+  S[2] = gsl_spmatrix_comprow(A);
+
+  create_random_vector(x_exact, r);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, x_exact, 0.0, b);
+
+  for (k = 0; k < 3; ++k)
+    {
+      status = gsl_splinalg_cholesky_symbolic(S[k], w);
+      gsl_test(status, "cholesky %s N=%zu format=%zu symbolic", name, N, k);
+
+      status = gsl_splinalg_cholesky_numeric(S[k], w);
+      gsl_test(status, "cholesky %s N=%zu format=%zu numeric", name, N, k);
+
+      status = gsl_splinalg_cholesky_solve(w, b, x);
+      gsl_test(status, "cholesky %s N=%zu format=%zu solve", name, N, k);
+      test_solution(x, x_exact, 1.0e-10, "cholesky solve", name);
+    }
+
+  gsl_test(w->nsuper > N, "cholesky %s N=%zu nsuper=%zu", name, N, w->nsuper);
+
+  /* refactor A2 = A + 2 I, with the same pattern */
+  A2 = gsl_spmatrix_alloc_nzmax(N, N, A->nz, GSL_SPMATRIX_TRIPLET);
+  gsl_spmatrix_memcpy(A2, A);
+  for (i = 0; i < N; ++i)
+    gsl_spmatrix_set(A2, i, i, gsl_spmatrix_get(A, i, i) + 2.0);
+
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A2, x_exact, 0.0, b);
+
+  status = gsl_splinalg_cholesky_numeric(A2, w);
+  gsl_test(status, "cholesky %s N=%zu refactor", name, N);
+
+  gsl_vector_memcpy(x, b);
+  status = gsl_splinalg_cholesky_svx(w, x);
+  gsl_test(status, "cholesky %s N=%zu refactor svx", name, N);
+  test_solution(x, x_exact, 1.0e-10, "cholesky refactor", name);
+
+  /* indefinite matrices are rejected */
+  gsl_spmatrix_scale(A2, -1.0);
+  old_handler = gsl_set_error_handler_off();
+  status = gsl_splinalg_cholesky_numeric(A2, w);
+  gsl_test(status != GSL_EDOM, "cholesky %s N=%zu indefinite", name, N);
+
+  /* as are NaN pivots */
+  gsl_spmatrix_scale(A2, -1.0);
+  a00 = gsl_spmatrix_get(A2, 0, 0);
+  gsl_spmatrix_set(A2, 0, 0, GSL_NAN);
+  status = gsl_splinalg_cholesky_numeric(A2, w);
+  gsl_test(status != GSL_EDOM, "cholesky %s N=%zu nan pivot", name, N);
+  gsl_spmatrix_set(A2, 0, 0, a00);
+
+  /* so are elements outside the analyzed pattern, if there is fill */
+  if (N > 2 && gsl_spmatrix_get(A, N - 1, 0) == 0.0 &&
+      w->parent[0] != N - 1)
+    {
+      gsl_spmatrix_set(A2, N - 1, 0, 1.0e-3);
+      gsl_spmatrix_set(A2, 0, N - 1, 1.0e-3);
+      status = gsl_splinalg_cholesky_numeric(A2, w);
+      gsl_test(status != GSL_EINVAL, "cholesky %s N=%zu pattern", name, N);
+    }
+
+  gsl_set_error_handler(old_handler);
+
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_spmatrix_free(A2);
+  gsl_vector_free(x_exact);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_splinalg_cholesky_free(w);
+} /* test_cholesky() */
+
+/*
+test_LU()
+  Test the sparse LU factorization on the nonsingular matrix A in
+triplet format
+*/
+
+static void
+test_LU(const gsl_spmatrix *A, const double pivtol, const char *name,
+        const gsl_rng *r)
+{
+  const size_t N = A->size1;
+  gsl_splinalg_LU_workspace *w = gsl_splinalg_LU_alloc(N);
+  gsl_vector *x_exact = gsl_vector_alloc(N);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_spmatrix *S[3], *A2;
+  gsl_error_handler_t *old_handler;
+  size_t i, k;
+  int status;
+
+  w->pivtol = pivtol;
+
+  S[0] = (gsl_spmatrix *) A;
+  S[1] = gsl_spmatrix_compcol(A);
+  S[2] = gsl_spmatrix_comprow(A);
+
+  create_random_vector(x_exact, r);
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A, x_exact, 0.0, b);
+
+  for (k = 0; k < 3; ++k)
+    {
+      status = gsl_splinalg_LU_decomp(S[k], w);
+      gsl_test(status, "LU %s N=%zu pivtol=%g format=%zu decomp",
+               name, N, pivtol, k);
+
+      status = gsl_splinalg_LU_solve(w, b, x);
+      gsl_test(status, "LU %s N=%zu pivtol=%g format=%zu solve",
+               name, N, pivtol, k);
+      test_solution(x, x_exact, 1.0e-8, "LU solve", name);
+    }
+
+  /* refactor a matrix with the same pattern and new values */
+  A2 = gsl_spmatrix_alloc_nzmax(N, N, A->nz, GSL_SPMATRIX_TRIPLET);
+  gsl_spmatrix_memcpy(A2, A);
+  for (i = 0; i < A2->nz; ++i)
+    A2->data[i] *= 1.0 + 0.1 * gsl_rng_uniform(r);
+
+  gsl_spblas_dgemv(CblasNoTrans, 1.0, A2, x_exact, 0.0, b);
+
+  status = gsl_splinalg_LU_refactor(A2, w);
+  gsl_test(status, "LU %s N=%zu pivtol=%g refactor", name, N, pivtol);
+
+  gsl_vector_memcpy(x, b);
+  status = gsl_splinalg_LU_svx(w, x);
+  gsl_test(status, "LU %s N=%zu pivtol=%g refactor svx", name, N, pivtol);
+  test_solution(x, x_exact, 1.0e-8, "LU refactor", name);
+
+  /* solution vector with non-unit stride */
+  {
+    gsl_vector *y = gsl_vector_alloc(2 * N);
+    gsl_vector_view yv = gsl_vector_subvector_with_stride(y, 1, 2, N);
+
+    gsl_vector_memcpy(&yv.vector, b);
+    status = gsl_splinalg_LU_svx(w, &yv.vector);
+    gsl_test(status, "LU %s N=%zu pivtol=%g stride svx", name, N, pivtol);
+    test_solution(&yv.vector, x_exact, 1.0e-8, "LU stride", name);
+
+    gsl_vector_free(y);
+  }
+
+  /* a matrix with an empty column is singular */
+  old_handler = gsl_set_error_handler_off();
+
+  gsl_spmatrix_memcpy(A2, A);
+  for (i = 0; i < A2->nz; ++i)
+    {
+      if (A2->p[i] == N / 2)
+        A2->data[i] = 0.0;
+    }
+
+  status = gsl_splinalg_LU_decomp(A2, w);
+  gsl_test(status != GSL_ESING, "LU %s N=%zu pivtol=%g singular",
+           name, N, pivtol);
+
+  status = gsl_splinalg_LU_svx(w, x);
+  gsl_test(status != GSL_EINVAL, "LU %s N=%zu pivtol=%g not factored",
+           name, N, pivtol);
+
+  gsl_set_error_handler(old_handler);
+
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_spmatrix_free(A2);
+  gsl_vector_free(x_exact);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_splinalg_LU_free(w);
+} /* test_LU() */
+
+static void
+test_direct(const gsl_rng *r)
+{
+  const size_t sizes[] = { 1, 2, 5, 50, 300 };
+  size_t k;
+
+  for (k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+      const size_t N = sizes[k];
+      gsl_spmatrix *B = create_random_sparse(N, N, 3.0 / N, r);
+      gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+      size_t *perm = malloc(N * sizeof(size_t));
+      size_t i;
+
+      /* SPD: A = B + B^T + N I */
+      for (i = 0; i < B->nz; ++i)
+        {
+          const size_t bi = B->i[i], bj = B->p[i];
+
+          gsl_spmatrix_set(A, bi, bj, gsl_spmatrix_get(A, bi, bj) + B->data[i]);
+          gsl_spmatrix_set(A, bj, bi, gsl_spmatrix_get(A, bj, bi) + B->data[i]);
+        }
+
+      for (i = 0; i < N; ++i)
+        gsl_spmatrix_set(A, i, i, gsl_spmatrix_get(A, i, i) + N);
+
+      test_cholesky(A, "random", r);
+      gsl_spmatrix_free(A);
+
+      /* nonsymmetric with randomly permuted rows, requiring pivoting */
+      for (i = 0; i < N; ++i)
+        {
+          size_t j = gsl_rng_uniform_int(r, i + 1);
+
+          perm[i] = perm[j];
+          perm[j] = i;
+        }
+
+      A = gsl_spmatrix_alloc(N, N);
+      for (i = 0; i < B->nz; ++i)
+        {
+          gsl_spmatrix_set(A, perm[B->i[i]], B->p[i],
+                           B->data[i] + (B->i[i] == B->p[i] ? 2.0 : 0.0));
+        }
+
+      test_LU(A, 0.1, "random", r);
+      test_LU(A, 1.0, "random", r);
+
+      gsl_spmatrix_free(A);
+      gsl_spmatrix_free(B);
+      free(perm);
+    }
+
+  {
+    gsl_spmatrix *A = create_poisson2d(30, 0.0);
+
+    test_cholesky(A, "poisson2d", r);
+    test_LU(A, 0.1, "poisson2d", r);
+    gsl_spmatrix_free(A);
+  }
+} /* test_direct() */
+
 int
 main()
 {
   gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
   size_t n;
 
-  test_poisson(7, 1.0e-1, 0);
-  test_poisson(7, 1.0e-1, 1);
+  test_poisson(gsl_splinalg_itersolve_gmres, 7, 1.0e-1, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres, 7, 1.0e-1, 1);
+
+  test_poisson(gsl_splinalg_itersolve_gmres, 543, 1.0e-5, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres, 543, 1.0e-5, 1);
+  test_poisson(gsl_splinalg_itersolve_gmres, 543, 1.0e-5, 2);
+
+  test_poisson(gsl_splinalg_itersolve_gmres, 1000, 1.0e-6, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres, 1000, 1.0e-6, 1);
+
+  test_poisson(gsl_splinalg_itersolve_gmres, 5000, 1.0e-7, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres, 5000, 1.0e-7, 1);
+  test_poisson(gsl_splinalg_itersolve_gmres, 5000, 1.0e-7, 2);
+
+  test_poisson(gsl_splinalg_itersolve_gmres_cgs, 543, 1.0e-5, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres_cgs, 1000, 1.0e-6, 1);
+  test_poisson(gsl_splinalg_itersolve_gmres_cgs2, 543, 1.0e-5, 0);
+  test_poisson(gsl_splinalg_itersolve_gmres_cgs2, 1000, 1.0e-6, 2);
+
+  /* the 1D Poisson matrix is negative definite */
+  test_poisson(gsl_splinalg_itersolve_minres, 543, 1.0e-5, 0);
+  test_poisson(gsl_splinalg_itersolve_minres, 1000, 1.0e-6, 1);
+  test_poisson(gsl_splinalg_itersolve_minres, 1000, 1.0e-6, 2);
+  test_poisson(gsl_splinalg_itersolve_bicgstab, 543, 1.0e-5, 0);
+  test_poisson(gsl_splinalg_itersolve_bicgstab, 1000, 1.0e-6, 1);
+
+  test_toeplitz(gsl_splinalg_itersolve_gmres, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres, 15, 1.0, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres, 50, 1.0, 2.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres, 1000, 0.5, 1.0, 0.01);
+
+  test_toeplitz(gsl_splinalg_itersolve_gmres_cgs, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres_cgs, 1000, 0.5, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres_cgs2, 15, 1.0, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_gmres_cgs2, 50, 1.0, 2.0, 0.01);
+
+  test_toeplitz(gsl_splinalg_itersolve_bicgstab, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_bicgstab, 15, 1.0, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_bicgstab, 50, 1.0, 2.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_bicgstab, 1000, 0.5, 1.0, 0.01);
+
+  /* symmetric positive definite Toeplitz */
+  test_toeplitz(gsl_splinalg_itersolve_cg, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_cg, 1000, 0.4, 1.0, 0.4);
+  test_toeplitz(gsl_splinalg_itersolve_cg_pipelined, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_cg_pipelined, 1000, 0.4, 1.0, 0.4);
+  test_toeplitz(gsl_splinalg_itersolve_minres, 15, 0.01, 1.0, 0.01);
+  test_toeplitz(gsl_splinalg_itersolve_minres, 1000, 0.4, 1.0, 0.4);
 
-  test_poisson(543, 1.0e-5, 0);
-  test_poisson(543, 1.0e-5, 1);
+  for (n = 1; n <= 100; ++n)
+    {
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 0);
+      test_random(gsl_splinalg_itersolve_gmres, n, r, 1);
+      test_random(gsl_splinalg_itersolve_gmres_cgs, n, r, 0);
+      test_random(gsl_splinalg_itersolve_gmres_cgs2, n, r, 1);
+    }
 
-  test_poisson(1000, 1.0e-6, 0);
-  test_poisson(1000, 1.0e-6, 1);
+  test_precon(1, r);
+  test_precon(10, r);
+  test_precon(73, r);
 
-  test_poisson(5000, 1.0e-7, 0);
-  test_poisson(5000, 1.0e-7, 1);
+  {
+    const gsl_splinalg_precon_type *types[5];
+    int side;
+
+    types[0] = gsl_splinalg_precon_jacobi;
+    types[1] = gsl_splinalg_precon_ssor;
+    types[2] = gsl_splinalg_precon_ilu0;
+    types[3] = gsl_splinalg_precon_ilut;
+    types[4] = gsl_splinalg_precon_amg;
+
+    for (side = GSL_SPLINALG_PRECON_LEFT; side <= GSL_SPLINALG_PRECON_RIGHT;
+         ++side)
+      {
+        for (n = 0; n < 5; ++n)
+          test_precon_poisson2d(20, types[n], side, r);
+      }
+  }
 
-  test_toeplitz(15, 0.01, 1.0, 0.01);
-  test_toeplitz(15, 1.0, 1.0, 0.01);
-  test_toeplitz(50, 1.0, 2.0, 0.01);
-  test_toeplitz(1000, 0.5, 1.0, 0.01);
+  {
+    const gsl_splinalg_itersolve_type *solvers[7];
+    const gsl_splinalg_precon_type *types[6];
+    size_t k;
+    int side;
+
+    solvers[0] = gsl_splinalg_itersolve_cg;
+    solvers[1] = gsl_splinalg_itersolve_cg_pipelined;
+    solvers[2] = gsl_splinalg_itersolve_minres;
+    solvers[3] = gsl_splinalg_itersolve_bicgstab;
+    solvers[4] = gsl_splinalg_itersolve_gmres;
+    solvers[5] = gsl_splinalg_itersolve_gmres_cgs;
+    solvers[6] = gsl_splinalg_itersolve_gmres_cgs2;
+
+    types[0] = NULL;
+    types[1] = gsl_splinalg_precon_jacobi;
+    types[2] = gsl_splinalg_precon_ssor;
+    types[3] = gsl_splinalg_precon_ilu0;
+    types[4] = gsl_splinalg_precon_amg;
+    types[5] = gsl_splinalg_precon_ilut;
+
+    /* ILUT is not symmetric, so only use it with the nonsymmetric solvers */
+    for (side = GSL_SPLINALG_PRECON_LEFT; side <= GSL_SPLINALG_PRECON_RIGHT;
+         ++side)
+      {
+        for (k = 0; k < 7; ++k)
+          {
+            for (n = 0; n < (k < 3 ? 5 : 6); ++n)
+              test_solver_poisson2d(solvers[k], 30, 0.0, types[n], side, r);
+          }
+      }
+
+    /* symmetric indefinite systems, on which restarted GMRES stagnates */
+    for (k = 2; k < 4; ++k)
+      test_solver_poisson2d(solvers[k], 30, 0.5, NULL, 0, r);
+
+    test_solver_poisson2d(gsl_splinalg_itersolve_minres, 30, 0.5,
+                          gsl_splinalg_precon_jacobi, 0, r);
+  }
 
-  for (n = 1; n <= 100; ++n)
+  for (n = 16; n <= 128; n *= 2)
     {
-      test_random(n, r, 0);
-      test_random(n, r, 1);
+      test_amg_poisson2d(n, GSL_SPLINALG_AMG_GS, r);
+      test_amg_poisson2d(n, GSL_SPLINALG_AMG_JACOBI, r);
     }
 
+  test_direct(r);
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
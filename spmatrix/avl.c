@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <string.h>
+#include <gsl/gsl_alloc.h>
 
 /* Function types. */
 typedef int avl_comparison_func (const void *avl_a, const void *avl_b,
@@ -103,7 +104,7 @@ avl_create (avl_comparison_func *compare, void *param,
     allocator = &avl_allocator_default;
 
   /*tree = allocator->libavl_malloc (allocator, sizeof *tree);*/
-  tree = malloc(sizeof *tree);
+  tree = gsl_malloc(sizeof *tree);
   if (tree == NULL)
     return NULL;
 
@@ -583,7 +584,7 @@ static void
 avl_destroy (struct avl_table *tree, avl_item_func *destroy)
 {
   avl_empty(tree, destroy);
-  free(tree);
+  gsl_free(tree);
 }
 
 /* Allocates |size| bytes of space using |malloc()|.
@@ -591,14 +592,14 @@ avl_destroy (struct avl_table *tree, avl_item_func *destroy)
 static void *
 avl_malloc (size_t size, void *param)
 {
-  return malloc (size);
+  return gsl_malloc (size);
 }
 
 /* Frees |block|. */
 static void
 avl_free (void *block, void *param)
 {
-  free (block);
+  gsl_free (block);
 }
 
 /* Default memory allocator that uses |malloc()| and |free()|. */
@@ -0,0 +1,104 @@
+/* spmatrix/chunk.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Helpers for the parallel counting sorts which convert triplets to
+ * compressed storage and transpose compressed matrices. The non-zero
+ * elements are split into nchunks contiguous chunks, each with its
+ * own histogram of n outer indices in the work array, so that the
+ * result is the same as that of a serial counting sort.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* below this many non-zero elements the sorts run serially */
+#define SPMATRIX_PARALLEL_NNZ     (65536)
+
+/*
+chunk_count()
+  Choose the number of chunks for a counting sort
+
+Inputs: nz    - number of non-zero elements
+        n     - outer dimension of the result
+        lwork - length of work array
+
+Return: number of chunks, at least 1 and at most lwork / n
+*/
+
+static size_t
+chunk_count(const size_t nz, const size_t n, const size_t lwork)
+{
+  size_t nchunks = 1;
+
+#ifdef _OPENMP
+  if (nz >= SPMATRIX_PARALLEL_NNZ)
+    nchunks = (size_t) omp_get_max_threads();
+#else
+  (void) nz;
+#endif
+
+  if (n > 0)
+    nchunks = GSL_MIN(nchunks, lwork / n);
+
+  return GSL_MAX(nchunks, 1);
+} /* chunk_count() */
+
+/*
+chunk_offsets()
+  Convert the per-chunk histograms into scatter positions
+
+Inputs: n       - outer dimension of the result
+        nchunks - number of chunks
+        work    - (input/output) on input, work[t*n + q] is the number
+                  of elements of chunk t with outer index q; on
+                  output, their offset within outer index q
+        p       - (output) outer pointers, length n + 1
+
+Notes:
+1) Elements of chunk t are placed after those of chunks 0..t-1,
+which keeps the sort stable
+*/
+
+static void
+chunk_offsets(const size_t n, const size_t nchunks, size_t *work, size_t *p)
+{
+  size_t q;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+  for (q = 0; q < n; ++q)
+    {
+      size_t sum = 0;
+      size_t t;
+
+      for (t = 0; t < nchunks; ++t)
+        {
+          size_t c = work[t * n + q];
+          work[t * n + q] = sum;
+          sum += c;
+        }
+
+      p[q] = sum;
+    }
+
+  gsl_spmatrix_cumsum(n, p);
+} /* chunk_offsets() */
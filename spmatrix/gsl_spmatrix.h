@@ -21,10 +21,12 @@
 #define __GSL_SPMATRIX_H__
 
 #include <stdlib.h>
+#include <stdio.h>
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -64,6 +66,25 @@ typedef struct
  *   A->p[j] <= n < A->p[j+1]
  * so that column j is stored in
  * [ data[p[j]], data[p[j] + 1], ..., data[p[j+1] - 1] ]
+ *
+ * Compressed row format:
+ *
+ * If data[n] = A_{ij}, then:
+ *   j = A->i[n]
+ *   A->p[i] <= n < A->p[i+1]
+ * so that row i is stored in
+ * [ data[p[i]], data[p[i] + 1], ..., data[p[i+1] - 1] ]
+ *
+ * Sliced ELLPACK (SELL-C-sigma) format:
+ *
+ * Rows are sorted by decreasing length within windows of sigma rows,
+ * and the sorted rows are grouped into slices of C = A->slice rows.
+ * Each slice is padded to the length of its longest row and stored
+ * column by column in [ data[p[k]], ..., data[p[k+1] - 1] ], so that
+ * element l of row r of slice k is
+ *   data[p[k] + l*C + r], with column index i[p[k] + l*C + r]
+ * Stored row s = k*C + r holds row perm[s] of the matrix and has
+ * rowlen[s] non-zero elements; padding has value 0 and column index 0.
  */
 
 typedef struct
@@ -71,15 +92,17 @@ typedef struct
   size_t size1;  /* number of rows */
   size_t size2;  /* number of columns */
 
-  size_t *i;     /* row indices of size nzmax */
+  size_t *i;     /* row indices (column indices for CRS) of size nzmax */
   double *data;  /* matrix elements of size nzmax */
 
   /*
-   * p contains the column indices (triplet) or column pointers (compcol)
+   * p contains the column indices (triplet), column pointers (compcol)
+   * or row pointers (comprow)
    *
    * triplet:   p[n] = column number of element data[n]
    * comp. col: p[j] = index in data of first non-zero element in column j
    * comp. row: p[i] = index in data of first non-zero element in row i
+   * SELL:      p[k] = index in data of first element of slice k
    */
   size_t *p;
 
@@ -95,13 +118,30 @@ typedef struct
   void *work;
 
   size_t sptype; /* sparse storage type */
+
+  /* SELL-C-sigma format only */
+  size_t slice;    /* number of rows C in each slice */
+  size_t *perm;    /* perm[s] = matrix row held in stored row s, size size1 */
+  size_t *rowlen;  /* number of non-zeros in stored row s, size size1 */
+
+  /* matrices created by gsl_spmatrix_mmap only */
+  void *map;       /* start of file mapping holding p, i and data */
+  size_t map_size; /* length of mapping in bytes */
 } gsl_spmatrix;
 
 #define GSL_SPMATRIX_TRIPLET      (0)
 #define GSL_SPMATRIX_CCS          (1)
+#define GSL_SPMATRIX_CRS          (2)
+#define GSL_SPMATRIX_SELL         (3)
 
 #define GSL_SPMATRIX_ISTRIPLET(m) ((m)->sptype == GSL_SPMATRIX_TRIPLET)
 #define GSL_SPMATRIX_ISCCS(m)     ((m)->sptype == GSL_SPMATRIX_CCS)
+#define GSL_SPMATRIX_ISCRS(m)     ((m)->sptype == GSL_SPMATRIX_CRS)
+#define GSL_SPMATRIX_ISSELL(m)    ((m)->sptype == GSL_SPMATRIX_SELL)
+
+/* default and maximum slice height C for SELL-C-sigma storage */
+#define GSL_SPMATRIX_SELL_C       (8)
+#define GSL_SPMATRIX_SELL_CMAX    (64)
 
 /*
  * Prototypes
@@ -128,7 +168,15 @@ int gsl_spmatrix_set(gsl_spmatrix *m, const size_t i, const size_t j,
 
 /* spcompress.c */
 gsl_spmatrix *gsl_spmatrix_compcol(const gsl_spmatrix *T);
+gsl_spmatrix *gsl_spmatrix_comprow(const gsl_spmatrix *T);
+gsl_spmatrix *gsl_spmatrix_assemble(const size_t n1, const size_t n2,
+                                    const size_t nz, const size_t *i,
+                                    const size_t *j, const double *x,
+                                    const size_t sptype);
 void gsl_spmatrix_cumsum(const size_t n, size_t *c);
+size_t gsl_spmatrix_compress_worksize(const size_t n);
+int gsl_spmatrix_compress_work(gsl_spmatrix *dest, const gsl_spmatrix *T,
+                               size_t *work, const size_t lwork);
 
 /* spoper.c */
 int gsl_spmatrix_scale(gsl_spmatrix *m, const double x);
@@ -142,8 +190,34 @@ int gsl_spmatrix_sp2d(gsl_matrix *A, const gsl_spmatrix *S);
 /* spprop.c */
 int gsl_spmatrix_equal(const gsl_spmatrix *a, const gsl_spmatrix *b);
 
+/* spio.c */
+int gsl_spmatrix_fprintf(FILE *stream, const gsl_spmatrix *m,
+                         const char *format);
+gsl_spmatrix *gsl_spmatrix_fscanf(FILE *stream, const size_t sptype);
+int gsl_spmatrix_fwrite(FILE *stream, const gsl_spmatrix *m);
+int gsl_spmatrix_fread(FILE *stream, gsl_spmatrix *m);
+gsl_spmatrix *gsl_spmatrix_mmap(const char *filename);
+
+/* sporder.c */
+int gsl_spmatrix_order_rcm(const gsl_spmatrix *A, gsl_permutation *p);
+int gsl_spmatrix_order_amd(const gsl_spmatrix *A, gsl_permutation *p);
+int gsl_spmatrix_permute_sym(const gsl_spmatrix *A, const gsl_permutation *p,
+                             gsl_spmatrix *B);
+
+/* spsell.c */
+gsl_spmatrix *gsl_spmatrix_sell(const gsl_spmatrix *A, const size_t C,
+                                const size_t sigma);
+size_t gsl_spmatrix_sell_nslices(const gsl_spmatrix *m);
+
 /* spswap.c */
 int gsl_spmatrix_transpose_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src);
+int gsl_spmatrix_switch_major(gsl_spmatrix *dest, const gsl_spmatrix *src);
+int gsl_spmatrix_transpose_memcpy_work(gsl_spmatrix *dest,
+                                       const gsl_spmatrix *src,
+                                       size_t *work, const size_t lwork);
+int gsl_spmatrix_switch_major_work(gsl_spmatrix *dest,
+                                   const gsl_spmatrix *src,
+                                   size_t *work, const size_t lwork);
 
 __END_DECLS
 
@@ -20,10 +20,16 @@
 #include <config.h>
 #include <stdlib.h>
 #include <math.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_spmatrix.h>
 
+#include "chunk.c"
+
+static gsl_spmatrix *compress_alloc(const gsl_spmatrix *T,
+                                    const size_t sptype);
+
 /*
 gsl_spmatrix_compcol()
   Create a sparse matrix in compressed column format
@@ -36,51 +42,352 @@ Return: pointer to new matrix (should be freed when finished with it)
 gsl_spmatrix *
 gsl_spmatrix_compcol(const gsl_spmatrix *T)
 {
-  const size_t *Tj; /* column indices of triplet matrix */
-  size_t *Cp;       /* column pointers of compressed column matrix */
-  size_t *w;        /* copy of column pointers */
+  return compress_alloc(T, GSL_SPMATRIX_CCS);
+} /* gsl_spmatrix_compcol() */
+
+/*
+gsl_spmatrix_comprow()
+  Create a sparse matrix in compressed row format
+
+Inputs: T - sparse matrix in triplet format
+
+Return: pointer to new matrix (should be freed when finished with it)
+*/
+
+gsl_spmatrix *
+gsl_spmatrix_comprow(const gsl_spmatrix *T)
+{
+  return compress_alloc(T, GSL_SPMATRIX_CRS);
+} /* gsl_spmatrix_comprow() */
+
+/*
+gsl_spmatrix_compress_worksize()
+  Return the length of the work array which lets
+gsl_spmatrix_compress_work, gsl_spmatrix_transpose_memcpy_work and
+gsl_spmatrix_switch_major_work use all available threads
+
+Inputs: n - outer dimension of the result (number of columns for
+            compressed column, rows for compressed row)
+
+Return: number of size_t elements, at least n
+*/
+
+size_t
+gsl_spmatrix_compress_worksize(const size_t n)
+{
+  size_t nthreads = 1;
+
+#ifdef _OPENMP
+  nthreads = (size_t) omp_get_max_threads();
+#endif
+
+  return GSL_MAX(n, 1) * GSL_MAX(nthreads, 1);
+} /* gsl_spmatrix_compress_worksize() */
+
+/*
+gsl_spmatrix_compress_work()
+  Convert a triplet matrix to compressed column or compressed row
+format, out of place
+
+Inputs: dest  - (output) compressed matrix, of the same size as T;
+                the storage format of dest selects the conversion
+        T     - sparse matrix in triplet format
+        work  - work array
+        lwork - length of work, at least the outer dimension of dest
+
+Return: success or error
+
+Notes:
+1) This is a counting sort: the triplets are split into chunks, the
+chunks count their outer indices in parallel, the counts are turned
+into offsets, and each chunk scatters its elements. The number of
+chunks is the number of threads, limited by lwork / n; a work array
+of gsl_spmatrix_compress_worksize(n) elements allows one chunk per
+thread
+
+2) The elements of each column (row) keep the order in which they
+are stored in T, so the result does not depend on the number of
+threads
+
+3) dest is reallocated if it is too small to hold the elements of T
+*/
+
+int
+gsl_spmatrix_compress_work(gsl_spmatrix *dest, const gsl_spmatrix *T,
+                           size_t *work, const size_t lwork)
+{
+  if (!GSL_SPMATRIX_ISTRIPLET(T))
+    {
+      GSL_ERROR("input matrix must be in triplet format", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(dest) && !GSL_SPMATRIX_ISCRS(dest))
+    {
+      GSL_ERROR("output matrix must be in compressed format", GSL_EINVAL);
+    }
+  else if (dest->size1 != T->size1 || dest->size2 != T->size2)
+    {
+      GSL_ERROR("matrix sizes are different", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t nz = T->nz;
+      const size_t n = GSL_SPMATRIX_ISCCS(dest) ? T->size2 : T->size1;
+      const size_t *outer = GSL_SPMATRIX_ISCCS(dest) ? T->p : T->i;
+      const size_t *inner = GSL_SPMATRIX_ISCCS(dest) ? T->i : T->p;
+      const double *Td = T->data;
+      size_t nchunks, t;
+
+      if (lwork < n)
+        {
+          GSL_ERROR("work array is too small", GSL_EBADLEN);
+        }
+
+      if (dest->nzmax < nz)
+        {
+          int status = gsl_spmatrix_realloc(nz, dest);
+          if (status)
+            return status;
+        }
+
+      nchunks = chunk_count(nz, n, lwork);
+
+      /* count the outer indices of each chunk */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+      for (t = 0; t < nchunks; ++t)
+        {
+          size_t *w = work + t * n;
+          size_t k;
+
+          for (k = 0; k < n; ++k)
+            w[k] = 0;
+
+          for (k = nz * t / nchunks; k < nz * (t + 1) / nchunks; ++k)
+            w[outer[k]]++;
+        }
+
+      chunk_offsets(n, nchunks, work, dest->p);
+
+      /* scatter each chunk into its slots */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+      for (t = 0; t < nchunks; ++t)
+        {
+          const size_t *Mp = dest->p;
+          size_t *Mi = dest->i;
+          double *Md = dest->data;
+          size_t *w = work + t * n;
+          size_t k;
+
+          for (k = nz * t / nchunks; k < nz * (t + 1) / nchunks; ++k)
+            {
+              size_t q = outer[k];
+              size_t d = Mp[q] + w[q]++;
+
+              Mi[d] = inner[k];
+              Md[d] = Td[k];
+            }
+        }
+
+      dest->nz = nz;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_compress_work() */
+
+/*
+compress_alloc()
+  Allocate a compressed matrix and convert the triplet matrix T into
+it with gsl_spmatrix_compress_work, using all threads for large
+matrices
+*/
+
+static gsl_spmatrix *
+compress_alloc(const gsl_spmatrix *T, const size_t sptype)
+{
+  const size_t n = (sptype == GSL_SPMATRIX_CCS) ? T->size2 : T->size1;
   gsl_spmatrix *m;
-  size_t n;
+  size_t *work = NULL;
+  size_t lwork = n;
+  int status;
 
-  m = gsl_spmatrix_alloc_nzmax(T->size1, T->size2, T->nz,
-                               GSL_SPMATRIX_CCS);
+  m = gsl_spmatrix_alloc_nzmax(T->size1, T->size2, T->nz, sptype);
   if (!m)
     return NULL;
 
-  Tj = T->p;
-  Cp = m->p;
+  if (T->nz >= SPMATRIX_PARALLEL_NNZ)
+    {
+      lwork = gsl_spmatrix_compress_worksize(n);
+      if (lwork > n)
+        work = gsl_malloc(lwork * sizeof(size_t));
+    }
+
+  /* m->work holds at least n elements of size_t */
+  if (!work)
+    lwork = n;
+
+  status = gsl_spmatrix_compress_work(m, T, work ? work : (size_t *) m->work,
+                                      lwork);
+
+  gsl_free(work);
+
+  if (status)
+    {
+      gsl_spmatrix_free(m);
+      GSL_ERROR_NULL("failed to compress matrix", status);
+    }
+
+  return m;
+} /* compress_alloc() */
+
+/*
+gsl_spmatrix_assemble()
+  Create a sparse matrix in compressed column or compressed row
+format directly from arrays of triplets (i, j, x), summing the values
+of duplicate entries
 
-  /* initialize column pointers to 0 */
-  for (n = 0; n < m->size2 + 1; ++n)
-    Cp[n] = 0;
+Inputs: n1     - number of rows
+        n2     - number of columns
+        nz     - number of triplets
+        i      - row indices, length nz
+        j      - column indices, length nz
+        x      - values, length nz
+        sptype - GSL_SPMATRIX_CCS or GSL_SPMATRIX_CRS
 
-  /*
-   * compute the number of elements in each column:
-   * Cp[j] = # non-zero elements in column j
-   */
-  for (n = 0; n < T->nz; ++n)
-    Cp[Tj[n]]++;
+Return: pointer to new matrix (should be freed when finished with it)
 
-  /* compute column pointers: p[j] = p[j-1] + nnz[j-1] */
-  gsl_spmatrix_cumsum(m->size2, Cp);
+Notes:
+1) The triplets are sorted with two stable counting sort passes, first
+on the inner index (row for CCS, column for CRS) and then on the outer
+index, so that each column (or row) is stored contiguously with
+increasing inner indices. Duplicates are then adjacent and are summed
+in a single linear scan. The total cost is O(nz + n1 + n2) and no
+binary tree is built.
 
-  /* make a copy of the column pointers */
-  w = (size_t *) m->work;
-  for (n = 0; n < m->size2; ++n)
-    w[n] = Cp[n];
+2) Entries whose duplicates sum to zero are kept as explicit zeros
+*/
 
-  /* transfer data from triplet format to compressed column */
-  for (n = 0; n < T->nz; ++n)
+gsl_spmatrix *
+gsl_spmatrix_assemble(const size_t n1, const size_t n2, const size_t nz,
+                      const size_t *i, const size_t *j, const double *x,
+                      const size_t sptype)
+{
+  if (sptype != GSL_SPMATRIX_CCS && sptype != GSL_SPMATRIX_CRS)
     {
-      size_t k = w[Tj[n]]++;
-      m->i[k] = T->i[n];
-      m->data[k] = T->data[n];
+      GSL_ERROR_NULL("sptype must be compressed column or compressed row",
+                     GSL_EINVAL);
     }
+  else
+    {
+      /* outer index selects the column (CCS) or row (CRS) */
+      const size_t *outer = (sptype == GSL_SPMATRIX_CCS) ? j : i;
+      const size_t *inner = (sptype == GSL_SPMATRIX_CCS) ? i : j;
+      const size_t nouter = (sptype == GSL_SPMATRIX_CCS) ? n2 : n1;
+      const size_t ninner = (sptype == GSL_SPMATRIX_CCS) ? n1 : n2;
+      gsl_spmatrix *m;
+      size_t *perm; /* triplets ordered by inner index */
+      size_t *w;    /* bucket offsets */
+      size_t *Mi, *Mp;
+      double *Md;
+      size_t k, q, sum, nzout;
 
-  m->nz = T->nz;
+      for (k = 0; k < nz; ++k)
+        {
+          if (i[k] >= n1 || j[k] >= n2)
+            {
+              GSL_ERROR_NULL("triplet index out of range", GSL_EINVAL);
+            }
+        }
 
-  return m;
-} /* gsl_spmatrix_compcol() */
+      m = gsl_spmatrix_alloc_nzmax(n1, n2, nz, sptype);
+      if (!m)
+        return NULL;
+
+      perm = gsl_malloc(GSL_MAX(nz, 1) * sizeof(size_t));
+      if (!perm)
+        {
+          gsl_spmatrix_free(m);
+          GSL_ERROR_NULL("failed to allocate space for permutation",
+                         GSL_ENOMEM);
+        }
+
+      w = (size_t *) m->work;
+      Mi = m->i;
+      Mp = m->p;
+      Md = m->data;
+
+      /* pass 1: stable counting sort of the triplets by inner index */
+      for (q = 0; q < ninner; ++q)
+        w[q] = 0;
+
+      for (k = 0; k < nz; ++k)
+        w[inner[k]]++;
+
+      for (q = 0, sum = 0; q < ninner; ++q)
+        {
+          size_t c = w[q];
+          w[q] = sum;
+          sum += c;
+        }
+
+      for (k = 0; k < nz; ++k)
+        perm[w[inner[k]]++] = k;
+
+      /* pass 2: stable counting sort by outer index into the matrix */
+      for (q = 0; q < nouter + 1; ++q)
+        Mp[q] = 0;
+
+      for (k = 0; k < nz; ++k)
+        Mp[outer[k]]++;
+
+      gsl_spmatrix_cumsum(nouter, Mp);
+
+      for (q = 0; q < nouter; ++q)
+        w[q] = Mp[q];
+
+      for (k = 0; k < nz; ++k)
+        {
+          size_t t = perm[k];
+          size_t dest = w[outer[t]]++;
+
+          Mi[dest] = inner[t];
+          Md[dest] = x[t];
+        }
+
+      gsl_free(perm);
+
+      /* sum adjacent duplicates and compact each column (row) in place */
+      nzout = 0;
+      for (q = 0; q < nouter; ++q)
+        {
+          size_t start = nzout;
+          size_t end = Mp[q + 1];
+
+          for (k = Mp[q]; k < end; ++k)
+            {
+              if (nzout > start && Mi[nzout - 1] == Mi[k])
+                {
+                  Md[nzout - 1] += Md[k];
+                }
+              else
+                {
+                  Mi[nzout] = Mi[k];
+                  Md[nzout] = Md[k];
+                  ++nzout;
+                }
+            }
+
+          Mp[q] = start;
+        }
+
+      Mp[nouter] = nzout;
+      m->nz = nzout;
+
+      return m;
+    }
+} /* gsl_spmatrix_assemble() */
 
 /*
 gsl_spmatrix_cumsum()
@@ -43,11 +43,14 @@ gsl_spmatrix_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src)
   else
     {
       int s = GSL_SUCCESS;
+      /* SELL matrices also store their padding */
+      const size_t nstore = GSL_SPMATRIX_ISSELL(src) ?
+                            src->p[gsl_spmatrix_sell_nslices(src)] : src->nz;
       size_t n;
 
-      if (dest->nzmax < src->nz)
+      if (dest->nzmax < nstore)
         {
-          s = gsl_spmatrix_realloc(src->nz, dest);
+          s = gsl_spmatrix_realloc(nstore, dest);
           if (s)
             return s;
         }
@@ -71,19 +74,43 @@ gsl_spmatrix_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src)
                 }
             }
         }
-      else if (GSL_SPMATRIX_ISCCS(src))
+      else if (GSL_SPMATRIX_ISCCS(src) || GSL_SPMATRIX_ISCRS(src))
         {
+          /* number of column (CCS) or row (CRS) pointers */
+          const size_t np = GSL_SPMATRIX_ISCCS(src) ? N + 1 : M + 1;
+
           for (n = 0; n < src->nz; ++n)
             {
               dest->i[n] = src->i[n];
               dest->data[n] = src->data[n];
             }
 
-          for (n = 0; n < src->size2 + 1; ++n)
+          for (n = 0; n < np; ++n)
             {
               dest->p[n] = src->p[n];
             }
         }
+      else if (GSL_SPMATRIX_ISSELL(src))
+        {
+          const size_t np = gsl_spmatrix_sell_nslices(src) + 1;
+
+          for (n = 0; n < nstore; ++n)
+            {
+              dest->i[n] = src->i[n];
+              dest->data[n] = src->data[n];
+            }
+
+          for (n = 0; n < np; ++n)
+            dest->p[n] = src->p[n];
+
+          for (n = 0; n < M; ++n)
+            {
+              dest->perm[n] = src->perm[n];
+              dest->rowlen[n] = src->rowlen[n];
+            }
+
+          dest->slice = src->slice;
+        }
       else
         {
           GSL_ERROR("invalid matrix type for src", GSL_EINVAL);
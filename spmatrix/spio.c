@@ -0,0 +1,1055 @@
+/* spmatrix/spio.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+
+#if HAVE_SYS_MMAN_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*
+ * Matrix Market and binary input/output of sparse matrices
+ *
+ * The text format is the coordinate format of the Matrix Market
+ * exchange format, with 1-based indices:
+ *
+ * %%MatrixMarket matrix coordinate real general
+ * M N NZ
+ * i j x
+ * ...
+ *
+ * The binary format holds a compressed column or compressed row matrix
+ * in the native byte order and word size of the machine which wrote it:
+ *
+ * bytes 0-5: "GSLSPM"
+ * byte  6:   format version
+ * byte  7:   sizeof(size_t)
+ * then size_t fields: byte order marker, sptype, size1, size2, nz
+ *
+ * followed by the arrays p (outer dimension + 1 elements), i (nz
+ * elements) and data (nz elements), each starting at a multiple of
+ * SPIO_ALIGN bytes from the start of the file, so that a mapping of the
+ * file can be used directly as the arrays of a gsl_spmatrix.
+ */
+
+#define SPIO_VERSION        (1)
+#define SPIO_ALIGN          (64)
+#define SPIO_BYTE_ORDER     ((size_t) 0x0102)
+#define SPIO_NHEADER        (5)
+
+/* entries region size above which Matrix Market input is parsed in parallel */
+#define SPIO_PARALLEL_BYTES (1048576)
+
+typedef struct
+{
+  size_t sptype;
+  size_t size1;
+  size_t size2;
+  size_t nz;
+  size_t off_p;   /* file offsets of the arrays */
+  size_t off_i;
+  size_t off_data;
+  size_t length;  /* total file length */
+} spio_layout;
+
+static int spio_read_stream(FILE *stream, char **buf, size_t *len);
+static const char *spio_next_line(const char *s, const char *end);
+static const char *spio_skip_blank(const char *s, const char *end);
+static const char *spio_parse_size(const char *s, const char *end,
+                                   size_t *x);
+static int spio_parse_chunk(const char *s, const char *end, const int field,
+                            const size_t M, const size_t N, size_t *I,
+                            size_t *J, double *X);
+static size_t spio_count_chunk(const char *s, const char *end);
+static int spio_token(const char **s, const char *end, char *tok,
+                      const size_t len);
+static void spio_layout_init(spio_layout *l, const size_t sptype,
+                             const size_t size1, const size_t size2,
+                             const size_t nz);
+static int spio_header_read(const unsigned char *hdr, spio_layout *l);
+static int spio_check_arrays(const spio_layout *l, const size_t *p,
+                             const size_t *i);
+
+/* field types of Matrix Market files */
+#define SPIO_REAL     (0)
+#define SPIO_PATTERN  (1)
+
+/*
+gsl_spmatrix_fprintf()
+  Write a sparse matrix to a stream in Matrix Market coordinate format
+
+Inputs: stream - output stream
+        m      - sparse matrix in any storage format
+        format - printf format for the matrix elements, e.g. "%.18g"
+
+Return: success/error
+*/
+
+int
+gsl_spmatrix_fprintf(FILE *stream, const gsl_spmatrix *m,
+                     const char *format)
+{
+  size_t n, k;
+  int status;
+
+  status = fprintf(stream, "%%%%MatrixMarket matrix coordinate real general\n");
+  if (status < 0)
+    {
+      GSL_ERROR("fprintf failed", GSL_EFAILED);
+    }
+
+  status = fprintf(stream, "%zu %zu %zu\n", m->size1, m->size2,
+                   gsl_spmatrix_nnz(m));
+  if (status < 0)
+    {
+      GSL_ERROR("fprintf failed", GSL_EFAILED);
+    }
+
+  if (GSL_SPMATRIX_ISTRIPLET(m))
+    {
+      for (n = 0; n < m->nz; ++n)
+        {
+          status = fprintf(stream, "%zu %zu ", m->i[n] + 1, m->p[n] + 1);
+          if (status >= 0)
+            status = fprintf(stream, format, m->data[n]);
+          if (status >= 0)
+            status = putc('\n', stream);
+
+          if (status < 0)
+            {
+              GSL_ERROR("fprintf failed", GSL_EFAILED);
+            }
+        }
+    }
+  else if (GSL_SPMATRIX_ISCCS(m) || GSL_SPMATRIX_ISCRS(m))
+    {
+      const int ccs = GSL_SPMATRIX_ISCCS(m);
+      const size_t nouter = ccs ? m->size2 : m->size1;
+
+      for (k = 0; k < nouter; ++k)
+        {
+          for (n = m->p[k]; n < m->p[k + 1]; ++n)
+            {
+              const size_t i = ccs ? m->i[n] : k;
+              const size_t j = ccs ? k : m->i[n];
+
+              status = fprintf(stream, "%zu %zu ", i + 1, j + 1);
+              if (status >= 0)
+                status = fprintf(stream, format, m->data[n]);
+              if (status >= 0)
+                status = putc('\n', stream);
+
+              if (status < 0)
+                {
+                  GSL_ERROR("fprintf failed", GSL_EFAILED);
+                }
+            }
+        }
+    }
+  else if (GSL_SPMATRIX_ISSELL(m))
+    {
+      const size_t C = m->slice;
+      size_t s, l;
+
+      for (s = 0; s < m->size1; ++s)
+        {
+          const size_t base = m->p[s / C] + s % C;
+
+          for (l = 0; l < m->rowlen[s]; ++l)
+            {
+              const size_t q = base + l * C;
+
+              status = fprintf(stream, "%zu %zu ", m->perm[s] + 1, m->i[q] + 1);
+              if (status >= 0)
+                status = fprintf(stream, format, m->data[q]);
+              if (status >= 0)
+                status = putc('\n', stream);
+
+              if (status < 0)
+                {
+                  GSL_ERROR("fprintf failed", GSL_EFAILED);
+                }
+            }
+        }
+    }
+  else
+    {
+      GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_spmatrix_fprintf() */
+
+/*
+gsl_spmatrix_fscanf()
+  Read a sparse matrix in Matrix Market coordinate format
+
+Inputs: stream - input stream
+        sptype - storage format of the result: GSL_SPMATRIX_TRIPLET,
+                 GSL_SPMATRIX_CCS or GSL_SPMATRIX_CRS
+
+Return: pointer to new matrix (should be freed when finished with it)
+
+Notes:
+1) Real, integer and pattern fields are accepted, with general,
+symmetric or skew-symmetric structure; the missing triangle of
+symmetric matrices is filled in. Pattern entries are set to 1
+
+2) The stream is read into memory in one piece. The entries are then
+parsed by several threads when OpenMP is available: the text is split
+into chunks at line boundaries, the entry lines of each chunk are
+counted, and each chunk is parsed directly into its part of the
+triplet arrays
+
+3) Compressed matrices are assembled from the triplet arrays with
+gsl_spmatrix_assemble(), which sums duplicate entries, without building
+the binary tree of the triplet format
+*/
+
+gsl_spmatrix *
+gsl_spmatrix_fscanf(FILE *stream, const size_t sptype)
+{
+  if (sptype != GSL_SPMATRIX_TRIPLET && sptype != GSL_SPMATRIX_CCS &&
+      sptype != GSL_SPMATRIX_CRS)
+    {
+      GSL_ERROR_NULL("sptype must be triplet, compressed column or compressed row",
+                     GSL_EINVAL);
+    }
+  else
+    {
+      char *buf;
+      const char *s, *end;
+      char tok[32];
+      size_t len, M, N, nz, nzall, nchunks, k, t;
+      size_t *I, *J, *start, *count;
+      double *X;
+      int field, symm = 0; /* 0 = general, 1 = symmetric, -1 = skew */
+      int status;
+      gsl_spmatrix *m = NULL;
+
+      status = spio_read_stream(stream, &buf, &len);
+      if (status)
+        {
+          GSL_ERROR_NULL("failed to read stream", status);
+        }
+
+      s = buf;
+      end = buf + len;
+
+      /* banner: %%MatrixMarket matrix coordinate <field> <symmetry> */
+      if (len < 14 || strncmp(s, "%%MatrixMarket", 14) != 0)
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("missing Matrix Market banner", GSL_EINVAL);
+        }
+
+      s += 14;
+
+      status = spio_token(&s, end, tok, sizeof(tok));
+      status |= strcmp(tok, "matrix") != 0;
+      status |= spio_token(&s, end, tok, sizeof(tok));
+      status |= strcmp(tok, "coordinate") != 0;
+      if (status)
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("only coordinate matrices are supported", GSL_EINVAL);
+        }
+
+      spio_token(&s, end, tok, sizeof(tok));
+      if (strcmp(tok, "real") == 0 || strcmp(tok, "double") == 0 ||
+          strcmp(tok, "integer") == 0)
+        field = SPIO_REAL;
+      else if (strcmp(tok, "pattern") == 0)
+        field = SPIO_PATTERN;
+      else
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("unsupported Matrix Market field type", GSL_EINVAL);
+        }
+
+      spio_token(&s, end, tok, sizeof(tok));
+      if (strcmp(tok, "general") == 0)
+        symm = 0;
+      else if (strcmp(tok, "symmetric") == 0)
+        symm = 1;
+      else if (strcmp(tok, "skew-symmetric") == 0)
+        symm = -1;
+      else
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("unsupported Matrix Market symmetry type", GSL_EINVAL);
+        }
+
+      /* skip comments and blank lines up to the size line */
+      s = spio_next_line(s, end);
+      while (s < end)
+        {
+          const char *q = spio_skip_blank(s, end);
+
+          if (q < end && *q != '%' && *q != '\n' && *q != '\r')
+            break;
+
+          s = spio_next_line(s, end);
+        }
+
+      s = spio_parse_size(s, end, &M);
+      if (s)
+        s = spio_parse_size(s, end, &N);
+      if (s)
+        s = spio_parse_size(s, end, &nz);
+
+      if (!s)
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("invalid size line", GSL_EINVAL);
+        }
+
+      s = spio_next_line(s, end);
+
+      /* each entry takes more than one byte of input, and the arrays below
+         must not overflow a size_t */
+      if (nz > (size_t) (end - s) ||
+          nz > (SIZE_MAX / GSL_MAX(sizeof(size_t), sizeof(double)) - 1) / 2)
+        {
+          gsl_free(buf);
+          GSL_ERROR_NULL("invalid number of entries in size line", GSL_EINVAL);
+        }
+
+      /* room for the mirrored triangle of symmetric matrices */
+      nzall = symm ? 2 * nz : nz;
+      I = gsl_malloc((nzall + 1) * sizeof(size_t));
+      J = gsl_malloc((nzall + 1) * sizeof(size_t));
+      X = gsl_malloc((nzall + 1) * sizeof(double));
+
+      /* chunks of the entries region, split at line boundaries */
+      nchunks = 1;
+#ifdef _OPENMP
+      if ((size_t) (end - s) > SPIO_PARALLEL_BYTES)
+        nchunks = (size_t) omp_get_max_threads();
+#endif
+
+      start = gsl_malloc(2 * (nchunks + 1) * sizeof(size_t));
+      if (!I || !J || !X || !start)
+        {
+          gsl_free(I);
+          gsl_free(J);
+          gsl_free(X);
+          gsl_free(start);
+          gsl_free(buf);
+          GSL_ERROR_NULL("failed to allocate triplet arrays", GSL_ENOMEM);
+        }
+
+      count = start + nchunks + 1;
+
+      for (t = 0; t <= nchunks; ++t)
+        {
+          const char *q = s + (size_t) (end - s) * t / nchunks;
+
+          if (t > 0 && t < nchunks && q > s && q[-1] != '\n')
+            q = spio_next_line(q, end);
+
+          start[t] = (size_t) (q - buf);
+        }
+
+      /* pass 1: count entry lines of each chunk */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+      for (t = 0; t < nchunks; ++t)
+        count[t] = spio_count_chunk(buf + start[t], buf + start[t + 1]);
+
+      for (t = 0, k = 0; t < nchunks; ++t)
+        {
+          size_t c = count[t];
+          count[t] = k;
+          k += c;
+        }
+
+      status = GSL_SUCCESS;
+
+      if (k != nz)
+        {
+          status = GSL_EINVAL;
+        }
+      else
+        {
+          /* pass 2: parse each chunk into its part of the arrays */
+          int fail = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(|:fail) if (nchunks > 1)
+#endif
+          for (t = 0; t < nchunks; ++t)
+            {
+              const size_t o = count[t];
+
+              fail |= spio_parse_chunk(buf + start[t], buf + start[t + 1],
+                                       field, M, N, I + o, J + o, X + o);
+            }
+
+          if (fail)
+            status = GSL_EINVAL;
+        }
+
+      gsl_free(start);
+      gsl_free(buf);
+
+      if (status == GSL_SUCCESS)
+        {
+          /* fill in the other triangle */
+          if (symm)
+            {
+              size_t n = nz;
+
+              for (k = 0; k < nz; ++k)
+                {
+                  if (I[k] != J[k])
+                    {
+                      I[n] = J[k];
+                      J[n] = I[k];
+                      X[n] = symm * X[k];
+                      ++n;
+                    }
+                }
+
+              nzall = n;
+            }
+
+          if (sptype == GSL_SPMATRIX_TRIPLET)
+            {
+              m = gsl_spmatrix_alloc_nzmax(M, N, nzall, GSL_SPMATRIX_TRIPLET);
+
+              for (k = 0; m != NULL && k < nzall; ++k)
+                {
+                  if (gsl_spmatrix_set(m, I[k], J[k], X[k]))
+                    {
+                      gsl_spmatrix_free(m);
+                      m = NULL;
+                    }
+                }
+            }
+          else
+            {
+              m = gsl_spmatrix_assemble(M, N, nzall, I, J, X, sptype);
+            }
+        }
+
+      gsl_free(I);
+      gsl_free(J);
+      gsl_free(X);
+
+      if (status)
+        {
+          GSL_ERROR_NULL("invalid Matrix Market entries", status);
+        }
+
+      return m;
+    }
+} /* gsl_spmatrix_fscanf() */
+
+/*
+gsl_spmatrix_fwrite()
+  Write a compressed matrix to a stream in binary format
+
+Inputs: stream - output stream
+        m      - sparse matrix in compressed column or row format
+
+Return: success/error
+
+Notes:
+1) The data is written in the native binary format of the machine,
+and can be read back with gsl_spmatrix_fread() or gsl_spmatrix_mmap()
+*/
+
+int
+gsl_spmatrix_fwrite(FILE *stream, const gsl_spmatrix *m)
+{
+  if (!GSL_SPMATRIX_ISCCS(m) && !GSL_SPMATRIX_ISCRS(m))
+    {
+      GSL_ERROR("matrix must be in compressed column or row format",
+                GSL_EINVAL);
+    }
+  else
+    {
+      static const unsigned char zero[SPIO_ALIGN] = { 0 };
+      const size_t np = (GSL_SPMATRIX_ISCCS(m) ? m->size2 : m->size1) + 1;
+      unsigned char hdr[8];
+      size_t fields[SPIO_NHEADER];
+      spio_layout l;
+      size_t pos;
+
+      spio_layout_init(&l, m->sptype, m->size1, m->size2, m->nz);
+
+      memcpy(hdr, "GSLSPM", 6);
+      hdr[6] = SPIO_VERSION;
+      hdr[7] = (unsigned char) sizeof(size_t);
+
+      fields[0] = SPIO_BYTE_ORDER;
+      fields[1] = m->sptype;
+      fields[2] = m->size1;
+      fields[3] = m->size2;
+      fields[4] = m->nz;
+
+      if (fwrite(hdr, 1, sizeof(hdr), stream) != sizeof(hdr) ||
+          fwrite(fields, sizeof(size_t), SPIO_NHEADER, stream) != SPIO_NHEADER)
+        {
+          GSL_ERROR("fwrite failed", GSL_EFAILED);
+        }
+
+      pos = sizeof(hdr) + SPIO_NHEADER * sizeof(size_t);
+
+      if (fwrite(zero, 1, l.off_p - pos, stream) != l.off_p - pos ||
+          fwrite(m->p, sizeof(size_t), np, stream) != np)
+        {
+          GSL_ERROR("fwrite failed", GSL_EFAILED);
+        }
+
+      pos = l.off_p + np * sizeof(size_t);
+
+      if (fwrite(zero, 1, l.off_i - pos, stream) != l.off_i - pos ||
+          fwrite(m->i, sizeof(size_t), m->nz, stream) != m->nz)
+        {
+          GSL_ERROR("fwrite failed", GSL_EFAILED);
+        }
+
+      pos = l.off_i + m->nz * sizeof(size_t);
+
+      if (fwrite(zero, 1, l.off_data - pos, stream) != l.off_data - pos ||
+          fwrite(m->data, sizeof(double), m->nz, stream) != m->nz)
+        {
+          GSL_ERROR("fwrite failed", GSL_EFAILED);
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_fwrite() */
+
+/*
+gsl_spmatrix_fread()
+  Read a compressed matrix in binary format from a stream
+
+Inputs: stream - input stream
+        m      - (output) matrix of the same dimensions and storage
+                 format as the stored matrix; it is enlarged if needed
+
+Return: success/error
+*/
+
+int
+gsl_spmatrix_fread(FILE *stream, gsl_spmatrix *m)
+{
+  unsigned char hdr[8 + SPIO_NHEADER * sizeof(size_t)];
+  unsigned char pad[SPIO_ALIGN];
+  spio_layout l;
+  size_t np, pos;
+  int status;
+
+  if (fread(hdr, 1, sizeof(hdr), stream) != sizeof(hdr))
+    {
+      GSL_ERROR("fread failed", GSL_EFAILED);
+    }
+
+  status = spio_header_read(hdr, &l);
+  if (status)
+    return status;
+
+  if (l.sptype != m->sptype)
+    {
+      GSL_ERROR("matrix storage format does not match file", GSL_EINVAL);
+    }
+  else if (l.size1 != m->size1 || l.size2 != m->size2)
+    {
+      GSL_ERROR("matrix dimensions do not match file", GSL_EBADLEN);
+    }
+
+  if (m->nzmax < l.nz)
+    {
+      status = gsl_spmatrix_realloc(l.nz, m);
+      if (status)
+        return status;
+    }
+
+  np = (GSL_SPMATRIX_ISCCS(m) ? m->size2 : m->size1) + 1;
+  pos = sizeof(hdr);
+
+  if (fread(pad, 1, l.off_p - pos, stream) != l.off_p - pos ||
+      fread(m->p, sizeof(size_t), np, stream) != np)
+    {
+      GSL_ERROR("fread failed", GSL_EFAILED);
+    }
+
+  pos = l.off_p + np * sizeof(size_t);
+
+  if (fread(pad, 1, l.off_i - pos, stream) != l.off_i - pos ||
+      fread(m->i, sizeof(size_t), l.nz, stream) != l.nz)
+    {
+      GSL_ERROR("fread failed", GSL_EFAILED);
+    }
+
+  status = spio_check_arrays(&l, m->p, m->i);
+  if (status)
+    return status;
+
+  pos = l.off_i + l.nz * sizeof(size_t);
+
+  if (fread(pad, 1, l.off_data - pos, stream) != l.off_data - pos ||
+      fread(m->data, sizeof(double), l.nz, stream) != l.nz)
+    {
+      GSL_ERROR("fread failed", GSL_EFAILED);
+    }
+
+  m->nz = l.nz;
+
+  return GSL_SUCCESS;
+} /* gsl_spmatrix_fread() */
+
+/*
+gsl_spmatrix_mmap()
+  Create a compressed matrix from a file in binary format by mapping
+the file into memory
+
+Inputs: filename - file written with gsl_spmatrix_fwrite()
+
+Return: pointer to new matrix (should be freed when finished with it)
+
+Notes:
+1) The index and data arrays of the matrix point into a private,
+copy-on-write mapping of the file, so loading costs only the
+validation of the index arrays and the data pages are read on demand.
+Modifications of the matrix are not written back to the file.
+gsl_spmatrix_free() unmaps the file, and gsl_spmatrix_realloc() first
+copies the arrays to ordinary memory
+
+2) Without mmap() support the file is read with gsl_spmatrix_fread()
+*/
+
+gsl_spmatrix *
+gsl_spmatrix_mmap(const char *filename)
+{
+#if HAVE_SYS_MMAN_H
+  int fd;
+  struct stat st;
+  unsigned char *base;
+  spio_layout l;
+  gsl_spmatrix *m;
+  int status;
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    {
+      GSL_ERROR_NULL("unable to open file", GSL_EFAILED);
+    }
+
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < 8 + SPIO_NHEADER * sizeof(size_t))
+    {
+      close(fd);
+      GSL_ERROR_NULL("file is too short", GSL_EINVAL);
+    }
+
+  base = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+              fd, 0);
+  close(fd);
+
+  if (base == MAP_FAILED)
+    {
+      GSL_ERROR_NULL("failed to map file", GSL_EFAILED);
+    }
+
+  status = spio_header_read(base, &l);
+  if (status == GSL_SUCCESS && l.length > (size_t) st.st_size)
+    status = GSL_EINVAL;
+  if (status == GSL_SUCCESS)
+    status = spio_check_arrays(&l, (size_t *) (base + l.off_p),
+                               (size_t *) (base + l.off_i));
+
+  if (status)
+    {
+      munmap(base, (size_t) st.st_size);
+      GSL_ERROR_NULL("invalid sparse matrix file", status);
+    }
+
+  m = gsl_calloc(1, sizeof(gsl_spmatrix));
+  if (!m)
+    {
+      munmap(base, (size_t) st.st_size);
+      GSL_ERROR_NULL("failed to allocate space for spmatrix struct",
+                     GSL_ENOMEM);
+    }
+
+  m->work = gsl_malloc(GSL_MAX(l.size1, l.size2) *
+                       GSL_MAX(sizeof(size_t), sizeof(double)));
+  if (!m->work)
+    {
+      gsl_free(m);
+      munmap(base, (size_t) st.st_size);
+      GSL_ERROR_NULL("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  m->size1 = l.size1;
+  m->size2 = l.size2;
+  m->nz = l.nz;
+  m->nzmax = l.nz;
+  m->sptype = l.sptype;
+  m->p = (size_t *) (base + l.off_p);
+  m->i = (size_t *) (base + l.off_i);
+  m->data = (double *) (base + l.off_data);
+  m->map = base;
+  m->map_size = (size_t) st.st_size;
+
+  return m;
+#else
+  FILE *f = fopen(filename, "rb");
+  unsigned char hdr[8 + SPIO_NHEADER * sizeof(size_t)];
+  spio_layout l;
+  gsl_spmatrix *m;
+  int status;
+
+  if (!f)
+    {
+      GSL_ERROR_NULL("unable to open file", GSL_EFAILED);
+    }
+
+  if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) ||
+      spio_header_read(hdr, &l) != GSL_SUCCESS)
+    {
+      fclose(f);
+      GSL_ERROR_NULL("invalid sparse matrix file", GSL_EINVAL);
+    }
+
+  m = gsl_spmatrix_alloc_nzmax(l.size1, l.size2, l.nz, l.sptype);
+  if (!m)
+    {
+      fclose(f);
+      return NULL;
+    }
+
+  rewind(f);
+  status = gsl_spmatrix_fread(f, m);
+  fclose(f);
+
+  if (status)
+    {
+      gsl_spmatrix_free(m);
+      return NULL;
+    }
+
+  return m;
+#endif
+} /* gsl_spmatrix_mmap() */
+
+/* read the whole stream into a null-terminated buffer */
+static int
+spio_read_stream(FILE *stream, char **buf, size_t *len)
+{
+  size_t cap = 65536, n = 0;
+  char *b = gsl_malloc(cap + 1);
+
+  if (!b)
+    return GSL_ENOMEM;
+
+  while (1)
+    {
+      size_t r = fread(b + n, 1, cap - n, stream);
+
+      n += r;
+
+      if (n < cap)
+        {
+          if (ferror(stream))
+            {
+              gsl_free(b);
+              return GSL_EFAILED;
+            }
+
+          break;
+        }
+      else
+        {
+          char *ptr = gsl_realloc(b, 2 * cap + 1);
+
+          if (!ptr)
+            {
+              gsl_free(b);
+              return GSL_ENOMEM;
+            }
+
+          b = ptr;
+          cap *= 2;
+        }
+    }
+
+  b[n] = '\0';
+  *buf = b;
+  *len = n;
+
+  return GSL_SUCCESS;
+}
+
+/* return the start of the line following s */
+static const char *
+spio_next_line(const char *s, const char *end)
+{
+  const char *q = memchr(s, '\n', (size_t) (end - s));
+  return q ? q + 1 : end;
+}
+
+static const char *
+spio_skip_blank(const char *s, const char *end)
+{
+  while (s < end && (*s == ' ' || *s == '\t'))
+    ++s;
+
+  return s;
+}
+
+/* parse an unsigned integer after optional blanks; NULL on error */
+static const char *
+spio_parse_size(const char *s, const char *end, size_t *x)
+{
+  size_t v = 0;
+
+  s = spio_skip_blank(s, end);
+
+  if (s == end || !isdigit((unsigned char) *s))
+    return NULL;
+
+  while (s < end && isdigit((unsigned char) *s))
+    v = 10 * v + (size_t) (*s++ - '0');
+
+  *x = v;
+
+  return s;
+}
+
+/* number of entry lines, i.e. lines which are not blank or comments */
+static size_t
+spio_count_chunk(const char *s, const char *end)
+{
+  size_t n = 0;
+
+  while (s < end)
+    {
+      const char *q = spio_skip_blank(s, end);
+
+      if (q < end && *q != '\n' && *q != '\r' && *q != '%')
+        ++n;
+
+      s = spio_next_line(q, end);
+    }
+
+  return n;
+}
+
+/* parse the entry lines of a chunk into 0-based triplets */
+static int
+spio_parse_chunk(const char *s, const char *end, const int field,
+                 const size_t M, const size_t N, size_t *I, size_t *J,
+                 double *X)
+{
+  size_t n = 0;
+
+  while (s < end)
+    {
+      const char *q = spio_skip_blank(s, end);
+      size_t i, j;
+
+      if (q == end || *q == '\n' || *q == '\r' || *q == '%')
+        {
+          s = spio_next_line(q, end);
+          continue;
+        }
+
+      q = spio_parse_size(q, end, &i);
+      if (q)
+        q = spio_parse_size(q, end, &j);
+
+      if (!q || i == 0 || j == 0 || i > M || j > N)
+        return 1;
+
+      I[n] = i - 1;
+      J[n] = j - 1;
+
+      if (field == SPIO_PATTERN)
+        {
+          X[n] = 1.0;
+        }
+      else
+        {
+          char *r;
+
+          /* the buffer is null-terminated, so strtod stops in time */
+          X[n] = strtod(q, &r);
+          if (r == q)
+            return 1;
+
+          q = r;
+        }
+
+      ++n;
+      s = spio_next_line(q, end);
+    }
+
+  return 0;
+}
+
+/* read a lower case word of the banner line */
+static int
+spio_token(const char **s, const char *end, char *tok, const size_t len)
+{
+  const char *q = spio_skip_blank(*s, end);
+  size_t n = 0;
+
+  while (q < end && !isspace((unsigned char) *q))
+    {
+      if (n + 1 < len)
+        tok[n++] = (char) tolower((unsigned char) *q);
+      ++q;
+    }
+
+  tok[n] = '\0';
+  *s = q;
+
+  return (n == 0);
+}
+
+static size_t
+spio_align(const size_t x)
+{
+  return (x + SPIO_ALIGN - 1) / SPIO_ALIGN * SPIO_ALIGN;
+}
+
+static void
+spio_layout_init(spio_layout *l, const size_t sptype, const size_t size1,
+                 const size_t size2, const size_t nz)
+{
+  const size_t np = (sptype == GSL_SPMATRIX_CCS ? size2 : size1) + 1;
+
+  l->sptype = sptype;
+  l->size1 = size1;
+  l->size2 = size2;
+  l->nz = nz;
+  l->off_p = spio_align(8 + SPIO_NHEADER * sizeof(size_t));
+  l->off_i = spio_align(l->off_p + np * sizeof(size_t));
+  l->off_data = spio_align(l->off_i + nz * sizeof(size_t));
+  l->length = l->off_data + nz * sizeof(double);
+}
+
+static int
+spio_header_read(const unsigned char *hdr, spio_layout *l)
+{
+  size_t fields[SPIO_NHEADER];
+
+  if (memcmp(hdr, "GSLSPM", 6) != 0)
+    {
+      GSL_ERROR("not a sparse matrix file", GSL_EINVAL);
+    }
+  else if (hdr[6] != SPIO_VERSION)
+    {
+      GSL_ERROR("unsupported sparse matrix file version", GSL_EINVAL);
+    }
+  else if (hdr[7] != sizeof(size_t))
+    {
+      GSL_ERROR("file was written with a different size_t width", GSL_EINVAL);
+    }
+
+  memcpy(fields, hdr + 8, sizeof(fields));
+
+  if (fields[0] != SPIO_BYTE_ORDER)
+    {
+      GSL_ERROR("file was written with a different byte order", GSL_EINVAL);
+    }
+  else if (fields[1] != GSL_SPMATRIX_CCS && fields[1] != GSL_SPMATRIX_CRS)
+    {
+      GSL_ERROR("unsupported storage format in file", GSL_EINVAL);
+    }
+  else if (fields[2] == 0 || fields[3] == 0)
+    {
+      GSL_ERROR("invalid matrix dimensions in file", GSL_EINVAL);
+    }
+  else
+    {
+      /* the arrays, with their padding, must fit in a size_t, so that
+         the offsets computed by spio_layout_init cannot overflow */
+      const size_t off_p = spio_align(8 + SPIO_NHEADER * sizeof(size_t));
+      const size_t maxelem = (SIZE_MAX - off_p - 2 * SPIO_ALIGN) /
+                             GSL_MAX(sizeof(size_t), sizeof(double));
+      const size_t nouter = (fields[1] == GSL_SPMATRIX_CCS) ? fields[3] : fields[2];
+
+      if (fields[2] >= maxelem || fields[3] >= maxelem ||
+          fields[4] > (maxelem - nouter - 1) / 2)
+        {
+          GSL_ERROR("invalid matrix dimensions in file", GSL_EINVAL);
+        }
+    }
+
+  spio_layout_init(l, fields[1], fields[2], fields[3], fields[4]);
+
+  return GSL_SUCCESS;
+}
+
+/* check that the outer pointers are nondecreasing from 0 to nz and
+   that the inner indices are within the matrix */
+static int
+spio_check_arrays(const spio_layout *l, const size_t *p, const size_t *i)
+{
+  const int ccs = (l->sptype == GSL_SPMATRIX_CCS);
+  const size_t n = ccs ? l->size2 : l->size1;
+  const size_t ninner = ccs ? l->size1 : l->size2;
+  size_t k;
+
+  if (p[0] != 0 || p[n] != l->nz)
+    {
+      GSL_ERROR("invalid pointers in sparse matrix file", GSL_EINVAL);
+    }
+
+  for (k = 0; k < n; ++k)
+    {
+      if (p[k + 1] < p[k])
+        {
+          GSL_ERROR("invalid pointers in sparse matrix file", GSL_EINVAL);
+        }
+    }
+
+  for (k = 0; k < l->nz; ++k)
+    {
+      if (i[k] >= ninner)
+        {
+          GSL_ERROR("invalid indices in sparse matrix file", GSL_EINVAL);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
@@ -20,16 +20,22 @@
 #include <config.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_spmatrix.h>
 
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
 #include "avl.c"
 
 static int compare_triplet(const void *pa, const void *pb, void *param);
 static void *avl_spmalloc (size_t size, void *param);
 static void avl_spfree (void *block, void *param);
+static int spmatrix_unmap(gsl_spmatrix *m);
 
 static struct libavl_allocator avl_allocator_spmatrix =
 {
@@ -67,7 +73,8 @@ gsl_spmatrix_alloc_nzmax()
 Inputs: n1     - number of rows
         n2     - number of columns
         nzmax  - maximum number of matrix elements
-        sptype - type of matrix (triplet, compressed column)
+        sptype - type of matrix (triplet, compressed column,
+                 compressed row, SELL-C-sigma)
 
 Notes: if (n1,n2) are not known at allocation time, they can each be
 set to 1, and they will be expanded as elements are added to the matrix
@@ -90,7 +97,7 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
                      GSL_EINVAL, 0);
     }
 
-  m = calloc(1, sizeof(gsl_spmatrix));
+  m = gsl_calloc(1, sizeof(gsl_spmatrix));
   if (!m)
     {
       GSL_ERROR_VAL("failed to allocate space for spmatrix struct",
@@ -103,7 +110,7 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
   m->nzmax = GSL_MAX(nzmax, 1);
   m->sptype = sptype;
 
-  m->i = malloc(m->nzmax * sizeof(size_t));
+  m->i = gsl_malloc(m->nzmax * sizeof(size_t));
   if (!m->i)
     {
       gsl_spmatrix_free(m);
@@ -113,7 +120,7 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
 
   if (sptype == GSL_SPMATRIX_TRIPLET)
     {
-      m->tree_data = malloc(sizeof(gsl_spmatrix_tree));
+      m->tree_data = gsl_malloc(sizeof(gsl_spmatrix_tree));
       if (!m->tree_data)
         {
           gsl_spmatrix_free(m);
@@ -134,7 +141,7 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
         }
 
       /* preallocate nzmax tree nodes */
-      m->tree_data->node_array = malloc(m->nzmax * sizeof(struct avl_node));
+      m->tree_data->node_array = gsl_malloc(m->nzmax * sizeof(struct avl_node));
       if (!m->tree_data->node_array)
         {
           gsl_spmatrix_free(m);
@@ -142,7 +149,7 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
                         GSL_ENOMEM, 0);
         }
 
-      m->p = malloc(m->nzmax * sizeof(size_t));
+      m->p = gsl_malloc(m->nzmax * sizeof(size_t));
       if (!m->p)
         {
           gsl_spmatrix_free(m);
@@ -152,8 +159,8 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
     }
   else if (sptype == GSL_SPMATRIX_CCS)
     {
-      m->p = malloc((n2 + 1) * sizeof(size_t));
-      m->work = malloc(GSL_MAX(n1, n2) *
+      m->p = gsl_malloc((n2 + 1) * sizeof(size_t));
+      m->work = gsl_malloc(GSL_MAX(n1, n2) *
                        GSL_MAX(sizeof(size_t), sizeof(double)));
       if (!m->p || !m->work)
         {
@@ -162,8 +169,46 @@ gsl_spmatrix_alloc_nzmax(const size_t n1, const size_t n2,
                         GSL_ENOMEM, 0);
         }
     }
+  else if (sptype == GSL_SPMATRIX_CRS)
+    {
+      m->p = gsl_malloc((n1 + 1) * sizeof(size_t));
+      m->work = gsl_malloc(GSL_MAX(n1, n2) *
+                       GSL_MAX(sizeof(size_t), sizeof(double)));
+      if (!m->p || !m->work)
+        {
+          gsl_spmatrix_free(m);
+          GSL_ERROR_VAL("failed to allocate space for row pointers",
+                        GSL_ENOMEM, 0);
+        }
+    }
+  else if (sptype == GSL_SPMATRIX_SELL)
+    {
+      size_t s;
+
+      /* there are at most n1 slices, whatever the slice height */
+      m->slice = GSL_SPMATRIX_SELL_C;
+      m->p = gsl_malloc((n1 + 1) * sizeof(size_t));
+      m->perm = gsl_malloc(n1 * sizeof(size_t));
+      m->rowlen = gsl_malloc(n1 * sizeof(size_t));
+      if (!m->p || !m->perm || !m->rowlen)
+        {
+          gsl_spmatrix_free(m);
+          GSL_ERROR_VAL("failed to allocate space for slice pointers",
+                        GSL_ENOMEM, 0);
+        }
+
+      /* start as an empty matrix with the identity row order */
+      for (s = 0; s < n1; ++s)
+        {
+          m->perm[s] = s;
+          m->rowlen[s] = 0;
+        }
 
-  m->data = malloc(m->nzmax * sizeof(double));
+      for (s = 0; s < n1 + 1; ++s)
+        m->p[s] = 0;
+    }
+
+  m->data = gsl_malloc(m->nzmax * sizeof(double));
   if (!m->data)
     {
       gsl_spmatrix_free(m);
@@ -182,17 +227,33 @@ gsl_spmatrix_free()
 void
 gsl_spmatrix_free(gsl_spmatrix *m)
 {
-  if (m->i)
-    free(m->i);
+  if (m->map)
+    {
+      /* p, i and data point into the file mapping */
+#if HAVE_SYS_MMAN_H
+      munmap(m->map, m->map_size);
+#endif
+    }
+  else
+    {
+      if (m->i)
+        gsl_free(m->i);
 
-  if (m->p)
-    free(m->p);
+      if (m->p)
+        gsl_free(m->p);
 
-  if (m->data)
-    free(m->data);
+      if (m->data)
+        gsl_free(m->data);
+    }
 
   if (m->work)
-    free(m->work);
+    gsl_free(m->work);
+
+  if (m->perm)
+    gsl_free(m->perm);
+
+  if (m->rowlen)
+    gsl_free(m->rowlen);
 
   if (m->tree_data)
     {
@@ -200,12 +261,12 @@ gsl_spmatrix_free(gsl_spmatrix *m)
         avl_destroy(m->tree_data->tree, NULL);
 
       if (m->tree_data->node_array)
-        free(m->tree_data->node_array);
+        gsl_free(m->tree_data->node_array);
 
-      free(m->tree_data);
+      gsl_free(m->tree_data);
     }
 
-  free(m);
+  gsl_free(m);
 } /* gsl_spmatrix_free() */
 
 /*
@@ -226,7 +287,14 @@ gsl_spmatrix_realloc(const size_t nzmax, gsl_spmatrix *m)
       GSL_ERROR("new nzmax is less than current nz", GSL_EINVAL);
     }
 
-  ptr = realloc(m->i, nzmax * sizeof(size_t));
+  if (m->map)
+    {
+      s = spmatrix_unmap(m);
+      if (s)
+        return s;
+    }
+
+  ptr = gsl_realloc(m->i, nzmax * sizeof(size_t));
   if (!ptr)
     {
       GSL_ERROR("failed to allocate space for row indices", GSL_ENOMEM);
@@ -236,7 +304,7 @@ gsl_spmatrix_realloc(const size_t nzmax, gsl_spmatrix *m)
 
   if (GSL_SPMATRIX_ISTRIPLET(m))
     {
-      ptr = realloc(m->p, nzmax * sizeof(size_t));
+      ptr = gsl_realloc(m->p, nzmax * sizeof(size_t));
       if (!ptr)
         {
           GSL_ERROR("failed to allocate space for column indices", GSL_ENOMEM);
@@ -245,7 +313,7 @@ gsl_spmatrix_realloc(const size_t nzmax, gsl_spmatrix *m)
       m->p = (size_t *) ptr;
     }
 
-  ptr = realloc(m->data, nzmax * sizeof(double));
+  ptr = gsl_realloc(m->data, nzmax * sizeof(double));
   if (!ptr)
     {
       GSL_ERROR("failed to allocate space for data", GSL_ENOMEM);
@@ -262,7 +330,7 @@ gsl_spmatrix_realloc(const size_t nzmax, gsl_spmatrix *m)
       avl_empty(m->tree_data->tree, NULL);
       m->tree_data->n = 0;
 
-      ptr = realloc(m->tree_data->node_array, nzmax * sizeof(struct avl_node));
+      ptr = gsl_realloc(m->tree_data->node_array, nzmax * sizeof(struct avl_node));
       if (!ptr)
         {
           GSL_ERROR("failed to allocate space for AVL tree nodes", GSL_ENOMEM);
@@ -301,6 +369,17 @@ gsl_spmatrix_set_zero(gsl_spmatrix *m)
       avl_empty(m->tree_data->tree, NULL);
       m->tree_data->n = 0;
     }
+  else if (GSL_SPMATRIX_ISSELL(m))
+    {
+      /* keep the row order, but make every slice empty */
+      size_t s;
+
+      for (s = 0; s < m->size1; ++s)
+        m->rowlen[s] = 0;
+
+      for (s = 0; s < m->size1 + 1; ++s)
+        m->p[s] = 0;
+    }
 
   return GSL_SUCCESS;
 } /* gsl_spmatrix_set_zero() */
@@ -311,14 +390,46 @@ gsl_spmatrix_nnz(const gsl_spmatrix *m)
   return m->nz;
 } /* gsl_spmatrix_nnz() */
 
-int
-gsl_spmatrix_fprintf(FILE *stream, const gsl_spmatrix *m,
-                     const char *format)
+/*
+spmatrix_unmap()
+  Copy the arrays of a matrix created by gsl_spmatrix_mmap() to
+allocated memory and release the file mapping
+*/
+
+static int
+spmatrix_unmap(gsl_spmatrix *m)
 {
-  int s = 0;
+  const size_t np = (GSL_SPMATRIX_ISCCS(m) ? m->size2 : m->size1) + 1;
+  const size_t nz = GSL_MAX(m->nz, 1);
+  size_t *i = gsl_malloc(nz * sizeof(size_t));
+  size_t *p = gsl_malloc(np * sizeof(size_t));
+  double *data = gsl_malloc(nz * sizeof(double));
 
-  return s;
-} /* gsl_spmatrix_fprintf() */
+  if (!i || !p || !data)
+    {
+      gsl_free(i);
+      gsl_free(p);
+      gsl_free(data);
+      GSL_ERROR("failed to allocate space for matrix arrays", GSL_ENOMEM);
+    }
+
+  memcpy(i, m->i, m->nz * sizeof(size_t));
+  memcpy(p, m->p, np * sizeof(size_t));
+  memcpy(data, m->data, m->nz * sizeof(double));
+
+#if HAVE_SYS_MMAN_H
+  munmap(m->map, m->map_size);
+#endif
+
+  m->i = i;
+  m->p = p;
+  m->data = data;
+  m->nzmax = nz;
+  m->map = NULL;
+  m->map_size = 0;
+
+  return GSL_SUCCESS;
+} /* spmatrix_unmap() */
 
 /*
 gsl_spmatrix_compare_idx()
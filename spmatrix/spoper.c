@@ -32,6 +32,21 @@ gsl_spmatrix_scale(gsl_spmatrix *m, const double x)
 {
   size_t i;
 
+  if (GSL_SPMATRIX_ISSELL(m))
+    {
+      /* scale only stored elements, the padding must remain zero */
+      const size_t C = m->slice;
+      size_t l;
+
+      for (i = 0; i < m->size1; ++i)
+        {
+          for (l = 0; l < m->rowlen[i]; ++l)
+            m->data[m->p[i / C] + l * C + i % C] *= x;
+        }
+
+      return GSL_SUCCESS;
+    }
+
   for (i = 0; i < m->nz; ++i)
     m->data[i] *= x;
 
@@ -49,6 +64,34 @@ gsl_spmatrix_minmax(const gsl_spmatrix *m, double *min_out, double *max_out)
       GSL_ERROR("matrix is empty", GSL_EINVAL);
     }
 
+  if (GSL_SPMATRIX_ISSELL(m))
+    {
+      const size_t C = m->slice;
+      size_t s, l;
+
+      min = GSL_POSINF;
+      max = GSL_NEGINF;
+
+      for (s = 0; s < m->size1; ++s)
+        {
+          for (l = 0; l < m->rowlen[s]; ++l)
+            {
+              double x = m->data[m->p[s / C] + l * C + s % C];
+
+              if (x < min)
+                min = x;
+
+              if (x > max)
+                max = x;
+            }
+        }
+
+      *min_out = min;
+      *max_out = max;
+
+      return GSL_SUCCESS;
+    }
+
   min = m->data[0];
   max = m->data[0];
 
@@ -100,9 +143,16 @@ gsl_spmatrix_add(gsl_spmatrix *c, const gsl_spmatrix *a,
     {
       GSL_ERROR("triplet format not yet supported", GSL_EINVAL);
     }
+  else if (GSL_SPMATRIX_ISSELL(a))
+    {
+      GSL_ERROR("SELL format not supported", GSL_EINVAL);
+    }
   else
     {
       int status = GSL_SUCCESS;
+      /* outer dimension (columns for CCS, rows for CRS) and inner dimension */
+      const size_t nouter = GSL_SPMATRIX_ISCCS(a) ? N : M;
+      const size_t ninner = GSL_SPMATRIX_ISCCS(a) ? M : N;
       size_t *w = (size_t *) a->work;
       double *x = (double *) b->work;
       size_t *Cp, *Ci;
@@ -118,14 +168,15 @@ gsl_spmatrix_add(gsl_spmatrix *c, const gsl_spmatrix *a,
         }
 
       /* initialize w = 0 */
-      for (j = 0; j < M; ++j)
+      for (j = 0; j < ninner; ++j)
         w[j] = 0;
 
       Ci = c->i;
       Cp = c->p;
       Cd = c->data;
 
-      for (j = 0; j < N; ++j)
+      /* j runs over columns (CCS) or rows (CRS) */
+      for (j = 0; j < nouter; ++j)
         {
           Cp[j] = nz;
 
@@ -139,8 +190,8 @@ gsl_spmatrix_add(gsl_spmatrix *c, const gsl_spmatrix *a,
             Cd[p] = x[Ci[p]];
         }
 
-      /* finalize last column of c */
-      Cp[N] = nz;
+      /* finalize last column or row of c */
+      Cp[nouter] = nz;
       c->nz = nz;
 
       return status;
@@ -208,9 +259,43 @@ gsl_spmatrix_sp2d(gsl_matrix *A, const gsl_spmatrix *S)
               gsl_matrix_set(A, i, j, x);
             }
         }
+      else if (GSL_SPMATRIX_ISCCS(S))
+        {
+          size_t j, p;
+
+          for (j = 0; j < S->size2; ++j)
+            {
+              for (p = S->p[j]; p < S->p[j + 1]; ++p)
+                gsl_matrix_set(A, S->i[p], j, S->data[p]);
+            }
+        }
+      else if (GSL_SPMATRIX_ISCRS(S))
+        {
+          size_t i, p;
+
+          for (i = 0; i < S->size1; ++i)
+            {
+              for (p = S->p[i]; p < S->p[i + 1]; ++p)
+                gsl_matrix_set(A, i, S->i[p], S->data[p]);
+            }
+        }
+      else if (GSL_SPMATRIX_ISSELL(S))
+        {
+          const size_t C = S->slice;
+          size_t s, l;
+
+          for (s = 0; s < S->size1; ++s)
+            {
+              for (l = 0; l < S->rowlen[s]; ++l)
+                {
+                  const size_t n = S->p[s / C] + l * C + s % C;
+                  gsl_matrix_set(A, S->perm[s], S->i[n], S->data[n]);
+                }
+            }
+        }
       else
         {
-          GSL_ERROR("non-triplet formats not yet supported", GSL_EINVAL);
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
         }
 
       return GSL_SUCCESS;
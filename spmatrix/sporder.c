@@ -0,0 +1,820 @@
+/* spmatrix/sporder.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+
+/*
+ * Symmetric orderings of sparse matrices
+ *
+ * Both orderings work on the graph of A + A^T without its diagonal,
+ * stored as adjacency lists, and return a permutation p such that the
+ * reordered matrix is B(i,j) = A(p[i],p[j]), as computed by
+ * gsl_spmatrix_permute_sym().
+ *
+ * [1] A. George and J. W. H. Liu, Computer solution of large sparse
+ *     positive definite systems, Prentice-Hall, 1981.
+ *
+ * [2] P. R. Amestoy, T. A. Davis and I. S. Duff, An approximate minimum
+ *     degree ordering algorithm, SIAM J. Matrix Anal. Appl. 17(4), 1996.
+ */
+
+#define ORDER_UNVISITED ((size_t) -1)
+
+/* growable list of node indices */
+typedef struct
+{
+  size_t *data;
+  size_t len;
+  size_t cap;
+} order_list;
+
+static int order_graph(const gsl_spmatrix *A, size_t **adjp, size_t **adji);
+static size_t order_bfs(const size_t *ap, const size_t *ai, const size_t root,
+                        size_t *level, size_t *queue, const int sort,
+                        size_t *nlevels);
+static int order_push(order_list *l, const size_t x);
+
+/*
+gsl_spmatrix_order_rcm()
+  Compute the reverse Cuthill-McKee ordering of A, which reduces the
+bandwidth and profile of the matrix
+
+Inputs: A - square sparse matrix in triplet or compressed format; the
+            pattern of A + A^T is used
+        p - (output) permutation
+
+Return: success/error
+
+Notes:
+1) Each connected component is numbered by a breadth-first search from
+a pseudo-peripheral node, found with the algorithm of George and Liu,
+visiting the neighbours of each node in order of increasing degree
+*/
+
+int
+gsl_spmatrix_order_rcm(const gsl_spmatrix *A, gsl_permutation *p)
+{
+  const size_t n = A->size1;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t *ap, *ai, *level, *queue;
+      size_t k = 0, i, root;
+      int status;
+
+      status = order_graph(A, &ap, &ai);
+      if (status)
+        return status;
+
+      level = gsl_malloc(2 * n * sizeof(size_t));
+      if (!level)
+        {
+          gsl_free(ap);
+          gsl_free(ai);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      queue = level + n;
+
+      for (i = 0; i < n; ++i)
+        level[i] = ORDER_UNVISITED;
+
+      for (root = 0; root < n; ++root)
+        {
+          size_t start, count, nlev, nlev_new, j;
+
+          if (level[root] != ORDER_UNVISITED)
+            continue;
+
+          /* start from a node of minimum degree in the component */
+          count = order_bfs(ap, ai, root, level, queue, 0, &nlev);
+          start = root;
+          for (j = 0; j < count; ++j)
+            {
+              const size_t v = queue[j];
+
+              if (ap[v + 1] - ap[v] < ap[start + 1] - ap[start])
+                start = v;
+            }
+
+          /* pseudo-peripheral node: move to a node of minimum degree in
+           * the last level while the eccentricity increases */
+          for (j = 0; j < count; ++j)
+            level[queue[j]] = ORDER_UNVISITED;
+
+          count = order_bfs(ap, ai, start, level, queue, 0, &nlev);
+
+          while (1)
+            {
+              size_t cand = queue[count - 1];
+
+              for (j = count; j-- > 0 && level[queue[j]] == nlev - 1; )
+                {
+                  const size_t v = queue[j];
+
+                  if (ap[v + 1] - ap[v] < ap[cand + 1] - ap[cand])
+                    cand = v;
+                }
+
+              for (j = 0; j < count; ++j)
+                level[queue[j]] = ORDER_UNVISITED;
+
+              count = order_bfs(ap, ai, cand, level, queue, 0, &nlev_new);
+
+              if (nlev_new <= nlev)
+                {
+                  /* no improvement, use the previous start node */
+                  for (j = 0; j < count; ++j)
+                    level[queue[j]] = ORDER_UNVISITED;
+                  break;
+                }
+
+              start = cand;
+              nlev = nlev_new;
+            }
+
+          /* Cuthill-McKee numbering of the component */
+          count = order_bfs(ap, ai, start, level, queue, 1, &nlev);
+
+          for (j = 0; j < count; ++j)
+            p->data[k + j] = queue[j];
+
+          k += count;
+        }
+
+      /* reverse */
+      for (i = 0; i < n / 2; ++i)
+        {
+          size_t tmp = p->data[i];
+
+          p->data[i] = p->data[n - 1 - i];
+          p->data[n - 1 - i] = tmp;
+        }
+
+      gsl_free(level);
+      gsl_free(ap);
+      gsl_free(ai);
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_order_rcm() */
+
+/*
+gsl_spmatrix_order_amd()
+  Compute an approximate minimum degree ordering of A, which reduces
+the fill-in of Cholesky and LU factorizations
+
+Inputs: A - square sparse matrix in triplet or compressed format; the
+            pattern of A + A^T is used
+        p - (output) permutation
+
+Return: success/error
+
+Notes:
+1) The elimination is simulated on the quotient graph: each
+eliminated node becomes an element representing the clique it creates,
+and elements adjacent to the pivot are absorbed into the new element,
+so storage never exceeds that of the original graph by much
+
+2) Degrees are bounded above with the approximate external degree of
+Amestoy, Davis and Duff, computed from |L_e \ L_p| for each element e
+adjacent to the updated nodes; elements with L_e contained in L_p are
+absorbed as well (aggressive absorption)
+*/
+
+int
+gsl_spmatrix_order_amd(const gsl_spmatrix *A, gsl_permutation *p)
+{
+  const size_t n = A->size1;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t *ap, *ai;
+      order_list *var;       /* variable neighbours of each variable */
+      order_list *elem;      /* element neighbours of each variable */
+      order_list *lelem;     /* variables of each element */
+      size_t *deg, *head, *next, *prev, *mark, *wval, *wmark;
+      unsigned char *state;  /* 0 = variable, 1 = element, 2 = absorbed */
+      size_t i, k, q, mindeg = 0, stamp = 0;
+      int status;
+
+      status = order_graph(A, &ap, &ai);
+      if (status)
+        return status;
+
+      var = gsl_calloc(3 * n, sizeof(order_list));
+      deg = gsl_malloc(7 * (n + 1) * sizeof(size_t));
+      state = gsl_calloc(n, 1);
+      if (!var || !deg || !state)
+        {
+          gsl_free(var);
+          gsl_free(deg);
+          gsl_free(state);
+          gsl_free(ap);
+          gsl_free(ai);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      elem = var + n;
+      lelem = var + 2 * n;
+      head = deg + (n + 1);
+      next = deg + 2 * (n + 1);
+      prev = deg + 3 * (n + 1);
+      mark = deg + 4 * (n + 1);
+      wval = deg + 5 * (n + 1);
+      wmark = deg + 6 * (n + 1);
+
+      for (i = 0; i <= n; ++i)
+        {
+          head[i] = n;
+          mark[i] = 0;
+          wmark[i] = 0;
+        }
+
+      /* initial degree lists */
+      for (i = 0; i < n && status == GSL_SUCCESS; ++i)
+        {
+          for (q = ap[i]; q < ap[i + 1] && status == GSL_SUCCESS; ++q)
+            status = order_push(&var[i], ai[q]);
+
+          deg[i] = ap[i + 1] - ap[i];
+          next[i] = head[deg[i]];
+          prev[i] = n;
+          if (head[deg[i]] != n)
+            prev[head[deg[i]]] = i;
+          head[deg[i]] = i;
+        }
+
+      gsl_free(ap);
+      gsl_free(ai);
+
+      for (k = 0; k < n && status == GSL_SUCCESS; ++k)
+        {
+          order_list *Lp;
+          size_t piv, e, nlp;
+
+          /* pivot of minimum approximate degree */
+          while (head[mindeg] == n)
+            ++mindeg;
+
+          piv = head[mindeg];
+          head[mindeg] = next[piv];
+          if (next[piv] != n)
+            prev[next[piv]] = n;
+
+          p->data[k] = piv;
+
+          /* L_p = (A_p U the variables of its elements) \ {p} */
+          ++stamp;
+          mark[piv] = stamp;
+          Lp = &lelem[piv];
+
+          for (q = 0; q < elem[piv].len && status == GSL_SUCCESS; ++q)
+            {
+              size_t r;
+
+              e = elem[piv].data[q];
+              if (state[e] != 1)
+                continue;
+
+              for (r = 0; r < lelem[e].len && status == GSL_SUCCESS; ++r)
+                {
+                  const size_t v = lelem[e].data[r];
+
+                  if (state[v] == 0 && mark[v] != stamp)
+                    {
+                      mark[v] = stamp;
+                      status = order_push(Lp, v);
+                    }
+                }
+
+              /* absorb e into the new element */
+              state[e] = 2;
+              gsl_free(lelem[e].data);
+              lelem[e].data = NULL;
+              lelem[e].len = lelem[e].cap = 0;
+            }
+
+          for (q = 0; q < var[piv].len && status == GSL_SUCCESS; ++q)
+            {
+              const size_t v = var[piv].data[q];
+
+              if (state[v] == 0 && mark[v] != stamp)
+                {
+                  mark[v] = stamp;
+                  status = order_push(Lp, v);
+                }
+            }
+
+          if (status)
+            break;
+
+          /* piv becomes an element */
+          state[piv] = 1;
+          gsl_free(var[piv].data);
+          gsl_free(elem[piv].data);
+          var[piv].data = elem[piv].data = NULL;
+          var[piv].len = elem[piv].len = 0;
+
+          nlp = Lp->len;
+
+          /* wval[e] = |L_e \ L_p| for elements adjacent to L_p */
+          for (q = 0; q < nlp; ++q)
+            {
+              const order_list *Ei = &elem[Lp->data[q]];
+              size_t r;
+
+              for (r = 0; r < Ei->len; ++r)
+                {
+                  e = Ei->data[r];
+                  if (state[e] != 1)
+                    continue;
+
+                  if (wmark[e] != stamp)
+                    {
+                      order_list *Le = &lelem[e];
+                      size_t t, len = 0;
+
+                      /* drop variables eliminated since e was formed */
+                      for (t = 0; t < Le->len; ++t)
+                        {
+                          if (state[Le->data[t]] == 0)
+                            Le->data[len++] = Le->data[t];
+                        }
+
+                      Le->len = len;
+                      wmark[e] = stamp;
+                      wval[e] = len;
+                    }
+
+                  --wval[e];
+                }
+            }
+
+          /* update the variables of L_p */
+          for (q = 0; q < nlp; ++q)
+            {
+              const size_t v = Lp->data[q];
+              order_list *Ei = &elem[v];
+              order_list *Ai = &var[v];
+              size_t r, len, d;
+
+              /* remove v from its degree list */
+              if (prev[v] != n)
+                next[prev[v]] = next[v];
+              else
+                head[deg[v]] = next[v];
+
+              if (next[v] != n)
+                prev[next[v]] = prev[v];
+
+              /* keep live elements not contained in L_p, then add p */
+              d = 0;
+              for (r = 0, len = 0; r < Ei->len; ++r)
+                {
+                  e = Ei->data[r];
+                  if (state[e] != 1)
+                    continue;
+
+                  if (wval[e] == 0)
+                    {
+                      /* aggressive absorption: L_e is a subset of L_p */
+                      state[e] = 2;
+                      continue;
+                    }
+
+                  d += wval[e];
+                  Ei->data[len++] = e;
+                }
+
+              Ei->len = len;
+              status = order_push(Ei, piv);
+              if (status)
+                break;
+
+              /* prune variables covered by the new element */
+              for (r = 0, len = 0; r < Ai->len; ++r)
+                {
+                  const size_t u = Ai->data[r];
+
+                  if (state[u] == 0 && mark[u] != stamp)
+                    Ai->data[len++] = u;
+                }
+
+              Ai->len = len;
+
+              /* approximate external degree */
+              d += len + nlp - 1;
+              d = GSL_MIN(d, deg[v] + nlp - 1);
+              d = GSL_MIN(d, n - k - 2);
+              deg[v] = d;
+
+              next[v] = head[d];
+              prev[v] = n;
+              if (head[d] != n)
+                prev[head[d]] = v;
+              head[d] = v;
+
+              mindeg = GSL_MIN(mindeg, d);
+            }
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_free(var[i].data);
+          gsl_free(elem[i].data);
+          gsl_free(lelem[i].data);
+        }
+
+      gsl_free(var);
+      gsl_free(deg);
+      gsl_free(state);
+
+      if (status)
+        {
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_order_amd() */
+
+/*
+gsl_spmatrix_permute_sym()
+  Apply a symmetric permutation to a compressed matrix,
+B(i,j) = A(p[i],p[j]), i.e. B = P A P^T
+
+Inputs: A - square compressed column or compressed row matrix
+        p - permutation
+        B - (output) permuted matrix, in the same format as A, with
+            sorted indices
+
+Return: success/error
+
+Notes:
+1) The inner indices of B are sorted by permuting into the transposed
+format and back, with two counting sorts
+*/
+
+int
+gsl_spmatrix_permute_sym(const gsl_spmatrix *A, const gsl_permutation *p,
+                         gsl_spmatrix *B)
+{
+  const size_t n = A->size1;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (B->size1 != n || B->size2 != n)
+    {
+      GSL_ERROR("B matrix dimensions must match A", GSL_EBADLEN);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(A) && !GSL_SPMATRIX_ISCRS(A))
+    {
+      GSL_ERROR("matrix must be in compressed column or row format",
+                GSL_EINVAL);
+    }
+  else if (A->sptype != B->sptype)
+    {
+      GSL_ERROR("matrices must have the same storage format", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t nz = A->nz;
+      size_t *pinv, *tp, *ti, *w;
+      double *td;
+      size_t j, k, q;
+      int status;
+
+      if (B->nzmax < nz)
+        {
+          status = gsl_spmatrix_realloc(nz, B);
+          if (status)
+            return status;
+        }
+
+      pinv = gsl_malloc((3 * n + 2 + nz) * sizeof(size_t));
+      td = gsl_malloc((nz + 1) * sizeof(double));
+      if (!pinv || !td)
+        {
+          gsl_free(pinv);
+          gsl_free(td);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      tp = pinv + n;
+      w = tp + n + 1;
+      ti = w + n + 1;
+
+      for (k = 0; k < n; ++k)
+        pinv[p->data[k]] = k;
+
+      /* T = transpose of B: inner index j of B becomes outer index of T */
+      for (k = 0; k <= n; ++k)
+        tp[k] = 0;
+
+      for (q = 0; q < nz; ++q)
+        tp[pinv[A->i[q]] + 1]++;
+
+      for (k = 0; k < n; ++k)
+        tp[k + 1] += tp[k];
+
+      for (k = 0; k < n; ++k)
+        w[k] = tp[k];
+
+      /* visit the outer indices of B in order, so T is sorted */
+      for (j = 0; j < n; ++j)
+        {
+          const size_t c = p->data[j];
+
+          for (q = A->p[c]; q < A->p[c + 1]; ++q)
+            {
+              const size_t t = w[pinv[A->i[q]]]++;
+
+              ti[t] = j;
+              td[t] = A->data[q];
+            }
+        }
+
+      /* transpose T back into B, again in order */
+      for (k = 0; k <= n; ++k)
+        B->p[k] = 0;
+
+      for (q = 0; q < nz; ++q)
+        B->p[ti[q] + 1]++;
+
+      for (k = 0; k < n; ++k)
+        B->p[k + 1] += B->p[k];
+
+      for (k = 0; k < n; ++k)
+        w[k] = B->p[k];
+
+      for (k = 0; k < n; ++k)
+        {
+          for (q = tp[k]; q < tp[k + 1]; ++q)
+            {
+              const size_t t = w[ti[q]]++;
+
+              B->i[t] = k;
+              B->data[t] = td[q];
+            }
+        }
+
+      B->nz = nz;
+
+      gsl_free(pinv);
+      gsl_free(td);
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_permute_sym() */
+
+/*
+order_graph()
+  Build the adjacency lists of the graph of A + A^T, excluding the
+diagonal and duplicate edges
+
+Inputs: A    - square sparse matrix
+        adjp - (output) list pointers, length n + 1
+        adji - (output) neighbours of node i are adji[adjp[i]..adjp[i+1]-1]
+
+Return: success/error
+*/
+
+static int
+order_graph(const gsl_spmatrix *A, size_t **adjp, size_t **adji)
+{
+  const size_t n = A->size1;
+  const size_t nz = A->nz;
+  size_t *ap, *ai, *w, *rows, *cols;
+  size_t k, q, len;
+
+  if (GSL_SPMATRIX_ISSELL(A))
+    {
+      GSL_ERROR("matrix must be in triplet or compressed format", GSL_EINVAL);
+    }
+
+  ap = gsl_malloc((2 * n + 2) * sizeof(size_t));
+  ai = gsl_malloc((2 * nz + 1) * sizeof(size_t));
+  rows = gsl_malloc((2 * nz + 1) * sizeof(size_t));
+  if (!ap || !ai || !rows)
+    {
+      gsl_free(ap);
+      gsl_free(ai);
+      gsl_free(rows);
+      GSL_ERROR("failed to allocate adjacency lists", GSL_ENOMEM);
+    }
+
+  w = ap + n + 1;
+  cols = rows + nz;
+
+  /* expand to (outer, inner) index pairs */
+  if (GSL_SPMATRIX_ISTRIPLET(A))
+    {
+      for (q = 0; q < nz; ++q)
+        {
+          rows[q] = A->i[q];
+          cols[q] = A->p[q];
+        }
+    }
+  else
+    {
+      const size_t nouter = GSL_SPMATRIX_ISCCS(A) ? A->size2 : A->size1;
+
+      for (k = 0; k < nouter; ++k)
+        {
+          for (q = A->p[k]; q < A->p[k + 1]; ++q)
+            {
+              rows[q] = A->i[q];
+              cols[q] = k;
+            }
+        }
+    }
+
+  /* count both directions of each off-diagonal element */
+  for (k = 0; k <= n; ++k)
+    ap[k] = 0;
+
+  for (q = 0; q < nz; ++q)
+    {
+      if (rows[q] != cols[q])
+        {
+          ap[rows[q] + 1]++;
+          ap[cols[q] + 1]++;
+        }
+    }
+
+  for (k = 0; k < n; ++k)
+    ap[k + 1] += ap[k];
+
+  for (k = 0; k < n; ++k)
+    w[k] = ap[k];
+
+  for (q = 0; q < nz; ++q)
+    {
+      if (rows[q] != cols[q])
+        {
+          ai[w[rows[q]]++] = cols[q];
+          ai[w[cols[q]]++] = rows[q];
+        }
+    }
+
+  gsl_free(rows);
+
+  /* remove duplicate edges, compacting in place */
+  for (k = 0; k < n; ++k)
+    w[k] = n;
+
+  len = 0;
+  for (k = 0; k < n; ++k)
+    {
+      const size_t start = ap[k];
+
+      ap[k] = len;
+      for (q = start; q < ap[k + 1]; ++q)
+        {
+          const size_t j = ai[q];
+
+          if (w[j] != k)
+            {
+              w[j] = k;
+              ai[len++] = j;
+            }
+        }
+    }
+
+  ap[n] = len;
+
+  *adjp = ap;
+  *adji = ai;
+
+  return GSL_SUCCESS;
+} /* order_graph() */
+
+/*
+order_bfs()
+  Breadth-first search of the component of root
+
+Inputs: ap, ai  - adjacency lists
+        root    - starting node
+        level   - on input, ORDER_UNVISITED for unvisited nodes; on
+                  output, the level of each visited node
+        queue   - (output) visited nodes in order of visit
+        sort    - if non-zero, the unvisited neighbours of each node are
+                  visited in order of increasing degree
+        nlevels - (output) number of levels
+
+Return: number of visited nodes
+*/
+
+static size_t
+order_bfs(const size_t *ap, const size_t *ai, const size_t root,
+          size_t *level, size_t *queue, const int sort, size_t *nlevels)
+{
+  size_t head = 0, tail = 1;
+
+  queue[0] = root;
+  level[root] = 0;
+
+  while (head < tail)
+    {
+      const size_t v = queue[head++];
+      const size_t first = tail;
+      size_t q;
+
+      for (q = ap[v]; q < ap[v + 1]; ++q)
+        {
+          const size_t u = ai[q];
+
+          if (level[u] != ORDER_UNVISITED)
+            continue;
+
+          level[u] = level[v] + 1;
+          queue[tail++] = u;
+        }
+
+      if (sort)
+        {
+          /* insertion sort of the new nodes by degree */
+          size_t a, b;
+
+          for (a = first + 1; a < tail; ++a)
+            {
+              const size_t u = queue[a];
+              const size_t du = ap[u + 1] - ap[u];
+
+              for (b = a; b > first && ap[queue[b - 1] + 1] - ap[queue[b - 1]] > du; --b)
+                queue[b] = queue[b - 1];
+
+              queue[b] = u;
+            }
+        }
+    }
+
+  *nlevels = level[queue[tail - 1]] + 1;
+
+  return tail;
+} /* order_bfs() */
+
+static int
+order_push(order_list *l, const size_t x)
+{
+  if (l->len == l->cap)
+    {
+      size_t cap = GSL_MAX(2 * l->cap, 4);
+      void *ptr = gsl_realloc(l->data, cap * sizeof(size_t));
+
+      if (!ptr)
+        return GSL_ENOMEM;
+
+      l->data = ptr;
+      l->cap = cap;
+    }
+
+  l->data[l->len++] = x;
+
+  return GSL_SUCCESS;
+}
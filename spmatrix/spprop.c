@@ -64,27 +64,53 @@ gsl_spmatrix_equal(const gsl_spmatrix *a, const gsl_spmatrix *b)
                 return 0;
             }
         }
-      else if (GSL_SPMATRIX_ISCCS(a))
+      else if (GSL_SPMATRIX_ISCCS(a) || GSL_SPMATRIX_ISCRS(a))
         {
+          /* number of column (CCS) or row (CRS) pointers */
+          const size_t np = GSL_SPMATRIX_ISCCS(a) ? N + 1 : M + 1;
+
           /*
-           * for compressed column, both matrices should have everything
-           * in the same order
+           * for compressed column and row, both matrices should have
+           * everything in the same order
            */
 
-          /* check row indices and data */
+          /* check inner indices and data */
           for (n = 0; n < nz; ++n)
             {
               if ((a->i[n] != b->i[n]) || (a->data[n] != b->data[n]))
                 return 0;
             }
 
-          /* check column pointers */
-          for (n = 0; n < a->size2 + 1; ++n)
+          /* check column or row pointers */
+          for (n = 0; n < np; ++n)
             {
               if (a->p[n] != b->p[n])
                 return 0;
             }
         }
+      else if (GSL_SPMATRIX_ISSELL(a))
+        {
+          /*
+           * matrices converted with different slice heights or row
+           * orders hold the same elements in different places, so
+           * compare row by row
+           */
+          size_t s, l;
+
+          for (s = 0; s < M; ++s)
+            {
+              const size_t *mi = a->i + a->p[s / a->slice] + s % a->slice;
+              const double *md = a->data + a->p[s / a->slice] + s % a->slice;
+
+              for (l = 0; l < a->rowlen[s]; ++l)
+                {
+                  const size_t j = mi[l * a->slice];
+
+                  if (md[l * a->slice] != gsl_spmatrix_get(b, a->perm[s], j))
+                    return 0;
+                }
+            }
+        }
       else
         {
           GSL_ERROR_VAL("unknown sparse matrix type", GSL_EINVAL, 0);
@@ -0,0 +1,233 @@
+/* spmatrix/spsell.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_alloc.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+
+typedef struct
+{
+  size_t len; /* number of non-zeros in row */
+  size_t row; /* row index */
+} sell_row;
+
+static int compare_rows(const void *pa, const void *pb);
+
+/*
+gsl_spmatrix_sell()
+  Create a sparse matrix in sliced ELLPACK (SELL-C-sigma) format
+
+Inputs: A     - sparse matrix in triplet, compressed column or
+                compressed row format
+        C     - number of rows per slice, 1 <= C <= GSL_SPMATRIX_SELL_CMAX
+        sigma - rows are sorted by decreasing length within windows
+                of sigma rows; sigma <= 1 keeps the original order
+
+Return: pointer to new matrix (should be freed when finished with it)
+
+Notes:
+1) Sorting rows of similar length into the same slice reduces the
+padding; taking sigma as a small multiple of C keeps the reordering
+local so that accesses to x and y retain most of their locality
+
+2) Within a slice, consecutive elements belong to consecutive rows,
+so a matrix-vector product processes C rows at once with unit stride
+loads of the matrix elements
+*/
+
+gsl_spmatrix *
+gsl_spmatrix_sell(const gsl_spmatrix *A, const size_t C, const size_t sigma)
+{
+  if (C == 0 || C > GSL_SPMATRIX_SELL_CMAX)
+    {
+      GSL_ERROR_NULL("slice height C must be between 1 and GSL_SPMATRIX_SELL_CMAX",
+                     GSL_EINVAL);
+    }
+  else if (GSL_SPMATRIX_ISSELL(A))
+    {
+      GSL_ERROR_NULL("matrix is already in SELL format", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t M = A->size1;
+      const size_t nslices = (M + C - 1) / C;
+      const size_t window = GSL_MAX(sigma, 1);
+      gsl_spmatrix *R; /* A in compressed row format */
+      gsl_spmatrix *m;
+      sell_row *rows;
+      size_t nzmax, s, k, w;
+
+      if (GSL_SPMATRIX_ISCRS(A))
+        {
+          R = (gsl_spmatrix *) A;
+        }
+      else if (GSL_SPMATRIX_ISTRIPLET(A))
+        {
+          R = gsl_spmatrix_comprow(A);
+          if (!R)
+            return NULL;
+        }
+      else
+        {
+          int status;
+
+          R = gsl_spmatrix_alloc_nzmax(M, A->size2, A->nz, GSL_SPMATRIX_CRS);
+          if (!R)
+            return NULL;
+
+          status = gsl_spmatrix_switch_major(R, A);
+          if (status)
+            {
+              gsl_spmatrix_free(R);
+              GSL_ERROR_NULL("failed to convert matrix to compressed row format",
+                             status);
+            }
+        }
+
+      rows = gsl_malloc(M * sizeof(sell_row));
+      if (!rows)
+        {
+          if (R != A)
+            gsl_spmatrix_free(R);
+
+          GSL_ERROR_NULL("failed to allocate space for row lengths",
+                         GSL_ENOMEM);
+        }
+
+      for (s = 0; s < M; ++s)
+        {
+          rows[s].len = R->p[s + 1] - R->p[s];
+          rows[s].row = s;
+        }
+
+      /* sort rows by decreasing length within each window */
+      if (window > 1)
+        {
+          for (s = 0; s < M; s += window)
+            {
+              qsort(&rows[s], GSL_MIN(window, M - s), sizeof(sell_row),
+                    compare_rows);
+            }
+        }
+
+      /* storage required for padded slices */
+      nzmax = 0;
+      for (k = 0; k < nslices; ++k)
+        {
+          size_t width = 0;
+
+          for (s = k * C; s < GSL_MIN((k + 1) * C, M); ++s)
+            width = GSL_MAX(width, rows[s].len);
+
+          nzmax += width * C;
+        }
+
+      m = gsl_spmatrix_alloc_nzmax(M, A->size2, nzmax, GSL_SPMATRIX_SELL);
+      if (!m)
+        {
+          gsl_free(rows);
+          if (R != A)
+            gsl_spmatrix_free(R);
+
+          return NULL;
+        }
+
+      m->slice = C;
+
+      for (s = 0; s < M; ++s)
+        {
+          m->perm[s] = rows[s].row;
+          m->rowlen[s] = rows[s].len;
+        }
+
+      m->p[0] = 0;
+      for (k = 0; k < nslices; ++k)
+        {
+          const size_t s0 = k * C;
+          const size_t ns = GSL_MIN(C, M - s0);
+          const size_t offset = m->p[k];
+          size_t width = 0, r;
+
+          for (r = 0; r < ns; ++r)
+            width = GSL_MAX(width, m->rowlen[s0 + r]);
+
+          for (r = 0; r < C; ++r)
+            {
+              const size_t len = (r < ns) ? m->rowlen[s0 + r] : 0;
+              const size_t p0 = (r < ns) ? R->p[m->perm[s0 + r]] : 0;
+
+              for (w = 0; w < len; ++w)
+                {
+                  m->i[offset + w * C + r] = R->i[p0 + w];
+                  m->data[offset + w * C + r] = R->data[p0 + w];
+                }
+
+              /* padding */
+              for (w = len; w < width; ++w)
+                {
+                  m->i[offset + w * C + r] = 0;
+                  m->data[offset + w * C + r] = 0.0;
+                }
+            }
+
+          m->p[k + 1] = offset + width * C;
+        }
+
+      m->nz = R->nz;
+
+      gsl_free(rows);
+      if (R != A)
+        gsl_spmatrix_free(R);
+
+      return m;
+    }
+} /* gsl_spmatrix_sell() */
+
+/*
+gsl_spmatrix_sell_nslices()
+  Return the number of slices of a SELL matrix
+*/
+
+size_t
+gsl_spmatrix_sell_nslices(const gsl_spmatrix *m)
+{
+  return (m->size1 + m->slice - 1) / m->slice;
+} /* gsl_spmatrix_sell_nslices() */
+
+/* sort by decreasing length, then by row index so the order is stable */
+static int
+compare_rows(const void *pa, const void *pb)
+{
+  const sell_row *a = (const sell_row *) pa;
+  const sell_row *b = (const sell_row *) pb;
+
+  if (a->len > b->len)
+    return -1;
+  else if (a->len < b->len)
+    return 1;
+  else if (a->row < b->row)
+    return -1;
+  else if (a->row > b->row)
+    return 1;
+  else
+    return 0;
+}
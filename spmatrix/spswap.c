@@ -25,8 +25,20 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_alloc.h>
 
 #include "avl.c"
+#include "chunk.c"
+
+static void compress_transpose(const size_t nouter, const size_t ninner,
+                               const gsl_spmatrix *src, gsl_spmatrix *dest,
+                               size_t *work, const size_t lwork);
+static void compress_transpose_alloc(const size_t nouter,
+                                     const size_t ninner,
+                                     const gsl_spmatrix *src,
+                                     gsl_spmatrix *dest);
+static size_t transpose_start(const size_t *p, const size_t n,
+                              const size_t t, const size_t nchunks);
 
 int
 gsl_spmatrix_transpose_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src)
@@ -77,39 +89,11 @@ gsl_spmatrix_transpose_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src)
         }
       else if (GSL_SPMATRIX_ISCCS(src))
         {
-          size_t *Ai = src->i;
-          size_t *Ap = src->p;
-          double *Ad = src->data;
-          size_t *ATi = dest->i;
-          size_t *ATp = dest->p;
-          double *ATd = dest->data;
-          size_t *w = (size_t *) dest->work;
-          size_t p, j;
-
-          /* initialize to 0 */
-          for (p = 0; p < M + 1; ++p)
-            ATp[p] = 0;
-
-          /* compute row counts of A (= column counts for A^T) */
-          for (p = 0; p < nz; ++p)
-            ATp[Ai[p]]++;
-
-          /* compute row pointers for A (= column pointers for A^T) */
-          gsl_spmatrix_cumsum(M, ATp);
-
-          /* make copy of row pointers */
-          for (j = 0; j < M; ++j)
-            w[j] = ATp[j];
-
-          for (j = 0; j < N; ++j)
-            {
-              for (p = Ap[j]; p < Ap[j + 1]; ++p)
-                {
-                  size_t k = w[Ai[p]]++;
-                  ATi[k] = j;
-                  ATd[k] = Ad[p];
-                }
-            }
+          compress_transpose_alloc(N, M, src, dest);
+        }
+      else if (GSL_SPMATRIX_ISCRS(src))
+        {
+          compress_transpose_alloc(M, N, src, dest);
         }
       else
         {
@@ -121,3 +105,339 @@ gsl_spmatrix_transpose_memcpy(gsl_spmatrix *dest, const gsl_spmatrix *src)
       return s;
     }
 } /* gsl_spmatrix_transpose_memcpy() */
+
+/*
+gsl_spmatrix_switch_major()
+  Convert a compressed column matrix to compressed row format
+or vice versa
+
+Inputs: dest - (output) matrix in compressed row format if src
+               is compressed column, or compressed column if src
+               is compressed row
+        src  - compressed matrix
+
+Return: success or error
+*/
+
+int
+gsl_spmatrix_switch_major(gsl_spmatrix *dest, const gsl_spmatrix *src)
+{
+  const size_t M = src->size1;
+  const size_t N = src->size2;
+
+  if (M != dest->size1 || N != dest->size2)
+    {
+      GSL_ERROR("matrix sizes are different", GSL_EBADLEN);
+    }
+  else if (GSL_SPMATRIX_ISCCS(src) && !GSL_SPMATRIX_ISCRS(dest))
+    {
+      GSL_ERROR("dest must be in compressed row format", GSL_EINVAL);
+    }
+  else if (GSL_SPMATRIX_ISCRS(src) && !GSL_SPMATRIX_ISCCS(dest))
+    {
+      GSL_ERROR("dest must be in compressed column format", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(src) && !GSL_SPMATRIX_ISCRS(src))
+    {
+      GSL_ERROR("src must be in compressed format", GSL_EINVAL);
+    }
+  else
+    {
+      int s = GSL_SUCCESS;
+
+      if (dest->nzmax < src->nz)
+        {
+          s = gsl_spmatrix_realloc(src->nz, dest);
+          if (s)
+            return s;
+        }
+
+      /*
+       * the compressed column arrays of a matrix are the compressed
+       * row arrays of its transpose, so switching major is a transpose
+       * of the underlying arrays
+       */
+      if (GSL_SPMATRIX_ISCCS(src))
+        compress_transpose_alloc(N, M, src, dest);
+      else
+        compress_transpose_alloc(M, N, src, dest);
+
+      dest->nz = src->nz;
+
+      return s;
+    }
+} /* gsl_spmatrix_switch_major() */
+
+/*
+gsl_spmatrix_transpose_memcpy_work()
+  Copy the transpose of a compressed matrix into dest, using a work
+array provided by the caller
+
+Inputs: dest  - (output) transpose of src, in the same format
+        src   - compressed column or compressed row matrix
+        work  - work array
+        lwork - length of work, at least the outer dimension of dest
+
+Return: success or error
+
+Notes:
+1) The transpose is a parallel counting sort as described for
+gsl_spmatrix_compress_work; gsl_spmatrix_compress_worksize gives the
+length of work needed to use all threads. The result has sorted inner
+indices.
+*/
+
+int
+gsl_spmatrix_transpose_memcpy_work(gsl_spmatrix *dest,
+                                   const gsl_spmatrix *src,
+                                   size_t *work, const size_t lwork)
+{
+  const size_t M = src->size1;
+  const size_t N = src->size2;
+
+  if (M != dest->size2 || N != dest->size1)
+    {
+      GSL_ERROR("dimensions of dest must be transpose of src matrix",
+                GSL_EBADLEN);
+    }
+  else if (dest->sptype != src->sptype)
+    {
+      GSL_ERROR("cannot copy matrices of different storage formats",
+                GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(src) && !GSL_SPMATRIX_ISCRS(src))
+    {
+      GSL_ERROR("src must be in compressed format", GSL_EINVAL);
+    }
+  else
+    {
+      /* outer and inner dimensions of src */
+      const size_t nouter = GSL_SPMATRIX_ISCCS(src) ? N : M;
+      const size_t ninner = GSL_SPMATRIX_ISCCS(src) ? M : N;
+
+      if (lwork < ninner)
+        {
+          GSL_ERROR("work array is too small", GSL_EBADLEN);
+        }
+
+      if (dest->nzmax < src->nz)
+        {
+          int s = gsl_spmatrix_realloc(src->nz, dest);
+          if (s)
+            return s;
+        }
+
+      compress_transpose(nouter, ninner, src, dest, work, lwork);
+      dest->nz = src->nz;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_transpose_memcpy_work() */
+
+/*
+gsl_spmatrix_switch_major_work()
+  Convert a compressed column matrix to compressed row format or vice
+versa, using a work array provided by the caller
+
+Inputs: dest  - (output) matrix in compressed row format if src
+                is compressed column, or compressed column if src
+                is compressed row
+        src   - compressed matrix
+        work  - work array
+        lwork - length of work, at least the outer dimension of dest
+
+Return: success or error
+*/
+
+int
+gsl_spmatrix_switch_major_work(gsl_spmatrix *dest, const gsl_spmatrix *src,
+                               size_t *work, const size_t lwork)
+{
+  const size_t M = src->size1;
+  const size_t N = src->size2;
+
+  if (M != dest->size1 || N != dest->size2)
+    {
+      GSL_ERROR("matrix sizes are different", GSL_EBADLEN);
+    }
+  else if (GSL_SPMATRIX_ISCCS(src) && !GSL_SPMATRIX_ISCRS(dest))
+    {
+      GSL_ERROR("dest must be in compressed row format", GSL_EINVAL);
+    }
+  else if (GSL_SPMATRIX_ISCRS(src) && !GSL_SPMATRIX_ISCCS(dest))
+    {
+      GSL_ERROR("dest must be in compressed column format", GSL_EINVAL);
+    }
+  else if (!GSL_SPMATRIX_ISCCS(src) && !GSL_SPMATRIX_ISCRS(src))
+    {
+      GSL_ERROR("src must be in compressed format", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t nouter = GSL_SPMATRIX_ISCCS(src) ? N : M;
+      const size_t ninner = GSL_SPMATRIX_ISCCS(src) ? M : N;
+
+      if (lwork < ninner)
+        {
+          GSL_ERROR("work array is too small", GSL_EBADLEN);
+        }
+
+      if (dest->nzmax < src->nz)
+        {
+          int s = gsl_spmatrix_realloc(src->nz, dest);
+          if (s)
+            return s;
+        }
+
+      compress_transpose(nouter, ninner, src, dest, work, lwork);
+      dest->nz = src->nz;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spmatrix_switch_major_work() */
+
+/*
+compress_transpose()
+  Transpose the arrays of a compressed (column or row) matrix. The
+result has sorted inner indices.
+
+Inputs: nouter - number of outer pointers of src (columns for CCS,
+                 rows for CRS)
+        ninner - inner dimension of src (rows for CCS, columns for CRS)
+        src    - compressed matrix
+        dest   - (output) compressed matrix with ninner + 1 outer
+                 pointers and nzmax >= src->nz
+        work   - work array
+        lwork  - length of work, at least ninner
+
+Notes:
+1) The outer indices of src are split into chunks with about the
+same number of elements, one histogram of length ninner per chunk
+(see chunk.c)
+*/
+
+static void
+compress_transpose(const size_t nouter, const size_t ninner,
+                   const gsl_spmatrix *src, gsl_spmatrix *dest,
+                   size_t *work, const size_t lwork)
+{
+  const size_t *Ai = src->i;
+  const size_t *Ap = src->p;
+  const double *Ad = src->data;
+  const size_t nchunks = chunk_count(src->nz, ninner, lwork);
+  size_t t;
+
+  /* count the inner indices of A (= outer indices of A^T) per chunk */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+  for (t = 0; t < nchunks; ++t)
+    {
+      const size_t j0 = transpose_start(Ap, nouter, t, nchunks);
+      const size_t j1 = transpose_start(Ap, nouter, t + 1, nchunks);
+      size_t *w = work + t * ninner;
+      size_t p;
+
+      for (p = 0; p < ninner; ++p)
+        w[p] = 0;
+
+      for (p = Ap[j0]; p < Ap[j1]; ++p)
+        w[Ai[p]]++;
+    }
+
+  chunk_offsets(ninner, nchunks, work, dest->p);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nchunks > 1)
+#endif
+  for (t = 0; t < nchunks; ++t)
+    {
+      const size_t j0 = transpose_start(Ap, nouter, t, nchunks);
+      const size_t j1 = transpose_start(Ap, nouter, t + 1, nchunks);
+      const size_t *ATp = dest->p;
+      size_t *ATi = dest->i;
+      double *ATd = dest->data;
+      size_t *w = work + t * ninner;
+      size_t j, p;
+
+      for (j = j0; j < j1; ++j)
+        {
+          for (p = Ap[j]; p < Ap[j + 1]; ++p)
+            {
+              size_t k = ATp[Ai[p]] + w[Ai[p]]++;
+              ATi[k] = j;
+              ATd[k] = Ad[p];
+            }
+        }
+    }
+} /* compress_transpose() */
+
+/*
+compress_transpose_alloc()
+  Call compress_transpose() with a work array of one histogram per
+thread for large matrices, or dest->work otherwise
+*/
+
+static void
+compress_transpose_alloc(const size_t nouter, const size_t ninner,
+                         const gsl_spmatrix *src, gsl_spmatrix *dest)
+{
+  size_t *work = NULL;
+  size_t lwork = ninner;
+
+  if (src->nz >= SPMATRIX_PARALLEL_NNZ)
+    {
+      lwork = gsl_spmatrix_compress_worksize(ninner);
+      if (lwork > ninner)
+        work = gsl_malloc(lwork * sizeof(size_t));
+    }
+
+  if (work)
+    {
+      compress_transpose(nouter, ninner, src, dest, work, lwork);
+      gsl_free(work);
+    }
+  else
+    {
+      /* dest->work holds at least ninner elements of size_t */
+      compress_transpose(nouter, ninner, src, dest,
+                         (size_t *) dest->work, ninner);
+    }
+} /* compress_transpose_alloc() */
+
+/*
+transpose_start()
+  Find the first outer index of chunk t out of nchunks, so that each
+chunk holds about the same number of elements
+
+Inputs: p       - outer pointers, length n + 1
+        n       - outer dimension
+        t       - chunk index, 0 <= t <= nchunks
+        nchunks - number of chunks
+
+Return: first outer index of chunk t
+*/
+
+static size_t
+transpose_start(const size_t *p, const size_t n, const size_t t,
+                const size_t nchunks)
+{
+  const double target = (double) p[n] * (double) t / (double) nchunks;
+  size_t lo = 0, hi = n;
+
+  if (t >= nchunks)
+    return n;
+
+  /* smallest j with p[j] >= target */
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if ((double) p[mid] < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return lo;
+} /* transpose_start() */
@@ -29,6 +29,7 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_permutation.h>
 #include <gsl/gsl_spmatrix.h>
 
 /*
@@ -170,6 +171,7 @@ test_getset(const size_t M, const size_t N, const gsl_rng *r)
   {
     gsl_spmatrix *T = create_random_sparse(M, N, 0.3, r);
     gsl_spmatrix *C = gsl_spmatrix_compcol(T);
+    gsl_spmatrix *R = gsl_spmatrix_comprow(T);
 
     status = 0;
     for (i = 0; i < M; ++i)
@@ -178,8 +180,9 @@ test_getset(const size_t M, const size_t N, const gsl_rng *r)
           {
             double Tij = gsl_spmatrix_get(T, i, j);
             double Cij = gsl_spmatrix_get(C, i, j);
+            double Rij = gsl_spmatrix_get(R, i, j);
 
-            if (Tij != Cij)
+            if (Tij != Cij || Tij != Rij)
               status = 1;
           }
       }
@@ -188,6 +191,7 @@ test_getset(const size_t M, const size_t N, const gsl_rng *r)
 
     gsl_spmatrix_free(T);
     gsl_spmatrix_free(C);
+    gsl_spmatrix_free(R);
   }
 } /* test_getset() */
 
@@ -199,7 +203,7 @@ test_memcpy(const size_t M, const size_t N, const gsl_rng *r)
   {
     gsl_spmatrix *at = create_random_sparse(M, N, 0.2, r);
     gsl_spmatrix *ac = gsl_spmatrix_compcol(at);
-    gsl_spmatrix *bt, *bc;
+    gsl_spmatrix *ar, *bt, *bc, *br;
   
     bt = gsl_spmatrix_alloc(M, N);
     gsl_spmatrix_memcpy(bt, at);
@@ -213,10 +217,19 @@ test_memcpy(const size_t M, const size_t N, const gsl_rng *r)
     status = gsl_spmatrix_equal(ac, bc) != 1;
     gsl_test(status, "test_memcpy: _memcpy M=%zu N=%zu compressed column format", M, N);
 
+    ar = gsl_spmatrix_comprow(at);
+    br = gsl_spmatrix_alloc_nzmax(M, N, ar->nzmax, GSL_SPMATRIX_CRS);
+    gsl_spmatrix_memcpy(br, ar);
+
+    status = gsl_spmatrix_equal(ar, br) != 1;
+    gsl_test(status, "test_memcpy: _memcpy M=%zu N=%zu compressed row format", M, N);
+
     gsl_spmatrix_free(at);
     gsl_spmatrix_free(ac);
+    gsl_spmatrix_free(ar);
     gsl_spmatrix_free(bt);
     gsl_spmatrix_free(bc);
+    gsl_spmatrix_free(br);
   }
 
   /* test transpose_memcpy */
@@ -225,10 +238,13 @@ test_memcpy(const size_t M, const size_t N, const gsl_rng *r)
     gsl_spmatrix *B = gsl_spmatrix_compcol(A);
     gsl_spmatrix *AT = gsl_spmatrix_alloc(N, M);
     gsl_spmatrix *BT = gsl_spmatrix_alloc_nzmax(N, M, 1, GSL_SPMATRIX_CCS);
+    gsl_spmatrix *C = gsl_spmatrix_comprow(A);
+    gsl_spmatrix *CT = gsl_spmatrix_alloc_nzmax(N, M, 1, GSL_SPMATRIX_CRS);
     size_t i, j;
 
     gsl_spmatrix_transpose_memcpy(AT, A);
     gsl_spmatrix_transpose_memcpy(BT, B);
+    gsl_spmatrix_transpose_memcpy(CT, C);
 
     status = 0;
     for (i = 0; i < M; ++i)
@@ -239,8 +255,10 @@ test_memcpy(const size_t M, const size_t N, const gsl_rng *r)
             double ATji = gsl_spmatrix_get(AT, j, i);
             double Bij = gsl_spmatrix_get(B, i, j);
             double BTji = gsl_spmatrix_get(BT, j, i);
+            double CTji = gsl_spmatrix_get(CT, j, i);
 
-            if ((Aij != ATji) || (Bij != BTji) || (Aij != Bij))
+            if ((Aij != ATji) || (Bij != BTji) || (Aij != Bij) ||
+                (Aij != CTji))
               status = 1;
           }
       }
@@ -251,6 +269,57 @@ test_memcpy(const size_t M, const size_t N, const gsl_rng *r)
     gsl_spmatrix_free(AT);
     gsl_spmatrix_free(B);
     gsl_spmatrix_free(BT);
+    gsl_spmatrix_free(C);
+    gsl_spmatrix_free(CT);
+  }
+
+  /* test switch_major */
+  {
+    gsl_spmatrix *A = create_random_sparse(M, N, 0.3, r);
+    gsl_spmatrix *B = gsl_spmatrix_compcol(A);
+    gsl_spmatrix *C = gsl_spmatrix_comprow(A);
+    gsl_spmatrix *BR = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
+    gsl_spmatrix *CC = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CCS);
+    gsl_spmatrix *CR = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
+    gsl_spmatrix *BC = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CCS);
+
+    /* CCS -> CRS, CRS -> CCS and back again */
+    gsl_spmatrix_switch_major(BR, B);
+    gsl_spmatrix_switch_major(CC, C);
+    gsl_spmatrix_switch_major(CR, CC);
+    gsl_spmatrix_switch_major(BC, BR);
+
+    /* results have sorted indices, so the different paths must agree exactly */
+    status = (gsl_spmatrix_equal(BR, CR) != 1) ||
+             (gsl_spmatrix_equal(BC, CC) != 1);
+    gsl_test(status, "test_memcpy: _switch_major M=%zu N=%zu sorted", M, N);
+
+    status = 0;
+    {
+      size_t i, j;
+
+      for (i = 0; i < M; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              double Aij = gsl_spmatrix_get(A, i, j);
+
+              if (Aij != gsl_spmatrix_get(BR, i, j) ||
+                  Aij != gsl_spmatrix_get(CC, i, j))
+                status = 1;
+            }
+        }
+    }
+
+    gsl_test(status, "test_memcpy: _switch_major M=%zu N=%zu", M, N);
+
+    gsl_spmatrix_free(A);
+    gsl_spmatrix_free(B);
+    gsl_spmatrix_free(C);
+    gsl_spmatrix_free(BR);
+    gsl_spmatrix_free(CC);
+    gsl_spmatrix_free(CR);
+    gsl_spmatrix_free(BC);
   }
 } /* test_memcpy() */
 
@@ -292,8 +361,818 @@ test_ops(const size_t M, const size_t N, const gsl_rng *r)
     gsl_spmatrix_free(b);
     gsl_spmatrix_free(c);
   }
+
+  /* test gsl_spmatrix_add in compressed row format */
+  {
+    gsl_spmatrix *Ta = create_random_sparse(M, N, 0.2, r);
+    gsl_spmatrix *Tb = create_random_sparse(M, N, 0.2, r);
+    gsl_spmatrix *a = gsl_spmatrix_comprow(Ta);
+    gsl_spmatrix *b = gsl_spmatrix_comprow(Tb);
+    gsl_spmatrix *c = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
+    
+    gsl_spmatrix_add(c, a, b);
+
+    status = 0;
+    for (i = 0; i < M; ++i)
+      {
+        for (j = 0; j < N; ++j)
+          {
+            double aij = gsl_spmatrix_get(Ta, i, j);
+            double bij = gsl_spmatrix_get(Tb, i, j);
+            double cij = gsl_spmatrix_get(c, i, j);
+
+            if (aij + bij != cij)
+              status = 1;
+          }
+      }
+
+    gsl_test(status, "test_ops: _add M=%zu N=%zu compressed row format", M, N);
+
+    gsl_spmatrix_free(Ta);
+    gsl_spmatrix_free(Tb);
+    gsl_spmatrix_free(a);
+    gsl_spmatrix_free(b);
+    gsl_spmatrix_free(c);
+  }
+
+  /* test gsl_spmatrix_sp2d for all formats */
+  {
+    gsl_spmatrix *T = create_random_sparse(M, N, 0.2, r);
+    gsl_spmatrix *C = gsl_spmatrix_compcol(T);
+    gsl_spmatrix *R = gsl_spmatrix_comprow(T);
+    gsl_matrix *At = gsl_matrix_alloc(M, N);
+    gsl_matrix *Ac = gsl_matrix_alloc(M, N);
+    gsl_matrix *Ar = gsl_matrix_alloc(M, N);
+
+    gsl_spmatrix_sp2d(At, T);
+    gsl_spmatrix_sp2d(Ac, C);
+    gsl_spmatrix_sp2d(Ar, R);
+
+    status = 0;
+    for (i = 0; i < M; ++i)
+      {
+        for (j = 0; j < N; ++j)
+          {
+            double Tij = gsl_spmatrix_get(T, i, j);
+
+            if (gsl_matrix_get(At, i, j) != Tij ||
+                gsl_matrix_get(Ac, i, j) != Tij ||
+                gsl_matrix_get(Ar, i, j) != Tij)
+              status = 1;
+          }
+      }
+
+    gsl_test(status, "test_ops: _sp2d M=%zu N=%zu", M, N);
+
+    gsl_spmatrix_free(T);
+    gsl_spmatrix_free(C);
+    gsl_spmatrix_free(R);
+    gsl_matrix_free(At);
+    gsl_matrix_free(Ac);
+    gsl_matrix_free(Ar);
+  }
 } /* test_ops() */
 
+static void
+test_assemble(const size_t M, const size_t N, const gsl_rng *r)
+{
+  /* rows are drawn from the first tenth of the matrix, so that each
+   occupied element receives about 3 triplets on average */
+  const size_t nz = 3 * M * N / 10 + 1;
+  size_t *ti = malloc(nz * sizeof(size_t));
+  size_t *tj = malloc(nz * sizeof(size_t));
+  double *tx = malloc(nz * sizeof(double));
+  gsl_matrix *D = gsl_matrix_calloc(M, N);
+  gsl_spmatrix *C, *R, *CR;
+  size_t i, j, k, p;
+  int status;
+
+  for (k = 0; k < nz; ++k)
+    {
+      ti[k] = gsl_rng_uniform(r) * M / 10;
+      tj[k] = gsl_rng_uniform(r) * N;
+      tx[k] = gsl_rng_uniform(r);
+
+      /* expected sum of duplicates */
+      *gsl_matrix_ptr(D, ti[k], tj[k]) += tx[k];
+    }
+
+  C = gsl_spmatrix_assemble(M, N, nz, ti, tj, tx, GSL_SPMATRIX_CCS);
+  R = gsl_spmatrix_assemble(M, N, nz, ti, tj, tx, GSL_SPMATRIX_CRS);
+
+  status = 0;
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double Dij = gsl_matrix_get(D, i, j);
+
+          if (fabs(gsl_spmatrix_get(C, i, j) - Dij) > 1.0e-12 ||
+              fabs(gsl_spmatrix_get(R, i, j) - Dij) > 1.0e-12)
+            status = 1;
+        }
+    }
+
+  gsl_test(status, "test_assemble: M=%zu N=%zu summed duplicates", M, N);
+
+  /* inner indices must be strictly increasing within each column/row */
+  status = 0;
+  for (j = 0; j < N; ++j)
+    {
+      for (p = C->p[j] + 1; p < C->p[j + 1]; ++p)
+        status |= (C->i[p - 1] >= C->i[p]);
+    }
+
+  for (i = 0; i < M; ++i)
+    {
+      for (p = R->p[i] + 1; p < R->p[i + 1]; ++p)
+        status |= (R->i[p - 1] >= R->i[p]);
+    }
+
+  gsl_test(status, "test_assemble: M=%zu N=%zu sorted indices", M, N);
+
+  /* both formats must describe the same matrix */
+  CR = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
+  gsl_spmatrix_switch_major(CR, C);
+
+  status = (gsl_spmatrix_nnz(C) != gsl_spmatrix_nnz(R)) ||
+           (gsl_spmatrix_equal(CR, R) != 1);
+  gsl_test(status, "test_assemble: M=%zu N=%zu CCS/CRS agree", M, N);
+
+  free(ti);
+  free(tj);
+  free(tx);
+  gsl_matrix_free(D);
+  gsl_spmatrix_free(C);
+  gsl_spmatrix_free(R);
+  gsl_spmatrix_free(CR);
+} /* test_assemble() */
+
+/* check that two compressed matrices have identical arrays */
+static int
+test_compress_same(const gsl_spmatrix *a, const gsl_spmatrix *b)
+{
+  const size_t n = GSL_SPMATRIX_ISCCS(a) ? a->size2 : a->size1;
+  size_t k;
+
+  if (a->sptype != b->sptype || a->nz != b->nz)
+    return 1;
+
+  for (k = 0; k <= n; ++k)
+    {
+      if (a->p[k] != b->p[k])
+        return 1;
+    }
+
+  for (k = 0; k < a->nz; ++k)
+    {
+      if (a->i[k] != b->i[k] || a->data[k] != b->data[k])
+        return 1;
+    }
+
+  return 0;
+}
+
+/*
+test_compress()
+  Test the triplet to compressed conversion and the transpose with
+caller provided work arrays, against the serial versions (one
+histogram) and against the elements of the triplet matrix
+*/
+
+static void
+test_compress(const size_t M, const size_t N, const double density,
+              const gsl_rng *r)
+{
+  gsl_spmatrix *T = create_random_sparse(M, N, density, r);
+  const size_t lwork = gsl_spmatrix_compress_worksize(GSL_MAX(M, N));
+  size_t *work = malloc(lwork * sizeof(size_t));
+  size_t k, f;
+  int status;
+
+  for (f = 0; f < 2; ++f)
+    {
+      const size_t sptype = f ? GSL_SPMATRIX_CRS : GSL_SPMATRIX_CCS;
+      const size_t n = f ? M : N;    /* outer dimension */
+      const size_t nt = f ? N : M;   /* outer dimension of transpose */
+      gsl_spmatrix *A = gsl_spmatrix_alloc_nzmax(M, N, 1, sptype);
+      gsl_spmatrix *B = gsl_spmatrix_alloc_nzmax(M, N, 1, sptype);
+      gsl_spmatrix *AT = gsl_spmatrix_alloc_nzmax(N, M, 1, sptype);
+      gsl_spmatrix *BT = gsl_spmatrix_alloc_nzmax(N, M, 1, sptype);
+      gsl_spmatrix *S = gsl_spmatrix_alloc_nzmax(M, N, 1,
+                                                 f ? GSL_SPMATRIX_CCS :
+                                                 GSL_SPMATRIX_CRS);
+      gsl_spmatrix *S2 = gsl_spmatrix_alloc_nzmax(M, N, 1,
+                                                  f ? GSL_SPMATRIX_CCS :
+                                                  GSL_SPMATRIX_CRS);
+
+      /* parallel and serial conversions give the same arrays */
+      status = gsl_spmatrix_compress_work(A, T, work, lwork);
+      status |= gsl_spmatrix_compress_work(B, T, work, n);
+      status |= test_compress_same(A, B);
+      gsl_test(status, "test_compress: M=%zu N=%zu format=%zu work",
+               M, N, f);
+
+      status = 0;
+      for (k = 0; k < T->nz; ++k)
+        status |= gsl_spmatrix_get(A, T->i[k], T->p[k]) != T->data[k];
+
+      gsl_test(status, "test_compress: M=%zu N=%zu format=%zu values",
+               M, N, f);
+
+      /* transpose */
+      status = gsl_spmatrix_transpose_memcpy_work(AT, A, work, lwork);
+      status |= gsl_spmatrix_transpose_memcpy_work(BT, A, work, nt);
+      status |= test_compress_same(AT, BT);
+
+      for (k = 0; k < T->nz; ++k)
+        status |= gsl_spmatrix_get(AT, T->p[k], T->i[k]) != T->data[k];
+
+      gsl_test(status, "test_compress: M=%zu N=%zu format=%zu transpose",
+               M, N, f);
+
+      gsl_spmatrix_transpose_memcpy(BT, A);
+      status = test_compress_same(AT, BT);
+      gsl_test(status, "test_compress: M=%zu N=%zu format=%zu transpose_memcpy",
+               M, N, f);
+
+      /* switch major, which sorts the inner indices */
+      status = gsl_spmatrix_switch_major_work(S, A, work, lwork);
+      gsl_spmatrix_switch_major(S2, A);
+      status |= test_compress_same(S, S2);
+
+      for (k = 0; k < T->nz; ++k)
+        status |= gsl_spmatrix_get(S, T->i[k], T->p[k]) != T->data[k];
+
+      for (k = 0; k < nt; ++k)
+        {
+          size_t p;
+
+          for (p = S->p[k] + 1; p < S->p[k + 1]; ++p)
+            status |= (S->i[p - 1] >= S->i[p]);
+        }
+
+      gsl_test(status, "test_compress: M=%zu N=%zu format=%zu switch_major",
+               M, N, f);
+
+      /* work arrays must hold at least one histogram */
+      if (n > 1)
+        {
+          gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
+
+          status = gsl_spmatrix_compress_work(B, T, work, n - 1);
+          gsl_test(status != GSL_EBADLEN,
+                   "test_compress: M=%zu N=%zu format=%zu short work",
+                   M, N, f);
+
+          status = gsl_spmatrix_compress_work(T, T, work, lwork);
+          gsl_test(status != GSL_EINVAL,
+                   "test_compress: M=%zu N=%zu format=%zu triplet dest",
+                   M, N, f);
+
+          gsl_set_error_handler(old_handler);
+        }
+
+      gsl_spmatrix_free(A);
+      gsl_spmatrix_free(B);
+      gsl_spmatrix_free(AT);
+      gsl_spmatrix_free(BT);
+      gsl_spmatrix_free(S);
+      gsl_spmatrix_free(S2);
+    }
+
+  gsl_spmatrix_free(T);
+  free(work);
+} /* test_compress() */
+
+static void
+test_sell(const size_t M, const size_t N, const size_t C,
+          const size_t sigma, const gsl_rng *r)
+{
+  gsl_spmatrix *T = create_random_sparse(M, N, 0.2, r);
+  gsl_spmatrix *A = gsl_spmatrix_compcol(T);
+  gsl_spmatrix *S[3], *S2;
+  gsl_matrix *D = gsl_matrix_alloc(M, N);
+  gsl_matrix *DS = gsl_matrix_alloc(M, N);
+  size_t i, j, k, s;
+  double min, max, smin, smax;
+  int status;
+
+  /* irregular row lengths: make the first row dense */
+  for (j = 0; j < N; ++j)
+    gsl_spmatrix_set(T, 0, j, 1.0 + j);
+
+  gsl_spmatrix_free(A);
+  A = gsl_spmatrix_compcol(T);
+
+  S[0] = gsl_spmatrix_sell(T, C, sigma);
+  S[1] = gsl_spmatrix_sell(A, C, sigma);
+  S2 = gsl_spmatrix_comprow(T);
+  S[2] = gsl_spmatrix_sell(S2, C, sigma);
+  gsl_spmatrix_free(S2);
+
+  gsl_spmatrix_sp2d(D, T);
+
+  for (k = 0; k < 3; ++k)
+    {
+      status = gsl_spmatrix_nnz(S[k]) != gsl_spmatrix_nnz(T);
+      gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu [%zu] nnz",
+               M, N, C, sigma, k);
+
+      status = 0;
+      for (i = 0; i < M; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            status |= (gsl_spmatrix_get(S[k], i, j) != gsl_matrix_get(D, i, j));
+        }
+
+      gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu [%zu] get",
+               M, N, C, sigma, k);
+
+      gsl_spmatrix_sp2d(DS, S[k]);
+      status = !gsl_matrix_equal(D, DS);
+      gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu [%zu] sp2d",
+               M, N, C, sigma, k);
+
+      /* rows within each window are sorted by decreasing length */
+      status = 0;
+      for (s = 1; s < M; ++s)
+        {
+          if (sigma > 1 && s % sigma != 0)
+            status |= (S[k]->rowlen[s] > S[k]->rowlen[s - 1]);
+        }
+
+      gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu [%zu] sorted",
+               M, N, C, sigma, k);
+    }
+
+  /* copies, including into a matrix of a different slice height */
+  S2 = gsl_spmatrix_sell(A, 1, 1);
+  gsl_spmatrix_memcpy(S2, S[0]);
+  status = !gsl_spmatrix_equal(S2, S[1]) || !gsl_spmatrix_equal(S[1], S2);
+  gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu memcpy",
+           M, N, C, sigma);
+
+  /* padding must not take part in min/max or scaling */
+  gsl_spmatrix_minmax(T, &min, &max);
+  gsl_spmatrix_minmax(S[0], &smin, &smax);
+  status = (min != smin) || (max != smax);
+  gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu minmax",
+           M, N, C, sigma);
+
+  gsl_spmatrix_scale(S[0], 2.0);
+  gsl_spmatrix_sp2d(DS, S[0]);
+  gsl_matrix_scale(D, 2.0);
+  status = !gsl_matrix_equal(D, DS);
+  /* S2 is a copy of S[0] with the same layout, padding included */
+  for (k = 0; k < S[0]->p[gsl_spmatrix_sell_nslices(S[0])]; ++k)
+    {
+      status |= (S[0]->data[k] != 2.0 * S2->data[k]);
+    }
+
+  gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu scale",
+           M, N, C, sigma);
+
+  gsl_spmatrix_set_zero(S[1]);
+  gsl_spmatrix_sp2d(DS, S[1]);
+  status = !gsl_matrix_isnull(DS) || (gsl_spmatrix_get(S[1], 0, 0) != 0.0);
+  gsl_test(status, "test_sell: M=%zu N=%zu C=%zu sigma=%zu set_zero",
+           M, N, C, sigma);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(S[0]);
+  gsl_spmatrix_free(S[1]);
+  gsl_spmatrix_free(S[2]);
+  gsl_spmatrix_free(S2);
+  gsl_matrix_free(D);
+  gsl_matrix_free(DS);
+} /* test_sell() */
+
+/* create the 5-point Laplacian on an n-by-n grid in compressed column format */
+static gsl_spmatrix *
+create_poisson2d(const size_t n)
+{
+  const size_t N = n * n;
+  gsl_spmatrix *T = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *A;
+  size_t i, j;
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < n; ++j)
+        {
+          size_t k = i * n + j;
+
+          gsl_spmatrix_set(T, k, k, 4.0);
+
+          if (j > 0)
+            gsl_spmatrix_set(T, k, k - 1, -1.0);
+          if (j < n - 1)
+            gsl_spmatrix_set(T, k, k + 1, -1.0);
+          if (i > 0)
+            gsl_spmatrix_set(T, k, k - n, -1.0);
+          if (i < n - 1)
+            gsl_spmatrix_set(T, k, k + n, -1.0);
+        }
+    }
+
+  A = gsl_spmatrix_compcol(T);
+  gsl_spmatrix_free(T);
+
+  return A;
+}
+
+/* bandwidth max |i - j| of a compressed column matrix */
+static size_t
+order_bandwidth(const gsl_spmatrix *A)
+{
+  size_t j, p, bw = 0;
+
+  for (j = 0; j < A->size2; ++j)
+    {
+      for (p = A->p[j]; p < A->p[j + 1]; ++p)
+        {
+          size_t i = A->i[p];
+          bw = GSL_MAX(bw, (i > j) ? i - j : j - i);
+        }
+    }
+
+  return bw;
+}
+
+/* number of non-zeros in the Cholesky factor of a symmetric pattern,
+ * by eliminating on a dense boolean copy */
+static size_t
+order_fill(const gsl_spmatrix *A)
+{
+  const size_t N = A->size1;
+  unsigned char *D = calloc(N * N, 1);
+  size_t i, j, k, p, nnz = 0;
+
+  for (j = 0; j < N; ++j)
+    {
+      for (p = A->p[j]; p < A->p[j + 1]; ++p)
+        D[A->i[p] * N + j] = D[j * N + A->i[p]] = 1;
+    }
+
+  for (k = 0; k < N; ++k)
+    {
+      for (i = k; i < N; ++i)
+        {
+          if (!D[i * N + k] && i != k)
+            continue;
+
+          ++nnz;
+
+          for (j = k + 1; j <= i && i != k; ++j)
+            {
+              if (D[j * N + k])
+                D[i * N + j] = D[j * N + i] = 1;
+            }
+        }
+    }
+
+  free(D);
+
+  return nnz;
+}
+
+static void
+test_order(const size_t n, const gsl_rng *r)
+{
+  const size_t N = n * n;
+  gsl_spmatrix *A = create_poisson2d(n);
+  gsl_spmatrix *B = gsl_spmatrix_alloc_nzmax(N, N, 1, GSL_SPMATRIX_CCS);
+  gsl_spmatrix *C = gsl_spmatrix_alloc_nzmax(N, N, 1, GSL_SPMATRIX_CCS);
+  gsl_spmatrix *AR, *BR, *T;
+  gsl_permutation *perm = gsl_permutation_alloc(N);
+  gsl_permutation *q = gsl_permutation_alloc(N);
+  size_t i, j, p, bw_scrambled, fill_natural, fill_scrambled;
+  int status;
+
+  /* random symmetric permutation of the grid ordering */
+  gsl_permutation_init(perm);
+  for (i = N - 1; i > 0; --i)
+    gsl_permutation_swap(perm, i, gsl_rng_uniform_int(r, i + 1));
+
+  status = gsl_spmatrix_permute_sym(A, perm, B);
+  gsl_test(status, "test_order: n=%zu permute_sym status", n);
+
+  status = (gsl_spmatrix_nnz(B) != gsl_spmatrix_nnz(A));
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double bij = gsl_spmatrix_get(B, i, j);
+          double aij = gsl_spmatrix_get(A, gsl_permutation_get(perm, i),
+                                        gsl_permutation_get(perm, j));
+          status |= (aij != bij);
+        }
+    }
+
+  for (j = 0; j < N; ++j)
+    {
+      for (p = B->p[j] + 1; p < B->p[j + 1]; ++p)
+        status |= (B->i[p] <= B->i[p - 1]);
+    }
+
+  gsl_test(status, "test_order: n=%zu permute_sym CCS", n);
+
+  /* compressed row storage */
+  AR = gsl_spmatrix_alloc_nzmax(N, N, gsl_spmatrix_nnz(A), GSL_SPMATRIX_CRS);
+  BR = gsl_spmatrix_alloc_nzmax(N, N, 1, GSL_SPMATRIX_CRS);
+  gsl_spmatrix_switch_major(AR, A);
+  gsl_spmatrix_permute_sym(AR, perm, BR);
+  gsl_spmatrix_switch_major(C, BR);
+  status = !gsl_spmatrix_equal(B, C);
+  gsl_test(status, "test_order: n=%zu permute_sym CRS", n);
+
+  bw_scrambled = order_bandwidth(B);
+  fill_natural = order_fill(A);
+  fill_scrambled = order_fill(B);
+
+  /* RCM recovers a band of width about n */
+  status = gsl_spmatrix_order_rcm(B, q);
+  status |= gsl_permutation_valid(q);
+  gsl_test(status, "test_order: n=%zu rcm valid", n);
+
+  gsl_spmatrix_permute_sym(B, q, C);
+  status = (order_bandwidth(C) > GSL_MIN(2 * n, bw_scrambled));
+  gsl_test(status, "test_order: n=%zu rcm bandwidth %zu scrambled %zu",
+           n, order_bandwidth(C), bw_scrambled);
+
+  /* AMD needs less fill than the natural and scrambled orderings */
+  status = gsl_spmatrix_order_amd(B, q);
+  status |= gsl_permutation_valid(q);
+  gsl_test(status, "test_order: n=%zu amd valid", n);
+
+  gsl_spmatrix_permute_sym(B, q, C);
+  status = (order_fill(C) > GSL_MIN(fill_natural, fill_scrambled));
+  gsl_test(status, "test_order: n=%zu amd fill %zu natural %zu scrambled %zu",
+           n, order_fill(C), fill_natural, fill_scrambled);
+
+  gsl_spmatrix_free(AR);
+  gsl_spmatrix_free(BR);
+
+  /* unsymmetric triplet input with empty rows and several components */
+  T = create_random_sparse(N, N, 1.0 / N, r);
+
+  status = gsl_spmatrix_order_rcm(T, q);
+  status |= gsl_permutation_valid(q);
+  gsl_test(status, "test_order: n=%zu rcm random", n);
+
+  status = gsl_spmatrix_order_amd(T, q);
+  status |= gsl_permutation_valid(q);
+  gsl_test(status, "test_order: n=%zu amd random", n);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_spmatrix_free(C);
+  gsl_permutation_free(perm);
+  gsl_permutation_free(q);
+} /* test_order() */
+
+static void
+test_io_compare(const gsl_spmatrix *A, const gsl_matrix *D,
+                const char *desc, const size_t M, const size_t N)
+{
+  gsl_matrix *DA = gsl_matrix_alloc(M, N);
+  int status;
+
+  gsl_spmatrix_sp2d(DA, A);
+  status = !gsl_matrix_equal(D, DA);
+  gsl_test(status, "test_io: M=%zu N=%zu %s", M, N, desc);
+
+  gsl_matrix_free(DA);
+}
+
+static void
+test_io(const size_t M, const size_t N, const double density,
+        const gsl_rng *r)
+{
+  gsl_spmatrix *T = create_random_sparse(M, N, density, r);
+  gsl_spmatrix *A = gsl_spmatrix_compcol(T);
+  gsl_spmatrix *R = gsl_spmatrix_comprow(T);
+  gsl_spmatrix *S = gsl_spmatrix_sell(R, 4, 8);
+  gsl_spmatrix *in[4], *B;
+  gsl_matrix *D = gsl_matrix_alloc(M, N);
+  gsl_error_handler_t *old_handler;
+  const size_t sptype[3] = { GSL_SPMATRIX_TRIPLET, GSL_SPMATRIX_CCS,
+                             GSL_SPMATRIX_CRS };
+  size_t k, l;
+  FILE *f;
+  int status;
+
+  gsl_spmatrix_sp2d(D, T);
+
+  in[0] = T;
+  in[1] = A;
+  in[2] = R;
+  in[3] = S;
+
+  /* Matrix Market round trips between all formats */
+  for (k = 0; k < 4; ++k)
+    {
+      f = fopen("test.txt", "w");
+      gsl_spmatrix_fprintf(f, in[k], "%.18g");
+      fclose(f);
+
+      for (l = 0; l < 3; ++l)
+        {
+          f = fopen("test.txt", "r");
+          B = gsl_spmatrix_fscanf(f, sptype[l]);
+          fclose(f);
+
+          status = (B == NULL) || (B->sptype != sptype[l]) ||
+                   (gsl_spmatrix_nnz(B) != gsl_spmatrix_nnz(T));
+          gsl_test(status, "test_io: M=%zu N=%zu fscanf [%zu,%zu]",
+                   M, N, k, l);
+
+          if (B)
+            {
+              test_io_compare(B, D, "fscanf values", M, N);
+              gsl_spmatrix_free(B);
+            }
+        }
+    }
+
+  /* binary round trips */
+  for (k = 1; k < 3; ++k)
+    {
+      f = fopen("test.dat", "wb");
+      status = gsl_spmatrix_fwrite(f, in[k]);
+      fclose(f);
+      gsl_test(status, "test_io: M=%zu N=%zu fwrite [%zu]", M, N, k);
+
+      B = gsl_spmatrix_alloc_nzmax(M, N, 1, in[k]->sptype);
+      f = fopen("test.dat", "rb");
+      status = gsl_spmatrix_fread(f, B);
+      fclose(f);
+      status |= !gsl_spmatrix_equal(B, in[k]);
+      gsl_test(status, "test_io: M=%zu N=%zu fread [%zu]", M, N, k);
+      gsl_spmatrix_free(B);
+
+      B = gsl_spmatrix_mmap("test.dat");
+      status = (B == NULL) || !gsl_spmatrix_equal(B, in[k]);
+      gsl_test(status, "test_io: M=%zu N=%zu mmap [%zu]", M, N, k);
+
+      /* the mapping is private, and realloc moves it to memory */
+      gsl_spmatrix_scale(B, 2.0);
+      gsl_spmatrix_realloc(2 * gsl_spmatrix_nnz(B) + 1, B);
+      gsl_spmatrix_scale(B, 0.5);
+      status = !gsl_spmatrix_equal(B, in[k]) || (B->map != NULL);
+      gsl_test(status, "test_io: M=%zu N=%zu mmap realloc [%zu]", M, N, k);
+      gsl_spmatrix_free(B);
+
+      B = gsl_spmatrix_mmap("test.dat");
+      status = !gsl_spmatrix_equal(B, in[k]);
+      gsl_test(status, "test_io: M=%zu N=%zu mmap unchanged [%zu]", M, N, k);
+      gsl_spmatrix_free(B);
+    }
+
+  /* reading into a matrix of another format fails */
+  old_handler = gsl_set_error_handler_off();
+
+  B = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CCS);
+  f = fopen("test.dat", "rb");
+  status = gsl_spmatrix_fread(f, B) != GSL_EINVAL;
+  fclose(f);
+  gsl_test(status, "test_io: M=%zu N=%zu fread format mismatch", M, N);
+  gsl_spmatrix_free(B);
+
+  /* corrupted files are rejected; test.dat holds R in CRS format */
+  if (gsl_spmatrix_nnz(R) > 0)
+    {
+      const size_t off_nz = 8 + 4 * sizeof(size_t);
+      const size_t off_i = (8 + 5 * sizeof(size_t) + 63) / 64 * 64 +
+                           ((M + 1) * sizeof(size_t) + 63) / 64 * 64;
+      size_t x = N;
+
+      f = fopen("test.dat", "r+b");
+      fseek(f, (long) off_i, SEEK_SET);
+      fwrite(&x, sizeof(size_t), 1, f);
+      fclose(f);
+
+      B = gsl_spmatrix_mmap("test.dat");
+      status = (B != NULL);
+      gsl_test(status, "test_io: M=%zu N=%zu mmap invalid index", M, N);
+      if (B)
+        gsl_spmatrix_free(B);
+
+      B = gsl_spmatrix_alloc_nzmax(M, N, 1, GSL_SPMATRIX_CRS);
+      f = fopen("test.dat", "rb");
+      status = gsl_spmatrix_fread(f, B) != GSL_EINVAL;
+      fclose(f);
+      gsl_test(status, "test_io: M=%zu N=%zu fread invalid index", M, N);
+      gsl_spmatrix_free(B);
+
+      x = ((size_t) -1) / 2;
+      f = fopen("test.dat", "r+b");
+      fseek(f, (long) off_nz, SEEK_SET);
+      fwrite(&x, sizeof(size_t), 1, f);
+      fclose(f);
+
+      B = gsl_spmatrix_mmap("test.dat");
+      status = (B != NULL);
+      gsl_test(status, "test_io: M=%zu N=%zu mmap invalid nz", M, N);
+      if (B)
+        gsl_spmatrix_free(B);
+    }
+
+  status = gsl_spmatrix_fwrite(stdout, T) != GSL_EINVAL;
+  gsl_test(status, "test_io: M=%zu N=%zu fwrite triplet", M, N);
+
+  gsl_set_error_handler(old_handler);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(R);
+  gsl_spmatrix_free(S);
+  gsl_matrix_free(D);
+} /* test_io() */
+
+static void
+test_io_mm(void)
+{
+  const char *text[] = {
+    "%%MatrixMarket matrix coordinate real symmetric\n"
+    "% comment\n"
+    "\n"
+    "3 3 4\n"
+    "1 1 2.0\n"
+    "2 1 -1e0\n"
+    "\n"
+    "3 2 -1.5\n"
+    "3 3 4\n",
+    "%%MatrixMarket matrix coordinate pattern skew-symmetric\n"
+    "3 3 2\n"
+    "2 1\n"
+    "3 2\n",
+    "%%MatrixMarket matrix coordinate integer general\n"
+    "3 3 2\n"
+    "1 3 7\n"
+    "4 1 1\n",
+    "%%MatrixMarket matrix coordinate real general\n"
+    "3 3 3\n"
+    "1 1 1.0\n",
+    "%%MatrixMarket matrix array real general\n"
+    "1 1\n"
+    "1.0\n",
+    "%%MatrixMarket matrix coordinate real symmetric\n"
+    "3 3 9223372036854775808\n"
+    "1 1 1.0\n"
+  };
+  const double expected[2][9] = {
+    { 2.0, -1.0, 0.0, -1.0, 0.0, -1.5, 0.0, -1.5, 4.0 },
+    { 0.0, -1.0, 0.0, 1.0, 0.0, -1.0, 0.0, 1.0, 0.0 }
+  };
+  gsl_error_handler_t *old_handler;
+  gsl_spmatrix *B;
+  size_t k, i, j;
+  FILE *f;
+  int status;
+
+  for (k = 0; k < 6; ++k)
+    {
+      f = fopen("test.txt", "w");
+      fputs(text[k], f);
+      fclose(f);
+
+      f = fopen("test.txt", "r");
+
+      if (k < 2)
+        {
+          B = gsl_spmatrix_fscanf(f, GSL_SPMATRIX_CCS);
+
+          status = (B == NULL);
+          for (i = 0; B && i < 3; ++i)
+            {
+              for (j = 0; j < 3; ++j)
+                status |= (gsl_spmatrix_get(B, i, j) != expected[k][3 * i + j]);
+            }
+
+          gsl_test(status, "test_io_mm: file %zu", k);
+        }
+      else
+        {
+          /* out of range index, wrong count, array format, count
+             too large for the input */
+          old_handler = gsl_set_error_handler_off();
+          B = gsl_spmatrix_fscanf(f, GSL_SPMATRIX_TRIPLET);
+          gsl_set_error_handler(old_handler);
+
+          gsl_test(B != NULL, "test_io_mm: invalid file %zu", k);
+        }
+
+      fclose(f);
+
+      if (B)
+        gsl_spmatrix_free(B);
+    }
+} /* test_io_mm() */
+
 int
 main()
 {
@@ -314,6 +1193,33 @@ main()
   test_ops(20, 50, r);
   test_ops(76, 43, r);
 
+  test_assemble(20, 20, r);
+  test_assemble(50, 20, r);
+  test_assemble(20, 50, r);
+  test_assemble(300, 7, r);
+
+  test_compress(20, 20, 0.2, r);
+  test_compress(37, 3, 0.5, r);
+  test_compress(1, 50, 0.5, r);
+  test_compress(2000, 1500, 0.03, r);
+
+  test_sell(20, 20, 4, 8, r);
+  test_sell(37, 15, 8, 32, r);
+  test_sell(53, 70, 1, 1, r);
+  test_sell(101, 40, 16, 1, r);
+  test_sell(5, 90, 64, 128, r);
+
+  test_order(1, r);
+  test_order(5, r);
+  test_order(12, r);
+  test_order(20, r);
+
+  test_io(20, 20, 0.2, r);
+  test_io(53, 17, 0.3, r);
+  test_io(1, 40, 0.5, r);
+  test_io(1000, 900, 0.05, r);
+  test_io_mm();
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
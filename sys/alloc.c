@@ -0,0 +1,359 @@
+/* sys/alloc.c
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_alloc.h>
+
+/*
+ * Every allocation made through gsl_malloc is preceded by a small
+ * header recording the allocator and the base address it returned.
+ * The user pointer is placed ALLOC_OFFSET bytes (or more, for aligned
+ * requests) past the base, so it keeps the alignment of malloc.
+ */
+
+typedef struct
+{
+  const gsl_allocator * allocator;
+  void * base;
+  size_t size;
+} alloc_header;
+
+#define ALLOC_OFFSET    (32)
+#define ARENA_ALIGN     (16)
+
+#define HEADER(p) (((alloc_header *) (p)) - 1)
+
+static void * default_alloc (size_t size, void * params);
+static void default_dealloc (void * ptr, void * params);
+static void * arena_alloc (size_t size, void * params);
+static void arena_dealloc (void * ptr, void * params);
+
+static const gsl_allocator default_allocator =
+{
+  "malloc",
+  &default_alloc,
+  &default_dealloc,
+  NULL
+};
+
+/* allocator of the calling thread, NULL for the default */
+#ifdef GSL_TLS
+static GSL_TLS const gsl_allocator * current_allocator = NULL;
+#else
+static const gsl_allocator * current_allocator = NULL;
+#endif
+
+struct gsl_arena_chunk_struct
+{
+  gsl_arena_chunk * next;
+  size_t size;          /* bytes available in this chunk */
+  size_t used;          /* bytes used in this chunk */
+  char * data;
+};
+
+/*
+gsl_set_allocator()
+  Install the allocator a for all subsequent library allocations
+made by the calling thread, or restore the default allocator if
+a is NULL. Returns the previous allocator.
+*/
+
+const gsl_allocator *
+gsl_set_allocator (const gsl_allocator * a)
+{
+  const gsl_allocator * previous = gsl_get_allocator ();
+
+  current_allocator = (a == &default_allocator) ? NULL : a;
+
+  return previous;
+}
+
+const gsl_allocator *
+gsl_get_allocator (void)
+{
+  return (current_allocator != NULL) ? current_allocator : &default_allocator;
+}
+
+void *
+gsl_malloc_aligned (size_t size, size_t alignment)
+{
+  const gsl_allocator * a = gsl_get_allocator ();
+  size_t extra = ALLOC_OFFSET;
+  char * base;
+  char * p;
+
+  if (alignment > ALLOC_OFFSET)
+    extra += alignment;
+
+  if (size > (size_t) -1 - extra)
+    return NULL;
+
+  base = (char *) (a->alloc) (size + extra, a->params);
+  if (base == NULL)
+    return NULL;
+
+  p = base + ALLOC_OFFSET;
+
+  if (alignment > ALLOC_OFFSET)
+    {
+      size_t r = ((size_t) p) & (alignment - 1);
+
+      if (r != 0)
+        p += alignment - r;
+    }
+
+  HEADER (p)->allocator = a;
+  HEADER (p)->base = base;
+  HEADER (p)->size = size;
+
+  return p;
+}
+
+void *
+gsl_malloc (size_t size)
+{
+  return gsl_malloc_aligned (size, 0);
+}
+
+void *
+gsl_calloc (size_t nmemb, size_t size)
+{
+  void * p;
+
+  if (size != 0 && nmemb > (size_t) -1 / size)
+    return NULL;
+
+  p = gsl_malloc (nmemb * size);
+  if (p != NULL)
+    memset (p, 0, nmemb * size);
+
+  return p;
+}
+
+void *
+gsl_realloc (void * ptr, size_t size)
+{
+  alloc_header h;
+  void * p;
+
+  if (ptr == NULL)
+    return gsl_malloc (size);
+
+  h = *HEADER (ptr);
+
+  if (h.allocator == &default_allocator && h.base == (char *) ptr - ALLOC_OFFSET)
+    {
+      /* let the system resize in place where possible */
+      char * base;
+
+      if (size > (size_t) -1 - ALLOC_OFFSET)
+        return NULL;
+
+      base = (char *) realloc (h.base, size + ALLOC_OFFSET);
+      if (base == NULL)
+        return NULL;
+
+      p = base + ALLOC_OFFSET;
+      HEADER (p)->base = base;
+      HEADER (p)->size = size;
+
+      return p;
+    }
+
+  /* otherwise allocate from the allocator that owns ptr */
+  {
+    const gsl_allocator * previous = current_allocator;
+
+    current_allocator = h.allocator;
+    p = gsl_malloc (size);
+    current_allocator = previous;
+  }
+
+  if (p == NULL)
+    return NULL;
+
+  memcpy (p, ptr, (h.size < size) ? h.size : size);
+  gsl_free (ptr);
+
+  return p;
+}
+
+void
+gsl_free (void * ptr)
+{
+  const gsl_allocator * a;
+
+  if (ptr == NULL)
+    return;
+
+  a = HEADER (ptr)->allocator;
+  (a->dealloc) (HEADER (ptr)->base, a->params);
+}
+
+static void *
+default_alloc (size_t size, void * params)
+{
+  (void) params;
+  return malloc (size);
+}
+
+static void
+default_dealloc (void * ptr, void * params)
+{
+  (void) params;
+  free (ptr);
+}
+
+/*
+gsl_arena_alloc()
+  Allocate an arena whose chunks hold at least chunk_size bytes.
+Chunks are obtained from the system directly, so arenas may be
+created while another arena is installed.
+*/
+
+gsl_arena *
+gsl_arena_alloc (const size_t chunk_size)
+{
+  gsl_arena * a = (gsl_arena *) malloc (sizeof (gsl_arena));
+
+  if (a == NULL)
+    return NULL;
+
+  a->allocator.name = "arena";
+  a->allocator.alloc = &arena_alloc;
+  a->allocator.dealloc = &arena_dealloc;
+  a->allocator.params = a;
+  a->head = NULL;
+  a->current = NULL;
+  a->chunk_size = (chunk_size > 0) ? chunk_size : 65536;
+  a->used = 0;
+
+  return a;
+}
+
+void
+gsl_arena_free (gsl_arena * a)
+{
+  gsl_arena_chunk * c;
+
+  if (a == NULL)
+    return;
+
+  c = a->head;
+  while (c != NULL)
+    {
+      gsl_arena_chunk * next = c->next;
+      free (c);
+      c = next;
+    }
+
+  free (a);
+}
+
+/*
+gsl_arena_reset()
+  Release everything allocated from the arena at once. The chunks
+are kept for reuse, so a reset arena does not touch the system
+allocator again until it outgrows its previous peak.
+*/
+
+void
+gsl_arena_reset (gsl_arena * a)
+{
+  gsl_arena_chunk * c;
+
+  for (c = a->head; c != NULL; c = c->next)
+    c->used = 0;
+
+  a->current = a->head;
+  a->used = 0;
+}
+
+size_t
+gsl_arena_used (const gsl_arena * a)
+{
+  return a->used;
+}
+
+const gsl_allocator *
+gsl_arena_allocator (gsl_arena * a)
+{
+  return &(a->allocator);
+}
+
+static void *
+arena_alloc (size_t size, void * params)
+{
+  gsl_arena * a = (gsl_arena *) params;
+  gsl_arena_chunk * c = a->current;
+  gsl_arena_chunk * last;
+  void * p;
+
+  if (size > (size_t) -1 - ARENA_ALIGN)
+    return NULL;
+
+  size = (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+
+  /* find the next chunk with enough room */
+  while (c != NULL && c->size - c->used < size)
+    c = c->next;
+
+  if (c == NULL)
+    {
+      size_t csize = (size > a->chunk_size) ? size : a->chunk_size;
+      size_t hsize = (sizeof (gsl_arena_chunk) + ARENA_ALIGN - 1)
+                     & ~((size_t) ARENA_ALIGN - 1);
+
+      c = (gsl_arena_chunk *) malloc (hsize + csize);
+      if (c == NULL)
+        return NULL;
+
+      c->next = NULL;
+      c->size = csize;
+      c->used = 0;
+      c->data = (char *) c + hsize;
+
+      /* append to the end of the list */
+      if (a->head == NULL)
+        a->head = c;
+      else
+        {
+          for (last = a->head; last->next != NULL; last = last->next)
+            ;
+          last->next = c;
+        }
+    }
+
+  p = c->data + c->used;
+  c->used += size;
+  a->current = c;
+  a->used += size;
+
+  return p;
+}
+
+static void
+arena_dealloc (void * ptr, void * params)
+{
+  /* memory is reclaimed by gsl_arena_reset */
+  (void) ptr;
+  (void) params;
+}
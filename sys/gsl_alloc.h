@@ -0,0 +1,86 @@
+/* sys/gsl_alloc.h
+ *
+ * Copyright (C) 2016 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_ALLOC_H__
+#define __GSL_ALLOC_H__
+
+#include <stdlib.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/*
+ * Memory allocator used for library objects. The alloc function
+ * must return memory aligned as by malloc, or NULL on failure.
+ * Each allocation records the allocator which provided it, so
+ * gsl_free always releases memory through the right allocator
+ * regardless of the allocator currently installed.
+ */
+typedef struct
+{
+  const char *name;
+  void * (* alloc) (size_t size, void * params);
+  void (* dealloc) (void * ptr, void * params);
+  void * params;
+} gsl_allocator;
+
+const gsl_allocator * gsl_set_allocator (const gsl_allocator * a);
+const gsl_allocator * gsl_get_allocator (void);
+
+void * gsl_malloc (size_t size);
+void * gsl_malloc_aligned (size_t size, size_t alignment);
+void * gsl_calloc (size_t nmemb, size_t size);
+void * gsl_realloc (void * ptr, size_t size);
+void gsl_free (void * ptr);
+
+/*
+ * Arena (bump) allocator: allocations are carved sequentially from
+ * large chunks, individual frees are no-ops, and all memory is
+ * recycled at once by gsl_arena_reset
+ */
+
+typedef struct gsl_arena_chunk_struct gsl_arena_chunk;
+
+typedef struct
+{
+  gsl_allocator allocator;  /* allocator interface to this arena */
+  gsl_arena_chunk * head;   /* list of chunks */
+  gsl_arena_chunk * current; /* chunk currently used for allocation */
+  size_t chunk_size;        /* minimum size of new chunks in bytes */
+  size_t used;              /* bytes handed out since last reset */
+} gsl_arena;
+
+gsl_arena * gsl_arena_alloc (const size_t chunk_size);
+void gsl_arena_free (gsl_arena * a);
+void gsl_arena_reset (gsl_arena * a);
+size_t gsl_arena_used (const gsl_arena * a);
+const gsl_allocator * gsl_arena_allocator (gsl_arena * a);
+
+__END_DECLS
+
+#endif /* __GSL_ALLOC_H__ */
@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_test.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_ieee_utils.h>
 
 int
@@ -678,5 +679,78 @@ main (void)
     gsl_test_rel (x, 0.5772156649015328606065120900824, 4 * GSL_DBL_EPSILON, "M_EULER");
   }    
 
+  /* allocators */
+
+  {
+    double *x = gsl_malloc (100 * sizeof (double));
+    size_t i;
+
+    gsl_test (x == NULL, "gsl_malloc");
+
+    for (i = 0; i < 100; i++)
+      x[i] = (double) i;
+
+    x = gsl_realloc (x, 1000 * sizeof (double));
+    gsl_test (x == NULL || x[99] != 99.0, "gsl_realloc preserves contents");
+    gsl_free (x);
+  }
+
+  {
+    size_t i, status = 0;
+    char *x = gsl_calloc (37, 3);
+
+    for (i = 0; i < 37 * 3; i++)
+      status |= (x[i] != 0);
+
+    gsl_test (status, "gsl_calloc zero fill");
+    gsl_free (x);
+  }
+
+  {
+    void *x = gsl_malloc_aligned (10, 256);
+    gsl_test (((size_t) x) % 256 != 0, "gsl_malloc_aligned 256");
+    gsl_free (x);
+  }
+
+  {
+    gsl_arena *a = gsl_arena_alloc (1024);
+    const gsl_allocator *prev = gsl_set_allocator (gsl_arena_allocator (a));
+    double *x, *y, *z;
+    size_t used;
+
+    gsl_test (gsl_get_allocator () != gsl_arena_allocator (a),
+              "gsl_set_allocator arena");
+
+    x = gsl_malloc (10 * sizeof (double));
+    y = gsl_malloc (500 * sizeof (double));   /* larger than a chunk */
+    used = gsl_arena_used (a);
+    gsl_test (x == NULL || y == NULL || used == 0, "arena allocation");
+    gsl_test (((size_t) y) % sizeof (double) != 0, "arena alignment");
+
+    y[499] = 1.0;
+    y = gsl_realloc (y, 1000 * sizeof (double));
+    gsl_test (y == NULL || y[499] != 1.0, "arena realloc");
+
+    /* memory from the arena may be freed with another allocator installed */
+    gsl_set_allocator (prev);
+    z = gsl_malloc (10 * sizeof (double));
+    gsl_free (x);
+    gsl_free (y);
+    gsl_free (z);
+    gsl_test (gsl_arena_used (a) < used, "arena free is a no-op");
+
+    gsl_arena_reset (a);
+    gsl_test (gsl_arena_used (a) != 0, "arena reset");
+
+    gsl_set_allocator (gsl_arena_allocator (a));
+    x = gsl_malloc (10 * sizeof (double));
+    gsl_test (x == NULL || gsl_arena_used (a) == 0, "arena reuse after reset");
+    gsl_set_allocator (NULL);
+
+    gsl_test (gsl_get_allocator () != prev, "gsl_set_allocator default");
+
+    gsl_arena_free (a);
+  }
+
   exit (gsl_test_summary ());
 }
@@ -1,6 +1,7 @@
 #include <config.h>
 #include <stdlib.h>
 #include <string.h>
+#include <gsl/gsl_alloc.h>
 #include <gsl/gsl_vector.h>
 
 #define BASE_GSL_COMPLEX_LONG
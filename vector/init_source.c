@@ -29,7 +29,7 @@ FUNCTION (gsl_vector, alloc) (const size_t n)
                         GSL_EINVAL, 0);
     }
 
-  v = (TYPE (gsl_vector) *) malloc (sizeof (TYPE (gsl_vector)));
+  v = (TYPE (gsl_vector) *) gsl_malloc (sizeof (TYPE (gsl_vector)));
 
   if (v == 0)
     {
@@ -41,7 +41,7 @@ FUNCTION (gsl_vector, alloc) (const size_t n)
 
   if (block == 0)
     {
-      free (v) ;
+      gsl_free (v) ;
 
       GSL_ERROR_VAL ("failed to allocate space for block",
                         GSL_ENOMEM, 0);
@@ -101,7 +101,7 @@ FUNCTION (gsl_vector, alloc_from_block) (TYPE(gsl_block) * block,
       GSL_ERROR_VAL ("vector would extend past end of block", GSL_EINVAL, 0);
     }
 
-  v = (TYPE (gsl_vector) *) malloc (sizeof (TYPE (gsl_vector)));
+  v = (TYPE (gsl_vector) *) gsl_malloc (sizeof (TYPE (gsl_vector)));
 
   if (v == 0)
     {
@@ -142,7 +142,7 @@ FUNCTION (gsl_vector, alloc_from_vector) (TYPE(gsl_vector) * w,
       GSL_ERROR_VAL ("vector would extend past end of block", GSL_EINVAL, 0);
     }
 
-  v = (TYPE (gsl_vector) *) malloc (sizeof (TYPE (gsl_vector)));
+  v = (TYPE (gsl_vector) *) gsl_malloc (sizeof (TYPE (gsl_vector)));
 
   if (v == 0)
     {
@@ -169,7 +169,7 @@ FUNCTION (gsl_vector, free) (TYPE (gsl_vector) * v)
     {
       FUNCTION(gsl_block, free) (v->block) ;
     }
-  free (v);
+  gsl_free (v);
 }
 
 
@@ -3,6 +3,38 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 
+/* Find the extremum of the N > 0 elements of unit stride data x,
+   the maximum for cmp = > or the minimum for cmp = <, using four
+   independent accumulators.  nan is set if UNIT_IS_NAN holds for any
+   element. */
+
+#define UNIT_STRIDE_EXTREMUM(x, N, cmp, out, nan)                      \
+  do {                                                                 \
+    const size_t n4_ = (N) - (N) % 4;                                  \
+    BASE m0_ = (x)[0], m1_ = (x)[0], m2_ = (x)[0], m3_ = (x)[0];       \
+    size_t i_;                                                         \
+    for (i_ = 0; i_ < n4_; i_ += 4)                                    \
+      {                                                                \
+        const BASE x0_ = (x)[i_], x1_ = (x)[i_ + 1];                   \
+        const BASE x2_ = (x)[i_ + 2], x3_ = (x)[i_ + 3];               \
+        m0_ = (x0_ cmp m0_) ? x0_ : m0_;                               \
+        m1_ = (x1_ cmp m1_) ? x1_ : m1_;                               \
+        m2_ = (x2_ cmp m2_) ? x2_ : m2_;                               \
+        m3_ = (x3_ cmp m3_) ? x3_ : m3_;                               \
+        (nan) |= UNIT_IS_NAN (x0_) | UNIT_IS_NAN (x1_)                 \
+          | UNIT_IS_NAN (x2_) | UNIT_IS_NAN (x3_);                     \
+      }                                                                \
+    for (; i_ < (N); i_++)                                             \
+      {                                                                \
+        const BASE x0_ = (x)[i_];                                      \
+        m0_ = (x0_ cmp m0_) ? x0_ : m0_;                               \
+        (nan) |= UNIT_IS_NAN (x0_);                                    \
+      }                                                                \
+    m0_ = (m1_ cmp m0_) ? m1_ : m0_;                                   \
+    m2_ = (m3_ cmp m2_) ? m3_ : m2_;                                   \
+    (out) = (m2_ cmp m0_) ? m2_ : m0_;                                 \
+  } while (0)
+
 #define BASE_LONG_DOUBLE
 #include "templates_on.h"
 #include "minmax_source.c"
@@ -17,6 +17,70 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+/* Reductions over unit stride data of length N > 0, using several
+   independent accumulators so that the loops can be vectorized (see
+   UNIT_STRIDE_EXTREMUM in minmax.c).  For floating point types they
+   return a nonzero value if a NaN was seen, in which case the caller
+   falls back to the scalar loop to return the first NaN. */
+
+#ifdef FP
+#define UNIT_IS_NAN(x) ((x) != (x))
+#else
+#define UNIT_IS_NAN(x) 0
+#endif
+
+static int
+FUNCTION(unit,max) (const ATOMIC * x, const size_t N, BASE * max_out)
+{
+  int nan = 0;
+  UNIT_STRIDE_EXTREMUM (x, N, >, *max_out, nan);
+  return nan;
+}
+
+static int
+FUNCTION(unit,min) (const ATOMIC * x, const size_t N, BASE * min_out)
+{
+  int nan = 0;
+  UNIT_STRIDE_EXTREMUM (x, N, <, *min_out, nan);
+  return nan;
+}
+
+static int
+FUNCTION(unit,minmax) (const ATOMIC * x, const size_t N,
+                       BASE * min_out, BASE * max_out)
+{
+  const size_t N2 = N - N % 2;
+  BASE min0 = x[0], min1 = x[0], max0 = x[0], max1 = x[0];
+  int nan = 0;
+  size_t i;
+
+  for (i = 0; i < N2; i += 2)
+    {
+      const BASE x0 = x[i], x1 = x[i + 1];
+
+      min0 = (x0 < min0) ? x0 : min0;
+      min1 = (x1 < min1) ? x1 : min1;
+      max0 = (x0 > max0) ? x0 : max0;
+      max1 = (x1 > max1) ? x1 : max1;
+      nan |= UNIT_IS_NAN (x0) | UNIT_IS_NAN (x1);
+    }
+
+  if (i < N)
+    {
+      const BASE x0 = x[i];
+      min0 = (x0 < min0) ? x0 : min0;
+      max0 = (x0 > max0) ? x0 : max0;
+      nan |= UNIT_IS_NAN (x0);
+    }
+
+  *min_out = (min1 < min0) ? min1 : min0;
+  *max_out = (max1 > max0) ? max1 : max0;
+
+  return nan;
+}
+
+#undef UNIT_IS_NAN
+
 BASE 
 FUNCTION(gsl_vector,max) (const TYPE(gsl_vector) * v)
 {
@@ -28,6 +92,9 @@ FUNCTION(gsl_vector,max) (const TYPE(gsl_vector) * v)
   BASE max = v->data[0 * stride];
   size_t i;
 
+  if (stride == 1 && N > 0 && !FUNCTION(unit,max) (v->data, N, &max))
+    return max;
+
   for (i = 0; i < N; i++)
     {
       BASE x = v->data[i*stride];
@@ -53,6 +120,9 @@ FUNCTION(gsl_vector,min) (const TYPE(gsl_vector) * v)
   BASE min = v->data[0 * stride];
   size_t i;
 
+  if (stride == 1 && N > 0 && !FUNCTION(unit,min) (v->data, N, &min))
+    return min;
+
   for (i = 0; i < N; i++)
     {
       BASE x = v->data[i*stride];
@@ -82,6 +152,13 @@ FUNCTION(gsl_vector,minmax) (const TYPE(gsl_vector) * v,
 
   size_t i;
 
+  if (stride == 1 && N > 0 && !FUNCTION(unit,minmax) (v->data, N, &min, &max))
+    {
+      *min_out = min;
+      *max_out = max;
+      return;
+    }
+
   for (i = 0; i < N; i++)
     {
       BASE x = v->data[i*stride];
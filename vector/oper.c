@@ -4,6 +4,30 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 
+/* Replace x[i] by x[i] op y[i*ystep] for the n elements of unit stride
+   data x, with ystep = 1 for a vector operand y or 0 for a scalar.
+   All loads of a block of four precede its stores, so the block can be
+   vectorized even if x and y overlap. */
+
+#define UNIT_STRIDE_OPER(x, op, y, ystep, n)                          \
+  do {                                                                \
+    const size_t n4_ = (n) - (n) % 4;                                 \
+    size_t i_;                                                        \
+    for (i_ = 0; i_ < n4_; i_ += 4)                                   \
+      {                                                               \
+        const ATOMIC x0_ = (x)[i_] op (y)[i_ * (ystep)];              \
+        const ATOMIC x1_ = (x)[i_ + 1] op (y)[(i_ + 1) * (ystep)];    \
+        const ATOMIC x2_ = (x)[i_ + 2] op (y)[(i_ + 2) * (ystep)];    \
+        const ATOMIC x3_ = (x)[i_ + 3] op (y)[(i_ + 3) * (ystep)];    \
+        (x)[i_] = x0_;                                                \
+        (x)[i_ + 1] = x1_;                                            \
+        (x)[i_ + 2] = x2_;                                            \
+        (x)[i_ + 3] = x3_;                                            \
+      }                                                               \
+    for (; i_ < (n); i_++)                                            \
+      (x)[i_] = (x)[i_] op (y)[i_ * (ystep)];                         \
+  } while (0)
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "oper_complex_source.c"
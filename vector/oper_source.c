@@ -26,6 +26,12 @@ FUNCTION(gsl_vector, add) (TYPE(gsl_vector) * a, const TYPE(gsl_vector) * b)
     {
       GSL_ERROR ("vectors must have same length", GSL_EBADLEN);
     }
+  else if (a->stride == 1 && b->stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, +, b->data, 1, N);
+
+      return GSL_SUCCESS;
+    }
   else 
     {
       const size_t stride_a = a->stride;
@@ -51,6 +57,12 @@ FUNCTION(gsl_vector, sub) (TYPE(gsl_vector) * a, const TYPE(gsl_vector) * b)
     {
       GSL_ERROR ("vectors must have same length", GSL_EBADLEN);
     }
+  else if (a->stride == 1 && b->stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, -, b->data, 1, N);
+
+      return GSL_SUCCESS;
+    }
   else 
     {
       const size_t stride_a = a->stride;
@@ -76,6 +88,12 @@ FUNCTION(gsl_vector, mul) (TYPE(gsl_vector) * a, const TYPE(gsl_vector) * b)
     {
       GSL_ERROR ("vectors must have same length", GSL_EBADLEN);
     }
+  else if (a->stride == 1 && b->stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, *, b->data, 1, N);
+
+      return GSL_SUCCESS;
+    }
   else 
     {
       const size_t stride_a = a->stride;
@@ -101,6 +119,12 @@ FUNCTION(gsl_vector, div) (TYPE(gsl_vector) * a, const TYPE(gsl_vector) * b)
     {
       GSL_ERROR ("vectors must have same length", GSL_EBADLEN);
     }
+  else if (a->stride == 1 && b->stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, /, b->data, 1, N);
+
+      return GSL_SUCCESS;
+    }
   else 
     {
       const size_t stride_a = a->stride;
@@ -124,6 +148,13 @@ FUNCTION(gsl_vector, scale) (TYPE(gsl_vector) * a, const double x)
   const size_t stride = a->stride;
   
   size_t i;
+
+  if (stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, *, &x, 0, N);
+
+      return GSL_SUCCESS;
+    }
   
   for (i = 0; i < N; i++)
     {
@@ -140,6 +171,13 @@ FUNCTION(gsl_vector, add_constant) (TYPE(gsl_vector) * a, const double x)
   const size_t stride = a->stride;
   
   size_t i;
+
+  if (stride == 1)
+    {
+      UNIT_STRIDE_OPER (a->data, +, &x, 0, N);
+
+      return GSL_SUCCESS;
+    }
   
   for (i = 0; i < N; i++)
     {
@@ -148,4 +186,3 @@ FUNCTION(gsl_vector, add_constant) (TYPE(gsl_vector) * a, const double x)
   
   return GSL_SUCCESS;
 }
-
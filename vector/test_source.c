@@ -575,6 +575,19 @@ FUNCTION (test, func) (size_t stride, size_t N)
       TEST (imax != exp_imax, "_minmax_index returns correct maximum i for NaN");
       TEST (imin != exp_imin, "_minmax_index returns correct minimum i for NaN");
     }
+
+    FUNCTION(gsl_vector, set) (v, i, (BASE) 0);
+    FUNCTION(gsl_vector, set) (v, N - 1, GSL_NAN);
+
+    {
+      BASE min, max;
+      FUNCTION(gsl_vector, minmax) (v, &min, &max);
+
+      gsl_test_abs (FUNCTION(gsl_vector, max) (v), GSL_NAN, 0, "_max returns correct maximum value for final NaN");
+      gsl_test_abs (FUNCTION(gsl_vector, min) (v), GSL_NAN, 0, "_min returns correct minimum value for final NaN");
+      gsl_test_abs (max, GSL_NAN, 0, "_minmax returns correct maximum value for final NaN");
+      gsl_test_abs (min, GSL_NAN, 0, "_minmax returns correct minimum value for final NaN");
+    }
 #endif
 
   }
@@ -704,6 +717,42 @@ FUNCTION (test, ops) (size_t stride1, size_t stride2, size_t N)
     TEST2 (status, "_div division");
   }
 
+  FUNCTION(gsl_vector, memcpy) (v, a);
+  FUNCTION(gsl_vector, add) (v, v);
+  
+  {
+    int status = 0;
+    
+    for (i = 0; i < N; i++)
+      {
+        BASE r = FUNCTION(gsl_vector,get) (v,i);
+        BASE x = FUNCTION(gsl_vector,get) (a,i);
+        BASE z = x + x;
+        if (r != z)
+          status = 1;
+      }
+    TEST2 (status, "_add aliased vector addition");
+  }
+
+  FUNCTION(gsl_vector, memcpy) (v, a);
+  FUNCTION(gsl_vector, add_constant) (v, 1.0);
+  FUNCTION(gsl_vector, scale) (v, 0.5);
+  
+  {
+    int status = 0;
+    
+    for (i = 0; i < N; i++)
+      {
+        BASE r = FUNCTION(gsl_vector,get) (v,i);
+        BASE x = FUNCTION(gsl_vector,get) (a,i);
+        BASE z = (BASE) (x + 1.0);
+        z = (BASE) (z * 0.5);
+        if (r != z)
+          status = 1;
+      }
+    TEST2 (status, "_add_constant and _scale");
+  }
+
   FUNCTION(gsl_vector, free) (a);
   FUNCTION(gsl_vector, free) (b);
   FUNCTION(gsl_vector, free) (v);